@@ -18,6 +18,7 @@ Index of this file:
 // [SECTION] Tables: Context Menu
 // [SECTION] Tables: Settings (.ini data)
 // [SECTION] Tables: Garbage Collection
+// [SECTION] Tables: Data-bound tables
 // [SECTION] Tables: Debugging
 // [SECTION] Columns, BeginColumns, EndColumns, etc.
 
@@ -524,7 +525,7 @@ bool    ImGui::BeginTableEx(const char* name, ImGuiID id, int columns_count, ImG
         }
     }
     if (old_columns_raw_data)
-        IM_FREE(old_columns_raw_data);
+        ImSizeClassPool::Free(old_columns_raw_data);
 
     // Load settings
     if (table->IsSettingsRequestLoad)
@@ -563,7 +564,7 @@ bool    ImGui::BeginTableEx(const char* name, ImGuiID id, int columns_count, ImG
 
 // For reference, the average total _allocation count_ for a table is:
 // + 0 (for ImGuiTable instance, we are pooling allocations in g.Tables)
-// + 1 (for table->RawData allocated below)
+// + 1 (for table->RawData allocated below, from g.ObjectPool so that it is recycled as tables come and go)
 // + 1 (for table->ColumnsNames, if names are used)
 // Shared allocations per number of nested tables
 // + 1 (for table->Splitter._Channels)
@@ -577,7 +578,8 @@ void ImGui::TableBeginInitMemory(ImGuiTable* table, int columns_count)
     span_allocator.Reserve(0, columns_count * sizeof(ImGuiTableColumn));
     span_allocator.Reserve(1, columns_count * sizeof(ImGuiTableColumnIdx));
     span_allocator.Reserve(2, columns_count * sizeof(ImGuiTableCellData), 4);
-    table->RawData = IM_ALLOC(span_allocator.GetArenaSizeInBytes());
+    ImGuiContext& g = *GImGui;
+    table->RawData = g.ObjectPool.Alloc(span_allocator.GetArenaSizeInBytes());
     memset(table->RawData, 0, span_allocator.GetArenaSizeInBytes());
     span_allocator.SetArenaBasePtr(table->RawData);
     span_allocator.GetSpan(0, &table->Columns);
@@ -3522,6 +3524,537 @@ void ImGui::TableGcCompactSettings()
 }
 
 
+//-------------------------------------------------------------------------
+// [SECTION] Tables: Data-bound tables
+//-------------------------------------------------------------------------
+// - ImGuiDataTable
+// - DataTableCompareRows() [Internal]
+// - ImGuiDataTableSorter<> [Internal]
+// - DataTableSortRows() [Internal]
+// - DataTableUpdateOrder() [Internal]
+// - DataTableUpdateFilters() [Internal]
+// - DataTable()
+//-------------------------------------------------------------------------
+// Sorting is a merge sort, which splits well over worker threads: chunks of rows are sorted on their own, then merged
+// pairwise. Each merge is itself split into parts of equal output size (merge path), so the last passes, which only
+// have one or two pairs of long runs to merge, keep every worker busy. Rows compare equal only to themselves (ties
+// are broken by row index), which makes the result independent of the number of chunks, and lets rows appended later
+// be sorted on their own and merged in.
+//-------------------------------------------------------------------------
+
+static const int DATA_TABLE_MAX_ORDERS = 4;                 // Sort orders kept per table
+static const int DATA_TABLE_SORT_CHUNK_MIN_ROWS = 16384;    // Below this, sort and merge on a single thread
+static const int DATA_TABLE_SORT_MAX_CHUNKS = 64;
+static const int DATA_TABLE_FILTER_CHUNK_ROWS = 16384;
+
+// One sort key, resolved from the sort specs and the column once per sort
+struct ImGuiDataTableSortKey
+{
+    const char*                         Data;
+    int                                 Stride;
+    ImGuiDataType                       DataType;
+    const char* const*                  Strings;
+    int                                 Sign;               // +1 ascending, -1 descending
+};
+
+struct ImGuiDataTableSortContext
+{
+    ImGuiDataTableSortKey               Keys[IMGUI_TABLE_MAX_COLUMNS];
+    int                                 KeysCount;
+
+    // Parallel passes
+    int*                                Src;
+    int*                                Dst;
+    int                                 RowsCount;
+    int                                 ChunkSize;
+    int                                 MergeWidth;         // Length of the runs merged by a pass, or -1 to merge [0, MergeMid) with [MergeMid, RowsCount)
+    int                                 MergeMid;
+    int                                 MergeParts;         // Jobs per pair of runs
+
+    // Merge sort functions, specialized for the sort keys (see DataTableBindSorter())
+    void                                (*MergeRunsFn)(const ImGuiDataTableSortContext* ctx, const int* a, int a_count, const int* b, int b_count, int* out);
+    int                                 (*MergeSplitFn)(const ImGuiDataTableSortContext* ctx, const int* a, int a_count, const int* b, int b_count, int out_n);
+    void                                (*MergeSortFn)(const ImGuiDataTableSortContext* ctx, int* rows, int* buffer, int count);
+};
+
+struct ImGuiDataTableFilterContext
+{
+    const ImGuiDataTable*               Table;
+    const ImGuiDataTableColumn*         Columns;
+    int                                 ColumnsCount;
+    int                                 RowsBegin;
+    int                                 RowsEnd;
+    ImU8*                               RowsPassFilter;
+};
+
+ImGuiDataTable::~ImGuiDataTable()
+{
+    Orders.clear_destruct();
+    for (int n = 0; n < Filters.Size; n++)
+        IM_DELETE(Filters[n]);
+}
+
+void ImGuiDataTable::Invalidate()
+{
+    Orders.clear_destruct();
+    CurrentOrder = -1;
+    RowsPassFilter.resize(0);
+    VisibleRowsDirty = true;
+}
+
+int ImGuiDataTable::GetVisibleRowsCount() const
+{
+    return FilterActive ? VisibleRows.Size : RowsCount;
+}
+
+int ImGuiDataTable::GetVisibleRow(int n) const
+{
+    if (FilterActive)
+        return VisibleRows[n];
+    return (CurrentOrder != -1) ? Orders[CurrentOrder].Rows[n] : n;
+}
+
+static void DataTableParallelFor(int count, void (*job)(void* job_data, int index), void* job_data)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.IO.ParallelForFn && count > 1)
+        g.IO.ParallelForFn(g.IO.ParallelForUserData, count, job, job_data);
+    else
+        for (int n = 0; n < count; n++)
+            job(job_data, n);
+}
+
+static inline const void* DataTableGetValue(const ImGuiDataTableColumn* column, int row)
+{
+    const int stride = column->Stride ? column->Stride : (int)ImGui::DataTypeGetInfo(column->DataType)->Size;
+    return (const char*)column->Data + (size_t)row * stride;
+}
+
+// Return the text displayed for a cell, which is also what column filters are applied to
+static const char* DataTableFormatValue(const ImGuiDataTableColumn* column, int row, char* buf, int buf_size, const char** out_text_end)
+{
+    if (column->Strings)
+    {
+        const char* text = column->Strings[row] ? column->Strings[row] : "";
+        *out_text_end = text + strlen(text);
+        return text;
+    }
+    const char* format = column->Format ? column->Format : ImGui::DataTypeGetInfo(column->DataType)->PrintFmt;
+    *out_text_end = buf + ImGui::DataTypeFormatString(buf, buf_size, column->DataType, DataTableGetValue(column, row), format);
+    return buf;
+}
+
+template<typename T>
+static inline int DataTableCompareValues(const ImGuiDataTableSortKey* key, int row_a, int row_b)
+{
+    const T a = *(const T*)(key->Data + (size_t)row_a * key->Stride);
+    const T b = *(const T*)(key->Data + (size_t)row_b * key->Stride);
+    return (a < b) ? -1 : (b < a) ? +1 : 0;
+}
+
+static int DataTableCompareRows(const ImGuiDataTableSortContext* ctx, int row_a, int row_b)
+{
+    for (const ImGuiDataTableSortKey* key = ctx->Keys; key < ctx->Keys + ctx->KeysCount; key++)
+    {
+        int delta;
+        switch (key->Strings ? -1 : key->DataType)
+        {
+        case -1:                   delta = strcmp(key->Strings[row_a] ? key->Strings[row_a] : "", key->Strings[row_b] ? key->Strings[row_b] : ""); break;
+        case ImGuiDataType_S8:     delta = DataTableCompareValues<ImS8  >(key, row_a, row_b); break;
+        case ImGuiDataType_U8:     delta = DataTableCompareValues<ImU8  >(key, row_a, row_b); break;
+        case ImGuiDataType_S16:    delta = DataTableCompareValues<ImS16 >(key, row_a, row_b); break;
+        case ImGuiDataType_U16:    delta = DataTableCompareValues<ImU16 >(key, row_a, row_b); break;
+        case ImGuiDataType_S32:    delta = DataTableCompareValues<ImS32 >(key, row_a, row_b); break;
+        case ImGuiDataType_U32:    delta = DataTableCompareValues<ImU32 >(key, row_a, row_b); break;
+        case ImGuiDataType_S64:    delta = DataTableCompareValues<ImS64 >(key, row_a, row_b); break;
+        case ImGuiDataType_U64:    delta = DataTableCompareValues<ImU64 >(key, row_a, row_b); break;
+        case ImGuiDataType_Float:  delta = DataTableCompareValues<float >(key, row_a, row_b); break;
+        case ImGuiDataType_Double: delta = DataTableCompareValues<double>(key, row_a, row_b); break;
+        default:                   IM_ASSERT(0); delta = 0; break;
+        }
+        if (delta != 0)
+            return delta * key->Sign;
+    }
+    return row_a - row_b;
+}
+
+// Sorts on a single numeric key get their own comparer, with the compare of values inlined into the merge loops
+struct ImGuiDataTableRowsComparer
+{
+    const ImGuiDataTableSortContext* Ctx;
+    int operator()(int row_a, int row_b) const { return DataTableCompareRows(Ctx, row_a, row_b); }
+};
+
+template<typename T>
+struct ImGuiDataTableRowsComparerT
+{
+    const ImGuiDataTableSortContext* Ctx;
+    int operator()(int row_a, int row_b) const
+    {
+        const int delta = DataTableCompareValues<T>(&Ctx->Keys[0], row_a, row_b);
+        return (delta != 0) ? delta * Ctx->Keys[0].Sign : row_a - row_b;
+    }
+};
+
+template<typename COMPARER>
+struct ImGuiDataTableSorter
+{
+    static void MergeRuns(const ImGuiDataTableSortContext* ctx, const int* a, int a_count, const int* b, int b_count, int* out)
+    {
+        const COMPARER compare = { ctx };
+        const int* a_end = a + a_count;
+        const int* b_end = b + b_count;
+        while (a < a_end && b < b_end)
+            *out++ = (compare(*b, *a) < 0) ? *b++ : *a++;
+        while (a < a_end)
+            *out++ = *a++;
+        while (b < b_end)
+            *out++ = *b++;
+    }
+
+    // Return how many of the first 'out_n' rows of the merge of 'a' and 'b' come from 'a'
+    static int MergeSplit(const ImGuiDataTableSortContext* ctx, const int* a, int a_count, const int* b, int b_count, int out_n)
+    {
+        const COMPARER compare = { ctx };
+        int lo = ImMax(0, out_n - b_count);
+        int hi = ImMin(out_n, a_count);
+        while (lo < hi)
+        {
+            const int a_n = (lo + hi) / 2;
+            if (compare(a[a_n], b[out_n - a_n - 1]) < 0)
+                lo = a_n + 1;
+            else
+                hi = a_n;
+        }
+        return lo;
+    }
+
+    // Bottom-up merge sort of 'rows', with 'buffer' as large as 'rows'
+    static void MergeSort(const ImGuiDataTableSortContext* ctx, int* rows, int* buffer, int count)
+    {
+        const COMPARER compare = { ctx };
+        const int INSERTION_RUN = 16;
+        for (int run = 0; run < count; run += INSERTION_RUN)
+        {
+            const int run_end = ImMin(run + INSERTION_RUN, count);
+            for (int n = run + 1; n < run_end; n++)
+            {
+                const int row = rows[n];
+                int dst_n = n;
+                for (; dst_n > run && compare(row, rows[dst_n - 1]) < 0; dst_n--)
+                    rows[dst_n] = rows[dst_n - 1];
+                rows[dst_n] = row;
+            }
+        }
+        int* src = rows;
+        int* dst = buffer;
+        for (int width = INSERTION_RUN; width < count; width *= 2)
+        {
+            for (int lo = 0; lo < count; lo += width * 2)
+            {
+                const int mid = ImMin(lo + width, count);
+                const int hi = ImMin(lo + width * 2, count);
+                MergeRuns(ctx, src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+            }
+            ImSwap(src, dst);
+        }
+        if (src != rows)
+            memcpy(rows, src, (size_t)count * sizeof(int));
+    }
+
+    static void Bind(ImGuiDataTableSortContext* ctx)
+    {
+        ctx->MergeRunsFn = MergeRuns;
+        ctx->MergeSplitFn = MergeSplit;
+        ctx->MergeSortFn = MergeSort;
+    }
+};
+
+static void DataTableBindSorter(ImGuiDataTableSortContext* ctx)
+{
+    if (ctx->KeysCount == 1 && ctx->Keys[0].Strings == NULL)
+        switch (ctx->Keys[0].DataType)
+        {
+        case ImGuiDataType_S8:     ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImS8  > >::Bind(ctx); return;
+        case ImGuiDataType_U8:     ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImU8  > >::Bind(ctx); return;
+        case ImGuiDataType_S16:    ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImS16 > >::Bind(ctx); return;
+        case ImGuiDataType_U16:    ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImU16 > >::Bind(ctx); return;
+        case ImGuiDataType_S32:    ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImS32 > >::Bind(ctx); return;
+        case ImGuiDataType_U32:    ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImU32 > >::Bind(ctx); return;
+        case ImGuiDataType_S64:    ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImS64 > >::Bind(ctx); return;
+        case ImGuiDataType_U64:    ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<ImU64 > >::Bind(ctx); return;
+        case ImGuiDataType_Float:  ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<float > >::Bind(ctx); return;
+        case ImGuiDataType_Double: ImGuiDataTableSorter<ImGuiDataTableRowsComparerT<double> >::Bind(ctx); return;
+        default: break;
+        }
+    ImGuiDataTableSorter<ImGuiDataTableRowsComparer>::Bind(ctx);
+}
+
+static void DataTableSortChunkJob(void* job_data, int chunk_n)
+{
+    ImGuiDataTableSortContext* ctx = (ImGuiDataTableSortContext*)job_data;
+    const int begin = chunk_n * ctx->ChunkSize;
+    const int end = ImMin(begin + ctx->ChunkSize, ctx->RowsCount);
+    ctx->MergeSortFn(ctx, ctx->Src + begin, ctx->Dst + begin, end - begin);
+}
+
+static void DataTableMergeJob(void* job_data, int job_n)
+{
+    ImGuiDataTableSortContext* ctx = (ImGuiDataTableSortContext*)job_data;
+    const int pair_n = job_n / ctx->MergeParts;
+    const int part_n = job_n % ctx->MergeParts;
+    const int lo = (ctx->MergeWidth == -1) ? 0 : pair_n * ctx->MergeWidth * 2;
+    const int mid = (ctx->MergeWidth == -1) ? ctx->MergeMid : ImMin(lo + ctx->MergeWidth, ctx->RowsCount);
+    const int hi = (ctx->MergeWidth == -1) ? ctx->RowsCount : ImMin(lo + ctx->MergeWidth * 2, ctx->RowsCount);
+    const int* a = ctx->Src + lo;
+    const int* b = ctx->Src + mid;
+    const int a_count = mid - lo;
+    const int b_count = hi - mid;
+    const int out_begin = (int)((ImS64)(hi - lo) * part_n / ctx->MergeParts);
+    const int out_end = (int)((ImS64)(hi - lo) * (part_n + 1) / ctx->MergeParts);
+    const int a_begin = ctx->MergeSplitFn(ctx, a, a_count, b, b_count, out_begin);
+    const int a_end = ctx->MergeSplitFn(ctx, a, a_count, b, b_count, out_end);
+    ctx->MergeRunsFn(ctx, a + a_begin, a_end - a_begin, b + (out_begin - a_begin), (out_end - a_end) - (out_begin - a_begin), ctx->Dst + lo + out_begin);
+}
+
+static int DataTableCalcChunksCount(int rows_count)
+{
+    ImGuiContext& g = *GImGui;
+    int chunks_count = 1;
+    if (g.IO.ParallelForFn)
+        while (chunks_count < DATA_TABLE_SORT_MAX_CHUNKS && rows_count / (chunks_count * 2) >= DATA_TABLE_SORT_CHUNK_MIN_ROWS)
+            chunks_count *= 2;
+    return chunks_count;
+}
+
+// Sort 'rows', with 'buffer' as large as 'rows'
+static void DataTableSortRows(ImGuiDataTableSortContext* ctx, int* rows, int* buffer, int count)
+{
+    const int chunks_count = DataTableCalcChunksCount(count);
+    if (chunks_count == 1)
+    {
+        ctx->MergeSortFn(ctx, rows, buffer, count);
+        return;
+    }
+
+    ctx->Src = rows;
+    ctx->Dst = buffer;
+    ctx->RowsCount = count;
+    ctx->ChunkSize = (count + chunks_count - 1) / chunks_count;
+    DataTableParallelFor(chunks_count, DataTableSortChunkJob, ctx);
+    for (ctx->MergeWidth = ctx->ChunkSize; ctx->MergeWidth < count; ctx->MergeWidth *= 2)
+    {
+        const int pairs_count = (count + ctx->MergeWidth * 2 - 1) / (ctx->MergeWidth * 2);
+        ctx->MergeParts = ImMax(chunks_count / pairs_count, 1);
+        DataTableParallelFor(pairs_count * ctx->MergeParts, DataTableMergeJob, ctx);
+        ImSwap(ctx->Src, ctx->Dst);
+    }
+    if (ctx->Src != rows)
+        memcpy(rows, ctx->Src, (size_t)count * sizeof(int));
+}
+
+// Bring an order up to date with the data source: rows appended since last time are sorted alone, then merged in.
+static void DataTableUpdateOrder(ImGuiDataTable* table, ImGuiDataTableOrder* order, ImGuiDataTableSortContext* ctx, int rows_count)
+{
+    const int sorted_count = order->Rows.Size;
+    if (sorted_count == rows_count)
+        return;
+    IM_ASSERT(sorted_count < rows_count);
+
+    const int appended_count = rows_count - sorted_count;
+    order->Rows.resize(rows_count);
+    for (int n = sorted_count; n < rows_count; n++)
+        order->Rows[n] = n;
+    table->SortBuffer.resize(rows_count);
+    DataTableSortRows(ctx, order->Rows.Data + sorted_count, table->SortBuffer.Data, appended_count);
+    if (sorted_count == 0)
+        return;
+
+    ctx->Src = order->Rows.Data;
+    ctx->Dst = table->SortBuffer.Data;
+    ctx->RowsCount = rows_count;
+    ctx->MergeWidth = -1;
+    ctx->MergeMid = sorted_count;
+    ctx->MergeParts = DataTableCalcChunksCount(rows_count);
+    DataTableParallelFor(ctx->MergeParts, DataTableMergeJob, ctx);
+    order->Rows.swap(table->SortBuffer);
+}
+
+static void DataTableFilterJob(void* job_data, int chunk_n)
+{
+    ImGuiDataTableFilterContext* ctx = (ImGuiDataTableFilterContext*)job_data;
+    const int begin = ctx->RowsBegin + chunk_n * DATA_TABLE_FILTER_CHUNK_ROWS;
+    const int end = ImMin(begin + DATA_TABLE_FILTER_CHUNK_ROWS, ctx->RowsEnd);
+    char buf[64];
+    for (int row = begin; row < end; row++)
+    {
+        bool pass = true;
+        for (int column_n = 0; column_n < ctx->ColumnsCount && pass; column_n++)
+        {
+            const ImGuiTextFilter* filter = ctx->Table->Filters[column_n];
+            if (!filter->IsActive())
+                continue;
+            const char* text_end;
+            const char* text = DataTableFormatValue(&ctx->Columns[column_n], row, buf, IM_ARRAYSIZE(buf), &text_end);
+            pass = filter->PassFilter(text, text_end);
+        }
+        ctx->RowsPassFilter[row] = pass ? 1 : 0;
+    }
+}
+
+// Apply the filters to rows they were not applied to yet
+static void DataTableUpdateFilters(ImGuiDataTable* table, const ImGuiDataTableColumn* columns, int columns_count, int rows_count)
+{
+    ImGuiDataTableFilterContext ctx;
+    ctx.Table = table;
+    ctx.Columns = columns;
+    ctx.ColumnsCount = columns_count;
+    ctx.RowsBegin = table->RowsPassFilter.Size;
+    ctx.RowsEnd = rows_count;
+    table->RowsPassFilter.resize(rows_count);
+    ctx.RowsPassFilter = table->RowsPassFilter.Data;
+    DataTableParallelFor((ctx.RowsEnd - ctx.RowsBegin + DATA_TABLE_FILTER_CHUNK_ROWS - 1) / DATA_TABLE_FILTER_CHUNK_ROWS, DataTableFilterJob, &ctx);
+}
+
+bool ImGui::DataTable(const char* str_id, ImGuiDataTable* table, const ImGuiDataTableColumn* columns, int columns_count, int rows_count, ImGuiTableFlags flags, const ImVec2& outer_size)
+{
+    IM_ASSERT(table != NULL && columns != NULL && rows_count >= 0);
+
+    // Header and filter rows are frozen, which requires scrolling
+    if (!BeginTable(str_id, columns_count, flags | ImGuiTableFlags_ScrollY, outer_size))
+        return false;
+
+    table->UseCount++;
+    while (table->Filters.Size < columns_count)
+        table->Filters.push_back(IM_NEW(ImGuiTextFilter)());
+    if (rows_count < table->RowsCount)
+        table->Invalidate(); // Rows were removed: we can't tell which
+
+    for (int column_n = 0; column_n < columns_count; column_n++)
+    {
+        const ImGuiDataTableColumn* column = &columns[column_n];
+        IM_ASSERT((column->Data != NULL || column->Strings != NULL || rows_count == 0) && "Missing data for column!");
+        TableSetupColumn(column->Label, column->Flags, column->InitWidthOrWeight, (ImGuiID)column_n);
+    }
+    TableSetupScrollFreeze(0, 2);
+
+    // Sort, reusing the order of previous identical sort specs
+    int order_n = -1;
+    ImGuiTableSortSpecs* sort_specs = TableGetSortSpecs();
+    if (sort_specs && sort_specs->SpecsCount > 0)
+    {
+        ImGuiID specs_hash = 0;
+        for (int spec_n = 0; spec_n < sort_specs->SpecsCount; spec_n++)
+        {
+            const int key[2] = { sort_specs->Specs[spec_n].ColumnIndex, sort_specs->Specs[spec_n].SortDirection };
+            specs_hash = ImHashData(key, sizeof(key), specs_hash);
+        }
+        for (int n = 0; n < table->Orders.Size && order_n == -1; n++)
+            if (table->Orders[n].SpecsHash == specs_hash)
+                order_n = n;
+        if (order_n == -1)
+        {
+            if (table->Orders.Size < DATA_TABLE_MAX_ORDERS)
+            {
+                table->Orders.push_back(ImGuiDataTableOrder());
+                order_n = table->Orders.Size - 1;
+            }
+            else
+            {
+                order_n = 0;
+                for (int n = 1; n < table->Orders.Size; n++)
+                    if (table->Orders[n].LastUse < table->Orders[order_n].LastUse)
+                        order_n = n;
+            }
+            table->Orders[order_n].SpecsHash = specs_hash;
+            table->Orders[order_n].Rows.resize(0);
+        }
+
+        ImGuiDataTableOrder* order = &table->Orders[order_n];
+        order->LastUse = table->UseCount;
+        ImGuiDataTableSortContext ctx;
+        ctx.KeysCount = sort_specs->SpecsCount;
+        for (int key_n = 0; key_n < ctx.KeysCount; key_n++)
+        {
+            const ImGuiTableColumnSortSpecs* spec = &sort_specs->Specs[key_n];
+            const ImGuiDataTableColumn* column = &columns[spec->ColumnIndex];
+            ImGuiDataTableSortKey* key = &ctx.Keys[key_n];
+            key->Data = (const char*)column->Data;
+            key->Stride = column->Stride ? column->Stride : (int)DataTypeGetInfo(column->DataType)->Size;
+            key->DataType = column->DataType;
+            key->Strings = column->Strings;
+            key->Sign = (spec->SortDirection == ImGuiSortDirection_Ascending) ? +1 : -1;
+        }
+        DataTableBindSorter(&ctx);
+        DataTableUpdateOrder(table, order, &ctx, rows_count);
+        sort_specs->SpecsDirty = false;
+    }
+    if (table->CurrentOrder != order_n)
+        table->VisibleRowsDirty = true;
+    table->CurrentOrder = order_n;
+
+    // Headers and filters
+    TableHeadersRow();
+    TableNextRow(ImGuiTableRowFlags_Headers);
+    bool filters_changed = false;
+    bool filter_active = false;
+    for (int column_n = 0; column_n < columns_count; column_n++)
+    {
+        ImGuiTextFilter* filter = table->Filters[column_n];
+        if (TableSetColumnIndex(column_n))
+        {
+            PushID(column_n);
+            filters_changed |= filter->Draw("##Filter", -FLT_MIN);
+            PopID();
+        }
+        filter_active |= filter->IsActive();
+    }
+    if (filters_changed || filter_active != table->FilterActive)
+    {
+        table->RowsPassFilter.resize(0);
+        table->VisibleRowsDirty = true;
+    }
+    if (rows_count != table->RowsCount)
+        table->VisibleRowsDirty = true;
+    table->FilterActive = filter_active;
+    table->RowsCount = rows_count;
+    if (filter_active && table->RowsPassFilter.Size < rows_count)
+        DataTableUpdateFilters(table, columns, columns_count, rows_count);
+    if (filter_active && table->VisibleRowsDirty)
+    {
+        const int* order_rows = (order_n != -1) ? table->Orders[order_n].Rows.Data : NULL;
+        table->VisibleRows.resize(0);
+        for (int n = 0; n < rows_count; n++)
+        {
+            const int row = order_rows ? order_rows[n] : n;
+            if (table->RowsPassFilter[row])
+                table->VisibleRows.push_back(row);
+        }
+    }
+    table->VisibleRowsDirty = false;
+
+    // Submit visible rows only
+    ImGuiListClipper clipper;
+    clipper.Begin(table->GetVisibleRowsCount());
+    char buf[64];
+    while (clipper.Step())
+        for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+        {
+            const int row = table->GetVisibleRow(n);
+            TableNextRow();
+            for (int column_n = 0; column_n < columns_count; column_n++)
+                if (TableSetColumnIndex(column_n))
+                {
+                    const char* text_end;
+                    const char* text = DataTableFormatValue(&columns[column_n], row, buf, IM_ARRAYSIZE(buf), &text_end);
+                    TextUnformatted(text, text_end);
+                }
+        }
+
+    EndTable();
+    return true;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Tables: Debugging
 //-------------------------------------------------------------------------
@@ -0,0 +1,155 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+struct BenchEntry
+{
+	const char* Name;
+	BenchFn Run;
+};
+
+static const BenchEntry BENCHES[] = {
+	{ "instance_batch", BenchInstanceBatch },
+	{ "shader_parser", BenchShaderParser },
+	{ "shader_cache", BenchShaderCache },
+	{ "uniforms", BenchUniforms },
+	{ "upload_ring", BenchUploadRing },
+	{ "gl_state", BenchGLState },
+	{ "polyline", BenchPolyline },
+	{ "circles", BenchCircles },
+	{ "utf8", BenchUtf8 },
+	{ "font_atlas", BenchFontAtlas },
+	{ "hash", BenchHash },
+	{ "storage", BenchStorage },
+	{ "text_document", BenchTextDocument },
+	{ "data_table", BenchDataTable },
+	{ "frame_allocations", BenchFrameAllocations },
+	{ "retained_draw_lists", BenchRetainedDrawLists },
+	{ "event_waiting", BenchEventWaiting },
+};
+
+static int s_Failures = 0;
+static volatile size_t s_Sink = 0;
+
+bool BenchCheck( bool condition, const char* format, ... )
+{
+	if ( condition )
+		return true;
+
+	s_Failures++;
+	printf( "  FAILED: " );
+	va_list args;
+	va_start( args, format );
+	vprintf( format, args );
+	va_end( args );
+	printf( "\n" );
+	return false;
+}
+
+void BenchKeep( size_t value )
+{
+	s_Sink = s_Sink + value;
+}
+
+BenchImGuiFrame::BenchImGuiFrame()
+{
+	m_Context = ImGui::CreateContext();
+
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = nullptr;
+	io.DisplaySize = ImVec2( 1920.0f, 1080.0f );
+	io.DeltaTime = 1.0f / 60.0f;
+	io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+	unsigned char* pixels;
+	int width, height;
+	io.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+
+	ImGui::NewFrame();
+}
+
+BenchImGuiFrame::~BenchImGuiFrame()
+{
+	ImGui::EndFrame();
+	ImGui::DestroyContext( m_Context );
+}
+
+void BenchImGuiFrame::ResetDrawList( ImDrawList& drawList, int flags ) const
+{
+	drawList._ResetForNewFrame();
+	drawList.Flags = flags | ImDrawListFlags_AllowVtxOffset;
+	drawList.PushClipRectFullScreen();
+	drawList.PushTextureID( ImGui::GetIO().Fonts->TexID );
+}
+
+bool BenchSameDrawList( const ImDrawList& a, const ImDrawList& b )
+{
+	if ( a.VtxBuffer.Size != b.VtxBuffer.Size || a.IdxBuffer.Size != b.IdxBuffer.Size || a.CmdBuffer.Size != b.CmdBuffer.Size )
+		return false;
+	return memcmp( a.VtxBuffer.Data, b.VtxBuffer.Data, a.VtxBuffer.size_in_bytes() ) == 0
+		&& memcmp( a.IdxBuffer.Data, b.IdxBuffer.Data, a.IdxBuffer.size_in_bytes() ) == 0
+		&& memcmp( a.CmdBuffer.Data, b.CmdBuffer.Data, a.CmdBuffer.size_in_bytes() ) == 0;
+}
+
+float BenchMaxVertexDistance( const ImDrawList& a, const ImDrawList& b )
+{
+	if ( a.VtxBuffer.Size != b.VtxBuffer.Size || a.IdxBuffer.Size != b.IdxBuffer.Size || a.CmdBuffer.Size != b.CmdBuffer.Size )
+		return -1.0f;
+	if ( memcmp( a.IdxBuffer.Data, b.IdxBuffer.Data, a.IdxBuffer.size_in_bytes() ) != 0 || memcmp( a.CmdBuffer.Data, b.CmdBuffer.Data, a.CmdBuffer.size_in_bytes() ) != 0 )
+		return -1.0f;
+
+	float maxDistance = 0.0f;
+	for ( int i = 0; i < a.VtxBuffer.Size; i++ )
+	{
+		const ImDrawVert& va = a.VtxBuffer[i];
+		const ImDrawVert& vb = b.VtxBuffer[i];
+		if ( va.col != vb.col || va.uv.x != vb.uv.x || va.uv.y != vb.uv.y )
+			return -1.0f;
+		maxDistance = ImMax( maxDistance, ImMax( ImFabs( va.pos.x - vb.pos.x ), ImFabs( va.pos.y - vb.pos.y ) ) );
+	}
+	return maxDistance;
+}
+
+// Usage: Bench [name...]. Without arguments every bench runs.
+int main( int argc, char** argv )
+{
+	for ( int i = 1; i < argc; i++ )
+	{
+		bool known = false;
+		for ( const BenchEntry& bench : BENCHES )
+			known |= strcmp( argv[i], bench.Name ) == 0;
+		if ( !known )
+		{
+			printf( "Unknown bench '%s'. Available:", argv[i] );
+			for ( const BenchEntry& bench : BENCHES )
+				printf( " %s", bench.Name );
+			printf( "\n" );
+			return 2;
+		}
+	}
+
+	for ( const BenchEntry& bench : BENCHES )
+	{
+		bool selected = argc < 2;
+		for ( int i = 1; i < argc; i++ )
+			selected |= strcmp( argv[i], bench.Name ) == 0;
+		if ( !selected )
+			continue;
+
+		printf( "== %s\n", bench.Name );
+		bench.Run();
+		fflush( stdout );
+	}
+
+	if ( s_Failures > 0 )
+	{
+		printf( "%d check(s) failed\n", s_Failures );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+// Shared helpers for the micro benchmarks. Every bench prints its own timings
+// and reports mismatches against its reference implementation through
+// BenchCheck(); any failed check makes the run exit with a non-zero code.
+
+typedef void ( *BenchFn )();
+
+struct ImDrawList;
+struct ImGuiContext;
+
+// Creates an ImGui context with a built font atlas and starts a frame, so draw
+// lists get valid shared data (texture UVs for lines, circle segment counts).
+// The frame is ended and the context destroyed with the object.
+class BenchImGuiFrame
+{
+public:
+	BenchImGuiFrame();
+	~BenchImGuiFrame();
+
+	BenchImGuiFrame( const BenchImGuiFrame& ) = delete;
+	BenchImGuiFrame& operator=( const BenchImGuiFrame& ) = delete;
+
+	// Clears the list and sets it up the way a window's list starts: full screen clip rect, font texture.
+	void ResetDrawList( ImDrawList& drawList, int flags ) const;
+
+private:
+	ImGuiContext* m_Context;
+};
+
+// True when both lists hold the same vertices, indices and commands, byte for byte.
+bool BenchSameDrawList( const ImDrawList& a, const ImDrawList& b );
+
+// Largest distance between matching vertex positions of two lists that are
+// otherwise identical (indices, commands, UVs and colors); -1 if they are not.
+float BenchMaxVertexDistance( const ImDrawList& a, const ImDrawList& b );
+
+class BenchTimer
+{
+public:
+	BenchTimer() : m_Start( std::chrono::steady_clock::now() ) {}
+
+	double GetMilliseconds() const
+	{
+		return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - m_Start ).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point m_Start;
+};
+
+// Best of 'repeats' runs, in milliseconds. The minimum is the least noisy
+// estimate on a desktop machine with other work going on.
+template<typename Fn>
+double BenchBestOf( int repeats, Fn&& fn )
+{
+	double best = 0.0;
+	for ( int i = 0; i < repeats; i++ )
+	{
+		BenchTimer timer;
+		fn();
+		double ms = timer.GetMilliseconds();
+		if ( i == 0 || ms < best )
+			best = ms;
+	}
+	return best;
+}
+
+inline double BenchMegabytesPerSecond( size_t bytes, double milliseconds )
+{
+	return milliseconds > 0.0 ? (double)bytes / ( 1024.0 * 1024.0 ) / ( milliseconds / 1000.0 ) : 0.0;
+}
+
+// Prints the message and counts a failure when 'condition' is false.
+bool BenchCheck( bool condition, const char* format, ... );
+
+// Keeps the optimizer from discarding a result that is otherwise unused.
+void BenchKeep( size_t value );
+
+void BenchInstanceBatch();
+void BenchShaderParser();
+void BenchShaderCache();
+void BenchPolyline();
+void BenchCircles();
+void BenchUtf8();
+void BenchFontAtlas();
+void BenchStorage();
+void BenchTextDocument();
+void BenchDataTable();
+void BenchUniforms();
+void BenchUploadRing();
+void BenchGLState();
+void BenchHash();
+void BenchFrameAllocations();
+void BenchRetainedDrawLists();
+void BenchEventWaiting();
@@ -0,0 +1,142 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Circle primitives and convex fills, each drawn 50k times into one list:
+// - "cached": the default path, circles reuse the unit-circle ring cache.
+// - "uncached": the ring cache is emptied and made read-only, so every circle is tessellated again.
+// - "scalar": uncached with ImDrawListFlags_NoSimd, the code path as it was before the cache and the batched fringes.
+// "uncached" must match "scalar" byte for byte. "cached" must too, except for the
+// anti-aliased fringe of filled circles, whose directions are normalized once on
+// the unit circle and may differ by rounding.
+
+enum class CircleShape
+{
+	Circle,
+	CircleFilled,
+	Ngon,
+	NgonFilled,
+	ConvexPolyFilled,
+};
+
+struct CircleCase
+{
+	const char* Name;
+	CircleShape Shape;
+	float Radius;
+	int Segments; // 0: automatic count. ConvexPolyFilled: number of points.
+	bool AntiAliasedFill;
+};
+
+static const CircleCase CASES[] = {
+	{ "AddCircle r4 16 seg", CircleShape::Circle, 4.0f, 16, true },
+	{ "AddCircle r6 auto", CircleShape::Circle, 6.0f, 0, true },
+	{ "AddCircleFilled r3 auto", CircleShape::CircleFilled, 3.0f, 0, true },
+	{ "AddCircleFilled r3 12 seg", CircleShape::CircleFilled, 3.0f, 12, true },
+	{ "AddCircleFilled r20 32 seg", CircleShape::CircleFilled, 20.0f, 32, true },
+	{ "AddCircleFilled r20 32 seg, no AA", CircleShape::CircleFilled, 20.0f, 32, false },
+	{ "AddNgon r8 6 seg", CircleShape::Ngon, 8.0f, 6, true },
+	{ "AddNgonFilled r8 6 seg", CircleShape::NgonFilled, 8.0f, 6, true },
+	{ "AddConvexPolyFilled 7 pts", CircleShape::ConvexPolyFilled, 10.0f, 7, true },
+	{ "AddConvexPolyFilled 24 pts", CircleShape::ConvexPolyFilled, 10.0f, 24, true },
+};
+
+// Largest position difference allowed between cached and uncached AA fill fringes (see ImDrawListCircleRing)
+static const float FRINGE_TOLERANCE = 1e-3f;
+
+static void SetCircleRingCache( bool enabled )
+{
+	ImDrawListSharedData* data = (ImDrawListSharedData*)ImGui::GetDrawListSharedData();
+	data->CachesReadOnly = false;
+	data->ClearCircleRings();
+	data->CachesReadOnly = !enabled;
+}
+
+static void DrawCase( ImDrawList& drawList, const CircleCase& test, const std::vector<ImVec2>& centers, const std::vector<ImVec2>& outline )
+{
+	const ImU32 col = IM_COL32( 255, 255, 255, 255 );
+	std::vector<ImVec2> polygon( outline.size() );
+
+	for ( const ImVec2& center : centers )
+	{
+		switch ( test.Shape )
+		{
+		case CircleShape::Circle:       drawList.AddCircle( center, test.Radius, col, test.Segments, 1.0f ); break;
+		case CircleShape::CircleFilled: drawList.AddCircleFilled( center, test.Radius, col, test.Segments ); break;
+		case CircleShape::Ngon:         drawList.AddNgon( center, test.Radius, col, test.Segments, 1.0f ); break;
+		case CircleShape::NgonFilled:   drawList.AddNgonFilled( center, test.Radius, col, test.Segments ); break;
+		case CircleShape::ConvexPolyFilled:
+			for ( size_t i = 0; i < outline.size(); i++ )
+				polygon[i] = ImVec2( center.x + outline[i].x, center.y + outline[i].y );
+			drawList.AddConvexPolyFilled( polygon.data(), (int)polygon.size(), col );
+			break;
+		}
+	}
+}
+
+void BenchCircles()
+{
+	BenchImGuiFrame frame;
+
+	const int COUNT = 50000;
+	std::vector<ImVec2> centers( COUNT );
+	for ( int i = 0; i < COUNT; i++ )
+		centers[i] = ImVec2( ( i % 500 ) * 3.1f + 0.37f, ( i / 500 ) * 4.3f + 0.61f );
+
+	ImDrawList cached( ImGui::GetDrawListSharedData() );
+	ImDrawList uncached( ImGui::GetDrawListSharedData() );
+	ImDrawList scalar( ImGui::GetDrawListSharedData() );
+
+	for ( const CircleCase& test : CASES )
+	{
+		std::vector<ImVec2> outline;
+		if ( test.Shape == CircleShape::ConvexPolyFilled )
+		{
+			for ( int i = 0; i < test.Segments; i++ )
+			{
+				// Irregular but convex: an ellipse sampled at uneven angles
+				float angle = ( i + 0.3f * ( i % 3 ) ) * 6.2831853f / test.Segments;
+				outline.push_back( ImVec2( test.Radius * cosf( angle ), 0.6f * test.Radius * sinf( angle ) ) );
+			}
+		}
+
+		const int flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ( test.AntiAliasedFill ? ImDrawListFlags_AntiAliasedFill : 0 );
+
+		SetCircleRingCache( true );
+		double cachedMs = BenchBestOf( 15, [&]() {
+			frame.ResetDrawList( cached, flags );
+			DrawCase( cached, test, centers, outline );
+		} );
+
+		SetCircleRingCache( false );
+		double uncachedMs = BenchBestOf( 15, [&]() {
+			frame.ResetDrawList( uncached, flags );
+			DrawCase( uncached, test, centers, outline );
+		} );
+		double scalarMs = BenchBestOf( 15, [&]() {
+			frame.ResetDrawList( scalar, flags | ImDrawListFlags_NoSimd );
+			DrawCase( scalar, test, centers, outline );
+		} );
+		SetCircleRingCache( true );
+
+		printf( "  %-36s cached %6.2f ms  uncached %6.2f ms  scalar %6.2f ms\n", test.Name, cachedMs, uncachedMs, scalarMs );
+
+		BenchCheck( BenchSameDrawList( uncached, scalar ), "%s: uncached output differs from the scalar path", test.Name );
+
+		const bool fringeMayDiffer = test.AntiAliasedFill && ( test.Shape == CircleShape::CircleFilled || test.Shape == CircleShape::NgonFilled );
+		if ( fringeMayDiffer )
+		{
+			float distance = BenchMaxVertexDistance( cached, scalar );
+			BenchCheck( distance >= 0.0f && distance <= FRINGE_TOLERANCE, "%s: cached fill differs from the scalar path (max distance %g)", test.Name, distance );
+		}
+		else
+		{
+			BenchCheck( BenchSameDrawList( cached, scalar ), "%s: cached output differs from the scalar path", test.Name );
+		}
+	}
+}
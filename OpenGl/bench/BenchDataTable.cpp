@@ -0,0 +1,249 @@
+#include "Bench.h"
+
+#include "WorkerPool.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// DataTable() sorts with a chunked merge sort and merges appended rows into its cached
+// orders. Every order it shows must be the one std::stable_sort gives for the same
+// keys, whatever the number of threads, the order of sort changes and appends.
+
+struct TelemetryRow
+{
+	int Pad;
+	float Value;
+};
+
+struct TableSource
+{
+	std::vector<int> Ids;                 // Few distinct values: lots of ties
+	std::vector<TelemetryRow> Rows;       // Read through a stride
+	std::vector<const char*> Names;
+	std::vector<double> Times;
+	ImGuiDataTableColumn Columns[4];
+
+	void Append( std::mt19937& random, int count )
+	{
+		static const char* NAMES[] = { "gamma", "alpha", "delta", "beta", "epsilon" };
+		for ( int i = 0; i < count; i++ )
+		{
+			Ids.push_back( (int)( random() % 100 ) );
+			Rows.push_back( { 0, (float)( random() % 1000 ) * 0.5f } );
+			Names.push_back( NAMES[random() % 5] );
+			Times.push_back( (double)random() / 1000.0 );
+		}
+		for ( ImGuiDataTableColumn& column : Columns )
+			column = ImGuiDataTableColumn();
+		Columns[0].Label = "Id";
+		Columns[0].DataType = ImGuiDataType_S32;
+		Columns[0].Data = Ids.data();
+		Columns[1].Label = "Value";
+		Columns[1].DataType = ImGuiDataType_Float;
+		Columns[1].Data = &Rows[0].Value;
+		Columns[1].Stride = sizeof( TelemetryRow );
+		Columns[2].Label = "Name";
+		Columns[2].Strings = Names.data();
+		Columns[3].Label = "Time";
+		Columns[3].DataType = ImGuiDataType_Double;
+		Columns[3].Data = Times.data();
+	}
+
+	int GetRowsCount() const { return (int)Ids.size(); }
+
+	int Compare( int column, int a, int b ) const
+	{
+		switch ( column )
+		{
+		case 0:  return Ids[a] < Ids[b] ? -1 : Ids[b] < Ids[a] ? 1 : 0;
+		case 1:  return Rows[a].Value < Rows[b].Value ? -1 : Rows[b].Value < Rows[a].Value ? 1 : 0;
+		case 2:  return strcmp( Names[a], Names[b] );
+		default: return Times[a] < Times[b] ? -1 : Times[b] < Times[a] ? 1 : 0;
+		}
+	}
+};
+
+struct SortKey
+{
+	int Column;
+	ImGuiSortDirection Direction;
+};
+
+static std::vector<int> ReferenceOrder( const TableSource& source, const std::vector<SortKey>& keys )
+{
+	std::vector<int> order( source.GetRowsCount() );
+	std::iota( order.begin(), order.end(), 0 );
+	std::stable_sort( order.begin(), order.end(), [&]( int a, int b ) {
+		for ( const SortKey& key : keys )
+		{
+			const int delta = source.Compare( key.Column, a, b );
+			if ( delta != 0 )
+				return key.Direction == ImGuiSortDirection_Ascending ? delta < 0 : delta > 0;
+		}
+		return false;
+	} );
+	return order;
+}
+
+// Runs frames with one window holding the table. Sort specs are changed the way clicking
+// (or shift-clicking) a header does, before the table is submitted.
+class DataTableFrames
+{
+public:
+	explicit DataTableFrames( WorkerPool* pool )
+	{
+		m_Context = ImGui::CreateContext();
+		ImGuiIO& io = ImGui::GetIO();
+		io.ParallelForFn = pool ? WorkerPool::ImGuiParallelFor : nullptr;
+		io.ParallelForUserData = pool;
+		io.IniFilename = nullptr;
+		io.DisplaySize = ImVec2( 1920.0f, 1080.0f );
+		io.DeltaTime = 1.0f / 60.0f;
+		unsigned char* pixels;
+		int width, height;
+		io.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+	}
+
+	~DataTableFrames() { ImGui::DestroyContext( m_Context ); }
+
+	void Run( ImGuiDataTable& table, const TableSource& source, const std::vector<SortKey>& keys )
+	{
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos( ImVec2( 0.0f, 0.0f ) );
+		ImGui::SetNextWindowSize( ImVec2( 800.0f, 600.0f ) );
+		ImGui::Begin( "Data" );
+		ImGuiTable* imguiTable = ImGui::TableFindByID( ImGui::GetID( "##Data" ) );
+		if ( imguiTable && !keys.empty() )
+		{
+			ImGuiContext& g = *GImGui;
+			g.CurrentTable = imguiTable;
+			for ( size_t n = 0; n < keys.size(); n++ )
+				ImGui::TableSetColumnSortDirection( keys[n].Column, keys[n].Direction, n > 0 );
+			g.CurrentTable = nullptr;
+		}
+		ImGui::DataTable( "##Data", &table, source.Columns, 4, source.GetRowsCount(), ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti );
+		ImGui::End();
+		ImGui::Render();
+	}
+
+private:
+	ImGuiContext* m_Context;
+};
+
+static std::vector<int> ShownOrder( const ImGuiDataTable& table )
+{
+	std::vector<int> order( table.GetVisibleRowsCount() );
+	for ( int n = 0; n < (int)order.size(); n++ )
+		order[n] = table.GetVisibleRow( n );
+	return order;
+}
+
+static void CheckSortOrders( WorkerPool* pool )
+{
+	const char* mode = pool ? "threads" : "1 thread";
+	std::mt19937 random( 16 );
+	TableSource source;
+	source.Append( random, 100000 );
+	ImGuiDataTable table;
+	DataTableFrames frames( pool );
+
+	// The first frame creates the table, which sorts on its first column
+	frames.Run( table, source, {} );
+	BenchCheck( ShownOrder( table ) == ReferenceOrder( source, { { 0, ImGuiSortDirection_Ascending } } ), "DataTable (%s): default sort on the first column", mode );
+
+	const std::vector<SortKey> specs[] = {
+		{ { 0, ImGuiSortDirection_Descending } },
+		{ { 2, ImGuiSortDirection_Ascending }, { 1, ImGuiSortDirection_Descending } },
+		{ { 1, ImGuiSortDirection_Ascending } },
+		{ { 2, ImGuiSortDirection_Descending }, { 0, ImGuiSortDirection_Ascending }, { 3, ImGuiSortDirection_Descending } },
+	};
+	int failures = 0;
+	for ( const std::vector<SortKey>& keys : specs )
+	{
+		frames.Run( table, source, keys );
+		failures += ShownOrder( table ) != ReferenceOrder( source, keys );
+	}
+	BenchCheck( failures == 0, "DataTable (%s): %d sort orders differ from std::stable_sort", mode, failures );
+
+	// Five different specs so far: only the four most recent are kept. Going back to one of them
+	// reuses its rows (same buffer), then appended rows are merged into it and into the others.
+	BenchCheck( table.Orders.Size == 4, "DataTable (%s): %d cached orders, expected 4", mode, table.Orders.Size );
+	frames.Run( table, source, specs[1] );
+	const int* cached = table.Orders[table.CurrentOrder].Rows.Data;
+	frames.Run( table, source, specs[3] );
+	frames.Run( table, source, specs[1] );
+	BenchCheck( table.Orders.Size == 4 && table.Orders[table.CurrentOrder].Rows.Data == cached, "DataTable (%s): going back to a cached sort must not sort again", mode );
+
+	failures = 0;
+	for ( int round = 0; round < 3; round++ )
+	{
+		source.Append( random, round == 0 ? 7 : 40000 );
+		for ( const std::vector<SortKey>& keys : specs )
+		{
+			frames.Run( table, source, keys );
+			failures += ShownOrder( table ) != ReferenceOrder( source, keys );
+		}
+	}
+	BenchCheck( failures == 0, "DataTable (%s): %d orders differ from std::stable_sort after appending rows", mode, failures );
+
+	// A filter shows the passing rows in the current order, including rows appended later
+	ImGuiTextFilter& filter = *table.Filters[2];
+	strcpy( filter.InputBuf, "lph" );
+	filter.Build();
+	frames.Run( table, source, specs[3] );
+	source.Append( random, 5000 );
+	frames.Run( table, source, specs[3] );
+	std::vector<int> expected;
+	for ( int row : ReferenceOrder( source, specs[3] ) )
+		if ( strcmp( source.Names[row], "alpha" ) == 0 )
+			expected.push_back( row );
+	BenchCheck( ShownOrder( table ) == expected, "DataTable (%s): filtered rows must keep the sort order", mode );
+
+	filter.Clear();
+	frames.Run( table, source, specs[3] );
+	BenchCheck( table.GetVisibleRowsCount() == source.GetRowsCount(), "DataTable (%s): clearing the filter must show every row", mode );
+}
+
+void BenchDataTable()
+{
+	// Serial, then split over 4 threads: chunks are sorted on their own and merged in parallel passes
+	WorkerPool pool( 3 );
+	CheckSortOrders( nullptr );
+	CheckSortOrders( &pool );
+
+	// Full sorts of 1M rows, alternating between two specs with nothing cached, then switching between cached orders
+	std::mt19937 random( 17 );
+	TableSource source;
+	source.Append( random, 1000000 );
+	const std::vector<SortKey> byId = { { 0, ImGuiSortDirection_Descending } };
+	const std::vector<SortKey> byNameValue = { { 2, ImGuiSortDirection_Ascending }, { 1, ImGuiSortDirection_Descending } };
+	for ( WorkerPool* threads : { (WorkerPool*)nullptr, &pool } )
+	{
+		ImGuiDataTable table;
+		DataTableFrames frames( threads );
+		frames.Run( table, source, {} );
+		double idMs = BenchBestOf( 3, [&]() {
+			table.Invalidate();
+			frames.Run( table, source, byId );
+		} );
+		double nameValueMs = BenchBestOf( 3, [&]() {
+			table.Invalidate();
+			frames.Run( table, source, byNameValue );
+		} );
+		frames.Run( table, source, byId );
+		double switchMs = BenchBestOf( 5, [&]() {
+			frames.Run( table, source, byId );
+			frames.Run( table, source, byNameValue );
+		} ) / 2.0;
+		printf( "  %-9s 1M rows: sort by int %7.2f ms  by string, float %7.2f ms  switch to a cached order %5.2f ms\n",
+			threads ? "4 threads" : "1 thread", idMs, nameValueMs, switchMs );
+	}
+}
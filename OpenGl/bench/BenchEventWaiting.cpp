@@ -0,0 +1,187 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// An event-driven main loop sleeps for GetEventWaitingTime() and presents a frame only
+// when ImDrawData::CalcContentHash() changed. The same scripted input (a tooltip delay,
+// a checkbox, typing with a blinking cursor, a combo, a modal and its fades, a key read
+// after what it changes) runs in a context rendering every step and in one only woken by
+// events and by the waiting time. At every step, what the event-driven one has on screen
+// must be what the other draws.
+
+// 1/64 s, exact in binary, so both contexts accumulate the same times
+static const double STEP = 1.0 / 64.0;
+static const int STEPS = 1920;
+
+struct ScriptedEvent
+{
+	int Step;
+	void ( *Apply )( ImGuiIO& io );
+};
+
+static const ScriptedEvent EVENTS[] = {
+	{ 64, []( ImGuiIO& io ) { io.AddMousePosEvent( 130.0f, 150.0f ); } },         // Hover "Button", its tooltip shows after the hover feedback ends
+	{ 192, []( ImGuiIO& io ) { io.AddMousePosEvent( 112.0f, 172.0f ); } },        // Checkbox
+	{ 224, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, true ); } },
+	{ 230, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, false ); } },
+	{ 320, []( ImGuiIO& io ) { io.AddMousePosEvent( 200.0f, 218.0f ); } },        // Text field, its cursor blinks from now on
+	{ 333, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, true ); } },
+	{ 340, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, false ); } },
+	{ 384, []( ImGuiIO& io ) { io.AddInputCharacter( 'x' ); } },
+	{ 576, []( ImGuiIO& io ) { io.AddMousePosEvent( 200.0f, 240.0f ); } },        // Combo, then its second item
+	{ 590, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, true ); } },
+	{ 596, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, false ); } },
+	{ 640, []( ImGuiIO& io ) { io.AddMousePosEvent( 200.0f, 282.0f ); } },
+	{ 653, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, true ); } },
+	{ 660, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, false ); } },
+	{ 768, []( ImGuiIO& io ) { io.AddMousePosEvent( 125.0f, 262.0f ); } },        // "Popup": the modal dims the background over a few frames
+	{ 781, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, true ); } },
+	{ 788, []( ImGuiIO& io ) { io.AddMouseButtonEvent( 0, false ); } },
+	{ 960, []( ImGuiIO& io ) { io.AddKeyEvent( ImGuiKey_Escape, true ); } },      // Closes the modal
+	{ 966, []( ImGuiIO& io ) { io.AddKeyEvent( ImGuiKey_Escape, false ); } },
+	{ 1056, []( ImGuiIO& io ) { io.AddInputCharacter( 'y' ); } },                 // Counted after "Typed" is drawn: shows on the next frame
+	{ 1088, []( ImGuiIO& io ) { io.AddMousePosEvent( -FLT_MAX, -FLT_MAX ); } },
+};
+static const int EVENTS_COUNT = (int)( sizeof( EVENTS ) / sizeof( EVENTS[0] ) );
+
+class EditFrames
+{
+public:
+	explicit EditFrames( ImFontAtlas* atlas )
+	{
+		m_Context = ImGui::CreateContext( atlas );
+		ImGui::SetCurrentContext( m_Context );
+		ImGuiIO& io = ImGui::GetIO();
+		io.IniFilename = nullptr;
+		io.DisplaySize = ImVec2( 1280.0f, 800.0f );
+		io.HoverDelayNormal = 1.5f;
+		io.AddMousePosEvent( -FLT_MAX, -FLT_MAX );
+	}
+
+	~EditFrames() { ImGui::DestroyContext( m_Context ); }
+
+	// Applies the events of steps up to 'step', then renders the frame of that step. Returns the hash of its draw data.
+	ImU32 Run( int step )
+	{
+		ImGui::SetCurrentContext( m_Context );
+		ImGuiIO& io = ImGui::GetIO();
+		for ( ; m_NextEvent < EVENTS_COUNT && EVENTS[m_NextEvent].Step <= step; m_NextEvent++ )
+			EVENTS[m_NextEvent].Apply( io );
+		io.DeltaTime = (float)( ( step - m_Step ) * STEP );
+		m_Step = step;
+
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos( ImVec2( 100.0f, 100.0f ), ImGuiCond_Once );
+		ImGui::SetNextWindowSize( ImVec2( 400.0f, 300.0f ), ImGuiCond_Once );
+		ImGui::Begin( "Edit" );
+		ImGui::Text( "Typed %d", m_Typed );
+		ImGui::Button( "Button" );
+		if ( ImGui::IsItemHovered( ImGuiHoveredFlags_DelayNormal ) )
+			ImGui::SetTooltip( "Tooltip" );
+		ImGui::Checkbox( "Check", &m_Checked );
+		if ( m_Checked )
+			ImGui::Text( "Checked" );
+		ImGui::InputText( "Text", m_Text, sizeof( m_Text ) );
+		ImGui::Combo( "Combo", &m_Item, "aaa\0bbb\0ccc\0" );
+		if ( ImGui::Button( "Popup" ) )
+			ImGui::OpenPopup( "Modal" );
+		if ( ImGui::BeginPopupModal( "Modal" ) )
+		{
+			ImGui::Text( "Modal" );
+			if ( ImGui::IsKeyPressed( ImGuiKey_Escape ) )
+				ImGui::CloseCurrentPopup();
+			ImGui::EndPopup();
+		}
+		ImGui::End();
+		m_Typed += io.InputQueueCharacters.Size;
+
+		// Auto-fitting, so its size settles a frame after its content changes
+		ImGui::Begin( "Auto", nullptr, ImGuiWindowFlags_AlwaysAutoResize );
+		ImGui::Text( "Item %d", m_Item );
+		ImGui::End();
+		ImGui::Render();
+		return ImGui::GetDrawData()->CalcContentHash();
+	}
+
+	double GetEventWaitingTime() const
+	{
+		ImGui::SetCurrentContext( m_Context );
+		return ImGui::GetEventWaitingTime();
+	}
+
+	bool IsEdited() const { return m_Checked && m_Item == 1 && strcmp( m_Text, "Textx" ) == 0 && m_Typed == 1; }
+
+private:
+	ImGuiContext* m_Context;
+	int m_Step = 0;
+	int m_NextEvent = 0;
+	bool m_Checked = false;
+	int m_Item = 0;
+	int m_Typed = 0;
+	char m_Text[64] = "Text";
+};
+
+void BenchEventWaiting()
+{
+	ImFontAtlas atlas;
+	unsigned char* pixels;
+	int width, height;
+	atlas.GetTexDataAsRGBA32( &pixels, &width, &height );
+
+	std::vector<ImU32> drawn( STEPS + 1 );
+	EditFrames continuous( &atlas );
+	double continuousMs = 0.0;
+	for ( int step = 1; step <= STEPS; step++ )
+	{
+		BenchTimer timer;
+		drawn[step] = continuous.Run( step );
+		continuousMs += timer.GetMilliseconds();
+	}
+	BenchCheck( continuous.IsEdited(), "Event waiting: the script didn't reach every widget" );
+
+	// Woken by the next event or after the waiting time (at least once per second, as with the default --min-refresh 1),
+	// right away after a frame that changed since layout uses the previous frame's sizes
+	EditFrames eventDriven( &atlas );
+	std::vector<ImU32> shown( STEPS + 1 );
+	int step = 0, nextEvent = 0, iterations = 0, presented = 0;
+	ImU32 onScreen = 0;
+	bool changed = true;
+	double eventDrivenMs = 0.0;
+	while ( step < STEPS )
+	{
+		const double wait = changed ? 0.0 : ImMin( eventDriven.GetEventWaitingTime(), 1.0 );
+		int next = step + ImMax( 1, (int)ImCeil( (float)( wait / STEP ) - 1e-4f ) );
+		while ( nextEvent < EVENTS_COUNT && EVENTS[nextEvent].Step <= step )
+			nextEvent++;
+		if ( nextEvent < EVENTS_COUNT && EVENTS[nextEvent].Step < next )
+			next = EVENTS[nextEvent].Step;
+		next = ImMin( next, STEPS );
+		for ( int skipped = step + 1; skipped < next; skipped++ )
+			shown[skipped] = onScreen;
+
+		BenchTimer timer;
+		const ImU32 hash = eventDriven.Run( next );
+		eventDrivenMs += timer.GetMilliseconds();
+		changed = hash != onScreen;
+		presented += changed;
+		onScreen = shown[next] = hash;
+		step = next;
+		iterations++;
+	}
+
+	int mismatches = 0, firstMismatch = 0;
+	for ( int n = 1; n <= STEPS; n++ )
+		if ( shown[n] != drawn[n] && mismatches++ == 0 )
+			firstMismatch = n;
+	BenchCheck( mismatches == 0, "Event waiting: %d of %d steps show a stale frame, the first at %.3f s", mismatches, STEPS, firstMismatch * STEP );
+	BenchCheck( iterations < STEPS / 4, "Event waiting: %d frames for %d steps, expected most of them skipped", iterations, STEPS );
+	BenchCheck( eventDriven.GetEventWaitingTime() == FLT_MAX, "Event waiting: %.3f s once idle, expected FLT_MAX (wait for input)", eventDriven.GetEventWaitingTime() );
+	printf( "  %.0f s of input: %d frames continuously (%.2f ms), %d event-driven (%.2f ms), %d presented\n",
+		STEPS * STEP, STEPS, continuousMs, iterations, eventDrivenMs, presented );
+}
@@ -0,0 +1,467 @@
+#include "Bench.h"
+
+#include "WorkerPool.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Font atlas build with 1 thread and with every hardware thread. io.ParallelForFn
+// is wrapped to time each batch of jobs the build hands out: codepoint lookup,
+// glyph measurement and rasterization, in that order. Whatever is left of the
+// total is the serial part (mostly rectangle packing). The texture and the glyphs
+// must be byte-identical whatever the thread count, and when each batch runs its
+// jobs in reverse order.
+//
+// The embedded default font only covers Latin-1. Set BENCH_FONT to the path of a
+// larger TTF (a CJK font, say) to merge it into every size.
+
+struct TimedParallelFor
+{
+	WorkerPool* Pool;
+	std::vector<double> PhaseMs;
+};
+
+static void TimedParallelForFn( void* userData, int count, void ( *job )( void* data, int index ), void* data )
+{
+	TimedParallelFor& timed = *(TimedParallelFor*)userData;
+	BenchTimer timer;
+	timed.Pool->ParallelFor( count, job, data );
+	timed.PhaseMs.push_back( timer.GetMilliseconds() );
+}
+
+// Runs the jobs of each batch last to first: the build must not depend on the order jobs complete in
+static void ReversedParallelForFn( void* userData, int count, void ( *job )( void* data, int index ), void* data )
+{
+	TimedParallelFor& timed = *(TimedParallelFor*)userData;
+	BenchTimer timer;
+	for ( int index = count - 1; index >= 0; index-- )
+		job( data, index );
+	timed.PhaseMs.push_back( timer.GetMilliseconds() );
+}
+
+struct AtlasBuildResult
+{
+	double TotalMs = 0.0;
+	std::vector<double> PhaseMs;
+	std::vector<unsigned char> Pixels;
+	std::vector<ImFontGlyph> Glyphs;
+	int Width = 0;
+	int Height = 0;
+};
+
+static void AddFonts( ImFontAtlas& atlas, const char* extraFont, float sizeScale = 1.0f )
+{
+	static const ImWchar ranges[] = { 0x0020, 0xFFFF, 0 };
+	const float sizes[] = { 13.0f, 16.0f, 20.0f, 26.0f, 32.0f, 40.0f };
+	for ( float size : sizes )
+	{
+		ImFontConfig config;
+		config.SizePixels = size * sizeScale;
+		config.OversampleH = 3;
+		config.OversampleV = size > 30.0f ? 2 : 1;
+		config.GlyphRanges = ranges;
+		atlas.AddFontDefault( &config );
+
+		if ( extraFont )
+		{
+			config.MergeMode = true;
+			config.RasterizerMultiply = 1.2f;
+			atlas.AddFontFromFileTTF( extraFont, size * sizeScale, &config, ranges );
+		}
+	}
+}
+
+static void ReadAtlas( ImFontAtlas& atlas, AtlasBuildResult& result )
+{
+	unsigned char* pixels;
+	atlas.GetTexDataAsAlpha8( &pixels, &result.Width, &result.Height );
+	result.Pixels.assign( pixels, pixels + result.Width * result.Height );
+	for ( const ImFont* font : atlas.Fonts )
+		result.Glyphs.insert( result.Glyphs.end(), font->Glyphs.begin(), font->Glyphs.end() );
+}
+
+static AtlasBuildResult BuildAtlas( const char* extraFont )
+{
+	ImFontAtlas atlas;
+	AddFonts( atlas, extraFont );
+
+	TimedParallelFor& timed = *(TimedParallelFor*)ImGui::GetIO().ParallelForUserData;
+	timed.PhaseMs.clear();
+
+	AtlasBuildResult result;
+	BenchTimer timer;
+	atlas.Build();
+	result.TotalMs = timer.GetMilliseconds();
+	result.PhaseMs = timed.PhaseMs;
+	ReadAtlas( atlas, result );
+	return result;
+}
+
+static bool SameAtlas( const AtlasBuildResult& a, const AtlasBuildResult& b )
+{
+	return a.Width == b.Width && a.Height == b.Height && a.Pixels == b.Pixels && a.Glyphs.size() == b.Glyphs.size()
+		&& memcmp( a.Glyphs.data(), b.Glyphs.data(), a.Glyphs.size() * sizeof( ImFontGlyph ) ) == 0;
+}
+
+static bool SameFontTables( const ImFontAtlas& a, const ImFontAtlas& b )
+{
+	if ( a.Fonts.Size != b.Fonts.Size )
+		return false;
+	const char* text = "The quick brown fox \xC3\xA9\xC3\xA8 0123456789";
+	for ( int n = 0; n < a.Fonts.Size; n++ )
+	{
+		const ImFont* fontA = a.Fonts[n];
+		const ImFont* fontB = b.Fonts[n];
+		const ImVec2 sizeA = fontA->CalcTextSizeA( fontA->FontSize, FLT_MAX, 0.0f, text );
+		const ImVec2 sizeB = fontB->CalcTextSizeA( fontB->FontSize, FLT_MAX, 0.0f, text );
+		if ( fontA->IndexAdvanceX.Size != fontB->IndexAdvanceX.Size || fontA->IndexLookup.Size != fontB->IndexLookup.Size
+			|| memcmp( fontA->IndexAdvanceX.Data, fontB->IndexAdvanceX.Data, fontA->IndexAdvanceX.size_in_bytes() ) != 0
+			|| memcmp( fontA->IndexLookup.Data, fontB->IndexLookup.Data, fontA->IndexLookup.size_in_bytes() ) != 0
+			|| fontA->Ascent != fontB->Ascent || fontA->Descent != fontB->Descent || sizeA.x != sizeB.x || sizeA.y != sizeB.y )
+			return false;
+	}
+	return true;
+}
+
+// A restored build cache must give the atlas Build() gives. Caches saved from other fonts or settings, truncated
+// or with trailing bytes must be rejected without touching the atlas.
+static void CheckBuildCache( const char* extraFont )
+{
+	ImFontAtlas built;
+	AddFonts( built, extraFont );
+	BenchTimer buildTimer;
+	built.Build();
+	const double buildMs = buildTimer.GetMilliseconds();
+	ImVector<char> data;
+	built.SaveBuildCache( &data );
+	AtlasBuildResult expected;
+	ReadAtlas( built, expected );
+
+	ImFontAtlas restored;
+	AddFonts( restored, extraFont );
+	BenchTimer loadTimer;
+	const bool loaded = restored.LoadBuildCache( data.Data, (size_t)data.Size );
+	const double loadMs = loadTimer.GetMilliseconds();
+	AtlasBuildResult result;
+	if ( BenchCheck( loaded, "LoadBuildCache(): a cache saved from the same fonts must load" ) )
+	{
+		ReadAtlas( restored, result );
+		BenchCheck( SameAtlas( expected, result ) && SameFontTables( built, restored ), "LoadBuildCache(): the restored atlas differs from the built one" );
+	}
+
+	ImFontAtlas larger;
+	AddFonts( larger, extraFont, 1.1f );
+	ImFontAtlas padded;
+	AddFonts( padded, extraFont );
+	padded.TexGlyphPadding = 2;
+	ImFontAtlas noMouseCursors;
+	AddFonts( noMouseCursors, extraFont );
+	noMouseCursors.Flags |= ImFontAtlasFlags_NoMouseCursors;
+	BenchCheck( !larger.LoadBuildCache( data.Data, (size_t)data.Size ) && !padded.LoadBuildCache( data.Data, (size_t)data.Size )
+		&& !noMouseCursors.LoadBuildCache( data.Data, (size_t)data.Size ), "LoadBuildCache(): a cache saved with other sizes, padding or flags must be rejected" );
+
+	// Every cut in the first 4 KB (header, metrics), then cuts spread over the rest, then one byte too many
+	ImFontAtlas rejected;
+	AddFonts( rejected, extraFont );
+	int accepted = 0;
+	const int step = std::max( 1, ( data.Size - 4096 ) / 500 );
+	for ( int size = 0; size < data.Size; size += ( size < 4096 ) ? 1 : step )
+		accepted += rejected.LoadBuildCache( data.Data, (size_t)size );
+	accepted += rejected.LoadBuildCache( data.Data, (size_t)data.Size - 1 );
+	data.push_back( 0 );
+	accepted += rejected.LoadBuildCache( data.Data, (size_t)data.Size );
+	BenchCheck( accepted == 0 && !larger.IsBuilt() && !padded.IsBuilt() && !rejected.IsBuilt(),
+		"LoadBuildCache(): %d truncated or oversized caches accepted, or a rejected cache touched the atlas", accepted );
+
+	printf( "  build cache: %d KB, load %6.1f ms, build %6.1f ms\n", data.Size / 1024, loadMs, buildMs );
+}
+
+static void AddDynamicFonts( ImFontAtlas& atlas )
+{
+	const float sizes[] = { 13.0f, 26.0f, 40.0f };
+	for ( float size : sizes )
+	{
+		ImFontConfig config;
+		config.SizePixels = size;
+		config.OversampleH = 2;
+		atlas.AddFontDefault( &config );
+	}
+}
+
+// Texture rectangle of a glyph, from its UVs
+static void GetGlyphRect( const ImFontAtlas& atlas, const ImFontGlyph& glyph, int& x, int& y, int& w, int& h )
+{
+	x = (int)( glyph.U0 * atlas.TexWidth + 0.5f );
+	y = (int)( glyph.V0 * atlas.TexHeight + 0.5f );
+	w = (int)( glyph.U1 * atlas.TexWidth + 0.5f ) - x;
+	h = (int)( glyph.V1 * atlas.TexHeight + 0.5f ) - y;
+}
+
+// Glyphs of the dynamic atlas must match the baked ones: metrics, advance, pixels (and the RGBA32 copy)
+static int CompareDynamicGlyphs( const ImFontAtlas& dynamic, const ImFontAtlas& baked, const std::vector<unsigned int>& codepoints, int& missing )
+{
+	int failures = 0;
+	for ( int n = 0; n < dynamic.Fonts.Size; n++ )
+		for ( unsigned int codepoint : codepoints )
+		{
+			const ImFontGlyph* a = dynamic.Fonts[n]->FindGlyphNoFallback( (ImWchar)codepoint );
+			const ImFontGlyph* b = baked.Fonts[n]->FindGlyphNoFallback( (ImWchar)codepoint );
+			if ( !a || !b )
+			{
+				missing++;
+				continue;
+			}
+			int ax, ay, aw, ah, bx, by, bw, bh;
+			GetGlyphRect( dynamic, *a, ax, ay, aw, ah );
+			GetGlyphRect( baked, *b, bx, by, bw, bh );
+			bool same = a->X0 == b->X0 && a->Y0 == b->Y0 && a->X1 == b->X1 && a->Y1 == b->Y1 && a->AdvanceX == b->AdvanceX && aw == bw && ah == bh;
+			for ( int row = 0; row < ah && same; row++ )
+			{
+				const unsigned char* pixelsA = dynamic.TexPixelsAlpha8 + ( ay + row ) * dynamic.TexWidth + ax;
+				const unsigned char* pixelsB = baked.TexPixelsAlpha8 + ( by + row ) * baked.TexWidth + bx;
+				same = memcmp( pixelsA, pixelsB, aw ) == 0;
+				for ( int column = 0; column < aw && same && dynamic.TexPixelsRGBA32; column++ )
+					same = dynamic.TexPixelsRGBA32[( ay + row ) * dynamic.TexWidth + ax + column] == IM_COL32( 255, 255, 255, pixelsA[column] );
+			}
+			failures += !same;
+		}
+	return failures;
+}
+
+static std::string ToUtf8( const std::vector<unsigned int>& codepoints )
+{
+	std::string text;
+	for ( unsigned int codepoint : codepoints )
+	{
+		text += (char)( 0xC0 | ( codepoint >> 6 ) );
+		text += (char)( 0x80 | ( codepoint & 0x3F ) );
+	}
+	return text;
+}
+
+// Shows a few Latin-1 characters every frame and batches of others in turn, on a dynamic atlas with a
+// narrow texture: glyphs get rasterized, evicted, rasterized again into reused slots, and the dynamic
+// area fills up and is compacted, which moves the glyphs still on screen.
+static void CheckDynamicGlyphs()
+{
+	ImFontAtlas baked;
+	AddDynamicFonts( baked );
+	baked.Build();
+
+	ImFontAtlas dynamic;
+	dynamic.Flags |= ImFontAtlasFlags_DynamicGlyphs;
+	dynamic.TexDesiredWidth = 256;
+	dynamic.GlyphsEvictDelay = 1.0f;
+	AddDynamicFonts( dynamic );
+	unsigned char* pixels;
+	int width, height;
+	dynamic.GetTexDataAsRGBA32( &pixels, &width, &height );
+
+	std::vector<unsigned int> always, batches[3];
+	for ( unsigned int codepoint = 0xA1; codepoint <= 0xFF; codepoint++ )
+		( codepoint < 0xB0 ? always : batches[codepoint % 3] ).push_back( codepoint );
+	const std::string alwaysText = ToUtf8( always );
+
+	ImGuiContext* context = ImGui::CreateContext( &dynamic );
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = nullptr;
+	io.DisplaySize = ImVec2( 1920.0f, 1080.0f );
+	io.DeltaTime = 0.5f;
+
+	int failures = 0, missing = 0, notEvicted = 0, moved = 0, checkedGlyphs = 0;
+	float firstV0 = -1.0f;
+	for ( int round = 0; round < 15; round++ )
+	{
+		const std::vector<unsigned int>& batch = batches[round % 3];
+		const std::string text = ToUtf8( batch );
+
+		// The first frame requests the glyphs, the next NewFrame() rasterizes them
+		for ( int frame = 0; frame < 3; frame++ )
+		{
+			ImGui::NewFrame();
+			ImGui::Begin( "Text" );
+			for ( ImFont* font : dynamic.Fonts )
+			{
+				ImGui::PushFont( font );
+				ImGui::TextUnformatted( alwaysText.c_str() );
+				ImGui::TextUnformatted( text.c_str() );
+				ImGui::PopFont();
+			}
+			ImGui::End();
+			ImGui::Render();
+			if ( frame >= 1 )
+			{
+				failures += CompareDynamicGlyphs( dynamic, baked, always, missing );
+				failures += CompareDynamicGlyphs( dynamic, baked, batch, missing );
+				checkedGlyphs += (int)( always.size() + batch.size() ) * dynamic.Fonts.Size;
+			}
+		}
+
+		// Only compaction moves a glyph that stays on screen
+		const ImFontGlyph* first = dynamic.Fonts[2]->FindGlyphNoFallback( (ImWchar)always[0] );
+		if ( first && firstV0 >= 0.0f && first->V0 != firstV0 )
+			moved++;
+		firstV0 = first ? first->V0 : -1.0f;
+
+		// The batch shown before this one has been unused for 1.5 s
+		if ( round > 0 )
+			for ( ImFont* font : dynamic.Fonts )
+				for ( unsigned int codepoint : batches[( round + 2 ) % 3] )
+					notEvicted += font->FindGlyphNoFallback( (ImWchar)codepoint ) != nullptr;
+	}
+	ImGui::DestroyContext( context );
+
+	BenchCheck( failures == 0 && missing == 0, "DynamicGlyphs: %d glyphs differ from the baked atlas, %d missing (%d compared)", failures, missing, checkedGlyphs );
+	BenchCheck( notEvicted == 0, "DynamicGlyphs: %d glyphs unused for longer than GlyphsEvictDelay were not evicted", notEvicted );
+	BenchCheck( moved > 0, "DynamicGlyphs: the dynamic area was never compacted, the check does not cover it" );
+}
+
+static ImFont* AddSdfFont( ImFontAtlas& atlas, const char* fontPath, float size )
+{
+	ImFontConfig config;
+	config.SizePixels = size;
+	config.OversampleH = config.OversampleV = 1;
+	return fontPath ? atlas.AddFontFromFileTTF( fontPath, size, &config ) : atlas.AddFontDefault( &config );
+}
+
+// Bilinear fetch from the alpha texture, as the backend's GL_LINEAR sampler does
+static float SampleAlpha8( const ImFontAtlas& atlas, float u, float v )
+{
+	const float x = u * atlas.TexWidth - 0.5f, y = v * atlas.TexHeight - 0.5f;
+	const int x0 = (int)floorf( x ), y0 = (int)floorf( y );
+	const float fx = x - x0, fy = y - y0;
+	auto texel = [&]( int tx, int ty ) {
+		tx = ImClamp( tx, 0, atlas.TexWidth - 1 );
+		ty = ImClamp( ty, 0, atlas.TexHeight - 1 );
+		return atlas.TexPixelsAlpha8[ty * atlas.TexWidth + tx] / 255.0f;
+	};
+	return ImLerp( ImLerp( texel( x0, y0 ), texel( x0 + 1, y0 ), fx ), ImLerp( texel( x0, y0 + 1 ), texel( x0 + 1, y0 + 1 ), fx ), fy );
+}
+
+struct SdfSize
+{
+	float Size;
+	float MaxError; // Mean absolute coverage error over the glyph pixels
+};
+
+// Coverage reconstructed with ImFontAtlasSdfCoverage() from a field built at one size, against glyphs
+// rasterized for coverage at each size. Pixels are compared relative to the baseline: every size rounds
+// its ascent on its own, which moves whole glyphs by up to a pixel and would hide the reconstruction error.
+static void CheckSdfCoverage( const char* name, const char* fontPath, float fieldSize, const SdfSize* sizes, int sizesCount )
+{
+	ImFontAtlas sdf;
+	sdf.Flags |= ImFontAtlasFlags_SignedDistanceField;
+	ImFont* sdfFont = AddSdfFont( sdf, fontPath, fieldSize );
+	sdf.Build();
+
+	for ( int n = 0; n < sizesCount; n++ )
+	{
+		const float size = sizes[n].Size;
+		ImFontAtlas coverage;
+		ImFont* font = AddSdfFont( coverage, fontPath, size );
+		coverage.Build();
+
+		const float scale = size / fieldSize;
+		const float texelPerPixel = (float)IM_FONT_SDF_ON_EDGE / sdf.TexSdfSpread / 255.0f / scale;
+		double error = 0.0;
+		int pixels = 0, advances = 0;
+		for ( ImWchar codepoint = 0x21; codepoint < 0x7F; codepoint++ )
+		{
+			const ImFontGlyph* a = sdfFont->FindGlyphNoFallback( codepoint );
+			const ImFontGlyph* b = font->FindGlyphNoFallback( codepoint );
+			if ( !a || !b || !b->Visible )
+				continue;
+			advances += fabsf( a->AdvanceX * scale - b->AdvanceX ) > 0.01f * size;
+
+			int bx, by, bw, bh;
+			GetGlyphRect( coverage, *b, bx, by, bw, bh );
+			const float ax0 = a->X0 * scale, ax1 = a->X1 * scale;
+			const float ay0 = ( a->Y0 - sdfFont->Ascent ) * scale, ay1 = ( a->Y1 - sdfFont->Ascent ) * scale;
+			for ( int y = 0; y < bh; y++ )
+				for ( int x = 0; x < bw; x++ )
+				{
+					const float px = b->X0 + x + 0.5f, py = b->Y0 - font->Ascent + y + 0.5f;
+					const float u = ImLerp( a->U0, a->U1, ( px - ax0 ) / ( ax1 - ax0 ) );
+					const float v = ImLerp( a->V0, a->V1, ( py - ay0 ) / ( ay1 - ay0 ) );
+					const float reconstructed = ImFontAtlasSdfCoverage( SampleAlpha8( sdf, u, v ), texelPerPixel );
+					error += fabsf( reconstructed - coverage.TexPixelsAlpha8[( by + y ) * coverage.TexWidth + bx + x] / 255.0f );
+					pixels++;
+				}
+		}
+		const double meanError = pixels ? error / pixels : 1.0;
+		BenchCheck( meanError <= sizes[n].MaxError && advances == 0, "SDF (%s, %.0f px field): %.0f px: mean coverage error %.3f (at most %.2f), %d advances differ",
+			name, fieldSize, size, meanError, sizes[n].MaxError, advances );
+		printf( "  SDF %s: %.0f px from a %.0f px field, mean coverage error %.3f over %d pixels\n", name, size, fieldSize, meanError, pixels );
+	}
+}
+
+void BenchFontAtlas()
+{
+	const char* extraFont = getenv( "BENCH_FONT" );
+	ImGuiContext* context = ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+
+	const unsigned int threadCounts[] = { 1, std::max( 2u, std::thread::hardware_concurrency() ) };
+	AtlasBuildResult reference;
+
+	for ( unsigned int threads : threadCounts )
+	{
+		// The calling thread takes part in every batch, so n threads is a pool of n - 1 workers
+		WorkerPool pool( threads - 1 );
+		TimedParallelFor timed = { &pool, {} };
+		io.ParallelForFn = TimedParallelForFn;
+		io.ParallelForUserData = &timed;
+
+		// Best of 3 by total time; the phases reported are those of that build
+		AtlasBuildResult best;
+		for ( int run = 0; run < 3; run++ )
+		{
+			AtlasBuildResult result = BuildAtlas( extraFont );
+			if ( run == 0 || result.TotalMs < best.TotalMs )
+				best = std::move( result );
+		}
+
+		if ( !BenchCheck( best.PhaseMs.size() == 3, "expected 3 batches of jobs (lookup, measure, render), got %d", (int)best.PhaseMs.size() ) )
+			break;
+
+		const double serialMs = best.TotalMs - best.PhaseMs[0] - best.PhaseMs[1] - best.PhaseMs[2];
+		printf( "  %2u thread(s): %dx%d, %d glyphs, total %7.1f ms  (lookup %6.1f, measure %5.1f, render %6.1f, serial rest %5.1f)\n",
+			threads, best.Width, best.Height, (int)best.Glyphs.size(), best.TotalMs, best.PhaseMs[0], best.PhaseMs[1], best.PhaseMs[2], serialMs );
+
+		if ( reference.Pixels.empty() )
+			reference = std::move( best );
+		else
+			BenchCheck( SameAtlas( reference, best ), "%u threads: atlas texture or glyphs differ from the 1 thread build", threads );
+	}
+
+	TimedParallelFor reversed = { nullptr, {} };
+	io.ParallelForFn = ReversedParallelForFn;
+	io.ParallelForUserData = &reversed;
+	BenchCheck( SameAtlas( reference, BuildAtlas( extraFont ) ), "jobs run in reverse order: atlas texture or glyphs differ from the in-order build" );
+
+	io.ParallelForFn = nullptr;
+	io.ParallelForUserData = nullptr;
+	CheckBuildCache( extraFont );
+	ImGui::DestroyContext( context );
+
+	CheckDynamicGlyphs();
+
+	// The embedded font is a pixel font drawn on a 13 px grid: its hard edges only come back at multiples
+	// of that size. Drawn smaller than the field, 1 px strokes land between texels and lose some contrast.
+	const SdfSize pixelFontSizes[] = { { 13.0f, 0.15f }, { 26.0f, 0.01f }, { 39.0f, 0.03f }, { 52.0f, 0.03f } };
+	CheckSdfCoverage( "default font", nullptr, 26.0f, pixelFontSizes, IM_ARRAYSIZE( pixelFontSizes ) );
+	if ( extraFont )
+	{
+		const SdfSize outlineFontSizes[] = { { 13.0f, 0.05f }, { 20.0f, 0.05f }, { 32.0f, 0.05f }, { 64.0f, 0.05f } };
+		CheckSdfCoverage( "BENCH_FONT", extraFont, 32.0f, outlineFontSizes, IM_ARRAYSIZE( outlineFontSizes ) );
+	}
+}
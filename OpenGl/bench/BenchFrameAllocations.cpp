@@ -0,0 +1,100 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cstdio>
+
+// Runs the demo and the Metrics window headless, with a moving mouse, a tooltip, a
+// popup and a window that come and go. Once every pool, arena and cache has filled
+// up, frames must not call MemAlloc() at all (io.MetricsFrameAllocations == 0).
+
+class DemoFrames
+{
+public:
+	DemoFrames()
+	{
+		m_Context = ImGui::CreateContext();
+		ImGuiIO& io = ImGui::GetIO();
+		io.IniFilename = nullptr;
+		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+		io.DisplaySize = ImVec2( 1600.0f, 1000.0f );
+		io.DeltaTime = 1.0f / 60.0f;
+		unsigned char* pixels;
+		int width, height;
+		io.Fonts->GetTexDataAsRGBA32( &pixels, &width, &height );
+	}
+
+	~DemoFrames() { ImGui::DestroyContext( m_Context ); }
+
+	// Returns io.MetricsFrameAllocations as NewFrame() set it: the MemAlloc() calls of the previous frame
+	int Run( int frame )
+	{
+		ImGuiIO& io = ImGui::GetIO();
+		io.MousePos = ImVec2( 100.0f + ( frame % 50 ) * 5.0f, 300.0f );
+		ImGui::NewFrame();
+		const int allocations = io.MetricsFrameAllocations;
+
+		bool open = true;
+		ImGui::ShowDemoWindow( &open );
+		ImGui::ShowMetricsWindow( &open );
+
+		const int phase = frame % 120;
+		ImGui::Begin( "App" );
+		ImGui::Text( "Frame %d, time %.3f", frame, frame / 60.0f );
+		ImGui::Button( "Button" );
+		if ( phase < 40 )
+			ImGui::SetTooltip( "Tooltip %d", frame );
+		if ( phase == 10 )
+			ImGui::OpenPopup( "Popup" );
+		if ( ImGui::BeginPopup( "Popup" ) )
+		{
+			ImGui::Text( "Popup %d", frame );
+			if ( phase == 60 )
+				ImGui::CloseCurrentPopup();
+			ImGui::EndPopup();
+		}
+		ImGui::End();
+
+		if ( phase < 80 )
+		{
+			ImGui::Begin( "Sometimes" );
+			for ( int line = 0; line < 20 + phase; line++ )
+				ImGui::Text( "Line %d", line );
+			ImGui::End();
+		}
+
+		ImGui::Render();
+		return allocations;
+	}
+
+private:
+	ImGuiContext* m_Context;
+};
+
+void BenchFrameAllocations()
+{
+	// The Metrics window draws new text every frame: its font's glyph run cache takes a few hundred frames to fill up
+	const int warmUpFrames = 600;
+	const int frames = 600;
+	DemoFrames demo;
+	int frame = 0;
+	int lastAllocatingFrame = -1;
+	for ( ; frame <= warmUpFrames; frame++ )
+		if ( demo.Run( frame ) != 0 )
+			lastAllocatingFrame = frame - 1;
+
+	// Each Run() reports the frame before it: these are frames warmUpFrames to warmUpFrames + frames - 1
+	int allocations = 0, allocatingFrames = 0;
+	BenchTimer timer;
+	for ( ; frame <= warmUpFrames + frames; frame++ )
+	{
+		const int count = demo.Run( frame );
+		allocations += count;
+		allocatingFrames += count != 0;
+	}
+	const double ms = timer.GetMilliseconds();
+
+	BenchCheck( allocations == 0, "Demo + Metrics: %d MemAlloc() calls over %d of the %d frames after warm-up, expected none", allocations, allocatingFrames, frames );
+	printf( "  demo + metrics: last allocation during warm-up on frame %d, %5.2f ms per frame\n", lastAllocatingFrame, ms / frames );
+}
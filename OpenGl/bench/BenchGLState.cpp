@@ -0,0 +1,318 @@
+#include "Bench.h"
+
+#include <imgui_impl_opengl3_state.h>
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+typedef ImGui_ImplOpenGL3_StateCache StateCache;
+
+// Stands in for the driver behind ImGui_ImplOpenGL3_StateFuncs. It keeps the state a
+// real context would hold and counts every call that reaches it. The dispatch table
+// takes plain function pointers, so the fake lives in one file-static instance.
+struct FakeGlDriver
+{
+	ImGui_ImplOpenGL3_State State;
+	std::map<unsigned int, bool> Caps;                 // Untracked caps
+	std::map<unsigned int, unsigned int> OtherBuffers; // Untracked targets, by target
+	int Calls;
+};
+
+static FakeGlDriver g_Driver;
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeGetIntegerv( unsigned int pname, int* data )
+{
+	const ImGui_ImplOpenGL3_State& s = g_Driver.State;
+	const int unit = (int)( s.ActiveTexture - StateCache::Gl_TEXTURE0 );
+	switch ( pname )
+	{
+	case StateCache::Gl_ACTIVE_TEXTURE:       *data = (int)s.ActiveTexture; break;
+	case StateCache::Gl_TEXTURE_BINDING_2D:   *data = (int)s.Texture2D[unit]; break;
+	case StateCache::Gl_SAMPLER_BINDING:      *data = (int)s.Sampler[unit]; break;
+	case StateCache::Gl_CURRENT_PROGRAM:      *data = (int)s.Program; break;
+	case StateCache::Gl_ARRAY_BUFFER_BINDING: *data = (int)s.ArrayBuffer; break;
+	case StateCache::Gl_VERTEX_ARRAY_BINDING: *data = (int)s.VertexArray; break;
+	case StateCache::Gl_VIEWPORT:             memcpy( data, s.Viewport, sizeof( s.Viewport ) ); break;
+	case StateCache::Gl_SCISSOR_BOX:          memcpy( data, s.Scissor, sizeof( s.Scissor ) ); break;
+	case StateCache::Gl_BLEND_EQUATION_RGB:   *data = (int)s.BlendEquationRgb; break;
+	case StateCache::Gl_BLEND_EQUATION_ALPHA: *data = (int)s.BlendEquationAlpha; break;
+	case StateCache::Gl_BLEND_SRC_RGB:        *data = (int)s.BlendSrcRgb; break;
+	case StateCache::Gl_BLEND_DST_RGB:        *data = (int)s.BlendDstRgb; break;
+	case StateCache::Gl_BLEND_SRC_ALPHA:      *data = (int)s.BlendSrcAlpha; break;
+	case StateCache::Gl_BLEND_DST_ALPHA:      *data = (int)s.BlendDstAlpha; break;
+	case StateCache::Gl_POLYGON_MODE:         data[0] = data[1] = (int)s.PolygonMode; break;
+	default:                                  *data = 0; break;
+	}
+}
+
+// Tracked caps live in State.Enabled, the others in Caps
+static bool& FakeCap( unsigned int cap )
+{
+	const int index = StateCache::CapIndex( cap );
+	return index >= 0 ? g_Driver.State.Enabled[index] : g_Driver.Caps[cap];
+}
+
+static unsigned char IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeIsEnabled( unsigned int cap ) { return FakeCap( cap ) ? 1 : 0; }
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeEnable( unsigned int cap ) { g_Driver.Calls++; FakeCap( cap ) = true; }
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeDisable( unsigned int cap ) { g_Driver.Calls++; FakeCap( cap ) = false; }
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeActiveTexture( unsigned int texture ) { g_Driver.Calls++; g_Driver.State.ActiveTexture = texture; }
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeUseProgram( unsigned int program ) { g_Driver.Calls++; g_Driver.State.Program = program; }
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeBindVertexArray( unsigned int array ) { g_Driver.Calls++; g_Driver.State.VertexArray = array; }
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeBindTexture( unsigned int target, unsigned int texture )
+{
+	g_Driver.Calls++;
+	if ( target == StateCache::Gl_TEXTURE_2D )
+		g_Driver.State.Texture2D[g_Driver.State.ActiveTexture - StateCache::Gl_TEXTURE0] = texture;
+}
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeBindSampler( unsigned int unit, unsigned int sampler )
+{
+	g_Driver.Calls++;
+	g_Driver.State.Sampler[unit] = sampler;
+}
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeBindBuffer( unsigned int target, unsigned int buffer )
+{
+	g_Driver.Calls++;
+	if ( target == StateCache::Gl_ARRAY_BUFFER )
+		g_Driver.State.ArrayBuffer = buffer;
+	else
+		g_Driver.OtherBuffers[target] = buffer;
+}
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeViewport( int x, int y, int width, int height )
+{
+	g_Driver.Calls++;
+	const int value[4] = { x, y, width, height };
+	memcpy( g_Driver.State.Viewport, value, sizeof( value ) );
+}
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeScissor( int x, int y, int width, int height )
+{
+	g_Driver.Calls++;
+	const int value[4] = { x, y, width, height };
+	memcpy( g_Driver.State.Scissor, value, sizeof( value ) );
+}
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeBlendEquationSeparate( unsigned int modeRgb, unsigned int modeAlpha )
+{
+	g_Driver.Calls++;
+	g_Driver.State.BlendEquationRgb = modeRgb;
+	g_Driver.State.BlendEquationAlpha = modeAlpha;
+}
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakeBlendFuncSeparate( unsigned int srcRgb, unsigned int dstRgb, unsigned int srcAlpha, unsigned int dstAlpha )
+{
+	g_Driver.Calls++;
+	g_Driver.State.BlendSrcRgb = srcRgb;
+	g_Driver.State.BlendDstRgb = dstRgb;
+	g_Driver.State.BlendSrcAlpha = srcAlpha;
+	g_Driver.State.BlendDstAlpha = dstAlpha;
+}
+
+static void IMGUI_IMPL_OPENGL_STATE_APIENTRY FakePolygonMode( unsigned int face, unsigned int mode )
+{
+	g_Driver.Calls++;
+	if ( face == StateCache::Gl_FRONT_AND_BACK )
+		g_Driver.State.PolygonMode = mode;
+}
+
+// Puts the fake driver in a non-trivial starting state
+static void ResetDriver()
+{
+	ImGui_ImplOpenGL3_State& s = g_Driver.State;
+	memset( (void*)&s, 0, sizeof( s ) );
+	s.ActiveTexture = StateCache::Gl_TEXTURE0 + 2;
+	for ( int unit = 0; unit < ImGui_ImplOpenGL3_State::TextureUnits; unit++ )
+	{
+		s.Texture2D[unit] = 100 + unit;
+		s.Sampler[unit] = unit % 2 ? 200 + unit : 0;
+	}
+	s.Program = 7;
+	s.ArrayBuffer = 11;
+	s.VertexArray = 13;
+	const int viewport[4] = { 0, 0, 1280, 720 };
+	memcpy( s.Viewport, viewport, sizeof( viewport ) );
+	memcpy( s.Scissor, viewport, sizeof( viewport ) );
+	s.BlendEquationRgb = s.BlendEquationAlpha = 0x8006; // GL_FUNC_ADD
+	s.BlendSrcRgb = s.BlendSrcAlpha = 0x0302;           // GL_SRC_ALPHA
+	s.BlendDstRgb = s.BlendDstAlpha = 0x0303;           // GL_ONE_MINUS_SRC_ALPHA
+	s.PolygonMode = 0x1B02;                              // GL_FILL
+
+	for ( int n = 0; n < ImGui_ImplOpenGL3_StateCap_COUNT; n++ )
+		s.Enabled[n] = n % 2 == 0;
+	g_Driver.Caps.clear();
+	g_Driver.OtherBuffers.clear();
+	g_Driver.Calls = 0;
+}
+
+static void InitCache( StateCache& cache )
+{
+	ImGui_ImplOpenGL3_StateFuncs& funcs = cache.Funcs;
+	funcs.GetIntegerv = FakeGetIntegerv;
+	funcs.IsEnabled = FakeIsEnabled;
+	funcs.Enable = FakeEnable;
+	funcs.Disable = FakeDisable;
+	funcs.ActiveTexture = FakeActiveTexture;
+	funcs.BindTexture = FakeBindTexture;
+	funcs.BindSampler = FakeBindSampler;
+	funcs.UseProgram = FakeUseProgram;
+	funcs.BindBuffer = FakeBindBuffer;
+	funcs.BindVertexArray = FakeBindVertexArray;
+	funcs.Viewport = FakeViewport;
+	funcs.Scissor = FakeScissor;
+	funcs.BlendEquationSeparate = FakeBlendEquationSeparate;
+	funcs.BlendFuncSeparate = FakeBlendFuncSeparate;
+	funcs.PolygonMode = FakePolygonMode;
+	ResetDriver();
+	cache.Sync();
+	g_Driver.Calls = 0;
+}
+
+static bool SameState( const ImGui_ImplOpenGL3_State& a, const ImGui_ImplOpenGL3_State& b )
+{
+	return memcmp( &a, &b, sizeof( a ) ) == 0;
+}
+
+// A fixed mix of 13 state changes. From the state InitCache() leaves, 8 of them set the value already current.
+static int ApplyFrame( StateCache& cache, int frame )
+{
+	cache.UseProgram( 20 + frame % 2 );
+	cache.UseProgram( 20 + frame % 2 );
+	cache.ActiveTexture( StateCache::Gl_TEXTURE0 );
+	cache.BindTexture( StateCache::Gl_TEXTURE_2D, 300 );
+	cache.BindTexture( StateCache::Gl_TEXTURE_2D, 300 );
+	cache.BindVertexArray( 13 );
+	cache.BindBuffer( StateCache::Gl_ARRAY_BUFFER, 11 );
+	cache.Viewport( 0, 0, 1280, 720 );
+	cache.Scissor( 10, 10, 100, 100 );
+	cache.Scissor( 10, 10, 100, 100 );
+	cache.Enable( 0x0BE2 );  // GL_BLEND
+	cache.Enable( 0x0C11 );  // GL_SCISSOR_TEST
+	cache.Disable( 0x0B71 ); // GL_DEPTH_TEST
+	return 13;
+}
+
+static void CheckRedundantFiltering()
+{
+	StateCache cache;
+	InitCache( cache );
+	BenchCheck( SameState( cache.Current, g_Driver.State ) && g_Driver.State.ActiveTexture == StateCache::Gl_TEXTURE0 + 2,
+		"StateCache: Sync() must read the driver state and leave the active texture unit as it was" );
+
+	// Setting the current value is dropped and counted, a new value reaches the driver once
+	cache.UseProgram( 7 );
+	cache.BindTexture( StateCache::Gl_TEXTURE_2D, 102 );
+	cache.Viewport( 0, 0, 1280, 720 );
+	cache.Enable( 0x0BE2 );
+	BenchCheck( g_Driver.Calls == 0 && cache.SkippedCount == 4 && cache.AppliedCount == 0,
+		"StateCache: redundant changes must not reach the driver (%d calls, %d skipped)", g_Driver.Calls, cache.SkippedCount );
+	cache.UseProgram( 8 );
+	cache.UseProgram( 8 );
+	BenchCheck( g_Driver.Calls == 1 && g_Driver.State.Program == 8 && cache.AppliedCount == 1 && cache.SkippedCount == 5,
+		"StateCache: a changed binding must reach the driver once" );
+
+	// Counters per frame: the same mix each frame, rolled over by NewFrame()
+	cache.NewFrame();
+	ApplyFrame( cache, 0 );
+	const int applied = cache.AppliedCount;
+	const int skipped = cache.SkippedCount;
+	cache.NewFrame();
+	BenchCheck( applied == 5 && skipped == 8 && cache.LastFrameAppliedCount == applied && cache.LastFrameSkippedCount == skipped
+		&& cache.AppliedCount == 0 && cache.SkippedCount == 0,
+		"StateCache: %d applied and %d skipped in a frame, expected 5 and 8", applied, skipped );
+	const int calls = g_Driver.Calls;
+	ApplyFrame( cache, 0 );
+	BenchCheck( g_Driver.Calls == calls && cache.AppliedCount == 0 && cache.SkippedCount == 13,
+		"StateCache: repeating a frame must not reach the driver (%d calls)", g_Driver.Calls - calls );
+	BenchCheck( SameState( cache.Current, g_Driver.State ), "StateCache: the shadow copy must match the driver" );
+
+	// Untracked targets and caps go through every time, without touching the tracked state
+	const int before = g_Driver.Calls;
+	cache.BindBuffer( 0x8893, 5 ); // GL_ELEMENT_ARRAY_BUFFER
+	cache.BindBuffer( 0x8893, 5 );
+	cache.Enable( 0x809D );        // GL_MULTISAMPLE
+	cache.Enable( 0x809D );
+	BenchCheck( g_Driver.Calls == before + 4 && cache.Current.ArrayBuffer == 11 && g_Driver.OtherBuffers[0x8893] == 5 && cache.IsEnabled( 0x809D ),
+		"StateCache: untracked targets and caps must always reach the driver" );
+}
+
+static void CheckRestore()
+{
+	StateCache cache;
+	InitCache( cache );
+	const ImGui_ImplOpenGL3_State saved = cache.Current;
+
+	// Restoring an unchanged state costs nothing
+	cache.Restore( saved );
+	BenchCheck( g_Driver.Calls == 0, "StateCache: restoring the current state must not reach the driver (%d calls)", g_Driver.Calls );
+
+	// Change some of everything the way the backend's render pass does, then put it back
+	cache.ActiveTexture( StateCache::Gl_TEXTURE0 );
+	cache.BindTexture( StateCache::Gl_TEXTURE_2D, 999 );
+	cache.BindSampler( 0, 55 );
+	cache.ActiveTexture( StateCache::Gl_TEXTURE0 + 5 );
+	cache.BindTexture( StateCache::Gl_TEXTURE_2D, 998 );
+	cache.UseProgram( 42 );
+	cache.BindVertexArray( 43 );
+	cache.BindBuffer( StateCache::Gl_ARRAY_BUFFER, 44 );
+	cache.Viewport( 1, 2, 3, 4 );
+	cache.Scissor( 5, 6, 7, 8 );
+	cache.BlendEquation( 0x800B ); // GL_FUNC_REVERSE_SUBTRACT
+	cache.BlendFuncSeparate( 1, 0, 1, 0 );
+	cache.PolygonMode( StateCache::Gl_FRONT_AND_BACK, 0x1B01 ); // GL_LINE
+	for ( int n = 0; n < ImGui_ImplOpenGL3_StateCap_COUNT; n++ )
+		cache.SetEnabled( StateCache::CapEnum( n ), n % 2 != 0 );
+	BenchCheck( !SameState( g_Driver.State, saved ), "StateCache: the driver state must have changed" );
+
+	cache.Restore( saved );
+	BenchCheck( SameState( g_Driver.State, saved ) && SameState( cache.Current, saved ),
+		"StateCache: Restore() must put the driver back in the saved state" );
+}
+
+static void CheckUnfiltered()
+{
+	// With FilterRedundant off the cache still tracks, but every call reaches the driver
+	StateCache cache;
+	InitCache( cache );
+	cache.FilterRedundant = false;
+	for ( int frame = 0; frame < 3; frame++ )
+		ApplyFrame( cache, 0 );
+	BenchCheck( g_Driver.Calls == 3 * 13 && cache.AppliedCount == 3 * 13 && cache.SkippedCount == 0,
+		"StateCache: FilterRedundant = false must forward every call (%d of %d)", g_Driver.Calls, 3 * 13 );
+	BenchCheck( SameState( cache.Current, g_Driver.State ), "StateCache: the shadow copy must match the driver" );
+
+	const ImGui_ImplOpenGL3_State saved = cache.Current;
+	const int before = g_Driver.Calls;
+	cache.Restore( saved );
+	BenchCheck( g_Driver.Calls > before && SameState( g_Driver.State, saved ), "StateCache: Restore() without filtering must send the state again" );
+}
+
+void BenchGLState()
+{
+	CheckRedundantFiltering();
+	CheckRestore();
+	CheckUnfiltered();
+
+	// Cost of a frame's worth of state changes when the driver call itself is free
+	const int frames = 200000;
+	for ( int filter = 1; filter >= 0; filter-- )
+	{
+		StateCache cache;
+		InitCache( cache );
+		cache.FilterRedundant = filter != 0;
+		double ms = BenchBestOf( 3, [&]() {
+			int count = 0;
+			for ( int frame = 0; frame < frames; frame++ )
+			{
+				count += ApplyFrame( cache, frame );
+				cache.NewFrame();
+			}
+			BenchKeep( (size_t)count );
+		} );
+		printf( "  %-10s %5.1f ns per change, %d of 13 reach the driver\n", filter ? "filtered" : "unfiltered", ms * 1e6 / ( frames * 13.0 ),
+			cache.LastFrameAppliedCount );
+	}
+}
@@ -0,0 +1,142 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+// ImHashData() and ImHashStr() against a bitwise CRC of the same polynomial. With
+// the default CRC32 this is the hash IDs always used, so imgui.ini data written by
+// earlier builds keeps its IDs. With IMGUI_USE_CRC32C_HASH, the CRC32 instruction
+// path (when the CPU has one) and the table path must give the same values.
+
+#ifdef IMGUI_USE_CRC32C_HASH
+static const ImU32 POLY = 0x82F63B78u;
+static const ImU32 CHECK_VALUE = 0xE3069283u; // CRC32C of "123456789"
+#else
+static const ImU32 POLY = 0xEDB88320u;
+static const ImU32 CHECK_VALUE = 0xCBF43926u; // CRC32 of "123456789"
+#endif
+
+static ImU32 ReferenceCrc( ImU32 seed, const char* data, size_t size )
+{
+	ImU32 crc = ~seed;
+	for ( size_t n = 0; n < size; n++ )
+	{
+		crc ^= (unsigned char)data[n];
+		for ( int bit = 0; bit < 8; bit++ )
+			crc = ( crc >> 1 ) ^ ( POLY & ( 0u - ( crc & 1 ) ) );
+	}
+	return ~crc;
+}
+
+// ImHashStr() only hashes from the last "###", which lets a label change while its ID stays the same
+static ImU32 ReferenceStrCrc( ImU32 seed, const char* str, size_t size )
+{
+	size_t begin = 0;
+	for ( size_t n = 0; n + 3 <= size; n++ )
+		if ( str[n] == '#' && str[n + 1] == '#' && str[n + 2] == '#' )
+			begin = n;
+	return ReferenceCrc( seed, str + begin, size - begin );
+}
+
+static void CheckRandomStrings()
+{
+	// Short alphabet so "##" and "###" runs of every length show up, cut anywhere by explicit sizes
+	static const char ALPHABET[] = "ab#c ##1";
+	std::mt19937 random( 22 );
+	int failures = 0;
+	for ( int i = 0; i < 200000; i++ )
+	{
+		std::string str;
+		const int length = random() % 90;
+		for ( int n = 0; n < length; n++ )
+			str += ALPHABET[random() % ( sizeof( ALPHABET ) - 1 )];
+		const ImU32 seed = ( i & 1 ) ? (ImU32)random() : 0;
+		const size_t cut = length ? random() % length : 0;
+
+		failures += ImHashStr( str.c_str(), 0, seed ) != ReferenceStrCrc( seed, str.c_str(), str.size() );
+		failures += length && ImHashStr( str.c_str(), str.size(), seed ) != ReferenceStrCrc( seed, str.c_str(), str.size() );
+		failures += cut && ImHashStr( str.c_str(), cut, seed ) != ReferenceStrCrc( seed, str.c_str(), cut );
+		failures += ImHashData( str.data(), str.size(), seed ) != ReferenceCrc( seed, str.data(), str.size() );
+	}
+	BenchCheck( failures == 0, "ImHashStr()/ImHashData(): %d mismatches against a bitwise CRC over random strings", failures );
+	BenchCheck( ImHashData( "123456789", 9 ) == CHECK_VALUE && ImHashStr( "123456789" ) == CHECK_VALUE,
+		"ImHashData(\"123456789\") is %08X, expected the check value %08X", ImHashData( "123456789", 9 ), CHECK_VALUE );
+}
+
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+struct HashedLiteral
+{
+	ImGuiHashedStr Hashed;
+	const char* Str;
+};
+
+#define HASHED_LITERAL( _STR ) { IM_HASHED_STR( _STR ), _STR }
+
+static void CheckHashedLiterals()
+{
+	// Longer than the 64 zero bytes the instruction path combines with, to take the fallback
+	static const HashedLiteral LITERALS[] = {
+		HASHED_LITERAL( "" ), HASHED_LITERAL( "a" ), HASHED_LITERAL( "Button" ), HASHED_LITERAL( "Save##file_menu" ),
+		HASHED_LITERAL( "Label###Stable" ), HASHED_LITERAL( "a###b###c" ), HASHED_LITERAL( "####" ), HASHED_LITERAL( "##" ),
+		HASHED_LITERAL( "exactly8" ), HASHED_LITERAL( "sixteen chars!!!" ),
+		HASHED_LITERAL( "A rather long label, longer than sixty-four characters, so combining it reads the string" ),
+	};
+	std::mt19937 random( 23 );
+	int failures = 0;
+	for ( const HashedLiteral& literal : LITERALS )
+		for ( int i = 0; i < 1000; i++ )
+		{
+			const ImU32 seed = i ? (ImU32)random() : 0;
+			failures += ImHashStr( literal.Hashed, seed ) != ImHashStr( literal.Str, 0, seed );
+		}
+	BenchCheck( failures == 0, "IM_HASHED_STR(): %d literals hash differently from ImHashStr()", failures );
+
+	// Through the ID stack of a window
+	BenchImGuiFrame frame;
+	ImGui::Begin( "Hash" );
+	ImGui::PushID( IM_HASHED_STR( "Toolbar" ) );
+	const ImGuiID hashed = ImGui::GetID( IM_HASHED_STR( "Open###open" ) );
+	ImGui::PopID();
+	ImGui::PushID( "Toolbar" );
+	const ImGuiID runtime = ImGui::GetID( "Open###open" );
+	ImGui::PopID();
+	ImGui::End();
+	BenchCheck( hashed == runtime, "PushID()/GetID() with IM_HASHED_STR() must give the IDs of the strings" );
+}
+#endif
+
+void BenchHash()
+{
+	CheckRandomStrings();
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+	CheckHashedLiterals();
+#endif
+
+	// Typical widget labels, hashed with a different seed each time as under different windows
+	static const char* LABELS[] = { "OK", "Cancel", "Button", "Save##file_menu", "Properties", "Node 1234", "Transform##inspector", "A somewhat longer label##with_suffix" };
+	const int count = 4000000;
+	double strMs = BenchBestOf( 3, [&]() {
+		size_t sum = 0;
+		for ( int i = 0; i < count; i++ )
+			sum += ImHashStr( LABELS[i & 7], 0, (ImU32)i );
+		BenchKeep( sum );
+	} );
+	printf( "  ImHashStr()      %5.1f ns per label\n", strMs * 1e6 / count );
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+	static const ImGuiHashedStr HASHED_LABELS[] = {
+		IM_HASHED_STR( "OK" ), IM_HASHED_STR( "Cancel" ), IM_HASHED_STR( "Button" ), IM_HASHED_STR( "Save##file_menu" ), IM_HASHED_STR( "Properties" ),
+		IM_HASHED_STR( "Node 1234" ), IM_HASHED_STR( "Transform##inspector" ), IM_HASHED_STR( "A somewhat longer label##with_suffix" ),
+	};
+	double hashedMs = BenchBestOf( 3, [&]() {
+		size_t sum = 0;
+		for ( int i = 0; i < count; i++ )
+			sum += ImHashStr( HASHED_LABELS[i & 7], (ImU32)i );
+		BenchKeep( sum );
+	} );
+	printf( "  IM_HASHED_STR()  %5.1f ns per label\n", hashedMs * 1e6 / count );
+#endif
+}
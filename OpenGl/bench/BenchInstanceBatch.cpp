@@ -0,0 +1,127 @@
+#include "Bench.h"
+
+#include "InstanceBatch.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+static SceneObject MakeObject( std::mt19937& random, unsigned int index )
+{
+	std::uniform_real_distribution<float> position( -10.0f, 10.0f );
+	std::uniform_real_distribution<float> angle( -3.0f, 3.0f );
+
+	SceneObject object;
+	object.Mesh = (MeshType)( random() % (unsigned int)MeshType::Count );
+	object.Position = glm::vec3( position( random ), position( random ), position( random ) );
+	if ( random() % 2 )
+		object.Rotation = glm::vec3( angle( random ), 0.0f, angle( random ) );
+	object.Scale = glm::vec3( 0.5f + ( index % 7 ) * 0.25f );
+	// The scene index travels in the color so the check can tell where each instance came from
+	object.Color = glm::vec4( (float)index, 0.5f, 0.25f, 1.0f );
+	object.Visible = random() % 8 != 0;
+	return object;
+}
+
+// Batches must come in MeshType order, cover the instance array without gaps,
+// and keep the scene order of equal meshes. Each instance must hold its object's
+// model matrix (column major, 16 floats) followed by its color (4 floats).
+static void CheckBatches( const Scene& scene, const BatchBuilder& builder )
+{
+	const std::vector<SceneObject>& objects = scene.GetObjects();
+	const std::vector<InstanceData>& instances = builder.GetInstances();
+	const std::vector<DrawBatch>& batches = builder.GetBatches();
+	int failures = 0;
+
+	unsigned int next = 0;
+	for ( size_t b = 0; b < batches.size(); b++ )
+	{
+		const DrawBatch& batch = batches[b];
+		failures += batch.FirstInstance != next || batch.InstanceCount == 0;
+		failures += b > 0 && (int)batches[b - 1].Mesh >= (int)batch.Mesh;
+		next = batch.FirstInstance + batch.InstanceCount;
+
+		// Walk the scene for this mesh: the batch must list exactly its visible objects, in order
+		unsigned int slot = batch.FirstInstance;
+		for ( unsigned int i = 0; i < (unsigned int)objects.size(); i++ )
+		{
+			const SceneObject& object = objects[i];
+			if ( !object.Visible || object.Mesh != batch.Mesh )
+				continue;
+			if ( slot >= next )
+			{
+				failures++;
+				break;
+			}
+
+			float expected[20];
+			const glm::mat4 model = ComputeModelMatrix( object );
+			for ( int column = 0; column < 4; column++ )
+				for ( int row = 0; row < 4; row++ )
+					expected[column * 4 + row] = model[column][row];
+			for ( int c = 0; c < 4; c++ )
+				expected[16 + c] = object.Color[c];
+			failures += memcmp( &instances[slot], expected, sizeof( expected ) ) != 0;
+			slot++;
+		}
+		failures += slot != next;
+	}
+	failures += next != (unsigned int)instances.size();
+
+	BenchCheck( failures == 0, "BatchBuilder: %d batches or instances out of place (%d objects)", failures, (int)objects.size() );
+}
+
+static void CheckBatchBuilder()
+{
+	BenchCheck( offsetof( InstanceData, Model ) == 0 && offsetof( InstanceData, Color ) == 16 * sizeof( float ),
+		"InstanceData: model must start at 0 and color at 64 bytes" );
+
+	std::mt19937 random( 1 );
+	Scene scene;
+	BatchBuilder builder;
+	BenchCheck( builder.Build( scene ) && builder.GetBatches().empty() && builder.GetInstances().empty(),
+		"BatchBuilder: an empty scene must build to no batches" );
+
+	for ( unsigned int i = 0; i < 5000; i++ )
+		scene.Add( MakeObject( random, i ) );
+	BenchCheck( builder.Build( scene ), "BatchBuilder: Build() after Add() must rebuild" );
+	CheckBatches( scene, builder );
+	BenchCheck( !builder.Build( scene ), "BatchBuilder: Build() on an unchanged scene must be skipped" );
+
+	// Hiding, moving and re-meshing objects reorders them between batches
+	for ( unsigned int i = 0; i < 500; i++ )
+	{
+		SceneObject& object = scene.Edit( random() % scene.GetObjectCount() );
+		object.Visible = !object.Visible;
+		object.Mesh = (MeshType)( random() % (unsigned int)MeshType::Count );
+		object.Position.x += 1.0f;
+	}
+	BenchCheck( builder.Build( scene ), "BatchBuilder: Build() after Edit() must rebuild" );
+	CheckBatches( scene, builder );
+
+	scene.Clear();
+	BenchCheck( builder.Build( scene ) && builder.GetBatches().empty(), "BatchBuilder: a cleared scene must build to no batches" );
+}
+
+void BenchInstanceBatch()
+{
+	CheckBatchBuilder();
+
+	std::mt19937 random( 2 );
+	const unsigned int counts[] = { 1000, 100000 };
+	for ( unsigned int count : counts )
+	{
+		Scene scene;
+		for ( unsigned int i = 0; i < count; i++ )
+			scene.Add( MakeObject( random, i ) );
+
+		BatchBuilder builder;
+		double ms = BenchBestOf( 5, [&]() {
+			scene.Edit( 0 ); // bump the version so every run rebuilds
+			builder.Build( scene );
+			BenchKeep( builder.GetInstances().size() );
+		} );
+		printf( "  %7u objects  build %8.3f ms  (%5.1f ns/object, %d batches)\n", count, ms, ms * 1e6 / count, (int)builder.GetBatches().size() );
+	}
+}
@@ -0,0 +1,64 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// One million point polyline, tessellated with the batched SSE2/NEON path and
+// with ImDrawListFlags_NoSimd, for every line flag set. Both must produce the
+// same bytes; the SIMD path is only worth keeping if it is also faster.
+void BenchPolyline()
+{
+	BenchImGuiFrame frame;
+
+	// A noisy sine with a few repeated points, so degenerate segments are covered too
+	const int POINTS = 1000000;
+	std::vector<ImVec2> points( POINTS );
+	std::mt19937 random( 10 );
+	std::uniform_real_distribution<float> jitter( -2.0f, 2.0f );
+	for ( int i = 0; i < POINTS; i++ )
+	{
+		if ( i > 0 && random() % 64 == 0 )
+			points[i] = points[i - 1];
+		else
+			points[i] = ImVec2( i * 0.0015f, 500.0f + 300.0f * sinf( i * 0.01f ) + jitter( random ) );
+	}
+
+	struct FlagSet
+	{
+		const char* Name;
+		int Flags;
+	};
+	const FlagSet flagSets[] = {
+		{ "aa+tex", ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex },
+		{ "aa", ImDrawListFlags_AntiAliasedLines },
+		{ "none", ImDrawListFlags_None },
+	};
+	const float thicknesses[] = { 1.0f, 3.0f };
+
+	ImDrawList simd( ImGui::GetDrawListSharedData() );
+	ImDrawList scalar( ImGui::GetDrawListSharedData() );
+
+	for ( const FlagSet& flagSet : flagSets )
+	{
+		for ( float thickness : thicknesses )
+		{
+			double simdMs = BenchBestOf( 5, [&]() {
+				frame.ResetDrawList( simd, flagSet.Flags );
+				simd.AddPolyline( points.data(), POINTS, IM_COL32( 255, 200, 0, 255 ), 0, thickness );
+			} );
+			double scalarMs = BenchBestOf( 5, [&]() {
+				frame.ResetDrawList( scalar, flagSet.Flags | ImDrawListFlags_NoSimd );
+				scalar.AddPolyline( points.data(), POINTS, IM_COL32( 255, 200, 0, 255 ), 0, thickness );
+			} );
+
+			printf( "  %-7s thickness %.0f  simd %7.2f ms  scalar %7.2f ms  (%d vertices)\n",
+				flagSet.Name, thickness, simdMs, scalarMs, simd.VtxBuffer.Size );
+			BenchCheck( BenchSameDrawList( simd, scalar ), "%s, thickness %.0f: SIMD and scalar output differ", flagSet.Name, thickness );
+		}
+	}
+}
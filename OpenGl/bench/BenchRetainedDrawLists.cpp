@@ -0,0 +1,215 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cstdio>
+
+// ImGuiWindowFlags_RetainDrawList must not change what gets rendered. The same panels
+// and the same scripted input run in a context using the flag and in one that doesn't,
+// and every frame the draw data is compared in rendering order: every list, command and
+// vertex. Only frames where a window reused a list its content no longer matched (counted
+// as late, displayed one frame late by design) may differ, and only as many as there are
+// changes made without input.
+
+static const int PANELS = 24;
+
+// Widget values, one set per context so both see the same ones
+struct PanelsState
+{
+	float Values[PANELS] = {};
+	bool Checked = false;
+	int Counter = 0;
+};
+
+// Changes made without input, each displayed one frame late at most
+static bool CounterChanges( int frame ) { return frame % 200 == 50; }
+static bool ChildShown( int frame ) { return ( frame / 150 ) % 2 == 1; }
+
+static void DrawPanels( PanelsState& state, ImGuiWindowFlags flags, int frame )
+{
+	for ( int n = 0; n < PANELS; n++ )
+	{
+		char name[32];
+		snprintf( name, sizeof( name ), "Panel %02d", n );
+		ImGui::SetNextWindowPos( ImVec2( ( n % 8 ) * 200.0f, ( n / 8 ) * 330.0f ), ImGuiCond_Always );
+		ImGui::SetNextWindowSize( ImVec2( 195.0f, 325.0f ), ImGuiCond_Always );
+		ImGui::Begin( name, nullptr, flags );
+		ImGui::Text( "Panel %d status: OK", n );
+		ImGui::ProgressBar( n / (float)PANELS );
+		ImGui::SliderFloat( "Value", &state.Values[n], 0.0f, 1.0f );
+		ImGui::Button( "Reset" );
+		ImGui::SameLine();
+		ImGui::ColorButton( "Color", ImVec4( n / (float)PANELS, 0.5f, 0.2f, 1.0f ) );
+		ImGui::Checkbox( "Check", &state.Checked );
+
+		// Changes without input: shown one frame late by the retaining context
+		if ( n == 3 )
+			ImGui::Text( "Counter %d", state.Counter );
+
+		if ( ImGui::BeginTable( "Table", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg ) )
+		{
+			for ( int cell = 0; cell < 9; cell++ )
+			{
+				ImGui::TableNextColumn();
+				ImGui::Text( "%d,%d", cell / 3, cell % 3 );
+			}
+			ImGui::EndTable();
+		}
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		const ImVec2 pos = ImGui::GetCursorScreenPos();
+		drawList->AddCircle( ImVec2( pos.x + 20.0f, pos.y + 20.0f ), 15.0f, IM_COL32( 255, 0, 0, 255 ) );
+		drawList->AddRectFilledMultiColor( ImVec2( pos.x + 40.0f, pos.y ), ImVec2( pos.x + 80.0f, pos.y + 40.0f ), IM_COL32( 255, 0, 0, 255 ), IM_COL32( 0, 255, 0, 255 ), IM_COL32( 0, 0, 255, 255 ), IM_COL32( 255, 255, 255, 255 ) );
+		ImGui::Dummy( ImVec2( 80.0f, 40.0f ) );
+
+		// Bordered children, drawn after content of their parent that they overlap. On every third panel
+		// the child comes and goes without input, with nothing else changing in the parent.
+		const bool toggled = n % 3 == 2;
+		if ( n % 2 == 0 && ( !toggled || ChildShown( frame ) ) )
+		{
+			ImGui::SetCursorScreenPos( ImVec2( pos.x + 10.0f, pos.y + 10.0f ) );
+			ImGui::BeginChild( "Child", ImVec2( 0.0f, 50.0f ), true, flags );
+			ImGui::BulletText( "Child of %d", n );
+			ImGui::EndChild();
+			if ( !toggled )
+				ImGui::Text( "After the child" );
+		}
+		ImGui::End();
+	}
+}
+
+// Hash of what the renderer draws: lists in order, the clip rect and texture of each command, its vertices as indexed
+static ImU32 HashDrawData( const ImDrawData* drawData )
+{
+	ImU32 hash = ImHashData( &drawData->CmdListsCount, sizeof( drawData->CmdListsCount ) );
+	for ( int n = 0; n < drawData->CmdListsCount; n++ )
+	{
+		const ImDrawList* list = drawData->CmdLists[n];
+		for ( const ImDrawCmd& cmd : list->CmdBuffer )
+		{
+			if ( cmd.ElemCount == 0 )
+				continue;
+			hash = ImHashData( &cmd.ClipRect, sizeof( cmd.ClipRect ), hash );
+			hash = ImHashData( &cmd.TextureId, sizeof( cmd.TextureId ), hash );
+			for ( unsigned int i = 0; i < cmd.ElemCount; i++ )
+				hash = ImHashData( &list->VtxBuffer[cmd.VtxOffset + list->IdxBuffer[cmd.IdxOffset + i]], sizeof( ImDrawVert ), hash );
+		}
+	}
+	return hash;
+}
+
+class PanelFrames
+{
+public:
+	PanelFrames( ImFontAtlas* atlas, ImGuiWindowFlags flags ) : m_Flags( flags )
+	{
+		m_Context = ImGui::CreateContext( atlas );
+		ImGui::SetCurrentContext( m_Context );
+		ImGuiIO& io = ImGui::GetIO();
+		io.IniFilename = nullptr;
+		io.DisplaySize = ImVec2( 1600.0f, 1000.0f );
+		io.DeltaTime = 1.0f / 60.0f;
+	}
+
+	~PanelFrames() { ImGui::DestroyContext( m_Context ); }
+
+	// Hovering panel 10, clicking Reset on panel 20, dragging the slider of panel 0, scrolling panel 5, toggling a checkbox
+	void Run( int frame )
+	{
+		ImGui::SetCurrentContext( m_Context );
+		ImGuiIO& io = ImGui::GetIO();
+		const int step = frame % 1000;
+		if ( step >= 100 && step < 110 )
+			io.AddMousePosEvent( 400.0f + ( step - 100 ) * 3.0f, 400.0f );
+		if ( step == 200 )
+			io.AddMousePosEvent( 830.0f, 755.0f );
+		if ( step == 201 || step == 501 )
+			io.AddMouseButtonEvent( 0, true );
+		if ( step == 203 || step == 503 )
+			io.AddMouseButtonEvent( 0, false );
+		if ( step == 300 )
+			io.AddMousePosEvent( 60.0f, 68.0f );
+		if ( step == 301 )
+			io.AddMouseButtonEvent( 0, true );
+		if ( step == 302 )
+			io.AddMousePosEvent( 120.0f, 68.0f );
+		if ( step == 303 )
+			io.AddMouseButtonEvent( 0, false );
+		if ( step == 400 )
+			io.AddMousePosEvent( 1100.0f, 100.0f );
+		if ( step == 401 )
+			io.AddMouseWheelEvent( 0.0f, -1.0f );
+		if ( step == 500 )
+			io.AddMousePosEvent( 20.0f, 120.0f );
+		if ( step == 110 || step == 206 || step == 304 || step == 402 || step == 506 )
+			io.AddMousePosEvent( -FLT_MAX, -FLT_MAX );
+		if ( CounterChanges( frame ) )
+			m_State.Counter++;
+
+		ImGui::NewFrame();
+		DrawPanels( m_State, m_Flags, frame );
+		ImGui::Render();
+	}
+
+	ImU32 GetDrawDataHash() const { return HashDrawData( ImGui::GetDrawData() ); }
+
+	// Sums of the per-window counters of the retaining context
+	void GetRetainedCounts( int& reused, int& rebuilt, int& late ) const
+	{
+		reused = rebuilt = late = 0;
+		for ( const ImGuiWindow* window : m_Context->Windows )
+		{
+			reused += window->RetainedReusedCount;
+			rebuilt += window->RetainedRebuiltCount;
+			late += window->RetainedLateCount;
+		}
+	}
+
+private:
+	ImGuiContext* m_Context;
+	ImGuiWindowFlags m_Flags;
+	PanelsState m_State;
+};
+
+void BenchRetainedDrawLists()
+{
+	ImFontAtlas atlas;
+	unsigned char* pixels;
+	int width, height;
+	atlas.GetTexDataAsRGBA32( &pixels, &width, &height );
+
+	const int frames = 2000;
+	PanelFrames plain( &atlas, 0 );
+	PanelFrames retained( &atlas, ImGuiWindowFlags_RetainDrawList );
+	int differences = 0, lateFrames = 0, changes = 0;
+	double plainMs = 0.0, retainedMs = 0.0;
+	for ( int frame = 0; frame < frames; frame++ )
+	{
+		changes += CounterChanges( frame ) || ( frame > 0 && ChildShown( frame ) != ChildShown( frame - 1 ) );
+
+		BenchTimer plainTimer;
+		plain.Run( frame );
+		plainMs += plainTimer.GetMilliseconds();
+		const ImU32 expected = plain.GetDrawDataHash();
+
+		int reused, rebuilt, lateBefore, lateAfter;
+		retained.GetRetainedCounts( reused, rebuilt, lateBefore );
+		BenchTimer retainedTimer;
+		retained.Run( frame );
+		retainedMs += retainedTimer.GetMilliseconds();
+		retained.GetRetainedCounts( reused, rebuilt, lateAfter );
+
+		if ( lateAfter != lateBefore )
+			lateFrames++;
+		else if ( retained.GetDrawDataHash() != expected )
+			differences++;
+	}
+	int reused, rebuilt, late;
+	retained.GetRetainedCounts( reused, rebuilt, late );
+
+	BenchCheck( differences == 0, "RetainDrawList: %d frames render differently from the same windows without the flag", differences );
+	BenchCheck( lateFrames <= changes, "RetainDrawList: %d frames late for %d changes without input: late frames aren't compared", lateFrames, changes );
+	BenchCheck( reused > rebuilt, "RetainDrawList: %d lists reused, %d rebuilt: the check barely covers reuse", reused, rebuilt );
+	printf( "  %d frames: %d lists reused, %d rebuilt, %d late (on %d frames)\n", frames, reused, rebuilt, late, lateFrames );
+	printf( "  per frame: %6.3f ms without the flag, %6.3f ms with it\n", plainMs / frames, retainedMs / frames );
+}
@@ -0,0 +1,140 @@
+#include "Bench.h"
+
+#include "ShaderSource.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+static void WriteFile( const fs::path& path, const char* text, int secondsFromNow )
+{
+	{
+		std::ofstream stream( path, std::ios::binary | std::ios::trunc );
+		stream << text;
+	}
+	// Explicit timestamps: consecutive writes can land within the file system's time resolution
+	std::error_code error;
+	fs::last_write_time( path, fs::file_time_type::clock::now() + std::chrono::seconds( secondsFromNow ), error );
+}
+
+static const char* MAIN_SHADER =
+	"#shader vertex\n"
+	"#version 330 core\n"
+	"#include \"common.glsl\"\n"
+	"layout( location = 0 ) in vec4 position;\n"
+	"void main() { gl_Position = Transform( position ); }\n"
+	"#shader fragment\n"
+	"#version 330 core\n"
+	"out vec4 color;\n"
+	"void main() { color = vec4( 1.0 ); }\n";
+
+static const char* COMMON_V1 = "vec4 Transform( vec4 p ) { return p; }\n";
+static const char* COMMON_V2 = "vec4 Transform( vec4 p ) { return p * 2.0; }\n";
+
+// Parses the program and computes its key the way ShaderLibrary does, and returns the files it depends on.
+static uint64_t ParseKey( const fs::path& path, const std::string& driver, std::vector<std::string>* files = nullptr )
+{
+	ShaderProgramSource source = ParseShader( path.string() );
+	if ( !BenchCheck( source.IsValid(), "ParseShader: %s: %s", path.string().c_str(), source.Errors.empty() ? "" : source.Errors[0].c_str() ) )
+		return 0;
+	if ( files )
+		*files = source.Files;
+	return ComputeShaderCacheKey( source, driver );
+}
+
+// ShaderLibrary rebuilds a program when a watched file changed and the new key differs from
+// the one it was built with, then looks the new key up in the binary cache. All of that is
+// GL-free, so the decisions are replayed here on real files in a temporary directory.
+static void CheckInvalidation( const fs::path& directory )
+{
+	const std::string driver = "Vendor|Renderer|4.6";
+	const fs::path mainPath = directory / "main.shader";
+	const fs::path commonPath = directory / "common.glsl";
+	WriteFile( mainPath, MAIN_SHADER, 0 );
+	WriteFile( commonPath, COMMON_V1, 0 );
+
+	ShaderBinaryCache cache( directory / "cache" );
+	const std::vector<char> binaryV1 = { 'v', '1' };
+	const std::vector<char> binaryV2 = { 'v', '2', '!' };
+	unsigned int format = 0;
+	std::vector<char> binary;
+
+	// Cold start: a miss, then the linked binary is stored under the key
+	std::vector<std::string> files;
+	const uint64_t key = ParseKey( mainPath, driver, &files );
+	bool includesCommon = false;
+	for ( const std::string& file : files )
+		includesCommon |= fs::path( file ).filename() == "common.glsl";
+	BenchCheck( files.size() == 2 && includesCommon, "ShaderProgramSource: the included file must be listed in Files (%d files)", (int)files.size() );
+	BenchCheck( !cache.Load( key, format, binary ), "ShaderBinaryCache: a cold cache must miss" );
+	BenchCheck( cache.Store( key, 7, binaryV1 ), "ShaderBinaryCache: Store() failed" );
+
+	// Warm start with unchanged sources: same key, cache hit with the stored binary
+	BenchCheck( ParseKey( mainPath, driver ) == key, "ComputeShaderCacheKey: unchanged sources must give the same key" );
+	BenchCheck( cache.Load( key, format, binary ) && format == 7 && binary == binaryV1, "ShaderBinaryCache: unchanged sources must hit" );
+	BenchCheck( ParseKey( mainPath, driver + " (updated)" ) != key, "ComputeShaderCacheKey: another driver must give another key" );
+
+	ShaderFileWatcher watcher( 0.5 );
+	for ( const std::string& file : files )
+		watcher.Watch( file );
+	BenchCheck( watcher.Poll( 0.0 ).empty(), "ShaderFileWatcher: nothing changed yet" );
+
+	// Saving the root file without edits: reported as changed, but the key is the same so nothing is rebuilt
+	WriteFile( mainPath, MAIN_SHADER, 2 );
+	std::vector<fs::path> changed = watcher.Poll( 1.0 );
+	BenchCheck( changed.size() == 1 && changed[0] == mainPath, "ShaderFileWatcher: a saved root file must be reported" );
+	BenchCheck( ParseKey( mainPath, driver ) == key, "ComputeShaderCacheKey: saving without edits must keep the key" );
+
+	// Editing the included file: reported, the key changes and the new key misses, so the program is rebuilt
+	WriteFile( commonPath, COMMON_V2, 4 );
+	BenchCheck( watcher.Poll( 1.2 ).empty(), "ShaderFileWatcher: polls closer than the interval must not touch the files" );
+	changed = watcher.Poll( 2.0 );
+	BenchCheck( changed.size() == 1 && changed[0] == commonPath, "ShaderFileWatcher: an edited include must be reported" );
+	const uint64_t editedKey = ParseKey( mainPath, driver );
+	BenchCheck( editedKey != key, "ComputeShaderCacheKey: editing an included file must change the key" );
+	BenchCheck( !cache.Load( editedKey, format, binary ), "ShaderBinaryCache: an edited include must miss and force a rebuild" );
+	BenchCheck( cache.Store( editedKey, 7, binaryV2 ), "ShaderBinaryCache: Store() failed" );
+
+	// Reverting the edit comes back to the first key, whose binary is still cached
+	WriteFile( commonPath, COMMON_V1, 6 );
+	changed = watcher.Poll( 3.0 );
+	BenchCheck( changed.size() == 1 && ParseKey( mainPath, driver ) == key, "ComputeShaderCacheKey: reverting an edit must give the previous key back" );
+	BenchCheck( cache.Load( key, format, binary ) && binary == binaryV1, "ShaderBinaryCache: the reverted version must hit" );
+
+	// A truncated entry is a miss and is deleted
+	{
+		std::ofstream stream( cache.GetEntryPath( editedKey ), std::ios::binary | std::ios::trunc );
+		stream << "SHBC";
+	}
+	BenchCheck( !cache.Load( editedKey, format, binary ) && !fs::exists( cache.GetEntryPath( editedKey ) ),
+		"ShaderBinaryCache: a truncated entry must miss and be deleted" );
+}
+
+void BenchShaderCache()
+{
+	const fs::path directory = fs::temp_directory_path() / "OpenGlBenchShaderCache";
+	std::error_code error;
+	fs::remove_all( directory, error );
+	fs::create_directories( directory, error );
+
+	CheckInvalidation( directory );
+
+	// What a warm start pays per program before the binary is loaded: parsing and hashing
+	const fs::path mainPath = directory / "main.shader";
+	const int runs = 2000;
+	double ms = BenchBestOf( 5, [&]() {
+		uint64_t sum = 0;
+		for ( int i = 0; i < runs; i++ )
+		{
+			ShaderProgramSource source = ParseShader( mainPath.string() );
+			sum += ComputeShaderCacheKey( source, "driver" );
+		}
+		BenchKeep( (size_t)sum );
+	} );
+	printf( "  parse + key of a 2-file program: %6.2f us\n", ms * 1000.0 / runs );
+
+	fs::remove_all( directory, error );
+}
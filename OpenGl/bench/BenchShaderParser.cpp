@@ -0,0 +1,144 @@
+#include "Bench.h"
+
+#include "ShaderParser.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+// The stringstream parser ParseShader used before the mapped single-pass one,
+// kept verbatim as the reference (renamed, and the result is a plain pair).
+struct StreamShaderSource
+{
+	std::string VertexSource;
+	std::string FragmentSource;
+};
+
+static StreamShaderSource ParseShaderStream( const std::string& filepath )
+{
+	std::ifstream stream( filepath );
+
+	enum class ShaderType
+	{
+		NONE = -1,
+		VERTEX = 0,
+		FRAGMENT = 1
+	};
+
+	std::string line;
+	std::stringstream sstring[2];
+
+	ShaderType stype = ShaderType::NONE;
+
+	while ( getline( stream, line ) )
+	{
+		if ( line.find( "#shader" ) != std::string::npos )
+		{
+			if ( line.find( "vertex" ) != std::string::npos )
+			{
+				stype = ShaderType::VERTEX;
+			}
+			if ( line.find( "fragment" ) != std::string::npos )
+			{
+				stype = ShaderType::FRAGMENT;
+			}
+		}
+		else
+		{
+			sstring[(int)stype] << line << '\n';
+		}
+	}
+
+	return { sstring[0].str(), sstring[1].str() };
+}
+
+// Shader-like text: alternating vertex and fragment sections of declarations,
+// indented statements, comments and preprocessor lines. No #version or
+// #include, so the new parser emits no #line directives and both parsers
+// must produce byte-identical stage sources.
+static std::string MakeCorpus( size_t targetBytes )
+{
+	static const char* LINES[] = {
+		"layout(location = 0) in vec4 a_Position;",
+		"uniform mat4 u_MVP;",
+		"\tgl_Position = u_MVP * a_Position;",
+		"\tvec3 n = normalize(v_Normal);",
+		"\tfloat diffuse = max(dot(n, u_LightDir), 0.0);",
+		"\tcolor = vec4(u_Color.rgb * (0.2 + 0.8 * diffuse), u_Color.a);",
+		"// per-fragment lighting, see SceneRenderer",
+		"#define MAX_LIGHTS 8",
+		"#ifdef USE_FOG",
+		"#endif",
+		"",
+		"void main()",
+		"{",
+		"}",
+	};
+
+	std::mt19937 random( 3 );
+	std::string text;
+	text.reserve( targetBytes + 4096 );
+	bool vertex = true;
+	while ( text.size() < targetBytes )
+	{
+		text += vertex ? "#shader vertex\n" : "#shader fragment\n";
+		vertex = !vertex;
+
+		int lines = 20 + (int)( random() % 200 );
+		for ( int i = 0; i < lines; i++ )
+		{
+			text += LINES[random() % ( sizeof( LINES ) / sizeof( LINES[0] ) )];
+			text += '\n';
+		}
+	}
+	return text;
+}
+
+void BenchShaderParser()
+{
+	const size_t sizes[] = { 64 * 1024, 8 * 1024 * 1024 };
+
+	for ( size_t size : sizes )
+	{
+		std::string corpus = MakeCorpus( size );
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "bench_shader_parser.shader";
+		{
+			std::ofstream file( path, std::ios::binary );
+			file.write( corpus.data(), (std::streamsize)corpus.size() );
+		}
+		const std::string filepath = path.string();
+
+		StreamShaderSource reference = ParseShaderStream( filepath );
+		ShaderProgramSource parsed = ParseShader( filepath );
+		BenchCheck( parsed.IsValid(), "ParseShader reported errors on the corpus" );
+		BenchCheck( parsed.GetStage( ShaderStage::Vertex ).ToString() == reference.VertexSource, "vertex source differs from the stringstream parser" );
+		BenchCheck( parsed.GetStage( ShaderStage::Fragment ).ToString() == reference.FragmentSource, "fragment source differs from the stringstream parser" );
+
+		const int repeats = size < 1024 * 1024 ? 50 : 5;
+		double streamMs = BenchBestOf( repeats, [&]() {
+			StreamShaderSource source = ParseShaderStream( filepath );
+			BenchKeep( source.VertexSource.size() + source.FragmentSource.size() );
+		} );
+		double mappedMs = BenchBestOf( repeats, [&]() {
+			ShaderProgramSource source = ParseShader( filepath );
+			BenchKeep( source.GetStage( ShaderStage::Vertex ).Chunks.size() );
+		} );
+		// Joining the chunks is what a caller needing one contiguous string would pay on top
+		double joinedMs = BenchBestOf( repeats, [&]() {
+			ShaderProgramSource source = ParseShader( filepath );
+			BenchKeep( source.GetStage( ShaderStage::Vertex ).ToString().size() + source.GetStage( ShaderStage::Fragment ).ToString().size() );
+		} );
+
+		printf( "  %7.2f MB  stringstream %8.1f MB/s  mapped %8.1f MB/s  mapped+join %8.1f MB/s\n",
+			corpus.size() / ( 1024.0 * 1024.0 ),
+			BenchMegabytesPerSecond( corpus.size(), streamMs ),
+			BenchMegabytesPerSecond( corpus.size(), mappedMs ),
+			BenchMegabytesPerSecond( corpus.size(), joinedMs ) );
+
+		std::error_code error;
+		std::filesystem::remove( path, error );
+	}
+}
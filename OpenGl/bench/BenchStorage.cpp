@@ -0,0 +1,218 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+typedef ImGuiStorage::ImGuiStoragePair StoragePair;
+
+// ImGuiStorage as it was before the hash index: pairs sorted by key, binary
+// searched, inserted in place. Kept as the baseline for the timings.
+struct SortedStorage
+{
+	ImVector<StoragePair> Data;
+
+	StoragePair* LowerBound( ImGuiID key ) const
+	{
+		StoragePair* first = Data.Data;
+		size_t count = (size_t)Data.Size;
+		while ( count > 0 )
+		{
+			size_t half = count >> 1;
+			StoragePair* mid = first + half;
+			if ( mid->key < key )
+			{
+				first = mid + 1;
+				count -= half + 1;
+			}
+			else
+			{
+				count = half;
+			}
+		}
+		return first;
+	}
+
+	int GetInt( ImGuiID key, int defaultValue ) const
+	{
+		StoragePair* it = LowerBound( key );
+		return ( it == Data.end() || it->key != key ) ? defaultValue : it->val_i;
+	}
+
+	void SetInt( ImGuiID key, int value )
+	{
+		StoragePair* it = LowerBound( key );
+		if ( it == Data.end() || it->key != key )
+			Data.insert( it, StoragePair( key, value ) );
+		else
+			it->val_i = value;
+	}
+};
+
+// Keys of one of a few shapes: random IDs, small sequential integers,
+// values sharing their low bits (like pointers), or keys that all land on
+// a handful of home slots, which makes long probe sequences.
+static ImGuiID MakeKey( std::mt19937& random, int shape, int range )
+{
+	switch ( shape )
+	{
+	case 0:  return (ImGuiID)random();
+	case 1:  return (ImGuiID)( random() % range );
+	case 2:  return (ImGuiID)( random() % range ) << 12;
+	default: return (ImGuiID)( random() % range ) * 0x10000u; // multiples of 65536 hash to few slots in small tables
+	}
+}
+
+static void CheckAgainstUnorderedMap()
+{
+	std::mt19937 random( 21 );
+	int failures = 0;
+
+	for ( int round = 0; round < 40; round++ )
+	{
+		const int shape = round % 4;
+		const int count = round < 20 ? 64 : 20000;
+		ImGuiStorage storage;
+		std::unordered_map<ImGuiID, int> reference;
+
+		// Random mix of Set, GetRef (insert on demand) and Get; Gets of missing keys exercise the probe early-exit
+		for ( int i = 0; i < count * 4; i++ )
+		{
+			const ImGuiID key = MakeKey( random, shape, count * 2 );
+			switch ( random() % 4 )
+			{
+			case 0:
+				storage.SetInt( key, i );
+				reference[key] = i;
+				break;
+			case 1:
+			{
+				int* value = storage.GetIntRef( key, -5 );
+				auto inserted = reference.emplace( key, -5 ).first;
+				failures += *value != inserted->second;
+				*value += 1;
+				inserted->second += 1;
+				break;
+			}
+			default:
+			{
+				auto it = reference.find( key );
+				failures += storage.GetInt( key, -7 ) != ( it == reference.end() ? -7 : it->second );
+				break;
+			}
+			}
+		}
+		failures += storage.Data.Size != (int)reference.size();
+		for ( const auto& pair : reference )
+			failures += storage.GetInt( pair.first, -9 ) != pair.second;
+
+		// Pairs added to Data directly, duplicates included, are re-indexed on the next access. The first one of a key wins.
+		ImGuiStorage direct;
+		std::unordered_map<ImGuiID, int> firstValues;
+		for ( int i = 0; i < count; i++ )
+		{
+			const ImGuiID key = MakeKey( random, shape, count / 2 );
+			direct.Data.push_back( StoragePair( key, i ) );
+			firstValues.emplace( key, i );
+		}
+		for ( const auto& pair : firstValues )
+			failures += direct.GetInt( pair.first, -9 ) != pair.second;
+		for ( int i = 0; i < 256; i++ )
+		{
+			const ImGuiID key = MakeKey( random, shape, count * 4 );
+			failures += direct.GetInt( key, -3 ) != ( firstValues.count( key ) ? firstValues[key] : -3 );
+		}
+
+		// Set on a duplicated key updates the pair lookups return
+		if ( !firstValues.empty() )
+		{
+			const ImGuiID key = firstValues.begin()->first;
+			direct.SetInt( key, 12345 );
+			failures += direct.GetInt( key ) != 12345;
+		}
+
+		// BuildSortByKey() sorts and re-indexes; a pushed pair is found without an explicit rebuild
+		direct.BuildSortByKey();
+		for ( int i = 1; i < direct.Data.Size; i++ )
+			failures += direct.Data[i - 1].key > direct.Data[i].key;
+		direct.Data.push_back( StoragePair( 0xDEADBEEF, 42 ) );
+		failures += direct.GetInt( 0xDEADBEEF ) != 42;
+		ImGuiStorage copy = direct;
+		failures += copy.GetInt( 0xDEADBEEF ) != 42;
+		direct.Clear();
+		failures += direct.GetInt( 0xDEADBEEF, 8 ) != 8;
+	}
+
+	BenchCheck( failures == 0, "ImGuiStorage: %d results differ from std::unordered_map", failures );
+}
+
+template<typename Storage>
+static void BenchStorageType( const char* name, const std::vector<ImGuiID>& keys, const std::vector<ImGuiID>& missing )
+{
+	const int count = (int)keys.size();
+	const int lookups = 2000000;
+	Storage storage;
+
+	// Inserting only happens once per storage, so this one is a single run
+	BenchTimer insertTimer;
+	for ( int i = 0; i < count; i++ )
+		storage.SetInt( keys[i], i );
+	double insertMs = insertTimer.GetMilliseconds();
+	double hitMs = BenchBestOf( 3, [&]() {
+		int sum = 0;
+		for ( int i = 0; i < lookups; i++ )
+			sum += storage.GetInt( keys[( i * 7919u ) % count], 0 );
+		BenchKeep( (size_t)sum );
+	} );
+	double missMs = BenchBestOf( 3, [&]() {
+		int sum = 0;
+		for ( int i = 0; i < lookups; i++ )
+			sum += storage.GetInt( missing[i % missing.size()], 1 );
+		BenchKeep( (size_t)sum );
+	} );
+
+	printf( "  %-13s %8d keys  insert %7.1f ns  hit %6.1f ns  miss %6.1f ns\n", name, count,
+		insertMs * 1e6 / count, hitMs * 1e6 / lookups, missMs * 1e6 / lookups );
+}
+
+// std::unordered_map behind the same two calls, for scale
+struct UnorderedMapStorage
+{
+	std::unordered_map<ImGuiID, int> Map;
+
+	int GetInt( ImGuiID key, int defaultValue ) const
+	{
+		auto it = Map.find( key );
+		return it == Map.end() ? defaultValue : it->second;
+	}
+
+	void SetInt( ImGuiID key, int value ) { Map[key] = value; }
+};
+
+void BenchStorage()
+{
+	CheckAgainstUnorderedMap();
+
+	std::mt19937 random( 1 );
+	const int sizes[] = { 1000, 100000, 1000000 };
+	for ( int count : sizes )
+	{
+		std::vector<ImGuiID> keys( count ), missing( 1 << 16 );
+		for ( ImGuiID& key : keys )
+			key = (ImGuiID)random();
+		for ( ImGuiID& key : missing )
+			key = (ImGuiID)random();
+
+		BenchStorageType<ImGuiStorage>( "ImGuiStorage", keys, missing );
+		BenchStorageType<UnorderedMapStorage>( "unordered_map", keys, missing );
+
+		// In-place insertion into a sorted array is quadratic: a million keys would take minutes
+		if ( count <= 100000 )
+			BenchStorageType<SortedStorage>( "sorted (old)", keys, missing );
+	}
+}
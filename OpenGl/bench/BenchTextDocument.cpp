@@ -0,0 +1,135 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compares every query of the document against the same text held in a std::string.
+static bool SameText( const ImGuiTextDocument& doc, const std::string& text )
+{
+	ImVector<char> scratch;
+	if ( doc.GetLength() != (int)text.size() || std::string( doc.GetText( 0, doc.GetLength(), &scratch ), text.size() ) != text )
+		return false;
+
+	int line = 0, lineStart = 0;
+	for ( int offset = 0; offset <= (int)text.size(); offset++ )
+	{
+		if ( doc.GetLineFromOffset( offset ) != line || ( offset < (int)text.size() && doc.GetChar( offset ) != text[offset] ) )
+			return false;
+		if ( offset == (int)text.size() || text[offset] == '\n' )
+		{
+			if ( doc.GetLineStart( line ) != lineStart || doc.GetLineEnd( line ) != offset )
+				return false;
+			line++;
+			lineStart = offset + 1;
+		}
+	}
+	return doc.GetLineCount() == line;
+}
+
+static std::string MakeText( std::mt19937& random, int length )
+{
+	static const char CHARS[] = "abc \n\xC3\xA9";
+	std::string text;
+	for ( int i = 0; i < length; i++ )
+		text += CHARS[random() % ( sizeof( CHARS ) - 1 )];
+	return text;
+}
+
+static void CheckEmpty()
+{
+	// The constructor already sets an empty text on an empty document: both buffers have no storage
+	ImGuiTextDocument doc;
+	doc.SetText( "" );
+	doc.Replace( 0, 0, "" );
+	BenchCheck( SameText( doc, "" ) && doc.GetLineCount() == 1 && !doc.CanUndo(), "ImGuiTextDocument: an empty text must give one empty line" );
+	doc.Replace( 0, 0, "a\nb" );
+	doc.SetText( "" );
+	BenchCheck( SameText( doc, "" ) && !doc.CanUndo(), "ImGuiTextDocument: SetText(\"\") must clear the text and the undo history" );
+}
+
+static void CheckEdits()
+{
+	// Random replacements against a std::string, then every one undone and redone
+	std::mt19937 random( 15 );
+	int failures = 0;
+	for ( int round = 0; round < 20; round++ )
+	{
+		ImGuiTextDocument doc;
+		std::string text = MakeText( random, round * 50 );
+		doc.SetText( text.c_str() );
+		failures += !SameText( doc, text );
+
+		std::vector<std::string> history( 1, text );
+		const int edits = 1 + random() % 60;
+		for ( int edit = 0; edit < edits; edit++ )
+		{
+			const int offset = text.empty() ? 0 : (int)( random() % ( text.size() + 1 ) );
+			const int deleteLength = (int)( random() % ( text.size() - offset + 1 ) ) / ( 1 + random() % 4 );
+			const std::string inserted = MakeText( random, random() % 3 == 0 ? 0 : 1 + random() % 20 );
+			if ( deleteLength == 0 && inserted.empty() )
+				continue;
+			doc.Replace( offset, deleteLength, inserted.c_str(), inserted.c_str() + inserted.size() );
+			text.replace( offset, deleteLength, inserted );
+			history.push_back( text );
+			failures += !SameText( doc, text );
+		}
+
+		for ( int n = (int)history.size() - 2; n >= 0; n-- )
+			failures += !doc.Undo() || !SameText( doc, history[n] );
+		failures += doc.Undo();
+		for ( size_t n = 1; n < history.size(); n++ )
+			failures += !doc.Redo() || !SameText( doc, history[n] );
+		failures += doc.Redo();
+
+		// A new edit after undoing discards what could be redone
+		if ( history.size() > 1 )
+		{
+			doc.Undo();
+			doc.Replace( 0, 0, "x" );
+			failures += doc.CanRedo() || !SameText( doc, "x" + history[history.size() - 2] );
+		}
+	}
+	BenchCheck( failures == 0, "ImGuiTextDocument: %d mismatches against std::string over random edits, undo and redo", failures );
+}
+
+static void CheckUndoLimit()
+{
+	// At most STB_TEXTEDIT_UNDOSTATECOUNT records are kept: the oldest edits can no longer be undone
+	ImGuiTextDocument doc;
+	doc.SetText( "start" );
+	for ( int i = 0; i < STB_TEXTEDIT_UNDOSTATECOUNT + 10; i++ )
+		doc.Replace( doc.GetLength(), 0, "+" );
+	int undone = 0;
+	while ( doc.Undo() )
+		undone++;
+	BenchCheck( undone == STB_TEXTEDIT_UNDOSTATECOUNT && SameText( doc, "start" + std::string( 10, '+' ) ),
+		"ImGuiTextDocument: %d edits undone, expected %d", undone, STB_TEXTEDIT_UNDOSTATECOUNT );
+}
+
+void BenchTextDocument()
+{
+	CheckEmpty();
+	CheckEdits();
+	CheckUndoLimit();
+
+	// Loading a large document, typing into its middle, then looking up a line near the end
+	std::mt19937 random( 16 );
+	std::string text;
+	for ( int line = 0; line < 100000; line++ )
+		text += MakeText( random, 60 ) + "\n";
+	const int typed = 10000;
+	ImGuiTextDocument doc;
+	double ms = BenchBestOf( 3, [&]() {
+		doc.SetText( text.c_str(), text.c_str() + text.size() );
+		int offset = doc.GetLineStart( doc.GetLineCount() / 2 );
+		for ( int i = 0; i < typed; i++ )
+			doc.Replace( offset++, 0, ( i % 40 ) == 39 ? "\n" : "a" );
+		BenchKeep( (size_t)doc.GetLineStart( doc.GetLineCount() - 10 ) );
+	} );
+	printf( "  %d KB, %d lines: SetText + %d typed characters + lookup %7.2f ms\n", (int)( text.size() / 1024 ), doc.GetLineCount(), typed, ms );
+}
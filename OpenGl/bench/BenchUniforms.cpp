@@ -0,0 +1,174 @@
+#include "Bench.h"
+
+#include "ProgramReflection.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Stands in for the driver: programs are described up front, uploads go to the
+// program last passed to UseProgram() and are recorded along with the value
+// each (program, location) ends up holding.
+class FakeUniformBackend : public UniformBackend
+{
+public:
+	struct Upload
+	{
+		unsigned int Program;
+		int Location;
+		UniformType Type;
+	};
+
+	std::map<unsigned int, std::vector<UniformInfo>> Programs;
+	std::vector<std::pair<unsigned int, unsigned int>> BlockBindings; // (program, binding)
+	std::vector<Upload> Uploads;
+	std::map<std::pair<unsigned int, int>, std::vector<float>> Values;
+	unsigned int BoundProgram = 0;
+
+	void UseProgram( unsigned int program ) { BoundProgram = program; }
+
+	void QueryProgram( unsigned int program, std::vector<UniformInfo>& uniforms, std::vector<UniformBlockInfo>& blocks ) override
+	{
+		uniforms = Programs[program];
+		UniformBlockInfo block;
+		block.Name = "FrameData";
+		block.Index = 3;
+		block.Size = 64;
+		blocks.push_back( block );
+	}
+
+	void SetUniformBlockBinding( unsigned int program, unsigned int blockIndex, unsigned int binding ) override
+	{
+		(void)blockIndex;
+		BlockBindings.push_back( { program, binding } );
+	}
+
+	void Upload( int location, UniformType type, const void* data ) override
+	{
+		static const int FLOATS[] = { 1, 2, 3, 4, 1, 9, 16, 0 };
+		Uploads.push_back( { BoundProgram, location, type } );
+		std::vector<float>& value = Values[{ BoundProgram, location }];
+		value.resize( FLOATS[(int)type] );
+		memcpy( value.data(), data, value.size() * sizeof( float ) );
+	}
+
+	float GetFloat( unsigned int program, int location ) { return Values[{ program, location }].at( 0 ); }
+};
+
+static std::vector<UniformInfo> MakeUniforms( int extra )
+{
+	std::vector<UniformInfo> uniforms;
+	uniforms.push_back( { "u_Model", UniformType::Mat4, 0, 1 } );
+	uniforms.push_back( { "u_Color", UniformType::Vec4, 4, 1 } );
+	uniforms.push_back( { "u_Time", UniformType::Float, 5, 1 } );
+	uniforms.push_back( { "u_Texture", UniformType::Int, 6, 1 } );
+	for ( int i = 0; i < extra; i++ )
+		uniforms.push_back( { "u_Extra" + std::to_string( i ), UniformType::Vec3, 7 + i, 1 } );
+	return uniforms;
+}
+
+static void CheckDirtyTracking()
+{
+	const SharedUniformBlock sharedBlocks[] = { { "FrameData", 0 } };
+	FakeUniformBackend backend;
+	backend.Programs[1] = MakeUniforms( 40 );
+	backend.Programs[2] = MakeUniforms( 0 );
+	backend.Programs[3] = MakeUniforms( 0 );
+
+	ProgramReflection a, b;
+	a.Reflect( 1, &backend, sharedBlocks, 1 );
+	b.Reflect( 2, &backend, sharedBlocks, 1 );
+	BenchCheck( backend.BlockBindings.size() == 2 && backend.BlockBindings[0].second == 0, "ProgramReflection: FrameData must be bound to its shared binding point" );
+
+	// Every reflected name is found, unknown names and wrong types are rejected without uploading
+	int missing = 0;
+	for ( const UniformInfo& uniform : backend.Programs[1] )
+		missing += a.GetUniforms()[a.Find( uniform.Name.c_str() )].Location != uniform.Location;
+	BenchCheck( missing == 0, "ProgramReflection: %d uniforms not found by name", missing );
+	BenchCheck( a.Find( "u_Missing" ) == -1 && !a.Set( "u_Missing", 1.0f ) && !a.Set( "u_Time", 1 ) && backend.Uploads.empty(),
+		"ProgramReflection: unknown names and wrong types must not upload" );
+
+	// First Set uploads, repeating the same value does not, a new value uploads exactly once
+	backend.UseProgram( 1 );
+	const glm::mat4 model( 2.0f );
+	a.Set( "u_Model", model );
+	a.Set( "u_Time", 0.5f );
+	BenchCheck( backend.Uploads.size() == 2 && a.GetUploadCount() == 2, "ProgramReflection: first Set() calls must upload (%d uploads)", (int)backend.Uploads.size() );
+	for ( int i = 0; i < 100; i++ )
+	{
+		a.Set( "u_Model", model );
+		a.Set( "u_Time", 0.5f );
+	}
+	BenchCheck( backend.Uploads.size() == 2 && a.GetSkippedCount() == 200, "ProgramReflection: unchanged Set() calls must not upload (%d uploads)", (int)backend.Uploads.size() );
+	a.Set( "u_Time", 0.75f );
+	a.Set( "u_Time", 0.75f );
+	BenchCheck( backend.Uploads.size() == 3 && backend.GetFloat( 1, 5 ) == 0.75f, "ProgramReflection: a changed value must upload exactly once" );
+	glm::mat4 moved = model;
+	moved[3][0] = 1.0f; // only the last column changes: the whole matrix is compared
+	a.Set( "u_Model", moved );
+	BenchCheck( backend.Uploads.size() == 4 && backend.Values[{ 1, 0 }][12] == 1.0f, "ProgramReflection: a change in any matrix element must upload" );
+
+	// Switching programs: each reflection uploads to its own program, and values a program
+	// still holds are not sent again when it is bound back
+	backend.UseProgram( 2 );
+	b.Set( "u_Time", 0.75f );
+	BenchCheck( backend.Uploads.size() == 5 && backend.Uploads.back().Program == 2, "ProgramReflection: another program must get its own upload" );
+	backend.UseProgram( 1 );
+	a.Set( "u_Time", 0.75f );
+	BenchCheck( backend.Uploads.size() == 5 && backend.GetFloat( 1, 5 ) == 0.75f && backend.GetFloat( 2, 5 ) == 0.75f,
+		"ProgramReflection: rebinding a program must not re-upload values it still holds" );
+
+	// Relinking (hot reload) gives a new program with default uniforms: the same values must be sent again
+	backend.UseProgram( 3 );
+	b.Reflect( 3, &backend, sharedBlocks, 1 );
+	b.Set( "u_Time", 0.75f );
+	b.Set( "u_Texture", 1 );
+	BenchCheck( backend.Uploads.size() == 7 && backend.GetFloat( 3, 5 ) == 0.75f && backend.Uploads[5].Program == 3,
+		"ProgramReflection: a reflected new program must re-upload every value" );
+
+	// Invalidate() forgets the shadows, e.g. after someone else called glUniform
+	backend.UseProgram( 1 );
+	a.Invalidate();
+	a.Set( "u_Time", 0.75f );
+	BenchCheck( backend.Uploads.size() == 8, "ProgramReflection: Set() after Invalidate() must upload" );
+}
+
+void BenchUniforms()
+{
+	CheckDirtyTracking();
+
+	const SharedUniformBlock sharedBlocks[] = { { "FrameData", 0 } };
+	FakeUniformBackend backend;
+	backend.Programs[1] = MakeUniforms( 60 );
+	ProgramReflection reflection;
+	reflection.Reflect( 1, &backend, sharedBlocks, 1 );
+	backend.UseProgram( 1 );
+
+	const int runs = 1000000;
+	const ProgramReflection::UniformHandle model = reflection.Find( "u_Model" );
+	double findMs = BenchBestOf( 3, [&]() {
+		int sum = 0;
+		for ( int i = 0; i < runs; i++ )
+			sum += reflection.Find( ( i & 1 ) ? "u_Extra42" : "u_Color" );
+		BenchKeep( (size_t)sum );
+	} );
+	glm::mat4 matrix( 1.0f );
+	double unchangedMs = BenchBestOf( 3, [&]() {
+		for ( int i = 0; i < runs; i++ )
+			reflection.Set( model, matrix );
+	} );
+	backend.Uploads.reserve( runs * 3 );
+	double changedMs = BenchBestOf( 3, [&]() {
+		for ( int i = 0; i < runs; i++ )
+		{
+			matrix[3][0] = (float)i;
+			reflection.Set( model, matrix );
+		}
+		backend.Uploads.clear();
+	} );
+	printf( "  Find %5.1f ns  Set(mat4) unchanged %5.1f ns  changed %5.1f ns (fake upload)\n",
+		findMs * 1e6 / runs, unchangedMs * 1e6 / runs, changedMs * 1e6 / runs );
+}
@@ -0,0 +1,257 @@
+#include "Bench.h"
+
+#include <imgui_impl_opengl3_ring.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Stands in for the driver behind ImGui_ImplOpenGL3_RingFuncs. Fences are numbered in
+// submission order and the GPU completes them in that order: only when the test
+// advances it, or when the ring blocks on one. Each submitted block is filled with a
+// tag, and the GPU checks the tag is still there when it gets to that submission,
+// so a block handed out again too early shows up as corrupted data.
+struct FakeRingGpu
+{
+	struct Region
+	{
+		int Storage;
+		size_t Begin, End;
+		int Fence;
+		unsigned char Tag;
+	};
+
+	std::vector<std::vector<unsigned char>> Storages;
+	bool StorageAlive = false;
+	bool FailCreate = false;
+
+	int FenceCount = 0;          // Fence ids are 1..FenceCount
+	int Completed = 0;           // Every fence <= Completed has signaled
+	std::vector<bool> Deleted = std::vector<bool>( 1, false ); // By fence id
+	std::vector<Region> Regions; // Submitted and not yet read by the GPU
+
+	int Failures = 0;
+	int Overlaps = 0;
+	int Corrupted = 0;
+
+	ImGui_ImplOpenGL3_RingFuncs GetFuncs()
+	{
+		ImGui_ImplOpenGL3_RingFuncs funcs;
+		funcs.CreateStorage = []( void* user_data, size_t size ) { return ( (FakeRingGpu*)user_data )->CreateStorage( size ); };
+		funcs.DestroyStorage = []( void* user_data ) { ( (FakeRingGpu*)user_data )->DestroyStorage(); };
+		funcs.InsertFence = []( void* user_data ) { return ( (FakeRingGpu*)user_data )->InsertFence(); };
+		funcs.WaitFence = []( void* user_data, void* fence, bool block ) { return ( (FakeRingGpu*)user_data )->WaitFence( (int)(intptr_t)fence, block ); };
+		funcs.DeleteFence = []( void* user_data, void* fence ) { ( (FakeRingGpu*)user_data )->DeleteFence( (int)(intptr_t)fence ); };
+		funcs.UserData = this;
+		return funcs;
+	}
+
+	void* CreateStorage( size_t size )
+	{
+		Failures += StorageAlive;
+		if ( FailCreate )
+			return nullptr;
+		Storages.emplace_back( size, (unsigned char)0 );
+		StorageAlive = true;
+		return Storages.back().data();
+	}
+
+	void DestroyStorage()
+	{
+		// The GPU must be done with every block of the storage: all its fences waited for and deleted
+		Failures += !StorageAlive;
+		for ( int fence = 1; fence <= FenceCount; fence++ )
+			Failures += !Deleted[fence];
+		StorageAlive = false;
+		std::vector<unsigned char>().swap( Storages.back() );
+	}
+
+	void* InsertFence()
+	{
+		FenceCount++;
+		Deleted.push_back( false );
+		return (void*)(intptr_t)FenceCount;
+	}
+
+	bool WaitFence( int fence, bool block )
+	{
+		if ( block )
+			Advance( fence );
+		return fence <= Completed;
+	}
+
+	void DeleteFence( int fence )
+	{
+		Failures += fence > Completed || Deleted[fence];
+		Deleted[fence] = true;
+	}
+
+	// The GPU finishes every submission up to 'fence': it reads their blocks now
+	void Advance( int fence )
+	{
+		if ( fence <= Completed )
+			return;
+		Completed = fence;
+		for ( size_t i = 0; i < Regions.size(); )
+		{
+			const Region& region = Regions[i];
+			if ( region.Fence > Completed )
+			{
+				i++;
+				continue;
+			}
+			const unsigned char* data = Storages[region.Storage].data();
+			Corrupted += data[region.Begin] != region.Tag || memcmp( data + region.Begin, data + region.Begin + 1, region.End - region.Begin - 1 ) != 0;
+			Regions.erase( Regions.begin() + i );
+		}
+	}
+
+	// Allocates, checks the block against everything the GPU has not read yet, fills it and submits it
+	bool Submit( ImGui_ImplOpenGL3_Ring& ring, size_t size, unsigned char tag )
+	{
+		const size_t offset = ring.Alloc( size );
+		if ( offset == ImGui_ImplOpenGL3_Ring::NoSpace )
+			return false;
+
+		const int storage = (int)Storages.size() - 1;
+		Failures += ring.MappedData != Storages[storage].data() || offset % ImGui_ImplOpenGL3_Ring::Alignment != 0 || offset + size > ring.Capacity;
+		for ( const Region& region : Regions )
+		{
+			if ( region.Storage == storage && offset < region.End && region.Begin < offset + size )
+				Overlaps++;
+		}
+
+		memset( Storages[storage].data() + offset, tag, size );
+		ring.Submit();
+		Regions.push_back( { storage, offset, offset + size, FenceCount, tag } );
+		return true;
+	}
+
+	bool Check( const char* what ) const
+	{
+		return BenchCheck( Failures == 0 && Overlaps == 0 && Corrupted == 0, "Ring (%s): %d misuses, %d blocks handed out while the GPU still used them, %d corrupted",
+			what, Failures, Overlaps, Corrupted );
+	}
+};
+
+static void CheckWraparound()
+{
+	// Fixed-size frames, GPU two frames behind: the ring cycles through the storage and wraps
+	FakeRingGpu gpu;
+	ImGui_ImplOpenGL3_Ring ring;
+	ring.Init( gpu.GetFuncs() );
+	const size_t size = 700 * 1024 + 8;
+	for ( int frame = 0; frame < 200; frame++ )
+	{
+		gpu.Submit( ring, size, (unsigned char)frame );
+		gpu.Advance( gpu.FenceCount - 2 );
+	}
+	BenchCheck( ring.WrapCount > 20 && ring.StallCount == 0 && ring.GrowCount == 1, "Ring (wraparound): %d wraps, %d stalls, %d grows",
+		ring.WrapCount, ring.StallCount, ring.GrowCount );
+
+	// Destroy() waits for the two frames still in flight before releasing the storage
+	ring.Destroy();
+	gpu.Check( "wraparound" );
+	BenchCheck( !gpu.StorageAlive && ring.StallCount == 2 && gpu.Regions.empty(), "Ring: Destroy() must wait for every submission and release the storage" );
+}
+
+static void CheckUnsignaledFences()
+{
+	// The GPU never gets ahead on its own: every reuse has to wait on a fence that has not signaled
+	FakeRingGpu gpu;
+	ImGui_ImplOpenGL3_Ring ring;
+	ring.Init( gpu.GetFuncs() );
+	const size_t size = 1000 * 1024;
+	for ( int frame = 0; frame < 100; frame++ )
+		gpu.Submit( ring, size, (unsigned char)frame );
+	gpu.Check( "unsignaled fences" );
+	BenchCheck( ring.StallCount >= 90 && ring.InFlightCount <= ImGui_ImplOpenGL3_Ring::MaxInFlight, "Ring (unsignaled fences): %d stalls", ring.StallCount );
+	ring.Destroy();
+}
+
+static void CheckGrowth()
+{
+	// MaxInFlight small frames still referenced, then one that does not fit three times: the old storage is
+	// only released after every fence passed, and the new one holds MaxInFlight blocks of the new size
+	FakeRingGpu gpu;
+	ImGui_ImplOpenGL3_Ring ring;
+	ring.Init( gpu.GetFuncs() );
+	for ( int frame = 0; frame < ImGui_ImplOpenGL3_Ring::MaxInFlight; frame++ )
+		gpu.Submit( ring, 64 * 1024, (unsigned char)frame );
+	BenchCheck( ring.InFlightCount == ImGui_ImplOpenGL3_Ring::MaxInFlight && gpu.Completed == 0, "Ring (growth): frames must still be in flight" );
+
+	const size_t big = 3 * 1024 * 1024;
+	gpu.Submit( ring, big, 0xAB );
+	BenchCheck( ring.GrowCount == 2 && gpu.Storages.size() == 2 && ring.Capacity > ( big + ImGui_ImplOpenGL3_Ring::Alignment ) * ImGui_ImplOpenGL3_Ring::MaxInFlight,
+		"Ring (growth): %d grows, capacity %d", ring.GrowCount, (int)ring.Capacity );
+	BenchCheck( ring.StallCount == ImGui_ImplOpenGL3_Ring::MaxInFlight, "Ring (growth): growing must wait for each frame in flight (%d stalls)", ring.StallCount );
+	for ( int frame = 0; frame < 20; frame++ )
+	{
+		gpu.Submit( ring, big, (unsigned char)frame );
+		gpu.Advance( gpu.FenceCount - 2 );
+	}
+	BenchCheck( ring.GrowCount == 2 && ring.StallCount == ImGui_ImplOpenGL3_Ring::MaxInFlight, "Ring (growth): frames of the new size must fit without stalls (%d grows, %d stalls)",
+		ring.GrowCount, ring.StallCount );
+
+	// Storage creation failing: Alloc() reports it, and works again once the storage can be created
+	ring.Destroy();
+	gpu.FailCreate = true;
+	BenchCheck( ring.Alloc( 1024 ) == ImGui_ImplOpenGL3_Ring::NoSpace && ring.MappedData == nullptr, "Ring: Alloc() must fail when the storage can't be created" );
+	gpu.FailCreate = false;
+	BenchCheck( gpu.Submit( ring, 1024, 1 ), "Ring: Alloc() must recover once the storage can be created" );
+	ring.Destroy();
+	gpu.Check( "growth" );
+}
+
+static void CheckRandom()
+{
+	// Random sizes up to just below the growth threshold, so the ring runs nearly full, with an occasional
+	// larger frame that makes it grow (up to 16 MB). The GPU lags a random number of frames behind.
+	std::mt19937 random( 7 );
+	FakeRingGpu gpu;
+	ImGui_ImplOpenGL3_Ring ring;
+	ring.Init( gpu.GetFuncs() );
+	const int frames = 5000;
+	for ( int frame = 0; frame < frames; frame++ )
+	{
+		const size_t capacity = ring.Capacity ? ring.Capacity : ImGui_ImplOpenGL3_Ring::InitialCapacity;
+		const size_t limit = capacity / ImGui_ImplOpenGL3_Ring::MaxInFlight - 2 * ImGui_ImplOpenGL3_Ring::Alignment;
+		size_t size = 1 + random() % limit;
+		if ( capacity < 16 * 1024 * 1024 && random() % 500 == 0 )
+			size = limit + random() % limit;
+		gpu.Submit( ring, size, (unsigned char)( frame + 1 ) );
+		if ( random() % 4 != 0 )
+			gpu.Advance( gpu.FenceCount - (int)( random() % 4 ) );
+	}
+	ring.Destroy();
+	gpu.Check( "random" );
+	printf( "  random: %d frames, %d wraps, %d stalls, %d grows, final capacity %d KB\n", frames, ring.WrapCount, ring.StallCount, ring.GrowCount, (int)( ring.Capacity / 1024 ) );
+}
+
+void BenchUploadRing()
+{
+	CheckWraparound();
+	CheckUnsignaledFences();
+	CheckGrowth();
+	CheckRandom();
+
+	// Bookkeeping cost per frame, GPU two frames behind, no copies
+	FakeRingGpu gpu;
+	ImGui_ImplOpenGL3_Ring ring;
+	ring.Init( gpu.GetFuncs() );
+	const int frames = 1000000;
+	double ms = BenchBestOf( 3, [&]() {
+		size_t sum = 0;
+		for ( int frame = 0; frame < frames; frame++ )
+		{
+			sum += ring.Alloc( 256 * 1024 );
+			ring.Submit();
+			gpu.Completed = gpu.FenceCount - 2;
+		}
+		BenchKeep( sum );
+	} );
+	ring.Destroy();
+	printf( "  Alloc + Submit %5.1f ns per frame (fake fences)\n", ms * 1e6 / frames );
+}
@@ -0,0 +1,272 @@
+#include "Bench.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// The UTF-8 decoding helpers as they were before the ASCII/SIMD fast paths,
+// kept verbatim (renamed) as the reference the current ones must match on
+// every input: decoded characters, bytes consumed and 'in_text_remaining',
+// with an explicit end as well as with a NULL end (NUL-terminated input).
+namespace Reference
+{
+static int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end)
+{
+    static const char lengths[32] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 3, 3, 4, 0 };
+    static const int masks[]  = { 0x00, 0x7f, 0x1f, 0x0f, 0x07 };
+    static const uint32_t mins[] = { 0x400000, 0, 0x80, 0x800, 0x10000 };
+    static const int shiftc[] = { 0, 18, 12, 6, 0 };
+    static const int shifte[] = { 0, 6, 4, 2, 0 };
+    int len = lengths[*(const unsigned char*)in_text >> 3];
+    int wanted = len + !len;
+
+    if (in_text_end == NULL)
+        in_text_end = in_text + wanted; // Max length, nulls will be taken into account.
+
+    // Copy at most 'len' bytes, stop copying at 0 or past in_text_end. Branch predictor does a good job here,
+    // so it is fast even with excessive branching.
+    unsigned char s[4];
+    s[0] = in_text + 0 < in_text_end ? in_text[0] : 0;
+    s[1] = in_text + 1 < in_text_end ? in_text[1] : 0;
+    s[2] = in_text + 2 < in_text_end ? in_text[2] : 0;
+    s[3] = in_text + 3 < in_text_end ? in_text[3] : 0;
+
+    // Assume a four-byte character and load four bytes. Unused bits are shifted out.
+    *out_char  = (uint32_t)(s[0] & masks[len]) << 18;
+    *out_char |= (uint32_t)(s[1] & 0x3f) << 12;
+    *out_char |= (uint32_t)(s[2] & 0x3f) <<  6;
+    *out_char |= (uint32_t)(s[3] & 0x3f) <<  0;
+    *out_char >>= shiftc[len];
+
+    // Accumulate the various error conditions.
+    int e = 0;
+    e  = (*out_char < mins[len]) << 6; // non-canonical encoding
+    e |= ((*out_char >> 11) == 0x1b) << 7;  // surrogate half?
+    e |= (*out_char > IM_UNICODE_CODEPOINT_MAX) << 8;  // out of range?
+    e |= (s[1] & 0xc0) >> 2;
+    e |= (s[2] & 0xc0) >> 4;
+    e |= (s[3]       ) >> 6;
+    e ^= 0x2a; // top two bits of each tail byte correct?
+    e >>= shifte[len];
+
+    if (e)
+    {
+        // No bytes are consumed when *in_text == 0 || in_text == in_text_end.
+        // One byte is consumed in case of invalid first byte of in_text.
+        // All available bytes (at most `len` bytes) are consumed on incomplete/invalid second to last bytes.
+        // Invalid or incomplete input may consume less bytes than wanted, therefore every byte has to be inspected in s.
+        wanted = ImMin(wanted, !!s[0] + !!s[1] + !!s[2] + !!s[3]);
+        *out_char = IM_UNICODE_CODEPOINT_INVALID;
+    }
+
+    return wanted;
+}
+
+static int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
+{
+    ImWchar* buf_out = buf;
+    ImWchar* buf_end = buf + buf_size;
+    while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        if (c == 0)
+            break;
+        *buf_out++ = (ImWchar)c;
+    }
+    *buf_out = 0;
+    if (in_text_remaining)
+        *in_text_remaining = in_text;
+    return (int)(buf_out - buf);
+}
+
+static int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
+{
+    int char_count = 0;
+    while ((!in_text_end || in_text < in_text_end) && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        if (c == 0)
+            break;
+        char_count++;
+    }
+    return char_count;
+}
+} // namespace Reference
+
+// Random bytes biased towards UTF-8 lead and continuation bytes, NULs and surrogate leads (0xED)
+static unsigned char RandomByte( std::mt19937& random )
+{
+	switch ( random() % 8 )
+	{
+	case 0:  return (unsigned char)( random() % 0x80 );
+	case 1:  return (unsigned char)( 0x80 + random() % 0x40 );
+	case 2:  return (unsigned char)( 0xC0 + random() % 0x20 );
+	case 3:  return (unsigned char)( 0xE0 + random() % 0x10 );
+	case 4:  return (unsigned char)( 0xF0 + random() % 0x10 );
+	case 5:  return 0;
+	case 6:  return 0xED;
+	default: return (unsigned char)( random() % 256 );
+	}
+}
+
+// Every first and second byte, with a choice of third bytes, and every amount of available input
+static void CheckCharFromUtf8Exhaustive()
+{
+	const unsigned int thirdBytes[] = { 0x00, 0x41, 0x80, 0x9F, 0xA0, 0xBF, 0xC0, 0xFF };
+	int failures = 0;
+
+	for ( unsigned int a = 0; a < 256; a++ )
+		for ( unsigned int b = 0; b < 256; b++ )
+			for ( unsigned int c : thirdBytes )
+				for ( int available = 0; available <= 4; available++ )
+				{
+					const char text[8] = { (char)a, (char)b, (char)c, (char)0x80, 0, 0, 0, 0 };
+					const char* end = available == 4 ? NULL : text + available;
+					unsigned int expected = 0xDEAD, actual = 0xDEAD;
+					int expectedLength = Reference::ImTextCharFromUtf8( &expected, text, end );
+					int actualLength = ImTextCharFromUtf8( &actual, text, end );
+					if ( expectedLength != actualLength || expected != actual )
+						failures++;
+				}
+
+	BenchCheck( failures == 0, "ImTextCharFromUtf8: %d mismatches over all two-byte prefixes", failures );
+}
+
+static void CheckStrFromUtf8Fuzz()
+{
+	std::mt19937 random( 14 );
+	std::vector<ImWchar> expected( 256 ), actual( 256 );
+	int strFailures = 0, countFailures = 0, charFailures = 0;
+
+	for ( int iteration = 0; iteration < 300000; iteration++ )
+	{
+		// Random bytes with runs of ASCII letters, so the fast paths get entered and left at every alignment
+		std::string text;
+		int length = (int)( random() % 100 );
+		for ( int i = 0; i < length; i++ )
+		{
+			if ( random() % 4 == 0 )
+				text.append( random() % 20, (char)( 'a' + random() % 26 ) );
+			else
+				text += (char)RandomByte( random );
+		}
+
+		// Decoding errors may read (and consume) up to 3 bytes past the terminator, as they always did
+		text.append( 8, '\0' );
+		text.resize( text.size() - 8 );
+
+		// NULL end: stops at the first NUL like strlen. Otherwise end at, or a little before, the end of the string.
+		const char* begin = text.c_str();
+		const char* end = NULL;
+		if ( random() % 3 != 0 )
+			end = begin + text.size() - std::min<size_t>( random() % 3, text.size() );
+
+		const int bufferSize = 1 + (int)( random() % 150 );
+		std::fill( expected.begin(), expected.end(), (ImWchar)0x5555 );
+		std::fill( actual.begin(), actual.end(), (ImWchar)0x5555 );
+		const char* expectedRemaining = NULL;
+		const char* actualRemaining = NULL;
+		int expectedCount = Reference::ImTextStrFromUtf8( expected.data(), bufferSize, begin, end, &expectedRemaining );
+		int actualCount = ImTextStrFromUtf8( actual.data(), bufferSize, begin, end, &actualRemaining );
+		if ( expectedCount != actualCount || expectedRemaining != actualRemaining || expected != actual )
+			strFailures++;
+
+		if ( Reference::ImTextCountCharsFromUtf8( begin, end ) != ImTextCountCharsFromUtf8( begin, end ) )
+			countFailures++;
+
+		// Character by character, the way text rendering walks a string
+		for ( const char* s = begin; end ? s < end : *s != 0; )
+		{
+			unsigned int expectedChar = 0, actualChar = 0;
+			int expectedLength = Reference::ImTextCharFromUtf8( &expectedChar, s, end );
+			int actualLength = ImTextCharFromUtf8( &actualChar, s, end );
+			if ( expectedLength != actualLength || expectedChar != actualChar )
+			{
+				charFailures++;
+				break;
+			}
+			if ( expectedLength == 0 )
+				break;
+			s += expectedLength;
+		}
+	}
+
+	BenchCheck( strFailures == 0, "ImTextStrFromUtf8: %d of 300000 random strings differ", strFailures );
+	BenchCheck( countFailures == 0, "ImTextCountCharsFromUtf8: %d of 300000 random strings differ", countFailures );
+	BenchCheck( charFailures == 0, "ImTextCharFromUtf8: %d of 300000 random strings differ", charFailures );
+}
+
+static void AppendCodepoints( std::string& text, std::initializer_list<unsigned int> codepoints )
+{
+	for ( unsigned int c : codepoints )
+	{
+		char utf8[5];
+		ImTextCharToUtf8( utf8, c );
+		text += utf8;
+	}
+}
+
+static std::string MakeCorpus( int kind, size_t targetBytes )
+{
+	std::string text;
+	while ( text.size() < targetBytes )
+	{
+		switch ( kind )
+		{
+		case 0:
+			text += "[12:34:56.789] INFO  renderer: frame 12345 took 16.6 ms, 1234 draw calls\n";
+			break;
+		case 1:
+			AppendCodepoints( text, { 0x41F, 0x440, 0x438, 0x432, 0x435, 0x442, 0x20, 0x43C, 0x438, 0x440, 0x20 } );
+			text += "ok 42\n";
+			break;
+		case 2:
+			AppendCodepoints( text, { 0x4F60, 0x597D, 0x4E16, 0x754C, 0x3002, 0x6587, 0x5B57 } );
+			text += "\n";
+			break;
+		default:
+			text += "user=";
+			AppendCodepoints( text, { 0xE9, 0x4E2D, 0x41F, 0x1F600, 0x20, 0x6587 } );
+			text += " status=200 path=/api/v1/items\n";
+			break;
+		}
+	}
+	return text;
+}
+
+static void BenchUtf8Throughput()
+{
+	const char* names[] = { "ascii", "cyrillic", "cjk", "mixed" };
+
+	for ( int kind = 0; kind < 4; kind++ )
+	{
+		const std::string text = MakeCorpus( kind, 4 * 1024 * 1024 );
+		const char* begin = text.c_str();
+		const char* end = begin + text.size();
+		std::vector<ImWchar> output( text.size() + 1 );
+
+		double strReference = BenchBestOf( 5, [&]() { BenchKeep( Reference::ImTextStrFromUtf8( output.data(), (int)output.size(), begin, NULL, NULL ) ); } );
+		double strCurrent = BenchBestOf( 5, [&]() { BenchKeep( ImTextStrFromUtf8( output.data(), (int)output.size(), begin, NULL ) ); } );
+		double countReference = BenchBestOf( 5, [&]() { BenchKeep( Reference::ImTextCountCharsFromUtf8( begin, end ) ); } );
+		double countCurrent = BenchBestOf( 5, [&]() { BenchKeep( ImTextCountCharsFromUtf8( begin, end ) ); } );
+
+		printf( "  %-9s StrFromUtf8 %6.0f -> %6.0f MB/s   CountCharsFromUtf8 %6.0f -> %6.0f MB/s\n", names[kind],
+			BenchMegabytesPerSecond( text.size(), strReference ), BenchMegabytesPerSecond( text.size(), strCurrent ),
+			BenchMegabytesPerSecond( text.size(), countReference ), BenchMegabytesPerSecond( text.size(), countCurrent ) );
+	}
+}
+
+void BenchUtf8()
+{
+	CheckCharFromUtf8Exhaustive();
+	CheckStrFromUtf8Fuzz();
+	BenchUtf8Throughput();
+}
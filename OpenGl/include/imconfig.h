@@ -49,6 +49,10 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
 
+//---- Hash IDs with CRC32C instead of CRC32. CRC32C is faster (hardware instruction on SSE 4.2 and ARMv8 CPUs) but gives different IDs:
+// .ini data written without it (docking layouts, table settings, which are stored by ID) is lost once when you enable it.
+//#define IMGUI_USE_CRC32C_HASH
+
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
@@ -30,9 +30,9 @@ Index of this file:
 // [SECTION] Helpers: Memory allocations macros, ImVector<>
 // [SECTION] ImGuiStyle
 // [SECTION] ImGuiIO
-// [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiWindowClass, ImGuiPayload, ImGuiTableSortSpecs, ImGuiTableColumnSortSpecs)
-// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
-// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiWindowClass, ImGuiPayload, ImGuiTableSortSpecs, ImGuiTableColumnSortSpecs, ImGuiDataTableColumn, ImGuiDataTable)
+// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiTextDocument, ImGuiStorage, ImGuiListClipper, ImColor)
+// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawStream, ImDrawData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
 // [SECTION] Platform Dependent Interfaces (ImGuiPlatformIO, ImGuiPlatformMonitor, ImGuiPlatformImeData)
@@ -70,6 +70,9 @@ Index of this file:
 #define IMGUI_HAS_TABLE
 #define IMGUI_HAS_VIEWPORT          // Viewport WIP branch
 #define IMGUI_HAS_DOCK              // Docking WIP branch
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define IMGUI_HAS_CONSTEXPR_HASH    // ImGuiHashedStr, IM_HASHED_STR() (C++14)
+#endif
 
 // Define attributes of all API symbols declarations (e.g. for DLL under Windows)
 // IMGUI_API is used for core imgui functions, IMGUI_IMPL_API is used for the default backends files (imgui_impl_xxx.h)
@@ -139,15 +142,22 @@ struct ImDrawData;                  // All draw command lists required to render
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
+struct ImDrawStream;                // Recorded drawing commands, tessellated into their own ImDrawList during Render(), possibly on worker threads
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
+struct ImFontGlyphRunCache;         // Layout of text recently drawn with a font (see imgui_internal.h)
+struct ImFontTextSizeCache;         // Size of text recently measured with a font (see imgui_internal.h)
+struct ImFontAtlasDynamicGlyphs;    // Glyphs of an ImFontAtlas rasterized on demand (see imgui_draw.cpp)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
+struct ImGuiDataTable;              // State of a DataTable(): cached sort orders and filters
+struct ImGuiDataTableColumn;        // One typed column of the data source of a DataTable()
+struct ImGuiHashedStr;              // Helper: string literal hashed at compile time, for PushID()/GetID() (see IM_HASHED_STR())
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
@@ -163,6 +173,7 @@ struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often handling sort specs for a single column, occasionally more)
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
+struct ImGuiTextDocument;           // Helper to hold and edit large texts with InputTextMultiline() (piece table with a line index)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
 struct ImGuiViewport;               // A Platform Window (always 1 unless multi-viewport are enabled. One per platform window to output to). In the future may represent Platform Monitor
 struct ImGuiWindowClass;            // Window class (rare/advanced uses: provide hints to the platform backend via altered viewport flags and parent/child info)
@@ -350,6 +361,7 @@ namespace ImGui
     IMGUI_API bool          IsWindowFocused(ImGuiFocusedFlags flags=0); // is current window focused? or its root/child, depending on flags. see flags for options.
     IMGUI_API bool          IsWindowHovered(ImGuiHoveredFlags flags=0); // is current window hovered (and typically: not blocked by a popup/modal)? see flags for options. NB: If you are trying to check whether your mouse should be dispatched to imgui or to your app, you should use the 'io.WantCaptureMouse' boolean for that! Please read the FAQ!
     IMGUI_API ImDrawList*   GetWindowDrawList();                        // get draw list associated to the current window, to append your own drawing primitives
+    IMGUI_API void          AddDrawStream(ImDrawStream* stream);        // queue a recorded stream to be tessellated in Render() and drawn over the current window's contents. Keep it alive and unmodified until the frame is rendered.
     IMGUI_API float         GetWindowDpiScale();                        // get DPI scale currently associated to the current window's viewport.
     IMGUI_API ImVec2        GetWindowPos();                             // get current window position in screen space (useful if you want to do your own drawing via the DrawList API)
     IMGUI_API ImVec2        GetWindowSize();                            // get current window size
@@ -479,6 +491,10 @@ namespace ImGui
     IMGUI_API ImGuiID       GetID(const char* str_id);                                      // calculate unique ID (hash of whole ID stack + given parameter). e.g. if you want to query into ImGuiStorage yourself
     IMGUI_API ImGuiID       GetID(const char* str_id_begin, const char* str_id_end);
     IMGUI_API ImGuiID       GetID(const void* ptr_id);
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+    IMGUI_API void          PushID(const ImGuiHashedStr& str_id);                           // push string hashed at compile time, e.g. PushID(IM_HASHED_STR("Toolbar")). Same ID as PushID("Toolbar"), without hashing the string every frame.
+    IMGUI_API ImGuiID       GetID(const ImGuiHashedStr& str_id);
+#endif
 
     // Widgets: Text
     IMGUI_API void          TextUnformatted(const char* text, const char* text_end = NULL); // raw text without formatting. Roughly equivalent to Text("%s", text) but: A) doesn't require null terminated string if 'text_end' is specified, B) it's faster, no memory copy is done, no buffer size limits, recommended for long chunks of text.
@@ -575,6 +591,7 @@ namespace ImGui
     // - Most of the ImGuiInputTextFlags flags are only useful for InputText() and not for InputFloatX, InputIntX, InputDouble etc.
     IMGUI_API bool          InputText(const char* label, char* buf, size_t buf_size, ImGuiInputTextFlags flags = 0, ImGuiInputTextCallback callback = NULL, void* user_data = NULL);
     IMGUI_API bool          InputTextMultiline(const char* label, char* buf, size_t buf_size, const ImVec2& size = ImVec2(0, 0), ImGuiInputTextFlags flags = 0, ImGuiInputTextCallback callback = NULL, void* user_data = NULL);
+    IMGUI_API bool          InputTextMultiline(const char* label, ImGuiTextDocument* doc, const ImVec2& size = ImVec2(0, 0), ImGuiInputTextFlags flags = 0); // For large texts: only visible lines are processed. Supports _ReadOnly, _AllowTabInput, _NoUndoRedo.
     IMGUI_API bool          InputTextWithHint(const char* label, const char* hint, char* buf, size_t buf_size, ImGuiInputTextFlags flags = 0, ImGuiInputTextCallback callback = NULL, void* user_data = NULL);
     IMGUI_API bool          InputFloat(const char* label, float* v, float step = 0.0f, float step_fast = 0.0f, const char* format = "%.3f", ImGuiInputTextFlags flags = 0);
     IMGUI_API bool          InputFloat2(const char* label, float v[2], const char* format = "%.3f", ImGuiInputTextFlags flags = 0);
@@ -771,6 +788,13 @@ namespace ImGui
     IMGUI_API void                  TableSetColumnEnabled(int column_n, bool v);// change user accessible enabled/disabled state of a column. Set to false to hide the column. User can use the context menu to change this themselves (right-click in headers, or right-click in columns body with ImGuiTableFlags_ContextMenuInBody)
     IMGUI_API void                  TableSetBgColor(ImGuiTableBgTarget target, ImU32 color, int column_n = -1);  // change the color of a cell, row, or column. See ImGuiTableBgTarget_ flags for details.
 
+    // Tables: Data-bound tables
+    // - DataTable() submits a whole table from columnar data: headers, a row of ImGuiTextFilter per column, and the visible rows only.
+    // - Sorting is done for you, on worker threads when io.ParallelForFn is set. Sorted orders are kept in 'table' and
+    //   rows appended to the data source (a larger 'rows_count') are merged into them instead of sorting again.
+    // - Call table->Invalidate() after modifying rows which were already submitted.
+    IMGUI_API bool                  DataTable(const char* str_id, ImGuiDataTable* table, const ImGuiDataTableColumn* columns, int columns_count, int rows_count, ImGuiTableFlags flags = 0, const ImVec2& outer_size = ImVec2(0.0f, 0.0f));
+
     // Legacy Columns API (prefer using Tables!)
     // - You can also use SameLine(pos_x) to mimic simplified columns.
     IMGUI_API void          Columns(int count = 1, const char* id = NULL, bool border = true);
@@ -896,6 +920,13 @@ namespace ImGui
     IMGUI_API bool          BeginChildFrame(ImGuiID id, const ImVec2& size, ImGuiWindowFlags flags = 0); // helper to create a child window / scrolling region that looks like a normal widget frame
     IMGUI_API void          EndChildFrame();                                                    // always call EndChildFrame() regardless of BeginChildFrame() return values (which indicates a collapsed/clipped window)
 
+    // Idle Frames Utilities
+    // - Applications that wait for events instead of polling (e.g. glfwWaitEventsTimeout()) can ask after Render() how long they may sleep.
+    // - Dear ImGui requests frames for its own animations, timers, active items and blinking text cursor. Call SetMaxWaitBeforeNextFrame() for yours.
+    // - Layout uses sizes measured on the previous frame: after a frame whose output changed (see ImDrawData::CalcContentHash()), render another one before waiting.
+    IMGUI_API void          SetMaxWaitBeforeNextFrame(double time);                             // request the next frame within 'time' seconds (0.0 = right away). call between NewFrame() and Render().
+    IMGUI_API double        GetEventWaitingTime();                                              // time the application may wait for input events before the next frame is needed. 0.0 = render again right away, FLT_MAX = only on input.
+
     // Text Utilities
     IMGUI_API ImVec2        CalcTextSize(const char* text, const char* text_end = NULL, bool hide_text_after_double_hash = false, float wrap_width = -1.0f);
 
@@ -965,6 +996,7 @@ namespace ImGui
     IMGUI_API void          GetAllocatorFunctions(ImGuiMemAllocFunc* p_alloc_func, ImGuiMemFreeFunc* p_free_func, void** p_user_data);
     IMGUI_API void*         MemAlloc(size_t size);
     IMGUI_API void          MemFree(void* ptr);
+    IMGUI_API void*         MemAllocFrame(size_t size);     // Scratch memory from the current context, 16-bytes aligned. Released all at once by the next NewFrame(): never pass it to MemFree().
 
     // (Optional) Platform/OS interface for multi-viewport support
     // Read comments around the ImGuiPlatformIO structure for more details.
@@ -1007,6 +1039,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_NoNavFocus             = 1 << 19,  // No focusing toward this window with gamepad/keyboard navigation (e.g. skipped by CTRL+TAB)
     ImGuiWindowFlags_UnsavedDocument        = 1 << 20,  // Display a dot next to the title. When used in a tab/docking context, tab is selected when clicking the X + closure is not assumed (will wait for user to stop submitting the tab). Otherwise closure is assumed when pressing the X, so if you keep submitting the tab may reappear at end of tab bar.
     ImGuiWindowFlags_NoDocking              = 1 << 21,  // Disable docking of this window
+    ImGuiWindowFlags_RetainDrawList         = 1 << 22,  // Keep last frame's vertices when the same draw commands are submitted again and no input touched the window. Content changing without input (e.g. a value updated by your code) is displayed one frame late. Windows with child windows are rebuilt every frame, as children may draw their border and background into the parent's list: give the flag to the child windows too. Vertices written directly with PrimReserve() aren't compared.
 
     ImGuiWindowFlags_NoNav                  = ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
     ImGuiWindowFlags_NoDecoration           = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse,
@@ -2018,6 +2051,7 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigDrawNoSimd;               // = false          // Disable the batched SSE2/NEON tessellation paths of ImDrawList (output is identical, this is for comparing performance).
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -2046,6 +2080,11 @@ struct ImGuiIO
     void*       _UnusedPadding;                                     // Unused field to keep data structure the same size.
 #endif
 
+    // Optional: Run independent jobs on worker threads. Must call job(job_data, n) once for each n in [0, count) and return once all of them have completed.
+    // (default to running them one after the other on the calling thread. Used by Render() to tessellate ImDrawStream contents)
+    void        (*ParallelForFn)(void* user_data, int count, void (*job)(void* job_data, int index), void* job_data);
+    void*       ParallelForUserData;
+
     //------------------------------------------------------------------
     // Input - Call before calling NewFrame()
     //------------------------------------------------------------------
@@ -2086,6 +2125,7 @@ struct ImGuiIO
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
     int         MetricsActiveAllocations;           // Number of active allocations, updated by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
+    int         MetricsFrameAllocations;            // Number of MemAlloc() calls during the previous frame (from one NewFrame() to the next). 0 once caches are full: e.g. text that changes every frame (as in the Metrics window) adds glyph runs to its font's cache until it holds IM_FONT_GLYPH_RUN_CACHE_SIZE runs, a few hundred frames.
     ImVec2      MouseDelta;                         // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     // Legacy: before 1.87, we required backend to fill io.KeyMap[] (imgui->native map) during initialization and io.KeysDown[] (native indices) every frame.
@@ -2261,8 +2301,53 @@ struct ImGuiTableSortSpecs
     ImGuiTableSortSpecs()       { memset(this, 0, sizeof(*this)); }
 };
 
+// One column of the data source of a DataTable(). Either 'Data' or 'Strings' points to the values, indexed by row.
+// Those pointers are read again on every call, so they may change when your storage grows.
+struct ImGuiDataTableColumn
+{
+    const char*                 Label;
+    ImGuiTableColumnFlags       Flags;              // Passed to TableSetupColumn()
+    float                       InitWidthOrWeight;
+    ImGuiDataType               DataType;           // Type of the values of 'Data'
+    const void*                 Data;
+    int                         Stride;             // Bytes between two values of 'Data'. 0: tightly packed
+    const char* const*          Strings;            // Zero-terminated strings, when not using 'Data'
+    const char*                 Format;             // printf format of the values of 'Data'. NULL: default format of the type
+
+    ImGuiDataTableColumn()      { memset(this, 0, sizeof(*this)); }
+};
+
+// Rows of an ImGuiDataTable sorted by one sort specs
+struct ImGuiDataTableOrder
+{
+    ImGuiID                     SpecsHash;
+    ImVector<int>               Rows;               // Indices of rows [0, Rows.Size) in sorted order
+    int                         LastUse;
+};
+
+// State of a DataTable(), to keep across frames
+struct IMGUI_API ImGuiDataTable
+{
+    ImVector<ImGuiDataTableOrder> Orders;           // Most recently used sort orders, so going back to a previous sort is free
+    int                         CurrentOrder;       // Index in Orders, -1 when not sorted
+    ImVector<ImGuiTextFilter*>  Filters;            // One per column
+    bool                        FilterActive;
+    ImVector<ImU8>              RowsPassFilter;     // Filter result of rows [0, RowsPassFilter.Size)
+    ImVector<int>               VisibleRows;        // Rows passing the filters, in display order. Only used with FilterActive.
+    bool                        VisibleRowsDirty;
+    int                         RowsCount;          // As of the last frame
+    int                         UseCount;
+    ImVector<int>               SortBuffer;         // Scratch buffer for merges
+
+    ImGuiDataTable()            { CurrentOrder = -1; FilterActive = VisibleRowsDirty = false; RowsCount = UseCount = 0; }
+    ~ImGuiDataTable();
+    void                        Invalidate();       // Forget sort orders and filter results. Call after modifying existing rows.
+    int                         GetVisibleRowsCount() const;
+    int                         GetVisibleRow(int n) const;     // Index in the data source of the n-th displayed row
+};
+
 //-----------------------------------------------------------------------------
-// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
+// [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiTextDocument, ImGuiStorage, ImGuiListClipper, ImColor)
 //-----------------------------------------------------------------------------
 
 // Helper: Unicode defines
@@ -2329,10 +2414,121 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Text document, for editing large texts (e.g. log files of tens of megabytes) with InputTextMultiline()
+// - The text is a piece table: a list of spans ('pieces') of either the text given to SetText() or an append-only buffer of inserted text.
+//   An edit only splits and removes pieces, so its cost doesn't depend on the size of the text, and removed text stays available for undo.
+// - Both buffers keep an index of their line breaks. Line <-> offset lookups walk the pieces and binary search that index.
+// - Offsets are in bytes of UTF-8 text. Nothing is converted to ImWchar: the widget only decodes the lines it displays or edits.
+// - Undo/redo follows imstb_textedit.h: each record replaces 'DeleteLength' bytes at 'Where' with 'InsertLength' bytes, at most
+//   STB_TEXTEDIT_UNDOSTATECOUNT records are kept, and a new edit discards those that could be redone. Records refer to pieces instead
+//   of holding a copy of the text, so large deletions can be undone too.
+struct ImGuiTextDocumentPiece
+{
+    int     Buffer;             // 0: Original, 1: Added
+    int     Offset;             // In the buffer
+    int     Length;
+    int     LineBreaks;         // Number of '\n' in the piece
+};
+
+struct ImGuiTextDocumentUndoRecord
+{
+    int     Where;
+    int     InsertLength;
+    int     DeleteLength;
+    int     PiecesOffset;       // In UndoPieces: the deleted text, followed by the inserted text
+    int     DeletedPiecesCount;
+    int     InsertedPiecesCount;
+};
+
+struct IMGUI_API ImGuiTextDocument
+{
+    ImVector<char>                          Original;           // Text given to SetText()
+    ImVector<char>                          Added;              // Inserted text, only ever appended to
+    ImVector<int>                           LineBreaks[2];      // Offsets of the '\n' of Original and Added, in increasing order
+    ImVector<ImGuiTextDocumentPiece>        Pieces;
+    int                                     Length;             // In bytes
+    int                                     LineCount;          // Number of '\n' + 1
+    ImVector<ImGuiTextDocumentUndoRecord>   UndoRecords;        // [0, UndoPoint) can be undone, [UndoPoint, Size) can be redone
+    ImVector<ImGuiTextDocumentPiece>        UndoPieces;
+    int                                     UndoPoint;
+
+    // State of the InputTextMultiline() editing the document, kept here so it survives losing focus. Offsets in bytes.
+    int                                     Cursor;
+    int                                     SelectStart, SelectEnd;
+    float                                   CursorAnim;
+    float                                   PreferredX;         // Column kept by up/down moves, -1.0f if unset
+    float                                   ContentWidth;       // Widest line displayed so far
+    bool                                    CursorFollow;
+    ImVector<char>                          Scratch;            // Copy of the visible lines when they span several pieces
+
+    ImGuiTextDocument()                     { Clear(); }
+    void                Clear()             { SetText("", NULL); }
+    void                SetText(const char* text, const char* text_end = NULL);     // Replace the whole text. Clears the undo history.
+    int                 GetLength() const   { return Length; }
+    int                 GetLineCount() const { return LineCount; }
+    int                 GetLineStart(int line) const;
+    int                 GetLineEnd(int line) const;                                 // Offset of the '\n' ending the line, or GetLength() for the last one
+    int                 GetLineFromOffset(int offset) const;
+    char                GetChar(int offset) const;
+    const char*         GetText(int offset, int length, ImVector<char>* scratch) const;    // Points into the document if the range is contiguous, else into a zero-terminated copy in 'scratch'
+    void                Replace(int offset, int delete_length, const char* text, const char* text_end = NULL, bool record_undo = true);
+    bool                CanUndo() const     { return UndoPoint > 0; }
+    bool                CanRedo() const     { return UndoPoint < UndoRecords.Size; }
+    bool                Undo();             // Also moves the cursor after the restored text
+    bool                Redo();
+    bool                HasSelection() const { return SelectStart != SelectEnd; }
+
+    // [Internal]
+    int                 SplitPiece(int offset);                                     // Make sure a piece starts at 'offset', return its index
+    void                DeletePieces(int offset, int length, ImVector<ImGuiTextDocumentPiece>* out_deleted);
+    void                InsertPieces(int offset, const ImGuiTextDocumentPiece* pieces, int pieces_count);
+};
+
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+// Helper: String literal hashed at compile time
+// - Use through IM_HASHED_STR(), which forces the evaluation at compile time: ImGui::PushID(IM_HASHED_STR("Toolbar"));
+// - Gives the same ID as the string itself (### operator included). Only combining the hash with the ID stack is left for runtime:
+//   a few CRC32 instructions when the CPU has them, otherwise a table-driven hash of the string that skips the strlen() and ### scan.
+#ifdef IMGUI_USE_CRC32C_HASH
+#define IM_HASH_CRC32_POLY      0x82F63B78u     // CRC32C (Castagnoli), reflected
+#else
+#define IM_HASH_CRC32_POLY      0xEDB88320u     // CRC32, reflected
+#endif
+#define IM_HASHED_STR(_STR)     ([]() { constexpr ImGuiHashedStr hashed_str(_STR); return hashed_str; }())
+
+struct ImGuiHashedStr
+{
+    const char*     Str;        // Whole string, for debug tools
+    const char*     StrEnd;
+    unsigned int    Len;        // Length of the hashed part (from the last ###, if any)
+    ImU32           Crc;        // CRC of the hashed part, starting from a zero register
+
+    template<size_t N>
+    constexpr ImGuiHashedStr(const char (&str)[N]) : Str(str), StrEnd(str), Len(0), Crc(0)
+    {
+        unsigned int str_len = 0;
+        while (str_len + 1 < N && str[str_len] != 0)
+            str_len++;
+        StrEnd = str + str_len;
+        unsigned int begin = 0;
+        for (unsigned int n = 0; n + 3 <= str_len; n++)
+            if (str[n] == '#' && str[n + 1] == '#' && str[n + 2] == '#')
+                begin = n;
+        Len = str_len - begin;
+        for (unsigned int n = begin; n < str_len; n++)
+        {
+            Crc ^= (unsigned char)str[n];
+            for (int bit = 0; bit < 8; bit++)
+                Crc = (Crc >> 1) ^ (IM_HASH_CRC32_POLY & (0u - (Crc & 1)));
+        }
+    }
+};
+#endif
+
 // Helper: Key->Value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
-// This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// This is optimized for efficient lookup and insertion (hash index over a contiguous buffer of pairs), so it stays cheap with 100k+ keys (e.g. open state of a large tree)
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2348,13 +2544,21 @@ struct ImGuiStorage
         ImGuiStoragePair(ImGuiID _key, float _val_f)    { key = _key; val_f = _val_f; }
         ImGuiStoragePair(ImGuiID _key, void* _val_p)    { key = _key; val_p = _val_p; }
     };
+    struct ImGuiStorageSlot
+    {
+        ImGuiID key;
+        int     index;                                  // Into Data[], -1 for an empty slot
+    };
 
-    ImVector<ImGuiStoragePair>      Data;
+    ImVector<ImGuiStoragePair>      Data;               // Pairs in insertion order (sorted by key after BuildSortByKey())
+    ImVector<ImGuiStorageSlot>      Slots;              // Open-addressing (Robin Hood, linear probing) index into Data. Size is a power of two, at most 3/4 used.
+    int                             SlotsCount;         // Number of pairs of Data indexed by Slots. Data modified directly (Data.Size != SlotsCount) gets re-indexed on next access.
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
-    // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Get***() functions find pair, never add/allocate. A query is a short probe sequence in Slots, O(1) on average.
+    // - Set***() functions find pair, insertion on demand if missing. Insertion appends to Data, it never moves existing pairs (except when Data grows).
+    // - A typical frame shouldn't need to insert any new pair.
+    ImGuiStorage()      { SlotsCount = 0; }
+    void                Clear() { Data.clear(); Slots.clear(); SlotsCount = 0; }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2376,7 +2580,7 @@ struct ImGuiStorage
     // Use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 
-    // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents to Data and then sort/index once.
     IMGUI_API void      BuildSortByKey();
 };
 
@@ -2469,7 +2673,7 @@ struct ImColor
 };
 
 //-----------------------------------------------------------------------------
-// [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawStream, ImDrawData)
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
 //-----------------------------------------------------------------------------
 
@@ -2594,6 +2798,7 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_NoSimd                  = 1 << 4,  // Tessellate with the scalar code even when batched SSE2/NEON paths are compiled in. Set when 'io.ConfigDrawNoSimd' is enabled.
 };
 
 // Draw command list
@@ -2622,9 +2827,13 @@ struct ImDrawList
     ImVector<ImVec4>        _ClipRectStack;     // [Internal]
     ImVector<ImTextureID>   _TextureIdStack;    // [Internal]
     ImVector<ImVec2>        _Path;              // [Internal] current path building
+    ImVector<ImVec2>        _TempBuffer;        // [Internal] scratch space of AddPolyline()/AddConvexPolyFilled(), per list so lists can be built concurrently
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
+    ImU32                   _ContentHash;       // [Internal] hash of this frame's primitive arguments, when _ContentHashing is set (ImGuiWindowFlags_RetainDrawList)
+    bool                    _ContentHashing;    // [Internal]
+    bool                    _ContentSkipTessellation; // [Internal] only hash primitives, don't emit vertices: the window is replaying last frame's buffers
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
     ImDrawList(const ImDrawListSharedData* shared_data) { memset(this, 0, sizeof(*this)); _Data = shared_data; }
@@ -2730,6 +2939,74 @@ struct ImDrawList
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
 };
 
+enum ImDrawStreamCmdType_
+{
+    ImDrawStreamCmdType_PushClipRect,
+    ImDrawStreamCmdType_PopClipRect,
+    ImDrawStreamCmdType_Line,
+    ImDrawStreamCmdType_Rect,
+    ImDrawStreamCmdType_RectFilled,
+    ImDrawStreamCmdType_Circle,
+    ImDrawStreamCmdType_CircleFilled,
+    ImDrawStreamCmdType_Polyline,
+    ImDrawStreamCmdType_ConvexPolyFilled,
+    ImDrawStreamCmdType_Text,
+};
+
+// A single recorded ImDrawStream command. Fields are reused according to Type.
+struct ImDrawStreamCmd
+{
+    int             Type;           // ImDrawStreamCmdType_
+    ImU32           Col;
+    ImVec2          P1, P2;         // Line: end points. Rect, ClipRect: min/max corners. Circle, Text: center/position in P1.
+    float           Thickness;      // Text: font size
+    float           Rounding;       // Circle: radius
+    int             Flags;          // ImDrawFlags. Circle: num_segments. ClipRect: intersect with current.
+    int             DataOffset;     // Polyline, ConvexPolyFilled: first point in Points[]. Text: first character in TextBuffer[].
+    int             DataCount;
+    const ImFont*   Font;
+};
+
+// Recorded drawing commands, for custom drawing heavy enough to be worth tessellating away from the main thread.
+// Primitives are stored as a compact command stream instead of being turned into vertices right away.
+// Submit the stream with ImGui::AddDrawStream(): Render() then replays every stream of a visible window into the stream's
+// own ImDrawList (spread over worker threads when io.ParallelForFn is set), and draws that list right after the window's
+// own contents, in submission order. The output never depends on how the jobs were scheduled.
+// - Recording doesn't touch the ImGui context, so streams may be filled on any thread. Hand them to AddDrawStream() from the thread owning the context once they are complete.
+// - A single stream is tessellated by a single job. Split large amounts of work into several streams.
+// - Same rules as ImDrawList regarding the 64K vertices limit of a single primitive with 16-bit indices.
+struct ImDrawStream
+{
+    ImVector<ImDrawStreamCmd>   Cmds;
+    ImVector<ImVec2>            Points;
+    ImVector<char>              TextBuffer;
+
+    // [Internal, set by ImGui::AddDrawStream()]
+    ImDrawList*                 _DrawList;      // Tessellated output, created on first submission
+    ImVec4                      _ClipRect;      // Clip rectangle of the window at the time of submission
+    ImTextureID                 _TextureId;
+    int                         _SubmitFrame;
+
+    ImDrawStream()  { memset(this, 0, sizeof(*this)); _SubmitFrame = -1; }
+    IMGUI_API ~ImDrawStream();
+    void            Clear() { Cmds.resize(0); Points.resize(0); TextBuffer.resize(0); }
+
+    IMGUI_API void  PushClipRect(const ImVec2& clip_rect_min, const ImVec2& clip_rect_max, bool intersect_with_current_clip_rect = false);
+    IMGUI_API void  PopClipRect();
+    IMGUI_API void  AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float thickness = 1.0f);
+    IMGUI_API void  AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding = 0.0f, ImDrawFlags flags = 0, float thickness = 1.0f);
+    IMGUI_API void  AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding = 0.0f, ImDrawFlags flags = 0);
+    IMGUI_API void  AddCircle(const ImVec2& center, float radius, ImU32 col, int num_segments = 0, float thickness = 1.0f);
+    IMGUI_API void  AddCircleFilled(const ImVec2& center, float radius, ImU32 col, int num_segments = 0);
+    IMGUI_API void  AddPolyline(const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags, float thickness);
+    IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col);
+    IMGUI_API void  AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL);   // Font of the draw list at the time of Render()
+    IMGUI_API void  AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end = NULL);
+
+    IMGUI_API void  Replay(ImDrawList* draw_list) const;    // Issue the recorded commands into a draw list. Only reads the stream, the font and the draw list's shared data.
+    IMGUI_API void  _CacheCircleRings(ImDrawList* draw_list) const; // [Internal] Called by Render() before Replay(), which only reads the circle ring cache of the shared data.
+};
+
 // All draw data to render a Dear ImGui frame
 // (NB: the style and the naming convention here is a little inconsistent, we currently preserve them for backward compatibility purpose,
 // as this is one of the oldest structure exposed by the library! Basically, ImDrawList == CmdList)
@@ -2750,6 +3027,7 @@ struct ImDrawData
     void Clear()    { memset(this, 0, sizeof(*this)); }     // The ImDrawList are owned by ImGuiContext!
     IMGUI_API void  DeIndexAllBuffers();                    // Helper to convert all buffers from indexed to non-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
     IMGUI_API void  ScaleClipRects(const ImVec2& fb_scale); // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than Dear ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
+    IMGUI_API ImU32 CalcContentHash() const;                // Hash of the display rectangle and of every list's commands, vertices and indices. Use to skip presenting a frame that would look the same as the previous one (as long as textures and user callbacks didn't change).
 };
 
 //-----------------------------------------------------------------------------
@@ -2831,6 +3109,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3,   // Only rasterize ASCII and a few special characters in Build(), into a fixed TexDesiredWidth (default 1024) square texture. Other glyphs of the requested ranges are rasterized when first used and evicted after GlyphsEvictDelay seconds without use. Backends need to upload GetTexDataDirtyRect() every frame. stb_truetype builder only.
+    ImFontAtlasFlags_SignedDistanceField= 1 << 4,   // Store glyphs as signed distance fields (TexSdfSpread pixels on each side of outlines), so a font added once at a large SizePixels stays sharp when drawn at any size. Requires a renderer reconstructing coverage from the font texture (see ImFontAtlasSdfCoverage() in imgui_internal.h). Implies ImFontAtlasFlags_NoBakedLines, ignores OversampleH/V and RasterizerMultiply. stb_truetype builder only.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2873,6 +3153,9 @@ struct ImFontAtlas
     IMGUI_API bool              Build();                    // Build pixels data. This is called automatically for you by the GetTexData*** functions.
     IMGUI_API void              GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 1 byte per-pixel
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
+    IMGUI_API bool              GetTexDataDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h);   // ImFontAtlasFlags_DynamicGlyphs: retrieve and clear the region of the texture modified since last call. Call after NewFrame() and upload it before rendering.
+    IMGUI_API bool              LoadBuildCache(const void* data, size_t data_size);    // Restore the output of an earlier Build() saved with SaveBuildCache(). Return false and leave the atlas untouched if it was saved from different fonts/settings.
+    IMGUI_API void              SaveBuildCache(ImVector<char>* out_data);              // Serialize the output of Build() (texture, glyphs, lookup tables, custom rects). Call after Build() and before ClearInputData().
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't built texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
@@ -2919,6 +3202,8 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
+    float                       GlyphsEvictDelay;   // = 10.0f  // ImFontAtlasFlags_DynamicGlyphs: seconds after which a glyph that wasn't used is evicted.
+    int                         TexSdfSpread;       // = 4      // ImFontAtlasFlags_SignedDistanceField: distance in pixels encoded on each side of glyph outlines. Text drawn smaller than SizePixels/TexSdfSpread loses its anti-aliasing.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
 
     // [Internal]
@@ -2939,6 +3224,7 @@ struct ImFontAtlas
     // [Internal] Font builder
     const ImFontBuilderIO*      FontBuilderIO;      // Opaque interface to a font builder (default to stb_truetype, can be changed to use FreeType by defining IMGUI_ENABLE_FREETYPE).
     unsigned int                FontBuilderFlags;   // Shared flags (for all fonts) for custom font builder. THIS IS BUILD IMPLEMENTATION DEPENDENT. Per-font override is also available in ImFontConfig.
+    ImFontAtlasDynamicGlyphs*   DynamicGlyphs;      // Created by Build() when ImFontAtlasFlags_DynamicGlyphs is set.
 
     // [Internal] Packing data
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
@@ -2975,6 +3261,8 @@ struct ImFont
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
+    ImFontGlyphRunCache*        GlyphRunCache;      // 4-8   // out //            // Layout of text drawn recently, reused by RenderText(). Created by BuildLookupTable().
+    ImFontTextSizeCache*        TextSizeCache;      // 4-8   // out //            // Size of text measured recently, reused by ImGui::CalcTextSize(). Created by BuildLookupTable().
 
     // Methods
     IMGUI_API ImFont();
@@ -3000,6 +3288,8 @@ struct ImFont
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API void              SetGlyphVisible(ImWchar c, bool visible);
     IMGUI_API bool              IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last);
+    IMGUI_API void              ClearGlyphRunCache();       // Call after changing glyph data without going through BuildLookupTable()
+    IMGUI_API void              ClearTextSizeCache();       // Call after changing advances without going through BuildLookupTable()
 };
 
 //-----------------------------------------------------------------------------
@@ -33,6 +33,17 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// (Optional) Upload all draw lists through one persistently mapped, fenced, triple-buffered ring instead of
+// re-specifying buffers per draw list. Enabled by default when the context supports it (GL 4.4 or GL_ARB_buffer_storage).
+// Return whether the ring is in use.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetPersistentUpload(bool enable);
+
+// (Optional) Route the backend's binds and enables through a shadow state cache shared with the application
+// (see imgui_impl_opengl3_state.h). RenderDrawData() then backs up and restores from the cache instead of
+// querying the driver, so every GL state change made outside the cache must be reported to it. Pass NULL to detach.
+struct ImGui_ImplOpenGL3_StateCache;
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetStateCache(ImGui_ImplOpenGL3_StateCache* cache);
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
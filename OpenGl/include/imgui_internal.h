@@ -312,11 +312,16 @@ namespace ImStb
 // - Helper: ImSpan<>, ImSpanAllocator<>
 // - Helper: ImPool<>
 // - Helper: ImChunkStream<>
+// - Helper: ImFrameArena
+// - Helper: ImSizeClassPool
 //-----------------------------------------------------------------------------
 
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImU32 seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImU32 seed = 0);
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+IMGUI_API ImGuiID       ImHashStr(const ImGuiHashedStr& str, ImU32 seed = 0);   // == ImHashStr(str.Str, 0, seed)
+#endif
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -701,6 +706,57 @@ struct ImChunkStream
 
 };
 
+// Helper: ImFrameArena
+// Linear allocator for data that only needs to live until the next NewFrame(): Alloc() bumps an offset into a single block, Reset() rewinds it.
+// Requests that don't fit get an allocation of their own, and the next Reset() regrows the block to hold everything the frame used,
+// so a steady workload is served from one block without calling MemAlloc().
+// Requests above LargeThreshold (e.g. pasting a big clipboard) always get their own allocation and don't regrow the block:
+// a one-off burst would otherwise stay pinned until the context is destroyed.
+struct IMGUI_API ImFrameArena
+{
+    enum { LargeThreshold = 32 * 1024 };
+
+    char*           Block;
+    size_t          BlockSize;
+    size_t          Used;                   // Bytes of Block handed out since the last Reset()
+    size_t          OverflowSize;           // Bytes handed out through Overflow[] since the last Reset(), for requests that didn't fit in Block
+    size_t          LargeSize;              // Bytes handed out through Overflow[] since the last Reset(), for requests above LargeThreshold
+    ImVector<void*> Overflow;               // Allocations that didn't fit in Block, and large ones
+    size_t          LastFrameSize;          // Used + OverflowSize + LargeSize at the last Reset() (for display purpose)
+
+    ImFrameArena()  { memset((void*)this, 0, sizeof(*this)); }
+    ~ImFrameArena() { Clear(); }
+    void*           Alloc(size_t size);     // 16-bytes aligned
+    void            Reset();                // Invalidate every pointer returned by Alloc()
+    void            Clear();                // Reset() and release the block
+};
+
+// Helper: ImSizeClassPool
+// Block allocator for long-lived objects which are created and destroyed over time (windows, dock nodes, tab bars, table columns).
+// Blocks of up to 16 KB come from 64 KB slabs, rounded to a power-of-two size class, and freed blocks go to a per-class free list,
+// so once the pool has grown to the peak number of objects they are recycled without calling MemAlloc(). Larger blocks are allocated individually.
+// Blocks are prefixed with a header pointing back to their pool: Free() and Delete() don't need to be told which pool owns the pointer.
+struct IMGUI_API ImSizeClassPool
+{
+    enum { ClassCount = 10, MinClassSizeLog2 = 5, SlabSize = 64 * 1024, HeaderSize = 16 };  // Classes of 32 B to 16 KB, header included
+
+    void*           FreeList[ClassCount];   // Free blocks of each class, linked through their first bytes
+    int             UsedBlocks[ClassCount];
+    int             TotalBlocks[ClassCount];
+    int             LargeBlocks;            // Blocks larger than the biggest class, allocated individually
+    ImVector<void*> Slabs;
+
+    ImSizeClassPool()   { memset((void*)this, 0, sizeof(*this)); }
+    ~ImSizeClassPool()  { Clear(); }
+    void*           Alloc(size_t size);
+    static void     Free(void* ptr);
+    void            Clear();                // Release the slabs. Every block must have been freed.
+    size_t          CalcMemoryUsage() const;
+    static int      GetClassSize(int class_idx) { return 1 << (MinClassSizeLog2 + class_idx); }
+    template<typename T>
+    static void     Delete(T* p)            { if (p) { p->~T(); Free(p); } }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawList support
 //-----------------------------------------------------------------------------
@@ -730,6 +786,24 @@ struct ImChunkStream
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: Number of unit circles kept by the circle ring cache (least recently used ones are replaced).
+#ifndef IM_DRAWLIST_CIRCLE_RING_CACHE_SIZE
+#define IM_DRAWLIST_CIRCLE_RING_CACHE_SIZE                      16
+#endif
+
+// A full circle tessellated once at the origin with a radius of 1, with the anti-aliasing fringe direction of each vertex.
+// AddCircle(), AddCircleFilled(), AddNgon() and AddNgonFilled() scale and offset it instead of tessellating again:
+// - Positions are produced by the same PathArcTo()/_PathArcToFastEx() code, so 'center + pos * radius' is bit-identical to a direct call.
+// - Fringe directions are normalized once on the unit circle, which saves the per-vertex normalization of AddConvexPolyFilled().
+//   They can differ from the ones computed on the final points by rounding errors.
+struct ImDrawListCircleRing
+{
+    int                 Key;                    // num_segments for an explicit count, -(sample step) for the automatic one. 0: unused slot.
+    int                 Count;                  // Number of vertices
+    unsigned int        LastUse;
+    ImVector<ImVec2>    Data;                   // Count positions followed by Count fringe directions
+};
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -748,8 +822,14 @@ struct IMGUI_API ImDrawListSharedData
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
 
+    // [Internal] Circle ring cache (see ImDrawListCircleRing)
+    ImDrawListCircleRing CircleRings[IM_DRAWLIST_CIRCLE_RING_CACHE_SIZE];
+    unsigned int    CircleRingsUseCount;
+    bool            CachesReadOnly;             // Set while draw lists are built by several threads: circle ring and glyph run caches are looked up but never modified
+
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
+    void ClearCircleRings();
 };
 
 struct ImDrawDataBuilder
@@ -762,6 +842,87 @@ struct ImDrawDataBuilder
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
+// ImFont: Number of text runs kept by the glyph run cache of each font, and longest text (in bytes) it stores.
+#ifndef IM_FONT_GLYPH_RUN_CACHE_SIZE
+#define IM_FONT_GLYPH_RUN_CACHE_SIZE                            512
+#endif
+#ifndef IM_FONT_GLYPH_RUN_MAX_TEXT_LENGTH
+#define IM_FONT_GLYPH_RUN_MAX_TEXT_LENGTH                       256
+#endif
+
+// A piece of text laid out by ImFont::RenderText(), as glyph quads relative to the text position.
+struct ImFontGlyphRun
+{
+    ImGuiID             Hash;                   // Of Text, Size and WrapWidth
+    float               Size;
+    float               WrapWidth;
+    ImVec4              Bounds;                 // Of the quads, relative to the text position: (min x, min y, max x, max y)
+    ImVector<char>      Text;
+    ImVector<ImVec4>    Quads;                  // For each visible glyph: (x1, y1, x2, y2) then (u1, v1, u2, v2)
+    int                 LruPrev, LruNext;       // Most recently used first, -1 at either end
+    int                 HashNext;               // Next run of the same bucket, -1 at the end
+
+    ImFontGlyphRun()    { memset(this, 0, sizeof(*this)); }
+};
+
+// Glyph run cache of an ImFont.
+// Text that RenderText() drew without clipping any glyph is stored with its layout, so drawing it again with the same size and wrap width,
+// at a position where it doesn't need clipping either, only offsets the quads: no UTF-8 decoding, glyph lookup or word wrapping.
+// Positions match a full layout up to float rounding (they are computed as 'pos + offset' instead of accumulating advances from 'pos').
+// Runs are replaced least recently used first. Fonts with colored glyphs don't use it, as the quads don't record which glyphs are colored.
+// Once IM_FONT_GLYPH_RUN_CACHE_SIZE runs are cached, a run is only replaced by text that fits its buffers, so a full cache never allocates.
+struct IMGUI_API ImFontGlyphRunCache
+{
+    ImVector<ImFontGlyphRun> Runs;
+    ImVector<int>       Buckets;                // First run of each bucket (indexed by the low bits of Hash), -1 if empty
+    int                 LruHead, LruTail;
+    bool                Disabled;
+    int                 Hits, Misses;           // Since the last Clear()
+    int                 Generation;             // Incremented by Clear(), i.e. whenever glyph data may have changed
+
+    ImFontGlyphRunCache()   { LruHead = LruTail = -1; Disabled = false; Hits = Misses = 0; Generation = 0; }
+    ~ImFontGlyphRunCache()  { Runs.clear_destruct(); }
+    void                Clear();
+    int                 Find(ImGuiID hash, float size, float wrap_width, const char* text, const char* text_end) const;    // Index in Runs, -1 if not cached
+    ImFontGlyphRun*     Add(ImGuiID hash, float size, float wrap_width, const char* text, const char* text_end, int quads_count); // When full, replaces one of the least recently used runs, NULL if none has room
+    void                Touch(int run_idx);
+    size_t              CalcMemoryUsage() const;
+    static ImGuiID      HashRun(float size, float wrap_width, const char* text, const char* text_end);
+};
+
+// ImFont: Number of entries of the text size cache of each font (power of two, entries are grouped in sets of 2), and longest text (in bytes) it stores.
+#ifndef IM_FONT_TEXT_SIZE_CACHE_SIZE
+#define IM_FONT_TEXT_SIZE_CACHE_SIZE                            2048
+#endif
+#ifndef IM_FONT_TEXT_SIZE_MAX_TEXT_LENGTH
+#define IM_FONT_TEXT_SIZE_MAX_TEXT_LENGTH                       1024
+#endif
+
+struct ImFontTextSize
+{
+    ImGuiID             Hash;                   // Of the text. As with IDs, texts of equal hash and length are assumed to be equal
+    int                 Length;                 // 0 if unused
+    float               Size;
+    float               WrapWidth;
+    ImVec2              TextSize;               // As returned by CalcTextSizeA(), not rounded
+    ImU32               LastUse;
+};
+
+// Text size cache of an ImFont, used by ImGui::CalcTextSize().
+// Widgets measure the same labels several times per frame (layout, clipped rendering, table column auto-fit) and again on every frame.
+// Only touched by ImGui code running on the main thread: ImFont::CalcTextSizeA() itself doesn't use it.
+struct IMGUI_API ImFontTextSizeCache
+{
+    ImFontTextSize      Entries[IM_FONT_TEXT_SIZE_CACHE_SIZE];
+    ImU32               UseCount;
+    int                 Hits, Misses;           // Since the last Clear()
+
+    ImFontTextSizeCache()   { Clear(); }
+    void                Clear()                 { memset(this, 0, sizeof(*this)); }
+    const ImVec2*       Find(ImGuiID hash, int length, float size, float wrap_width);  // NULL if not cached
+    void                Add(ImGuiID hash, int length, float size, float wrap_width, const ImVec2& text_size); // Replaces the least recently used entry of the set
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Widgets support: flags, enums, data structures
 //-----------------------------------------------------------------------------
@@ -1794,6 +1955,17 @@ struct ImGuiContext
     bool                    TestEngineHookItems;                // Will call test engine hooks: ImGuiTestEngineHook_ItemAdd(), ImGuiTestEngineHook_ItemInfo(), ImGuiTestEngineHook_Log()
     void*                   TestEngine;                         // Test engine user data
 
+    // Memory (declared before anything allocated from them, so they are destructed last)
+    ImFrameArena            FrameArena;                         // Transient allocations: MemAllocFrame(). Reset by NewFrame().
+    ImSizeClassPool         ObjectPool;                         // Long-lived objects: windows, dock nodes and their tab bars, table columns.
+    int                     FrameMemAllocCount;                 // MemAlloc()/MemFree() calls since the last NewFrame()
+    int                     FrameMemFreeCount;
+    const void*             OwnerThreadTag;                     // Thread that created the context or last called NewFrame()
+    volatile int            ThreadMemAllocCount;                // MemAlloc()/MemFree() calls from other threads, counted atomically. Added to the counters above by NewFrame() and Render().
+    volatile int            ThreadMemFreeCount;
+    float                   FrameMemAllocHistory[120];          // MemAlloc() calls of the last 120 frames (for the Metrics window)
+    int                     FrameMemAllocHistoryIdx;
+
     // Windows state
     ImVector<ImGuiWindow*>  Windows;                            // Windows, sorted in display order, back to front
     ImVector<ImGuiWindow*>  WindowsFocusOrder;                  // Root windows, sorted in focus order, back to front.
@@ -1933,6 +2105,8 @@ struct ImGuiContext
     // Render
     float                   DimBgRatio;                         // 0.0..1.0 animation when fading in a dimming background (for modal window and CTRL+TAB list)
     ImGuiMouseCursor        MouseCursor;
+    ImVector<ImDrawStream*> DrawStreamsToTessellate;            // Streams of the visible windows, gathered by Render()
+    bool                    ParallelJobsRunning;                // Set while jobs run through IO.ParallelForFn: the context must not be modified, and MemAllocFrame() is not available.
 
     // Drag and Drop
     bool                    DragDropActive;
@@ -2052,6 +2226,7 @@ struct ImGuiContext
     int                     WantCaptureMouseNextFrame;          // Explicit capture override via SetNextFrameWantCaptureMouse()/SetNextFrameWantCaptureKeyboard(). Default to -1.
     int                     WantCaptureKeyboardNextFrame;       // "
     int                     WantTextInputNextFrame;
+    double                  MaxWaitBeforeNextFrame;             // Returned by GetEventWaitingTime(). Reset to FLT_MAX by NewFrame(), lowered by SetMaxWaitBeforeNextFrame() during the frame and by EndFrame().
     ImVector<char>          TempBuffer;                         // Temporary text buffer
 
     ImGuiContext(ImFontAtlas* shared_font_atlas)
@@ -2070,6 +2245,12 @@ struct ImGuiContext
         TestEngineHookItems = false;
         TestEngine = NULL;
 
+        FrameMemAllocCount = FrameMemFreeCount = 0;
+        OwnerThreadTag = NULL;
+        ThreadMemAllocCount = ThreadMemFreeCount = 0;
+        memset(FrameMemAllocHistory, 0, sizeof(FrameMemAllocHistory));
+        FrameMemAllocHistoryIdx = 0;
+
         WindowsActiveCount = 0;
         CurrentWindow = NULL;
         HoveredWindow = NULL;
@@ -2151,6 +2332,7 @@ struct ImGuiContext
 
         DimBgRatio = 0.0f;
         MouseCursor = ImGuiMouseCursor_Arrow;
+        ParallelJobsRunning = false;
 
         DragDropActive = DragDropWithinSource = DragDropWithinTarget = false;
         DragDropSourceFlags = ImGuiDragDropFlags_None;
@@ -2216,6 +2398,7 @@ struct ImGuiContext
         FramerateSecPerFrameIdx = FramerateSecPerFrameCount = 0;
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
+        MaxWaitBeforeNextFrame = 0.0;
     }
 };
 
@@ -2365,6 +2548,12 @@ struct IMGUI_API ImGuiWindow
 
     ImDrawList*             DrawList;                           // == &DrawListInst (for backward compatibility reason with code using imgui_internal.h we keep this a pointer)
     ImDrawList              DrawListInst;
+    ImVector<ImDrawStream*> DrawStreams;                        // Submitted with AddDrawStream() this frame, drawn after DrawList
+    ImDrawList              DrawListRetainScratch;              // ImGuiWindowFlags_RetainDrawList: DrawList points here on frames reusing DrawListInst, so drawing is only hashed
+    ImU32                   RetainedHash;                       // ImGuiWindowFlags_RetainDrawList: content hash of what DrawListInst holds
+    bool                    RetainedHashStable;                 // Last frame hashed the same as DrawListInst, so this frame is expected to as well
+    int                     RetainedTouchedFrame;               // Last frame input may have changed the window's content
+    int                     RetainedReusedCount, RetainedRebuiltCount, RetainedLateCount; // Frames reusing DrawListInst / rebuilding it / reusing it although the content had changed (displayed one frame late)
     ImGuiWindow*            ParentWindow;                       // If we are a child _or_ popup _or_ docked window, this is pointing to our parent. Otherwise NULL.
     ImGuiWindow*            ParentWindowInBeginStack;
     ImGuiWindow*            RootWindow;                         // Point to ourself or first ancestor that is not a child window. Doesn't cross through popups/dock nodes.
@@ -2401,6 +2590,9 @@ public:
     ImGuiID     GetID(const char* str, const char* str_end = NULL);
     ImGuiID     GetID(const void* ptr);
     ImGuiID     GetID(int n);
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+    ImGuiID     GetID(const ImGuiHashedStr& str);
+#endif
     ImGuiID     GetIDFromRectangle(const ImRect& r_abs);
 
     // We don't use g.FontSize because the window may be != g.CurrentWindow.
@@ -2699,7 +2891,7 @@ struct IMGUI_API ImGuiTable
     bool                        HostSkipItems;              // Backup of InnerWindow->SkipItem at the end of BeginTable(), because we will overwrite InnerWindow->SkipItem on a per-column basis
 
     ImGuiTable()                { memset(this, 0, sizeof(*this)); LastFrameActive = -1; }
-    ~ImGuiTable()               { IM_FREE(RawData); }
+    ~ImGuiTable()               { ImSizeClassPool::Free(RawData); }
 };
 
 // Transient data that are only needed between BeginTable() and EndTable(), those buffers are shared (1 per level of stacked table).
@@ -3259,6 +3451,10 @@ struct ImFontBuilderIO
     bool    (*FontBuilder_Build)(ImFontAtlas* atlas);
 };
 
+// Glyphs of an atlas built with ImFontAtlasFlags_SignedDistanceField hold IM_FONT_SDF_ON_EDGE on outlines, higher values inside.
+// The value changes by IM_FONT_SDF_ON_EDGE/TexSdfSpread per pixel at the font's SizePixels. ImFontAtlasSdfCoverage() is how renderers turn it back into coverage.
+#define IM_FONT_SDF_ON_EDGE     128
+
 // Helper for font builder
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 IMGUI_API const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype();
@@ -3267,6 +3463,9 @@ IMGUI_API void      ImFontAtlasBuildInit(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent);
 IMGUI_API void      ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque);
 IMGUI_API void      ImFontAtlasBuildFinish(ImFontAtlas* atlas);
+IMGUI_API void      ImFontAtlasUpdateDynamicGlyphs(ImFontAtlas* atlas, double time);
+IMGUI_API bool      ImFontAtlasHasPendingDynamicGlyphs(const ImFontAtlas* atlas);
+IMGUI_API float     ImFontAtlasSdfCoverage(float texel, float texel_per_pixel);
 IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned char in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
@@ -2,12 +2,22 @@
 #version 330 core
 
 layout( location = 0 ) in vec4 position;
+layout( location = 1 ) in mat4 i_Model;
+layout( location = 5 ) in vec4 i_Color;
 
-uniform mat4 u_MVP;
+layout( std140 ) uniform FrameData
+{
+	mat4 u_ViewProj;
+};
+
+uniform mat4 u_Model;
+
+out vec4 v_Color;
 
 void main()
 {
-	gl_Position = u_MVP * position;
+	gl_Position = u_ViewProj * u_Model * i_Model * position;
+	v_Color = i_Color;
 };
 
 #shader fragment
@@ -15,9 +25,9 @@ void main()
 
 layout( location = 0 ) out vec4 fragcolor;
 
-uniform vec4 u_Color;
+in vec4 v_Color;
 
 void main()
 {
-	fragcolor = u_Color;
+	fragcolor = v_Color;
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "AppOptions.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+static void PrintUsage( const char* program )
+{
+	std::cout << "Usage: " << program << " [options]\n"
+		<< "  --headless            render offscreen in a hidden window and exit after --frames\n"
+		<< "  --frames <n>          number of frames to render in headless mode (default 300)\n"
+		<< "  --duration <s>        run headless mode for <s> seconds instead of --frames\n"
+		<< "  --timings <file>      write per-frame timings as CSV\n"
+		<< "  --capture <dir>       write PNG captures into <dir>\n"
+		<< "  --capture-every <n>   capture every n-th frame (default: last frame only)\n"
+		<< "  --size <w> <h>        framebuffer size (default 1280 1280)\n"
+		<< "  --state-cache         filter redundant GL state changes (can also be toggled in the UI)\n"
+		<< "  --event-driven        wait for input instead of rendering continuously (can also be toggled in the UI)\n"
+		<< "  --min-refresh <hz>    with --event-driven, wake up at least this often (default 1)\n";
+}
+
+static bool ReadInt( int argc, char** argv, int& i, int& value )
+{
+	if ( i + 1 >= argc )
+		return false;
+
+	char* end = nullptr;
+	long parsed = strtol( argv[++i], &end, 10 );
+	if ( *end != '\0' || parsed < 0 )
+		return false;
+
+	value = (int)parsed;
+	return true;
+}
+
+bool ParseAppOptions( int argc, char** argv, AppOptions& options )
+{
+	for ( int i = 1; i < argc; i++ )
+	{
+		const char* arg = argv[i];
+		bool ok = true;
+
+		if ( strcmp( arg, "--headless" ) == 0 )
+			options.Headless = true;
+		else if ( strcmp( arg, "--frames" ) == 0 )
+			ok = ReadInt( argc, argv, i, options.Frames );
+		else if ( strcmp( arg, "--duration" ) == 0 )
+			ok = ReadInt( argc, argv, i, options.Duration );
+		else if ( strcmp( arg, "--timings" ) == 0 && i + 1 < argc )
+			options.TimingsFile = argv[++i];
+		else if ( strcmp( arg, "--capture" ) == 0 && i + 1 < argc )
+			options.CaptureDirectory = argv[++i];
+		else if ( strcmp( arg, "--capture-every" ) == 0 )
+			ok = ReadInt( argc, argv, i, options.CaptureEvery );
+		else if ( strcmp( arg, "--size" ) == 0 )
+			ok = ReadInt( argc, argv, i, options.Width ) && ReadInt( argc, argv, i, options.Height )
+				&& options.Width > 0 && options.Height > 0;
+		else if ( strcmp( arg, "--state-cache" ) == 0 )
+			options.StateCache = true;
+		else if ( strcmp( arg, "--event-driven" ) == 0 )
+			options.EventDriven = true;
+		else if ( strcmp( arg, "--min-refresh" ) == 0 )
+			ok = ReadInt( argc, argv, i, options.MinRefreshRate ) && options.MinRefreshRate > 0;
+		else
+			ok = false;
+
+		if ( !ok )
+		{
+			std::cout << "Invalid argument: " << arg << std::endl;
+			PrintUsage( argv[0] );
+			return false;
+		}
+	}
+
+	return true;
+}
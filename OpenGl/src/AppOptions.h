@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+struct AppOptions
+{
+	// Render into an offscreen framebuffer of a hidden window, run a fixed
+	// number of frames, then report per-frame timings and exit.
+	bool Headless = false;
+	int Frames = 300;
+	int Duration = 0; // seconds; when set, replaces Frames as the end of the run
+
+	// Empty disables the respective output.
+	std::string TimingsFile;
+	std::string CaptureDirectory;
+	int CaptureEvery = 0; // 0 only captures the last frame
+
+	int Width = 1280;
+	int Height = 1280;
+
+	// Filter redundant GL binds through the shared state cache from the start.
+	bool StateCache = false;
+
+	// Sleep until input arrives or ImGui needs a frame, instead of rendering
+	// continuously, and don't draw frames that would look like the one on
+	// screen. The loop still wakes up MinRefreshRate times per second to pick
+	// up data that changes without any input.
+	bool EventDriven = false;
+	int MinRefreshRate = 1;
+};
+
+// Returns false (after printing usage) on an unknown or malformed argument.
+bool ParseAppOptions( int argc, char** argv, AppOptions& options );
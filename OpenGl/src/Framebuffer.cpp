@@ -0,0 +1,59 @@
+#include "Framebuffer.h"
+
+#include "GLState.h"
+
+#include <GL/glew.h>
+
+Framebuffer::Framebuffer( int width, int height )
+	: m_Width( width ), m_Height( height )
+{
+	glGenFramebuffers( 1, &m_RendererID );
+	glBindFramebuffer( GL_FRAMEBUFFER, m_RendererID );
+
+	glGenTextures( 1, &m_ColorAttachment );
+	GetGLState().BindTexture( GL_TEXTURE_2D, m_ColorAttachment );
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+	glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorAttachment, 0 );
+	GetGLState().BindTexture( GL_TEXTURE_2D, 0 );
+
+	glGenRenderbuffers( 1, &m_DepthAttachment );
+	glBindRenderbuffer( GL_RENDERBUFFER, m_DepthAttachment );
+	glRenderbufferStorage( GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height );
+	glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_DepthAttachment );
+	glBindRenderbuffer( GL_RENDERBUFFER, 0 );
+
+	m_Complete = glCheckFramebufferStatus( GL_FRAMEBUFFER ) == GL_FRAMEBUFFER_COMPLETE;
+
+	glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+}
+
+Framebuffer::~Framebuffer()
+{
+	glDeleteRenderbuffers( 1, &m_DepthAttachment );
+	GetGLState().OnTextureDeleted( m_ColorAttachment );
+	glDeleteTextures( 1, &m_ColorAttachment );
+	glDeleteFramebuffers( 1, &m_RendererID );
+}
+
+void Framebuffer::Bind() const
+{
+	glBindFramebuffer( GL_FRAMEBUFFER, m_RendererID );
+	GetGLState().Viewport( 0, 0, m_Width, m_Height );
+}
+
+void Framebuffer::Unbind() const
+{
+	glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+}
+
+void Framebuffer::ReadPixels( std::vector<unsigned char>& rgba ) const
+{
+	rgba.resize( (size_t)m_Width * m_Height * 4 );
+
+	glBindFramebuffer( GL_READ_FRAMEBUFFER, m_RendererID );
+	glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+	glReadPixels( 0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data() );
+	glBindFramebuffer( GL_READ_FRAMEBUFFER, 0 );
+}
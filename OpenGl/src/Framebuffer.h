@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+// Offscreen render target: RGBA8 color texture plus a 24-bit depth renderbuffer.
+class Framebuffer
+{
+public:
+	Framebuffer( int width, int height );
+	~Framebuffer();
+
+	Framebuffer( const Framebuffer& ) = delete;
+	Framebuffer& operator=( const Framebuffer& ) = delete;
+
+	bool IsComplete() const { return m_Complete; }
+
+	void Bind() const;
+	void Unbind() const;
+
+	// Reads the color attachment back, bottom row first (GL convention).
+	void ReadPixels( std::vector<unsigned char>& rgba ) const;
+
+	int GetWidth() const { return m_Width; }
+	int GetHeight() const { return m_Height; }
+
+private:
+	unsigned int m_RendererID = 0;
+	unsigned int m_ColorAttachment = 0;
+	unsigned int m_DepthAttachment = 0;
+	int m_Width;
+	int m_Height;
+	bool m_Complete = false;
+};
@@ -0,0 +1,50 @@
+#include "GLState.h"
+
+#include <GL/glew.h>
+#include <imgui_impl_opengl3.h>
+
+static ImGui_ImplOpenGL3_StateCache s_State;
+
+ImGui_ImplOpenGL3_StateCache& GetGLState()
+{
+	return s_State;
+}
+
+// GLEW exposes the entry points through function pointers, so the dispatch table
+// is copied from those (GL 1.x functions are plain exports and convert directly).
+void InitGLState()
+{
+	ImGui_ImplOpenGL3_StateFuncs& funcs = s_State.Funcs;
+	funcs.GetIntegerv = glGetIntegerv;
+	funcs.IsEnabled = glIsEnabled;
+	funcs.Enable = glEnable;
+	funcs.Disable = glDisable;
+	funcs.ActiveTexture = glActiveTexture;
+	funcs.BindTexture = glBindTexture;
+	funcs.BindSampler = glBindSampler;
+	funcs.UseProgram = glUseProgram;
+	funcs.BindBuffer = glBindBuffer;
+	funcs.BindVertexArray = glBindVertexArray;
+	funcs.Viewport = glViewport;
+	funcs.Scissor = glScissor;
+	funcs.BlendEquationSeparate = glBlendEquationSeparate;
+	funcs.BlendFuncSeparate = glBlendFuncSeparate;
+	funcs.PolygonMode = glPolygonMode;
+
+	s_State.FilterRedundant = false;
+	s_State.Sync();
+}
+
+void SetGLStateCacheEnabled( bool enabled )
+{
+	// Re-read the driver state: anything changed behind the cache while it was
+	// off would otherwise be filtered against a stale value.
+	s_State.FilterRedundant = enabled;
+	s_State.Sync();
+	ImGui_ImplOpenGL3_SetStateCache( enabled ? &s_State : nullptr );
+}
+
+bool IsGLStateCacheEnabled()
+{
+	return s_State.FilterRedundant;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <imgui_impl_opengl3_state.h>
+
+// Shadow copy of the GL bindings and enables shared by the renderer and the
+// ImGui backend. Binds issued through it skip the driver when the value is
+// already current, and the backend restores its state from the copy instead of
+// querying the driver every frame.
+//
+// Bindings always go through the cache, but filtering starts disabled, so the
+// cache behaves like plain GL calls until SetGLStateCacheEnabled( true ).
+
+ImGui_ImplOpenGL3_StateCache& GetGLState();
+
+// Call once with a current context, after glewInit and ImGui_ImplOpenGL3_Init.
+void InitGLState();
+
+void SetGLStateCacheEnabled( bool enabled );
+bool IsGLStateCacheEnabled();
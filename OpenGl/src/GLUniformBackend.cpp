@@ -0,0 +1,97 @@
+#include "GLUniformBackend.h"
+
+#include <GL/glew.h>
+
+static UniformType GetUniformType( GLenum type )
+{
+	switch ( type )
+	{
+	case GL_FLOAT:      return UniformType::Float;
+	case GL_FLOAT_VEC2: return UniformType::Vec2;
+	case GL_FLOAT_VEC3: return UniformType::Vec3;
+	case GL_FLOAT_VEC4: return UniformType::Vec4;
+	case GL_FLOAT_MAT3: return UniformType::Mat3;
+	case GL_FLOAT_MAT4: return UniformType::Mat4;
+	case GL_INT:
+	case GL_BOOL:
+	case GL_SAMPLER_2D:
+	case GL_SAMPLER_3D:
+	case GL_SAMPLER_CUBE:
+		return UniformType::Int;
+	default:
+		return UniformType::Other;
+	}
+}
+
+void GLUniformBackend::QueryProgram( unsigned int program, std::vector<UniformInfo>& uniforms, std::vector<UniformBlockInfo>& blocks )
+{
+	int count = 0;
+	int maxLength = 0;
+	glGetProgramiv( program, GL_ACTIVE_UNIFORMS, &count );
+	glGetProgramiv( program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength );
+
+	std::vector<char> name( maxLength + 1 );
+
+	for ( int i = 0; i < count; i++ )
+	{
+		int length = 0;
+		int size = 0;
+		GLenum type = 0;
+		glGetActiveUniform( program, i, (int)name.size(), &length, &size, &type, name.data() );
+
+		// Members of uniform blocks have no location and are set through the block's buffer
+		int location = glGetUniformLocation( program, name.data() );
+		if ( location < 0 )
+			continue;
+
+		UniformInfo info;
+		info.Name.assign( name.data(), length );
+		if ( info.Name.size() > 3 && info.Name.compare( info.Name.size() - 3, 3, "[0]" ) == 0 )
+			info.Name.resize( info.Name.size() - 3 );
+		info.Type = GetUniformType( type );
+		info.Location = location;
+		info.Count = size;
+		uniforms.push_back( info );
+	}
+
+	count = 0;
+	maxLength = 0;
+	glGetProgramiv( program, GL_ACTIVE_UNIFORM_BLOCKS, &count );
+	glGetProgramiv( program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength );
+
+	name.resize( maxLength + 1 );
+
+	for ( int i = 0; i < count; i++ )
+	{
+		int length = 0;
+		glGetActiveUniformBlockName( program, i, (int)name.size(), &length, name.data() );
+
+		UniformBlockInfo info;
+		info.Name.assign( name.data(), length );
+		info.Index = i;
+		glGetActiveUniformBlockiv( program, i, GL_UNIFORM_BLOCK_DATA_SIZE, &info.Size );
+		blocks.push_back( info );
+	}
+}
+
+void GLUniformBackend::SetUniformBlockBinding( unsigned int program, unsigned int blockIndex, unsigned int binding )
+{
+	glUniformBlockBinding( program, blockIndex, binding );
+}
+
+void GLUniformBackend::Upload( int location, UniformType type, const void* data )
+{
+	const float* f = (const float*)data;
+
+	switch ( type )
+	{
+	case UniformType::Float: glUniform1fv( location, 1, f ); break;
+	case UniformType::Vec2:  glUniform2fv( location, 1, f ); break;
+	case UniformType::Vec3:  glUniform3fv( location, 1, f ); break;
+	case UniformType::Vec4:  glUniform4fv( location, 1, f ); break;
+	case UniformType::Int:   glUniform1iv( location, 1, (const int*)data ); break;
+	case UniformType::Mat3:  glUniformMatrix3fv( location, 1, GL_FALSE, f ); break;
+	case UniformType::Mat4:  glUniformMatrix4fv( location, 1, GL_FALSE, f ); break;
+	default: break;
+	}
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "ProgramReflection.h"
+
+class GLUniformBackend : public UniformBackend
+{
+public:
+	void QueryProgram( unsigned int program, std::vector<UniformInfo>& uniforms, std::vector<UniformBlockInfo>& blocks ) override;
+	void SetUniformBlockBinding( unsigned int program, unsigned int blockIndex, unsigned int binding ) override;
+	void Upload( int location, UniformType type, const void* data ) override;
+};
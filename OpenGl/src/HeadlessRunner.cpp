@@ -0,0 +1,123 @@
+#include "HeadlessRunner.h"
+
+#include "PngWriter.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+static double MillisecondsSince( std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end )
+{
+	return std::chrono::duration<double, std::milli>( end - start ).count();
+}
+
+HeadlessRunner::HeadlessRunner( const AppOptions& options )
+	: m_Options( options ), m_Framebuffer( options.Width, options.Height ), m_RunStart( std::chrono::steady_clock::now() )
+{
+	m_Timings.reserve( options.Frames );
+
+	if ( !m_Options.CaptureDirectory.empty() )
+	{
+		std::error_code error;
+		std::filesystem::create_directories( m_Options.CaptureDirectory, error );
+	}
+}
+
+bool HeadlessRunner::IsDone() const
+{
+	if ( m_Options.Duration > 0 )
+		return std::chrono::steady_clock::now() - m_RunStart >= std::chrono::seconds( m_Options.Duration );
+	return m_Frame >= m_Options.Frames;
+}
+
+void HeadlessRunner::BeginFrame()
+{
+	m_FrameStart = std::chrono::steady_clock::now();
+	m_Framebuffer.Bind();
+}
+
+void HeadlessRunner::EndFrame()
+{
+	auto submitted = std::chrono::steady_clock::now();
+	glFinish();
+	auto finished = std::chrono::steady_clock::now();
+
+	m_Timings.push_back( { MillisecondsSince( m_FrameStart, submitted ), MillisecondsSince( submitted, finished ) } );
+
+	// Captures happen outside the timed region
+	const bool last = m_Options.Duration == 0 && m_Frame + 1 == m_Options.Frames;
+	if ( !m_Options.CaptureDirectory.empty() )
+	{
+		if ( last || ( m_Options.CaptureEvery > 0 && m_Frame % m_Options.CaptureEvery == 0 ) )
+			Capture();
+	}
+
+	m_Framebuffer.Unbind();
+	m_Frame++;
+}
+
+void HeadlessRunner::SkipFrame()
+{
+	m_Framebuffer.Unbind();
+	m_Skipped++;
+}
+
+void HeadlessRunner::Capture() const
+{
+	std::vector<unsigned char> pixels;
+	m_Framebuffer.ReadPixels( pixels );
+
+	char name[32];
+	snprintf( name, sizeof( name ), "frame_%05d.png", m_Frame );
+	std::filesystem::path path = std::filesystem::path( m_Options.CaptureDirectory ) / name;
+
+	if ( !WritePng( path.string(), m_Framebuffer.GetWidth(), m_Framebuffer.GetHeight(), pixels.data(), true ) )
+		std::cout << "Failed to write " << path.string() << std::endl;
+}
+
+void HeadlessRunner::Finish() const
+{
+	const double elapsed = MillisecondsSince( m_RunStart, std::chrono::steady_clock::now() ) / 1000.0;
+
+	if ( !m_Options.TimingsFile.empty() )
+	{
+		std::ofstream stream( m_Options.TimingsFile, std::ios::trunc );
+		stream << "frame,cpu_ms,gpu_wait_ms\n";
+		for ( size_t i = 0; i < m_Timings.size(); i++ )
+			stream << i << ',' << m_Timings[i].CpuMs << ',' << m_Timings[i].GpuWaitMs << '\n';
+
+		if ( !stream )
+			std::cout << "Failed to write " << m_Options.TimingsFile << std::endl;
+	}
+
+	if ( m_Skipped > 0 || m_Options.Duration > 0 )
+		printf( "%d loop iterations in %.2f s, %d rendered: %.2f rendered frames per second\n",
+			m_Frame + m_Skipped, elapsed, m_Frame, m_Frame / elapsed );
+
+	if ( m_Timings.empty() )
+		return;
+
+	std::vector<double> cpu;
+	double total = 0.0;
+	for ( const FrameTiming& timing : m_Timings )
+	{
+		cpu.push_back( timing.CpuMs );
+		total += timing.CpuMs + timing.GpuWaitMs;
+	}
+	std::sort( cpu.begin(), cpu.end() );
+
+	const size_t count = cpu.size();
+	double mean = 0.0;
+	for ( double value : cpu )
+		mean += value;
+	mean /= count;
+
+	printf( "Rendered %d frames on %s\n", (int)count, (const char*)glGetString( GL_RENDERER ) );
+	printf( "  cpu ms: mean %.3f, median %.3f, p95 %.3f, max %.3f\n",
+		mean, cpu[count / 2], cpu[std::min( count - 1, count * 95 / 100 )], cpu[count - 1] );
+	printf( "  frame ms incl. gpu wait: mean %.3f\n", total / count );
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "AppOptions.h"
+#include "Framebuffer.h"
+
+#include <chrono>
+#include <vector>
+
+// Drives a headless benchmark run: every frame renders into an offscreen
+// framebuffer, is timed, and optionally captured to PNG. Works with any GL
+// implementation the hidden window gets, including Mesa's llvmpipe software
+// rasterizer on machines without a GPU.
+//
+// With --event-driven, loop iterations that draw nothing end with SkipFrame()
+// instead of EndFrame(); a --duration run then reports how many frames were
+// actually rendered in that time.
+class HeadlessRunner
+{
+public:
+	explicit HeadlessRunner( const AppOptions& options );
+
+	bool IsValid() const { return m_Framebuffer.IsComplete(); }
+	bool IsDone() const;
+
+	void BeginFrame();
+	void EndFrame();
+	void SkipFrame();
+
+	// Writes the timings file (if requested) and prints a summary.
+	void Finish() const;
+
+private:
+	struct FrameTiming
+	{
+		double CpuMs;     // from BeginFrame until all commands were submitted
+		double GpuWaitMs; // glFinish after submission: rasterization not overlapped with the CPU
+	};
+
+	void Capture() const;
+
+	AppOptions m_Options;
+	Framebuffer m_Framebuffer;
+	std::vector<FrameTiming> m_Timings;
+	std::chrono::steady_clock::time_point m_RunStart;
+	std::chrono::steady_clock::time_point m_FrameStart;
+	int m_Frame = 0;
+	int m_Skipped = 0;
+};
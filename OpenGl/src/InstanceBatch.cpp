@@ -0,0 +1,61 @@
+#include "InstanceBatch.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+glm::mat4 ComputeModelMatrix( const SceneObject& object )
+{
+	glm::mat4 model = glm::translate( glm::mat4( 1.0f ), object.Position );
+
+	if ( object.Rotation.x != 0.0f )
+		model = glm::rotate( model, object.Rotation.x, glm::vec3( 1.0f, 0.0f, 0.0f ) );
+	if ( object.Rotation.y != 0.0f )
+		model = glm::rotate( model, object.Rotation.y, glm::vec3( 0.0f, 1.0f, 0.0f ) );
+	if ( object.Rotation.z != 0.0f )
+		model = glm::rotate( model, object.Rotation.z, glm::vec3( 0.0f, 0.0f, 1.0f ) );
+
+	return glm::scale( model, object.Scale );
+}
+
+bool BatchBuilder::Build( const Scene& scene )
+{
+	if ( scene.GetVersion() == m_BuiltVersion )
+		return false;
+
+	m_BuiltVersion = scene.GetVersion();
+
+	const std::vector<SceneObject>& objects = scene.GetObjects();
+	const unsigned int meshCount = (unsigned int)MeshType::Count;
+
+	// Counting sort on the mesh type: one pass to size the batches, one pass to place instances.
+	// Stable, so instances keep their scene order within a batch.
+	unsigned int counts[(int)MeshType::Count] = {};
+	for ( const SceneObject& object : objects )
+	{
+		if ( object.Visible )
+			counts[(int)object.Mesh]++;
+	}
+
+	unsigned int offsets[(int)MeshType::Count];
+	unsigned int total = 0;
+	m_Batches.clear();
+	for ( unsigned int i = 0; i < meshCount; i++ )
+	{
+		offsets[i] = total;
+		if ( counts[i] > 0 )
+			m_Batches.push_back( { (MeshType)i, total, counts[i] } );
+		total += counts[i];
+	}
+
+	m_Instances.resize( total );
+	for ( const SceneObject& object : objects )
+	{
+		if ( !object.Visible )
+			continue;
+
+		InstanceData& instance = m_Instances[offsets[(int)object.Mesh]++];
+		instance.Model = ComputeModelMatrix( object );
+		instance.Color = object.Color;
+	}
+
+	return true;
+}
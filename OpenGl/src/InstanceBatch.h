@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Mesh.h"
+#include "Scene.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Per-instance vertex data, laid out exactly as it is uploaded to the instance buffer.
+// The model matrix occupies attribute locations 1-4 and the color location 5.
+struct InstanceData
+{
+	glm::mat4 Model;
+	glm::vec4 Color;
+};
+
+static_assert( sizeof( InstanceData ) == 20 * sizeof( float ), "InstanceData must be tightly packed" );
+
+// One instanced draw: InstanceCount instances of Mesh starting at FirstInstance.
+struct DrawBatch
+{
+	MeshType Mesh;
+	unsigned int FirstInstance;
+	unsigned int InstanceCount;
+};
+
+glm::mat4 ComputeModelMatrix( const SceneObject& object );
+
+// CPU side of the instanced renderer. Packs the visible objects of a scene into one
+// contiguous instance array grouped by mesh (batches in MeshType order, scene order
+// preserved inside a batch) so each mesh is drawn with a single instanced call.
+class BatchBuilder
+{
+public:
+	// Returns false when the scene has not changed since the last build.
+	bool Build( const Scene& scene );
+
+	const std::vector<InstanceData>& GetInstances() const { return m_Instances; }
+	const std::vector<DrawBatch>& GetBatches() const { return m_Batches; }
+
+private:
+	std::vector<InstanceData> m_Instances;
+	std::vector<DrawBatch> m_Batches;
+	unsigned int m_BuiltVersion = 0;
+};
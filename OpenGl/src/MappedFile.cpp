@@ -0,0 +1,91 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile( const std::filesystem::path& path )
+{
+	HANDLE file = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+	if ( file == INVALID_HANDLE_VALUE )
+		return;
+
+	m_File = file;
+
+	LARGE_INTEGER size;
+	if ( !GetFileSizeEx( file, &size ) )
+		return;
+
+	m_Size = (size_t)size.QuadPart;
+	if ( m_Size == 0 )
+	{
+		// Zero-length files cannot be mapped, but they are still valid (empty) input
+		m_Open = true;
+		return;
+	}
+
+	m_Mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	if ( !m_Mapping )
+		return;
+
+	m_Data = (const char*)MapViewOfFile( m_Mapping, FILE_MAP_READ, 0, 0, 0 );
+	m_Open = m_Data != nullptr;
+}
+
+MappedFile::~MappedFile()
+{
+	if ( m_Data )
+		UnmapViewOfFile( m_Data );
+	if ( m_Mapping )
+		CloseHandle( m_Mapping );
+	if ( m_File )
+		CloseHandle( m_File );
+}
+
+#else
+
+MappedFile::MappedFile( const std::filesystem::path& path )
+{
+	m_File = open( path.c_str(), O_RDONLY );
+	if ( m_File < 0 )
+		return;
+
+	struct stat info;
+	if ( fstat( m_File, &info ) != 0 )
+		return;
+
+	m_Size = (size_t)info.st_size;
+	if ( m_Size == 0 )
+	{
+		// Zero-length files cannot be mapped, but they are still valid (empty) input
+		m_Open = true;
+		return;
+	}
+
+	void* data = mmap( nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0 );
+	if ( data == MAP_FAILED )
+		return;
+
+	m_Data = (const char*)data;
+	m_Open = true;
+}
+
+MappedFile::~MappedFile()
+{
+	if ( m_Data )
+		munmap( (void*)m_Data, m_Size );
+	if ( m_File >= 0 )
+		close( m_File );
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+// Read-only memory mapping of a whole file. The view stays valid for the
+// lifetime of the object; an empty file opens successfully with an empty view.
+class MappedFile
+{
+public:
+	explicit MappedFile( const std::filesystem::path& path );
+	~MappedFile();
+
+	MappedFile( const MappedFile& ) = delete;
+	MappedFile& operator=( const MappedFile& ) = delete;
+
+	bool IsOpen() const { return m_Open; }
+	std::string_view GetView() const { return m_Data ? std::string_view( m_Data, m_Size ) : std::string_view(); }
+
+private:
+	const char* m_Data = nullptr;
+	size_t m_Size = 0;
+	bool m_Open = false;
+
+#ifdef _WIN32
+	void* m_File = nullptr;
+	void* m_Mapping = nullptr;
+#else
+	int m_File = -1;
+#endif
+};
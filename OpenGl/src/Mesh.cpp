@@ -0,0 +1,144 @@
+#include "Mesh.h"
+
+#include <cmath>
+
+static const float PI = 3.14159265358979f;
+
+static const unsigned int CIRCLE_SEGMENTS = 48;
+static const unsigned int SPHERE_RINGS = 16;
+static const unsigned int SPHERE_SECTORS = 32;
+
+const char* GetMeshName( MeshType type )
+{
+	switch ( type )
+	{
+	case MeshType::Triangle: return "Triangle";
+	case MeshType::Square:   return "Square";
+	case MeshType::Circle:   return "Circle";
+	case MeshType::Pyramid:  return "Pyramid";
+	case MeshType::Cube:     return "Cube";
+	case MeshType::Sphere:   return "Sphere";
+	default:                 return "Unknown";
+	}
+}
+
+static void PushVertex( MeshData& mesh, float x, float y, float z )
+{
+	mesh.Vertices.push_back( x );
+	mesh.Vertices.push_back( y );
+	mesh.Vertices.push_back( z );
+	mesh.VertexCount++;
+}
+
+static void PushQuad( MeshData& mesh, const float* a, const float* b, const float* c, const float* d )
+{
+	PushVertex( mesh, a[0], a[1], a[2] );
+	PushVertex( mesh, b[0], b[1], b[2] );
+	PushVertex( mesh, c[0], c[1], c[2] );
+	PushVertex( mesh, c[0], c[1], c[2] );
+	PushVertex( mesh, d[0], d[1], d[2] );
+	PushVertex( mesh, a[0], a[1], a[2] );
+}
+
+static void BuildTriangle( MeshData& mesh )
+{
+	PushVertex( mesh, 0.0f, 0.5f, 0.0f );
+	PushVertex( mesh, 0.5f, -0.5f, 0.0f );
+	PushVertex( mesh, -0.5f, -0.5f, 0.0f );
+}
+
+static void BuildSquare( MeshData& mesh )
+{
+	const float a[3] = { -0.5f, -0.5f, 0.0f };
+	const float b[3] = { 0.5f, -0.5f, 0.0f };
+	const float c[3] = { 0.5f, 0.5f, 0.0f };
+	const float d[3] = { -0.5f, 0.5f, 0.0f };
+	PushQuad( mesh, a, b, c, d );
+}
+
+static void BuildCircle( MeshData& mesh )
+{
+	for ( unsigned int i = 0; i < CIRCLE_SEGMENTS; i++ )
+	{
+		float a0 = 2.0f * PI * i / CIRCLE_SEGMENTS;
+		float a1 = 2.0f * PI * ( i + 1 ) / CIRCLE_SEGMENTS;
+		PushVertex( mesh, 0.0f, 0.0f, 0.0f );
+		PushVertex( mesh, 0.5f * cosf( a0 ), 0.5f * sinf( a0 ), 0.0f );
+		PushVertex( mesh, 0.5f * cosf( a1 ), 0.5f * sinf( a1 ), 0.0f );
+	}
+}
+
+static void BuildPyramid( MeshData& mesh )
+{
+	const float apex[3] = { 0.0f, 0.5f, 0.0f };
+	const float base[4][3] = {
+		{ -0.5f, -0.5f, -0.5f },
+		{ 0.5f, -0.5f, -0.5f },
+		{ 0.5f, -0.5f, 0.5f },
+		{ -0.5f, -0.5f, 0.5f },
+	};
+
+	PushQuad( mesh, base[0], base[1], base[2], base[3] );
+	for ( int i = 0; i < 4; i++ )
+	{
+		const float* a = base[i];
+		const float* b = base[( i + 1 ) % 4];
+		PushVertex( mesh, a[0], a[1], a[2] );
+		PushVertex( mesh, b[0], b[1], b[2] );
+		PushVertex( mesh, apex[0], apex[1], apex[2] );
+	}
+}
+
+static void BuildCube( MeshData& mesh )
+{
+	const float c[8][3] = {
+		{ -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+		{ -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f },
+	};
+
+	PushQuad( mesh, c[4], c[5], c[6], c[7] ); // front
+	PushQuad( mesh, c[1], c[0], c[3], c[2] ); // back
+	PushQuad( mesh, c[0], c[4], c[7], c[3] ); // left
+	PushQuad( mesh, c[5], c[1], c[2], c[6] ); // right
+	PushQuad( mesh, c[7], c[6], c[2], c[3] ); // top
+	PushQuad( mesh, c[0], c[1], c[5], c[4] ); // bottom
+}
+
+static void BuildSphere( MeshData& mesh )
+{
+	for ( unsigned int r = 0; r < SPHERE_RINGS; r++ )
+	{
+		float phi0 = PI * r / SPHERE_RINGS;
+		float phi1 = PI * ( r + 1 ) / SPHERE_RINGS;
+
+		for ( unsigned int s = 0; s < SPHERE_SECTORS; s++ )
+		{
+			float theta0 = 2.0f * PI * s / SPHERE_SECTORS;
+			float theta1 = 2.0f * PI * ( s + 1 ) / SPHERE_SECTORS;
+
+			const float a[3] = { 0.5f * sinf( phi0 ) * cosf( theta0 ), 0.5f * cosf( phi0 ), 0.5f * sinf( phi0 ) * sinf( theta0 ) };
+			const float b[3] = { 0.5f * sinf( phi1 ) * cosf( theta0 ), 0.5f * cosf( phi1 ), 0.5f * sinf( phi1 ) * sinf( theta0 ) };
+			const float c[3] = { 0.5f * sinf( phi1 ) * cosf( theta1 ), 0.5f * cosf( phi1 ), 0.5f * sinf( phi1 ) * sinf( theta1 ) };
+			const float d[3] = { 0.5f * sinf( phi0 ) * cosf( theta1 ), 0.5f * cosf( phi0 ), 0.5f * sinf( phi0 ) * sinf( theta1 ) };
+			PushQuad( mesh, a, b, c, d );
+		}
+	}
+}
+
+MeshData GenerateMesh( MeshType type )
+{
+	MeshData mesh;
+
+	switch ( type )
+	{
+	case MeshType::Triangle: BuildTriangle( mesh ); break;
+	case MeshType::Square:   BuildSquare( mesh ); break;
+	case MeshType::Circle:   BuildCircle( mesh ); break;
+	case MeshType::Pyramid:  BuildPyramid( mesh ); break;
+	case MeshType::Cube:     BuildCube( mesh ); break;
+	case MeshType::Sphere:   BuildSphere( mesh ); break;
+	default: break;
+	}
+
+	return mesh;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+// Shapes the demo can place in the scene. Order is the draw order of batches.
+enum class MeshType
+{
+	Triangle = 0,
+	Square,
+	Circle,
+	Pyramid,
+	Cube,
+	Sphere,
+
+	Count
+};
+
+const char* GetMeshName( MeshType type );
+
+// Non-indexed triangle list, 3 floats (x, y, z) per vertex.
+// Every shape fits the unit box [-0.5, 0.5] and is scaled by its instance model matrix.
+struct MeshData
+{
+	std::vector<float> Vertices;
+	unsigned int VertexCount = 0;
+};
+
+MeshData GenerateMesh( MeshType type );
@@ -0,0 +1,114 @@
+#include "PngWriter.h"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+static uint32_t Crc32( uint32_t crc, const unsigned char* data, size_t size )
+{
+	static uint32_t table[256];
+	static bool initialized = false;
+	if ( !initialized )
+	{
+		for ( uint32_t i = 0; i < 256; i++ )
+		{
+			uint32_t c = i;
+			for ( int k = 0; k < 8; k++ )
+				c = ( c & 1 ) ? 0xEDB88320u ^ ( c >> 1 ) : c >> 1;
+			table[i] = c;
+		}
+		initialized = true;
+	}
+
+	crc = ~crc;
+	for ( size_t i = 0; i < size; i++ )
+		crc = table[( crc ^ data[i] ) & 0xFF] ^ ( crc >> 8 );
+	return ~crc;
+}
+
+static void PushU32( std::vector<unsigned char>& out, uint32_t value )
+{
+	out.push_back( (unsigned char)( value >> 24 ) );
+	out.push_back( (unsigned char)( value >> 16 ) );
+	out.push_back( (unsigned char)( value >> 8 ) );
+	out.push_back( (unsigned char)value );
+}
+
+static void WriteChunk( std::ofstream& stream, const char* type, const std::vector<unsigned char>& data )
+{
+	std::vector<unsigned char> chunk;
+	chunk.reserve( data.size() + 12 );
+	PushU32( chunk, (uint32_t)data.size() );
+	chunk.insert( chunk.end(), type, type + 4 );
+	chunk.insert( chunk.end(), data.begin(), data.end() );
+	PushU32( chunk, Crc32( 0, chunk.data() + 4, chunk.size() - 4 ) );
+
+	stream.write( (const char*)chunk.data(), chunk.size() );
+}
+
+bool WritePng( const std::string& filepath, int width, int height, const unsigned char* rgba, bool flipY )
+{
+	std::ofstream stream( filepath, std::ios::binary | std::ios::trunc );
+	if ( !stream )
+		return false;
+
+	static const unsigned char SIGNATURE[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+	stream.write( (const char*)SIGNATURE, sizeof( SIGNATURE ) );
+
+	std::vector<unsigned char> header;
+	PushU32( header, (uint32_t)width );
+	PushU32( header, (uint32_t)height );
+	header.push_back( 8 ); // bit depth
+	header.push_back( 6 ); // color type: RGBA
+	header.push_back( 0 ); // compression
+	header.push_back( 0 ); // filter
+	header.push_back( 0 ); // interlace
+	WriteChunk( stream, "IHDR", header );
+
+	// Raw scanlines: filter byte 0 (none) followed by the row
+	const size_t rowSize = (size_t)width * 4;
+	std::vector<unsigned char> raw;
+	raw.reserve( ( rowSize + 1 ) * height );
+	for ( int y = 0; y < height; y++ )
+	{
+		const unsigned char* row = rgba + rowSize * ( flipY ? height - 1 - y : y );
+		raw.push_back( 0 );
+		raw.insert( raw.end(), row, row + rowSize );
+	}
+
+	// zlib stream made of stored deflate blocks (at most 65535 bytes each)
+	std::vector<unsigned char> data;
+	data.reserve( raw.size() + raw.size() / 65535 * 5 + 16 );
+	data.push_back( 0x78 );
+	data.push_back( 0x01 );
+
+	size_t offset = 0;
+	do
+	{
+		size_t size = raw.size() - offset;
+		if ( size > 65535 )
+			size = 65535;
+		const bool last = offset + size == raw.size();
+
+		data.push_back( last ? 1 : 0 );
+		data.push_back( (unsigned char)size );
+		data.push_back( (unsigned char)( size >> 8 ) );
+		data.push_back( (unsigned char)~size );
+		data.push_back( (unsigned char)( ~size >> 8 ) );
+		data.insert( data.end(), raw.begin() + offset, raw.begin() + offset + size );
+		offset += size;
+	} while ( offset < raw.size() );
+
+	uint32_t a = 1, b = 0;
+	for ( unsigned char c : raw )
+	{
+		a = ( a + c ) % 65521;
+		b = ( b + a ) % 65521;
+	}
+	PushU32( data, ( b << 16 ) | a );
+
+	WriteChunk( stream, "IDAT", data );
+	WriteChunk( stream, "IEND", std::vector<unsigned char>() );
+
+	return (bool)stream;
+}
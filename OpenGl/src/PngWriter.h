@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+// Writes 8-bit RGBA pixels as a PNG. The image data is stored with uncompressed
+// deflate blocks: files are larger than they could be, but no zlib is needed and
+// writing is fast enough to capture every frame of a benchmark run.
+// 'flipY' writes rows bottom-up, which turns glReadPixels output the right way up.
+bool WritePng( const std::string& filepath, int width, int height, const unsigned char* rgba, bool flipY );
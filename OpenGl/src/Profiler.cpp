@@ -0,0 +1,457 @@
+#include "Profiler.h"
+
+#include <GL/glew.h>
+#include <imgui.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+Profiler& Profiler::Get()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+Profiler::Profiler()
+	: m_Epoch( std::chrono::steady_clock::now() ), m_History( HISTORY )
+{
+	m_Current.Index = 1;
+	m_Current.Start = Now();
+}
+
+uint64_t Profiler::Now() const
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_Epoch ).count();
+}
+
+Profiler::ThreadRing& Profiler::GetThreadRing()
+{
+	thread_local ThreadRing* ring = nullptr;
+	if ( !ring )
+	{
+		std::lock_guard<std::mutex> lock( m_ThreadsMutex );
+		m_Threads.push_back( std::make_unique<ThreadRing>() );
+		ring = m_Threads.back().get();
+		ring->Index = (uint32_t)m_Threads.size() - 1;
+	}
+	return *ring;
+}
+
+uint64_t Profiler::BeginCpuScope()
+{
+	GetThreadRing().Depth++;
+	return Now();
+}
+
+void Profiler::EndCpuScope( const char* name, uint64_t start )
+{
+	const uint64_t end = Now();
+	ThreadRing& ring = GetThreadRing();
+	ring.Depth--;
+
+	const uint32_t write = ring.Write.load( std::memory_order_relaxed );
+	const uint32_t read = ring.Read.load( std::memory_order_acquire );
+	if ( write - read >= RING_CAPACITY )
+	{
+		// The main thread has not collected for a while; losing events beats blocking
+		ring.Dropped.fetch_add( 1, std::memory_order_relaxed );
+		return;
+	}
+
+	ProfileEvent& event = ring.Events[write % RING_CAPACITY];
+	event.Name = name;
+	event.Start = start;
+	event.End = end;
+	event.Thread = ring.Index;
+	event.Depth = ring.Depth;
+	ring.Write.store( write + 1, std::memory_order_release );
+}
+
+void Profiler::InitGpuTimers()
+{
+	m_GpuEnabled = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+	if ( !m_GpuEnabled )
+		std::cout << "Timer queries are not supported, GPU scopes are disabled" << std::endl;
+}
+
+void Profiler::ShutdownGpuTimers()
+{
+	for ( const GpuScope& scope : m_GpuScopes )
+		glDeleteQueries( 2, scope.Queries );
+	if ( !m_FreeQueries.empty() )
+		glDeleteQueries( (int)m_FreeQueries.size(), m_FreeQueries.data() );
+
+	m_GpuScopes.clear();
+	m_FreeQueries.clear();
+	m_GpuDepth = 0;
+	m_GpuEnabled = false;
+}
+
+int Profiler::BeginGpuScope( const char* name )
+{
+	if ( !m_GpuEnabled )
+		return -1;
+
+	GpuScope scope;
+	scope.Name = name;
+	scope.Frame = m_Current.Index;
+	scope.Depth = m_GpuDepth++;
+
+	if ( m_FreeQueries.size() < 2 )
+	{
+		unsigned int queries[16];
+		glGenQueries( 16, queries );
+		m_FreeQueries.insert( m_FreeQueries.end(), queries, queries + 16 );
+	}
+	scope.Queries[0] = m_FreeQueries.back();
+	m_FreeQueries.pop_back();
+	scope.Queries[1] = m_FreeQueries.back();
+	m_FreeQueries.pop_back();
+
+	// Timestamps rather than GL_TIME_ELAPSED: elapsed-time queries cannot nest
+	glQueryCounter( scope.Queries[0], GL_TIMESTAMP );
+
+	m_GpuScopes.push_back( scope );
+	return (int)m_GpuScopes.size() - 1;
+}
+
+void Profiler::EndGpuScope( int scope )
+{
+	if ( scope < 0 || scope >= (int)m_GpuScopes.size() )
+		return;
+
+	glQueryCounter( m_GpuScopes[scope].Queries[1], GL_TIMESTAMP );
+	m_GpuDepth--;
+}
+
+ProfileFrame* Profiler::FindFrame( uint64_t index )
+{
+	// Results arrive a few frames late, so search from the newest end
+	for ( int i = 0; i < m_HistoryCount; i++ )
+	{
+		ProfileFrame& frame = m_History[( m_HistoryHead - 1 - i + HISTORY ) % HISTORY];
+		if ( frame.Index == index )
+			return &frame;
+		if ( frame.Index < index )
+			break;
+	}
+	return nullptr;
+}
+
+void Profiler::CollectGpuQueries()
+{
+	// Queries complete in submission order, so stop at the first one still in flight
+	size_t done = 0;
+	for ( ; done < m_GpuScopes.size(); done++ )
+	{
+		const GpuScope& scope = m_GpuScopes[done];
+
+		int available = 0;
+		glGetQueryObjectiv( scope.Queries[1], GL_QUERY_RESULT_AVAILABLE, &available );
+		if ( !available )
+			break;
+
+		GLuint64 start = 0;
+		GLuint64 end = 0;
+		glGetQueryObjectui64v( scope.Queries[0], GL_QUERY_RESULT, &start );
+		glGetQueryObjectui64v( scope.Queries[1], GL_QUERY_RESULT, &end );
+
+		m_FreeQueries.push_back( scope.Queries[0] );
+		m_FreeQueries.push_back( scope.Queries[1] );
+
+		// The frame is gone if it was recorded while paused or has already left the history
+		ProfileFrame* frame = FindFrame( scope.Frame );
+		if ( !frame )
+			continue;
+
+		if ( frame->Gpu.empty() )
+			frame->GpuStart = start;
+
+		ProfileEvent event;
+		event.Name = scope.Name;
+		event.Start = start - std::min<uint64_t>( start, frame->GpuStart );
+		event.End = end - std::min<uint64_t>( end, frame->GpuStart );
+		event.Thread = 0;
+		event.Depth = scope.Depth;
+		frame->Gpu.push_back( event );
+	}
+	m_GpuScopes.erase( m_GpuScopes.begin(), m_GpuScopes.begin() + done );
+
+	const uint64_t oldestPending = m_GpuScopes.empty() ? m_Current.Index + 1 : m_GpuScopes.front().Frame;
+	for ( int i = 0; i < m_HistoryCount; i++ )
+	{
+		ProfileFrame& frame = m_History[( m_HistoryHead - 1 - i + HISTORY ) % HISTORY];
+		if ( frame.Index < oldestPending )
+		{
+			if ( frame.GpuComplete )
+				break;
+			frame.GpuComplete = true;
+		}
+	}
+}
+
+void Profiler::NewFrame()
+{
+	const uint64_t now = Now();
+	m_Current.End = now;
+
+	{
+		std::lock_guard<std::mutex> lock( m_ThreadsMutex );
+		for ( const std::unique_ptr<ThreadRing>& ring : m_Threads )
+		{
+			const uint32_t read = ring->Read.load( std::memory_order_relaxed );
+			const uint32_t write = ring->Write.load( std::memory_order_acquire );
+			for ( uint32_t i = read; i != write; i++ )
+				m_Current.Cpu.push_back( ring->Events[i % RING_CAPACITY] );
+			ring->Read.store( write, std::memory_order_release );
+
+			m_Dropped += ring->Dropped.exchange( 0, std::memory_order_relaxed );
+		}
+	}
+
+	const uint64_t next = m_Current.Index + 1;
+	if ( !m_Paused )
+	{
+		// Reuse the oldest slot's vectors so steady-state frames do not allocate
+		ProfileFrame& slot = m_History[m_HistoryHead];
+		std::swap( slot, m_Current );
+		m_HistoryHead = ( m_HistoryHead + 1 ) % HISTORY;
+		m_HistoryCount = std::min( m_HistoryCount + 1, HISTORY );
+	}
+
+	if ( m_GpuEnabled )
+		CollectGpuQueries();
+
+	m_Current.Index = next;
+	m_Current.Start = now;
+	m_Current.End = now;
+	m_Current.Cpu.clear();
+	m_Current.Gpu.clear();
+	m_Current.GpuStart = 0;
+	m_Current.GpuComplete = false;
+}
+
+static ImU32 GetScopeColor( const char* name )
+{
+	// Hash the text, not the pointer: the same literal may live at several addresses
+	uint32_t hash = 2166136261u;
+	for ( const char* c = name; *c; c++ )
+	{
+		hash ^= (unsigned char)*c;
+		hash *= 16777619u;
+	}
+	const float hue = ( hash & 0xffff ) / 65535.0f;
+	return ImColor::HSV( hue, 0.45f, 0.75f );
+}
+
+void Profiler::DrawFlameGraph( const ProfileFrame& frame )
+{
+	const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+
+	uint32_t threadCount = 0;
+	for ( const ProfileEvent& event : frame.Cpu )
+		threadCount = std::max( threadCount, event.Thread + 1 );
+
+	// One lane per thread, one row per nesting level, then the GPU lane
+	std::vector<uint32_t> laneDepth( threadCount + 1, 0 );
+	for ( const ProfileEvent& event : frame.Cpu )
+		laneDepth[event.Thread] = std::max( laneDepth[event.Thread], event.Depth + 1 );
+	for ( const ProfileEvent& event : frame.Gpu )
+		laneDepth[threadCount] = std::max( laneDepth[threadCount], event.Depth + 1 );
+
+	uint64_t duration = frame.End - frame.Start;
+	for ( const ProfileEvent& event : frame.Gpu )
+		duration = std::max( duration, event.End );
+	if ( duration == 0 )
+		return;
+
+	float height = 0.0f;
+	for ( uint32_t depth : laneDepth )
+		height += rowHeight * ( std::max( depth, 1u ) + 1 );
+
+	const ImVec2 origin = ImGui::GetCursorScreenPos();
+	const float width = std::max( ImGui::GetContentRegionAvail().x, 100.0f );
+	ImGui::InvisibleButton( "##flamegraph", ImVec2( width, height ) );
+	const bool hovered = ImGui::IsItemHovered();
+	const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	const double scale = width / (double)duration;
+	const ProfileEvent* hoveredEvent = nullptr;
+
+	float y = origin.y;
+	for ( uint32_t lane = 0; lane <= threadCount; lane++ )
+	{
+		const bool gpu = lane == threadCount;
+
+		char label[32];
+		if ( gpu )
+			snprintf( label, sizeof( label ), frame.GpuComplete ? "GPU" : "GPU (pending)" );
+		else
+			snprintf( label, sizeof( label ), lane == 0 ? "Main thread" : "Thread %u", lane );
+		drawList->AddText( ImVec2( origin.x, y ), ImGui::GetColorU32( ImGuiCol_TextDisabled ), label );
+		y += rowHeight;
+
+		const std::vector<ProfileEvent>& events = gpu ? frame.Gpu : frame.Cpu;
+		for ( const ProfileEvent& event : events )
+		{
+			if ( !gpu && event.Thread != lane )
+				continue;
+
+			// Events from other threads may straddle the frame boundary
+			const uint64_t base = gpu ? 0 : frame.Start;
+			const uint64_t start = std::max( event.Start, base ) - base;
+			const uint64_t end = std::min( std::max( event.End, base ) - base, duration );
+
+			ImVec2 min( origin.x + (float)( start * scale ), y + event.Depth * rowHeight );
+			ImVec2 max( origin.x + (float)( end * scale ), min.y + rowHeight - 1.0f );
+			max.x = std::max( max.x, min.x + 1.0f );
+
+			drawList->AddRectFilled( min, max, GetScopeColor( event.Name ) );
+			if ( max.x - min.x > 20.0f )
+			{
+				drawList->PushClipRect( min, max, true );
+				drawList->AddText( ImVec2( min.x + 2.0f, min.y + 2.0f ), IM_COL32( 0, 0, 0, 255 ), event.Name );
+				drawList->PopClipRect();
+			}
+
+			if ( hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y )
+				hoveredEvent = &event;
+		}
+		y += rowHeight * std::max( laneDepth[lane], 1u );
+	}
+
+	if ( hoveredEvent )
+		ImGui::SetTooltip( "%s\n%.3f ms", hoveredEvent->Name, ( hoveredEvent->End - hoveredEvent->Start ) / 1e6 );
+}
+
+void Profiler::DrawWindow( bool* open )
+{
+	if ( !*open )
+		return;
+
+	ImGui::SetNextWindowSize( ImVec2( 520.0f, 360.0f ), ImGuiCond_FirstUseEver );
+	if ( !ImGui::Begin( "Profiler", open ) )
+	{
+		ImGui::End();
+		return;
+	}
+
+	ImGui::Checkbox( "Pause", &m_Paused );
+	ImGui::SameLine();
+	if ( ImGui::Button( "Export Chrome Trace" ) )
+		m_ExportStatus = ExportChromeTrace( "profile.json" ) ? "Wrote profile.json" : "Failed to write profile.json";
+	if ( !m_ExportStatus.empty() )
+	{
+		ImGui::SameLine();
+		ImGui::TextUnformatted( m_ExportStatus.c_str() );
+	}
+
+	if ( m_HistoryCount == 0 )
+	{
+		ImGui::TextUnformatted( "No frames recorded yet" );
+		ImGui::End();
+		return;
+	}
+
+	float frameTimes[HISTORY];
+	float total = 0.0f;
+	float longest = 0.0f;
+	for ( int i = 0; i < m_HistoryCount; i++ )
+	{
+		// Oldest first, so the newest frame is on the right
+		const ProfileFrame& frame = m_History[( m_HistoryHead - m_HistoryCount + i + HISTORY ) % HISTORY];
+		frameTimes[i] = ( frame.End - frame.Start ) / 1e6f;
+		total += frameTimes[i];
+		longest = std::max( longest, frameTimes[i] );
+	}
+
+	char overlay[64];
+	snprintf( overlay, sizeof( overlay ), "avg %.2f ms, max %.2f ms", total / m_HistoryCount, longest );
+	ImGui::PlotHistogram( "##frames", frameTimes, m_HistoryCount, 0, overlay, 0.0f, longest * 1.1f, ImVec2( -1.0f, 80.0f ) );
+
+	// Clicking a bar selects that frame
+	if ( ImGui::IsItemHovered() && ImGui::IsMouseClicked( ImGuiMouseButton_Left ) )
+	{
+		const float t = ( ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x ) / ImGui::GetItemRectSize().x;
+		const int bar = std::min( std::max( (int)( t * m_HistoryCount ), 0 ), m_HistoryCount - 1 );
+		m_SelectedFrame = m_HistoryCount - 1 - bar;
+	}
+
+	m_SelectedFrame = std::min( m_SelectedFrame, m_HistoryCount - 1 );
+	ImGui::SliderInt( "Frames Ago", &m_SelectedFrame, 0, m_HistoryCount - 1 );
+
+	const ProfileFrame& frame = m_History[( m_HistoryHead - 1 - m_SelectedFrame + HISTORY ) % HISTORY];
+
+	uint64_t gpuTime = 0;
+	for ( const ProfileEvent& event : frame.Gpu )
+	{
+		if ( event.Depth == 0 )
+			gpuTime += event.End - event.Start;
+	}
+
+	ImGui::Text( "Frame %llu: %.3f ms CPU, %.3f ms GPU%s", (unsigned long long)frame.Index, ( frame.End - frame.Start ) / 1e6, gpuTime / 1e6,
+		m_GpuEnabled ? ( frame.GpuComplete ? "" : " (pending)" ) : " (unavailable)" );
+	if ( m_Dropped )
+		ImGui::TextColored( ImVec4( 1.0f, 0.6f, 0.2f, 1.0f ), "%u events dropped (ring buffer full)", m_Dropped );
+
+	ImGui::Separator();
+	DrawFlameGraph( frame );
+
+	ImGui::End();
+}
+
+static void WriteJsonString( std::ofstream& stream, const char* text )
+{
+	stream << '"';
+	for ( const char* c = text; *c; c++ )
+	{
+		if ( *c == '"' || *c == '\\' )
+			stream << '\\';
+		stream << *c;
+	}
+	stream << '"';
+}
+
+static void WriteTraceEvent( std::ofstream& stream, const ProfileEvent& event, uint64_t offset, int pid, bool& first )
+{
+	if ( !first )
+		stream << ",\n";
+	first = false;
+
+	// Chrome trace timestamps are microseconds
+	stream << "{\"name\":";
+	WriteJsonString( stream, event.Name );
+	stream << ",\"ph\":\"X\",\"ts\":" << ( offset + event.Start ) / 1000.0
+		<< ",\"dur\":" << ( event.End - event.Start ) / 1000.0
+		<< ",\"pid\":" << pid << ",\"tid\":" << event.Thread << '}';
+}
+
+bool Profiler::ExportChromeTrace( const std::string& filepath ) const
+{
+	std::ofstream stream( filepath, std::ios::trunc );
+	if ( !stream )
+		return false;
+
+	stream << std::fixed << std::setprecision( 3 );
+	stream << "{\"traceEvents\":[\n";
+	stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}},\n";
+	stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}";
+	bool first = false;
+
+	for ( int i = 0; i < m_HistoryCount; i++ )
+	{
+		const ProfileFrame& frame = m_History[( m_HistoryHead - m_HistoryCount + i + HISTORY ) % HISTORY];
+		for ( const ProfileEvent& event : frame.Cpu )
+			WriteTraceEvent( stream, event, 0, 0, first );
+
+		// The GPU clock has its own origin; line each frame's GPU work up with the frame's CPU start
+		for ( const ProfileEvent& event : frame.Gpu )
+			WriteTraceEvent( stream, event, frame.Start, 1, first );
+	}
+
+	stream << "\n]}\n";
+	return (bool)stream;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Hierarchical frame profiler.
+//
+// CPU scopes are RAII markers (PROFILE_SCOPE) that write one event into a ring
+// buffer owned by the calling thread. Each ring has a single producer (its thread)
+// and a single consumer (NewFrame on the main thread), so recording never takes a
+// lock. GPU scopes (PROFILE_GPU_SCOPE) bracket GL commands with timestamp queries
+// that are read back a few frames later, only once the driver reports them ready.
+//
+// Names must be string literals (or otherwise outlive the profiler).
+
+struct ProfileEvent
+{
+	const char* Name;
+	uint64_t Start; // ns since the profiler was created (GPU events: ns since the frame's first GPU timestamp)
+	uint64_t End;
+	uint32_t Thread;
+	uint32_t Depth;
+};
+
+struct ProfileFrame
+{
+	uint64_t Index = 0;
+	uint64_t Start = 0;
+	uint64_t End = 0;
+	std::vector<ProfileEvent> Cpu;
+	std::vector<ProfileEvent> Gpu;
+	uint64_t GpuStart = 0; // raw GL timestamp the Gpu events are relative to
+	bool GpuComplete = false; // every GPU scope issued during the frame has been read back
+};
+
+class Profiler
+{
+public:
+	static Profiler& Get();
+
+	// Call once with a current GL context to enable GPU scopes (needs GL 3.3 or ARB_timer_query).
+	void InitGpuTimers();
+	void ShutdownGpuTimers();
+
+	// Closes the previous frame (collecting every thread's events and any finished
+	// GPU queries) and opens the next one. Call at the top of the main loop.
+	void NewFrame();
+
+	void DrawWindow( bool* open );
+	bool ExportChromeTrace( const std::string& filepath ) const;
+
+	// Used by the scope objects. GPU scopes may only be opened on the thread that owns the GL context.
+	uint64_t BeginCpuScope();
+	void EndCpuScope( const char* name, uint64_t start );
+	int BeginGpuScope( const char* name );
+	void EndGpuScope( int scope );
+
+private:
+	Profiler();
+
+	static const uint32_t RING_CAPACITY = 4096;
+	static const int HISTORY = 240;
+
+	struct ThreadRing
+	{
+		ProfileEvent Events[RING_CAPACITY];
+		std::atomic<uint32_t> Write{ 0 };
+		std::atomic<uint32_t> Read{ 0 };
+		std::atomic<uint32_t> Dropped{ 0 };
+		uint32_t Index = 0;
+		uint32_t Depth = 0; // only touched by the owning thread
+	};
+
+	struct GpuScope
+	{
+		const char* Name;
+		unsigned int Queries[2];
+		uint64_t Frame;
+		uint32_t Depth;
+	};
+
+	uint64_t Now() const;
+	ThreadRing& GetThreadRing();
+	ProfileFrame* FindFrame( uint64_t index );
+	void CollectGpuQueries();
+	void DrawFlameGraph( const ProfileFrame& frame );
+
+	std::chrono::steady_clock::time_point m_Epoch;
+
+	// Guards the list only; a thread takes it once to register its ring, recording never does
+	std::mutex m_ThreadsMutex;
+	std::vector<std::unique_ptr<ThreadRing>> m_Threads;
+
+	ProfileFrame m_Current;
+	std::vector<ProfileFrame> m_History; // circular, oldest entry at m_HistoryHead once full
+	int m_HistoryHead = 0;
+	int m_HistoryCount = 0;
+	uint32_t m_Dropped = 0;
+
+	bool m_GpuEnabled = false;
+	std::vector<unsigned int> m_FreeQueries;
+	std::vector<GpuScope> m_GpuScopes; // issue order, oldest first
+	uint32_t m_GpuDepth = 0;
+
+	// Window state
+	bool m_Paused = false;
+	int m_SelectedFrame = 0; // frames back from the newest
+	std::string m_ExportStatus;
+};
+
+struct ProfileScope
+{
+	explicit ProfileScope( const char* name )
+		: Name( name ), Start( Profiler::Get().BeginCpuScope() )
+	{
+	}
+
+	~ProfileScope()
+	{
+		Profiler::Get().EndCpuScope( Name, Start );
+	}
+
+	const char* Name;
+	uint64_t Start;
+};
+
+struct GpuProfileScope
+{
+	explicit GpuProfileScope( const char* name )
+		: Scope( Profiler::Get().BeginGpuScope( name ) )
+	{
+	}
+
+	~GpuProfileScope()
+	{
+		Profiler::Get().EndGpuScope( Scope );
+	}
+
+	int Scope;
+};
+
+#define PROFILE_CONCAT_INNER( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_INNER( a, b )
+#define PROFILE_SCOPE( name ) ProfileScope PROFILE_CONCAT( profileScope, __LINE__ )( name )
+#define PROFILE_GPU_SCOPE( name ) GpuProfileScope PROFILE_CONCAT( gpuProfileScope, __LINE__ )( name )
+#define PROFILE_FUNCTION() PROFILE_SCOPE( __FUNCTION__ )
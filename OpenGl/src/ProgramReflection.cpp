@@ -0,0 +1,143 @@
+#include "ProgramReflection.h"
+
+#include <cstring>
+
+static uint32_t HashUniformName( const char* name )
+{
+	uint32_t hash = 2166136261u;
+	for ( const char* c = name; *c; c++ )
+	{
+		hash ^= (unsigned char)*c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+void ProgramReflection::Reflect( unsigned int program, UniformBackend* backend, const SharedUniformBlock* sharedBlocks, int sharedBlockCount )
+{
+	Clear();
+
+	m_Program = program;
+	m_Backend = backend;
+	backend->QueryProgram( program, m_Uniforms, m_Blocks );
+
+	// Attach known blocks to their fixed binding points, so one buffer serves every program
+	for ( const UniformBlockInfo& block : m_Blocks )
+	{
+		for ( int i = 0; i < sharedBlockCount; i++ )
+		{
+			if ( block.Name == sharedBlocks[i].Name )
+				backend->SetUniformBlockBinding( program, block.Index, sharedBlocks[i].Binding );
+		}
+	}
+
+	m_Shadows.resize( m_Uniforms.size() );
+
+	// Keep the table at most half full so probe sequences stay short
+	size_t capacity = 8;
+	while ( capacity < m_Uniforms.size() * 2 )
+		capacity *= 2;
+
+	m_SlotHashes.assign( capacity, 0 );
+	m_Slots.assign( capacity, -1 );
+
+	for ( int i = 0; i < (int)m_Uniforms.size(); i++ )
+	{
+		uint32_t hash = HashUniformName( m_Uniforms[i].Name.c_str() );
+		size_t slot = hash & ( capacity - 1 );
+		while ( m_Slots[slot] != -1 )
+			slot = ( slot + 1 ) & ( capacity - 1 );
+
+		m_SlotHashes[slot] = hash;
+		m_Slots[slot] = i;
+	}
+}
+
+void ProgramReflection::Clear()
+{
+	m_Program = 0;
+	m_Backend = nullptr;
+	m_Uniforms.clear();
+	m_Blocks.clear();
+	m_Shadows.clear();
+	m_SlotHashes.clear();
+	m_Slots.clear();
+}
+
+ProgramReflection::UniformHandle ProgramReflection::Find( const char* name ) const
+{
+	if ( m_Slots.empty() )
+		return -1;
+
+	const size_t mask = m_Slots.size() - 1;
+	const uint32_t hash = HashUniformName( name );
+
+	for ( size_t slot = hash & mask; m_Slots[slot] != -1; slot = ( slot + 1 ) & mask )
+	{
+		if ( m_SlotHashes[slot] == hash && m_Uniforms[m_Slots[slot]].Name == name )
+			return m_Slots[slot];
+	}
+
+	return -1;
+}
+
+void ProgramReflection::Invalidate()
+{
+	for ( Shadow& shadow : m_Shadows )
+		shadow.Valid = false;
+}
+
+bool ProgramReflection::Upload( UniformHandle handle, UniformType type, const void* data, size_t size )
+{
+	if ( handle < 0 || handle >= (int)m_Uniforms.size() || m_Uniforms[handle].Type != type )
+		return false;
+
+	Shadow& shadow = m_Shadows[handle];
+	if ( shadow.Valid && memcmp( shadow.Value, data, size ) == 0 )
+	{
+		m_Skipped++;
+		return true;
+	}
+
+	memcpy( shadow.Value, data, size );
+	shadow.Valid = true;
+
+	m_Backend->Upload( m_Uniforms[handle].Location, type, data );
+	m_Uploads++;
+	return true;
+}
+
+bool ProgramReflection::Set( UniformHandle handle, float value )
+{
+	return Upload( handle, UniformType::Float, &value, sizeof( value ) );
+}
+
+bool ProgramReflection::Set( UniformHandle handle, int value )
+{
+	return Upload( handle, UniformType::Int, &value, sizeof( value ) );
+}
+
+bool ProgramReflection::Set( UniformHandle handle, const glm::vec2& value )
+{
+	return Upload( handle, UniformType::Vec2, &value[0], sizeof( value ) );
+}
+
+bool ProgramReflection::Set( UniformHandle handle, const glm::vec3& value )
+{
+	return Upload( handle, UniformType::Vec3, &value[0], sizeof( value ) );
+}
+
+bool ProgramReflection::Set( UniformHandle handle, const glm::vec4& value )
+{
+	return Upload( handle, UniformType::Vec4, &value[0], sizeof( value ) );
+}
+
+bool ProgramReflection::Set( UniformHandle handle, const glm::mat3& value )
+{
+	return Upload( handle, UniformType::Mat3, &value[0][0], sizeof( value ) );
+}
+
+bool ProgramReflection::Set( UniformHandle handle, const glm::mat4& value )
+{
+	return Upload( handle, UniformType::Mat4, &value[0][0], sizeof( value ) );
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class UniformType
+{
+	Float,
+	Vec2,
+	Vec3,
+	Vec4,
+	Int,     // also samplers
+	Mat3,
+	Mat4,
+	Other
+};
+
+struct UniformInfo
+{
+	std::string Name; // array uniforms are reported without their "[0]" suffix
+	UniformType Type = UniformType::Other;
+	int Location = -1;
+	int Count = 1;
+};
+
+struct UniformBlockInfo
+{
+	std::string Name;
+	unsigned int Index = 0;
+	int Size = 0;
+};
+
+// Everything ProgramReflection needs from the driver. The GL implementation is
+// GLUniformBackend; tests can substitute a fake that records uploads.
+class UniformBackend
+{
+public:
+	virtual ~UniformBackend() {}
+
+	virtual void QueryProgram( unsigned int program, std::vector<UniformInfo>& uniforms, std::vector<UniformBlockInfo>& blocks ) = 0;
+	virtual void SetUniformBlockBinding( unsigned int program, unsigned int blockIndex, unsigned int binding ) = 0;
+
+	// Uploads one value to the currently bound program.
+	virtual void Upload( int location, UniformType type, const void* data ) = 0;
+};
+
+// Uniform block names every program may declare, and the binding point each is attached to.
+struct SharedUniformBlock
+{
+	const char* Name;
+	unsigned int Binding;
+};
+
+// Reflection of one linked program: all active uniforms are queried once and
+// kept in a flat open-addressing table keyed by the name hash, so a lookup is
+// a hash and a probe instead of a driver string lookup. Setters keep a shadow
+// copy of the last uploaded value and skip the upload when nothing changed.
+//
+// Setters upload to the currently bound program; bind it with glUseProgram first.
+class ProgramReflection
+{
+public:
+	typedef int UniformHandle; // index into the uniform list, -1 if not found
+
+	void Reflect( unsigned int program, UniformBackend* backend, const SharedUniformBlock* sharedBlocks, int sharedBlockCount );
+	void Clear();
+
+	unsigned int GetProgram() const { return m_Program; }
+
+	UniformHandle Find( const char* name ) const;
+	const std::vector<UniformInfo>& GetUniforms() const { return m_Uniforms; }
+	const std::vector<UniformBlockInfo>& GetBlocks() const { return m_Blocks; }
+
+	// Return false if the uniform does not exist (or was optimized out) or has a different type.
+	bool Set( UniformHandle handle, float value );
+	bool Set( UniformHandle handle, int value );
+	bool Set( UniformHandle handle, const glm::vec2& value );
+	bool Set( UniformHandle handle, const glm::vec3& value );
+	bool Set( UniformHandle handle, const glm::vec4& value );
+	bool Set( UniformHandle handle, const glm::mat3& value );
+	bool Set( UniformHandle handle, const glm::mat4& value );
+
+	template<typename T>
+	bool Set( const char* name, const T& value ) { return Set( Find( name ), value ); }
+
+	// Forget all shadow values, e.g. after something uploaded uniforms behind our back.
+	void Invalidate();
+
+	unsigned int GetUploadCount() const { return m_Uploads; }
+	unsigned int GetSkippedCount() const { return m_Skipped; }
+	void ResetCounters() { m_Uploads = 0; m_Skipped = 0; }
+
+private:
+	struct Shadow
+	{
+		float Value[16];
+		bool Valid = false;
+	};
+
+	bool Upload( UniformHandle handle, UniformType type, const void* data, size_t size );
+
+	unsigned int m_Program = 0;
+	UniformBackend* m_Backend = nullptr;
+
+	std::vector<UniformInfo> m_Uniforms;
+	std::vector<UniformBlockInfo> m_Blocks;
+	std::vector<Shadow> m_Shadows;
+
+	// Open addressing, linear probing, power-of-two size; -1 marks an empty slot
+	std::vector<uint32_t> m_SlotHashes;
+	std::vector<int> m_Slots;
+
+	unsigned int m_Uploads = 0;
+	unsigned int m_Skipped = 0;
+};
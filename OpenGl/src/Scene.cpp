@@ -0,0 +1,20 @@
+#include "Scene.h"
+
+unsigned int Scene::Add( const SceneObject& object )
+{
+	m_Objects.push_back( object );
+	m_Version++;
+	return (unsigned int)m_Objects.size() - 1;
+}
+
+void Scene::Clear()
+{
+	m_Objects.clear();
+	m_Version++;
+}
+
+SceneObject& Scene::Edit( unsigned int index )
+{
+	m_Version++;
+	return m_Objects[index];
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Mesh.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+struct SceneObject
+{
+	MeshType Mesh = MeshType::Square;
+	glm::vec3 Position = glm::vec3( 0.0f );
+	glm::vec3 Rotation = glm::vec3( 0.0f ); // euler angles in radians, applied x, y, z
+	glm::vec3 Scale = glm::vec3( 1.0f );
+	glm::vec4 Color = glm::vec4( 1.0f );
+	bool Visible = true;
+};
+
+// Retained list of objects. Nothing here talks to OpenGL: the scene only records
+// what should be drawn, BatchBuilder packs it and SceneRenderer draws it.
+// Every modification bumps the version so consumers can skip work on unchanged frames.
+class Scene
+{
+public:
+	unsigned int Add( const SceneObject& object );
+	void Clear();
+
+	// Mutable access marks the scene as modified.
+	SceneObject& Edit( unsigned int index );
+
+	const std::vector<SceneObject>& GetObjects() const { return m_Objects; }
+	unsigned int GetObjectCount() const { return (unsigned int)m_Objects.size(); }
+	unsigned int GetVersion() const { return m_Version; }
+
+private:
+	std::vector<SceneObject> m_Objects;
+	unsigned int m_Version = 1;
+};
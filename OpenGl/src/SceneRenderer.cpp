@@ -0,0 +1,103 @@
+#include "SceneRenderer.h"
+
+#include "GLState.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+static const unsigned int POSITION_ATTRIB = 0;
+static const unsigned int MODEL_ATTRIB = 1; // mat4 takes locations 1-4
+static const unsigned int COLOR_ATTRIB = 5;
+
+SceneRenderer::SceneRenderer()
+{
+	glGenBuffers( 1, &m_InstanceBuffer );
+
+	for ( unsigned int i = 0; i < (unsigned int)MeshType::Count; i++ )
+	{
+		MeshData data = GenerateMesh( (MeshType)i );
+		MeshBuffers& mesh = m_Meshes[i];
+		mesh.VertexCount = data.VertexCount;
+
+		glGenVertexArrays( 1, &mesh.VertexArray );
+		GetGLState().BindVertexArray( mesh.VertexArray );
+
+		glGenBuffers( 1, &mesh.VertexBuffer );
+		GetGLState().BindBuffer( GL_ARRAY_BUFFER, mesh.VertexBuffer );
+		glBufferData( GL_ARRAY_BUFFER, data.Vertices.size() * sizeof( float ), data.Vertices.data(), GL_STATIC_DRAW );
+
+		glEnableVertexAttribArray( POSITION_ATTRIB );
+		glVertexAttribPointer( POSITION_ATTRIB, 3, GL_FLOAT, GL_FALSE, sizeof( float ) * 3, 0 );
+
+		// Instance attributes are enabled here; their pointers are set per batch in Draw().
+		for ( unsigned int column = 0; column < 4; column++ )
+		{
+			glEnableVertexAttribArray( MODEL_ATTRIB + column );
+			glVertexAttribDivisor( MODEL_ATTRIB + column, 1 );
+		}
+		glEnableVertexAttribArray( COLOR_ATTRIB );
+		glVertexAttribDivisor( COLOR_ATTRIB, 1 );
+	}
+
+	GetGLState().BindVertexArray( 0 );
+	GetGLState().BindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+SceneRenderer::~SceneRenderer()
+{
+	for ( MeshBuffers& mesh : m_Meshes )
+	{
+		GetGLState().OnBufferDeleted( mesh.VertexBuffer );
+		GetGLState().OnVertexArrayDeleted( mesh.VertexArray );
+		glDeleteBuffers( 1, &mesh.VertexBuffer );
+		glDeleteVertexArrays( 1, &mesh.VertexArray );
+	}
+
+	GetGLState().OnBufferDeleted( m_InstanceBuffer );
+	glDeleteBuffers( 1, &m_InstanceBuffer );
+}
+
+void SceneRenderer::UploadInstances( const BatchBuilder& batches )
+{
+	const std::vector<InstanceData>& instances = batches.GetInstances();
+	const size_t size = instances.size() * sizeof( InstanceData );
+
+	// Grow with headroom so adding a few objects does not reallocate every time
+	if ( size > m_InstanceCapacity )
+		m_InstanceCapacity = size + size / 2;
+
+	// Respecifying the storage orphans the old one, so we never wait on a frame still reading it
+	GetGLState().BindBuffer( GL_ARRAY_BUFFER, m_InstanceBuffer );
+	glBufferData( GL_ARRAY_BUFFER, m_InstanceCapacity, nullptr, GL_DYNAMIC_DRAW );
+	if ( size > 0 )
+		glBufferSubData( GL_ARRAY_BUFFER, 0, size, instances.data() );
+
+	GetGLState().BindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+void SceneRenderer::Draw( const BatchBuilder& batches ) const
+{
+	GetGLState().BindBuffer( GL_ARRAY_BUFFER, m_InstanceBuffer );
+
+	for ( const DrawBatch& batch : batches.GetBatches() )
+	{
+		const MeshBuffers& mesh = m_Meshes[(int)batch.Mesh];
+		const size_t base = batch.FirstInstance * sizeof( InstanceData );
+
+		GetGLState().BindVertexArray( mesh.VertexArray );
+
+		for ( unsigned int column = 0; column < 4; column++ )
+		{
+			glVertexAttribPointer( MODEL_ATTRIB + column, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ),
+				(const void*)( base + offsetof( InstanceData, Model ) + column * sizeof( glm::vec4 ) ) );
+		}
+		glVertexAttribPointer( COLOR_ATTRIB, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ),
+			(const void*)( base + offsetof( InstanceData, Color ) ) );
+
+		glDrawArraysInstanced( GL_TRIANGLES, 0, mesh.VertexCount, batch.InstanceCount );
+	}
+
+	GetGLState().BindVertexArray( 0 );
+	GetGLState().BindBuffer( GL_ARRAY_BUFFER, 0 );
+}
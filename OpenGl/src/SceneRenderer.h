@@ -0,0 +1,34 @@
+#pragma once
+
+#include "InstanceBatch.h"
+#include "Mesh.h"
+
+// GPU side of the instanced renderer. Every mesh is uploaded once into its own
+// vertex array; all instances live in one shared buffer that is only re-uploaded
+// when the batch builder produced new data. Requires a current GL 3.3 context.
+class SceneRenderer
+{
+public:
+	SceneRenderer();
+	~SceneRenderer();
+
+	SceneRenderer( const SceneRenderer& ) = delete;
+	SceneRenderer& operator=( const SceneRenderer& ) = delete;
+
+	void UploadInstances( const BatchBuilder& batches );
+
+	// One glDrawArraysInstanced per batch. The caller binds the program and sets u_ViewProj.
+	void Draw( const BatchBuilder& batches ) const;
+
+private:
+	struct MeshBuffers
+	{
+		unsigned int VertexArray = 0;
+		unsigned int VertexBuffer = 0;
+		unsigned int VertexCount = 0;
+	};
+
+	MeshBuffers m_Meshes[(int)MeshType::Count];
+	unsigned int m_InstanceBuffer = 0;
+	size_t m_InstanceCapacity = 0;
+};
@@ -0,0 +1,303 @@
+#include "ShaderLibrary.h"
+
+#include "UniformBuffer.h"
+
+#include <GL/glew.h>
+
+#include <iostream>
+#include <vector>
+
+static const unsigned int STAGE_TYPES[(int)ShaderStage::Count] = {
+	GL_VERTEX_SHADER,
+	GL_FRAGMENT_SHADER,
+	GL_GEOMETRY_SHADER,
+	GL_TESS_CONTROL_SHADER,
+	GL_TESS_EVALUATION_SHADER,
+	GL_COMPUTE_SHADER,
+};
+
+static unsigned int CompileShader( ShaderStage stage, const ShaderProgramSource& program )
+{
+	const ShaderStageSource& source = program.GetStage( stage );
+
+	// Hand the chunks to the driver as they are, no need to join them first
+	std::vector<const char*> strings;
+	std::vector<int> lengths;
+	for ( std::string_view chunk : source.Chunks )
+	{
+		strings.push_back( chunk.data() );
+		lengths.push_back( (int)chunk.size() );
+	}
+
+	unsigned int id = glCreateShader( STAGE_TYPES[(int)stage] );
+	glShaderSource( id, (int)strings.size(), strings.data(), lengths.data() );
+	glCompileShader( id );
+
+	int result;
+
+	glGetShaderiv( id, GL_COMPILE_STATUS, &result );
+	if ( result == GL_FALSE )
+	{
+		int length;
+
+		glGetShaderiv( id, GL_INFO_LOG_LENGTH, &length );
+		std::vector<char> message( length + 1 );
+		glGetShaderInfoLog( id, length, &length, message.data() );
+		std::cout << "Failed to compile " << GetShaderStageName( stage ) << std::endl;
+		std::cout << message.data() << std::endl;
+
+		// Error locations are "<source string>(<line>)"; print the file behind each source string
+		for ( size_t i = 0; i < program.Files.size(); i++ )
+			std::cout << "  source string " << i << ": " << program.Files[i] << std::endl;
+
+		glDeleteShader( id );
+
+		return 0;
+	}
+
+	return id;
+}
+
+static bool CheckLinkStatus( unsigned int program, bool log )
+{
+	int result;
+
+	glGetProgramiv( program, GL_LINK_STATUS, &result );
+	if ( result == GL_FALSE && log )
+	{
+		int length;
+
+		glGetProgramiv( program, GL_INFO_LOG_LENGTH, &length );
+		std::vector<char> message( length + 1 );
+		glGetProgramInfoLog( program, length, &length, message.data() );
+		std::cout << "Failed to link program" << std::endl;
+		std::cout << message.data() << std::endl;
+	}
+
+	return result != GL_FALSE;
+}
+
+static unsigned int CreateShader( const ShaderProgramSource& source, bool retrievable )
+{
+	unsigned int shaders[(int)ShaderStage::Count] = {};
+	bool compiled = true;
+
+	for ( int i = 0; i < (int)ShaderStage::Count; i++ )
+	{
+		if ( !source.Stages[i].Present )
+			continue;
+
+		shaders[i] = CompileShader( (ShaderStage)i, source );
+		compiled &= shaders[i] != 0;
+	}
+
+	unsigned int program = 0;
+
+	if ( compiled )
+	{
+		program = glCreateProgram();
+
+		if ( retrievable )
+			glProgramParameteri( program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+
+		for ( unsigned int shader : shaders )
+		{
+			if ( shader != 0 )
+				glAttachShader( program, shader );
+		}
+		glLinkProgram( program );
+		glValidateProgram( program );
+
+		if ( !CheckLinkStatus( program, true ) )
+		{
+			glDeleteProgram( program );
+			program = 0;
+		}
+	}
+
+	for ( unsigned int shader : shaders )
+		glDeleteShader( shader );
+
+	return program;
+}
+
+ShaderLibrary::ShaderLibrary( const std::string& cacheDirectory )
+	: m_Cache( cacheDirectory )
+{
+	int formats = 0;
+	if ( GLEW_ARB_get_program_binary )
+		glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &formats );
+	m_BinarySupported = formats > 0;
+
+	// A driver update invalidates every binary, so the driver identity is part of each cache key
+	const char* vendor = (const char*)glGetString( GL_VENDOR );
+	const char* renderer = (const char*)glGetString( GL_RENDERER );
+	const char* version = (const char*)glGetString( GL_VERSION );
+	m_Driver = std::string( vendor ? vendor : "" ) + "|" + ( renderer ? renderer : "" ) + "|" + ( version ? version : "" );
+}
+
+ShaderLibrary::~ShaderLibrary()
+{
+	for ( auto& entry : m_Programs )
+		glDeleteProgram( entry.second.RendererID );
+}
+
+unsigned int ShaderLibrary::Load( const std::string& name, const std::string& filepath )
+{
+	ShaderProgramSource source = ParseShader( filepath );
+	uint64_t key = ComputeShaderCacheKey( source, m_Driver );
+
+	Program& program = m_Programs[name];
+	if ( program.RendererID != 0 && program.Key == key )
+		return program.RendererID;
+
+	// Watch even if the build fails, so fixing the file on disk brings the program up
+	program.Filepath = filepath;
+	SetFiles( program, source );
+
+	unsigned int id = Build( source, key );
+	if ( id == 0 )
+		return program.RendererID;
+
+	glDeleteProgram( program.RendererID );
+	program.Key = key;
+	program.RendererID = id;
+	program.Reflection.Reflect( id, &m_UniformBackend, SHARED_UNIFORM_BLOCKS, SHARED_UNIFORM_BLOCK_COUNT );
+
+	return id;
+}
+
+unsigned int ShaderLibrary::Get( const std::string& name ) const
+{
+	auto it = m_Programs.find( name );
+	return it != m_Programs.end() ? it->second.RendererID : 0;
+}
+
+ProgramReflection& ShaderLibrary::GetReflection( const std::string& name )
+{
+	return m_Programs[name].Reflection;
+}
+
+bool ShaderLibrary::ReloadChanged( double time )
+{
+	std::vector<std::filesystem::path> changed = m_Watcher.Poll( time );
+	if ( changed.empty() )
+		return false;
+
+	bool replaced = false;
+
+	for ( auto& entry : m_Programs )
+	{
+		Program& program = entry.second;
+
+		bool dirty = false;
+		for ( const std::filesystem::path& file : changed )
+		{
+			for ( const std::string& dependency : program.Files )
+				dirty |= file == dependency;
+		}
+		if ( !dirty )
+			continue;
+
+		// Saving without edits changes the timestamp but not the key, so nothing is rebuilt.
+		// The include set may have changed though, so the watch list is refreshed either way.
+		ShaderProgramSource source = ParseShader( program.Filepath );
+		SetFiles( program, source );
+
+		uint64_t key = ComputeShaderCacheKey( source, m_Driver );
+		if ( key == program.Key )
+			continue;
+
+		unsigned int id = Build( source, key );
+		if ( id == 0 )
+		{
+			std::cout << "Keeping previous version of '" << entry.first << "'" << std::endl;
+			continue;
+		}
+
+		std::cout << "Reloaded shader '" << entry.first << "'" << std::endl;
+
+		glDeleteProgram( program.RendererID );
+		program.Key = key;
+		program.RendererID = id;
+		program.Reflection.Reflect( id, &m_UniformBackend, SHARED_UNIFORM_BLOCKS, SHARED_UNIFORM_BLOCK_COUNT );
+		replaced = true;
+	}
+
+	return replaced;
+}
+
+void ShaderLibrary::SetFiles( Program& program, const ShaderProgramSource& source )
+{
+	if ( source.Files.empty() )
+		program.Files = { program.Filepath };
+	else
+		program.Files = source.Files;
+
+	for ( const std::string& file : program.Files )
+		m_Watcher.Watch( file );
+}
+
+unsigned int ShaderLibrary::Build( const ShaderProgramSource& source, uint64_t key )
+{
+	if ( !source.IsValid() )
+	{
+		for ( const std::string& error : source.Errors )
+			std::cout << error << std::endl;
+		return 0;
+	}
+
+	if ( m_BinarySupported )
+	{
+		unsigned int program = LoadBinary( key );
+		if ( program != 0 )
+		{
+			m_CacheHits++;
+			return program;
+		}
+	}
+
+	m_CacheMisses++;
+
+	unsigned int program = CreateShader( source, m_BinarySupported );
+	if ( program != 0 && m_BinarySupported )
+		StoreBinary( program, key );
+
+	return program;
+}
+
+unsigned int ShaderLibrary::LoadBinary( uint64_t key )
+{
+	unsigned int format;
+	std::vector<char> binary;
+	if ( !m_Cache.Load( key, format, binary ) )
+		return 0;
+
+	unsigned int program = glCreateProgram();
+	glProgramBinary( program, format, binary.data(), (GLsizei)binary.size() );
+
+	// The driver may reject a binary it produced itself (e.g. after an update); fall back to compiling
+	if ( !CheckLinkStatus( program, false ) )
+	{
+		glDeleteProgram( program );
+		m_Cache.Invalidate( key );
+		return 0;
+	}
+
+	return program;
+}
+
+void ShaderLibrary::StoreBinary( unsigned int program, uint64_t key )
+{
+	int length = 0;
+	glGetProgramiv( program, GL_PROGRAM_BINARY_LENGTH, &length );
+	if ( length <= 0 )
+		return;
+
+	std::vector<char> binary( length );
+	GLenum format = 0;
+	glGetProgramBinary( program, length, &length, &format, binary.data() );
+	binary.resize( length );
+
+	m_Cache.Store( key, format, binary );
+}
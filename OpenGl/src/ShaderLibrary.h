@@ -0,0 +1,65 @@
+#pragma once
+
+#include "GLUniformBackend.h"
+#include "ProgramReflection.h"
+#include "ShaderSource.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Owns every linked program of the app. Programs are keyed by a content hash of
+// their sources: a warm start loads the linked binary from the on-disk cache
+// instead of compiling, and edited source files (including anything they
+// #include) are recompiled in place.
+class ShaderLibrary
+{
+public:
+	explicit ShaderLibrary( const std::string& cacheDirectory );
+	~ShaderLibrary();
+
+	ShaderLibrary( const ShaderLibrary& ) = delete;
+	ShaderLibrary& operator=( const ShaderLibrary& ) = delete;
+
+	// Returns 0 if the program failed to build.
+	unsigned int Load( const std::string& name, const std::string& filepath );
+	unsigned int Get( const std::string& name ) const;
+
+	// Active uniforms and blocks of a program, refreshed whenever the program is rebuilt.
+	// The reference stays valid for the lifetime of the library.
+	ProgramReflection& GetReflection( const std::string& name );
+
+	// Rebuilds programs whose source file changed on disk. Returns true when a program
+	// object was replaced; anything queried from the old id (uniform locations) is stale.
+	// A program that fails to compile keeps running the previous version.
+	bool ReloadChanged( double time );
+
+	unsigned int GetCacheHits() const { return m_CacheHits; }
+	unsigned int GetCacheMisses() const { return m_CacheMisses; }
+
+private:
+	struct Program
+	{
+		std::string Filepath;
+		std::vector<std::string> Files; // root file and everything it includes
+		uint64_t Key = 0;
+		unsigned int RendererID = 0;
+		ProgramReflection Reflection;
+	};
+
+	void SetFiles( Program& program, const ShaderProgramSource& source );
+	unsigned int Build( const ShaderProgramSource& source, uint64_t key );
+	unsigned int LoadBinary( uint64_t key );
+	void StoreBinary( unsigned int program, uint64_t key );
+
+	std::unordered_map<std::string, Program> m_Programs;
+	ShaderBinaryCache m_Cache;
+	ShaderFileWatcher m_Watcher;
+	GLUniformBackend m_UniformBackend;
+	std::string m_Driver;
+	bool m_BinarySupported = false;
+
+	unsigned int m_CacheHits = 0;
+	unsigned int m_CacheMisses = 0;
+};
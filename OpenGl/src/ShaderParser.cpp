@@ -0,0 +1,281 @@
+#include "ShaderParser.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+struct ShaderStageName
+{
+	const char* Name;
+	ShaderStage Stage;
+};
+
+static const ShaderStageName STAGE_NAMES[] = {
+	{ "vertex", ShaderStage::Vertex },
+	{ "fragment", ShaderStage::Fragment },
+	{ "pixel", ShaderStage::Fragment },
+	{ "geometry", ShaderStage::Geometry },
+	{ "tess_control", ShaderStage::TessControl },
+	{ "tessellation_control", ShaderStage::TessControl },
+	{ "tess_evaluation", ShaderStage::TessEvaluation },
+	{ "tessellation_evaluation", ShaderStage::TessEvaluation },
+	{ "compute", ShaderStage::Compute },
+};
+
+const char* GetShaderStageName( ShaderStage stage )
+{
+	switch ( stage )
+	{
+	case ShaderStage::Vertex:         return "vertex";
+	case ShaderStage::Fragment:       return "fragment";
+	case ShaderStage::Geometry:       return "geometry";
+	case ShaderStage::TessControl:    return "tess_control";
+	case ShaderStage::TessEvaluation: return "tess_evaluation";
+	case ShaderStage::Compute:        return "compute";
+	default:                          return "unknown";
+	}
+}
+
+size_t ShaderStageSource::GetLength() const
+{
+	size_t length = 0;
+	for ( std::string_view chunk : Chunks )
+		length += chunk.size();
+	return length;
+}
+
+std::string ShaderStageSource::ToString() const
+{
+	std::string text;
+	text.reserve( GetLength() );
+	for ( std::string_view chunk : Chunks )
+		text.append( chunk.data(), chunk.size() );
+	return text;
+}
+
+static bool IsBlank( char c )
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static std::string_view TrimFront( std::string_view text )
+{
+	size_t i = 0;
+	while ( i < text.size() && IsBlank( text[i] ) )
+		i++;
+	return text.substr( i );
+}
+
+static std::string_view Trim( std::string_view text )
+{
+	text = TrimFront( text );
+	while ( !text.empty() && ( IsBlank( text.back() ) || text.back() == '\n' ) )
+		text.remove_suffix( 1 );
+	return text;
+}
+
+// Splits "word rest" after a '#': returns the word and leaves the remainder in 'rest'.
+static std::string_view TakeWord( std::string_view text, std::string_view& rest )
+{
+	text = TrimFront( text );
+	size_t end = 0;
+	while ( end < text.size() && !IsBlank( text[end] ) && text[end] != '\n' )
+		end++;
+	rest = text.substr( end );
+	return text.substr( 0, end );
+}
+
+class ShaderParser
+{
+public:
+	explicit ShaderParser( ShaderProgramSource& out )
+		: m_Out( out )
+	{
+	}
+
+	// Returns false if nothing was added (include-once hit or unreadable file).
+	bool ParseFile( const std::filesystem::path& path, const std::string& from, unsigned int fromLine );
+
+private:
+	void Error( const std::string& file, unsigned int line, const std::string& message );
+	void EmitLine( unsigned int line, unsigned int fileIndex );
+	void Append( std::string_view text );
+
+	struct LoadedFile
+	{
+		unsigned int Index;
+		std::string_view Text;
+	};
+
+	ShaderProgramSource& m_Out;
+	std::unordered_map<std::string, LoadedFile> m_Loaded;
+	std::unordered_set<std::string> m_Included[(int)ShaderStage::Count];
+	int m_Stage = -1;
+	bool m_VersionSeen[(int)ShaderStage::Count] = {};
+};
+
+void ShaderParser::Error( const std::string& file, unsigned int line, const std::string& message )
+{
+	m_Out.Errors.push_back( file + "(" + std::to_string( line ) + "): " + message );
+}
+
+void ShaderParser::EmitLine( unsigned int line, unsigned int fileIndex )
+{
+	// GLSL only accepts #line after #version, so a stage gets none until its #version went by
+	if ( m_Stage < 0 || !m_VersionSeen[m_Stage] )
+		return;
+
+	char directive[48];
+	snprintf( directive, sizeof( directive ), "#line %u %u\n", line, fileIndex );
+	m_Out.m_Generated.emplace_back( directive );
+	m_Out.Stages[m_Stage].Chunks.push_back( m_Out.m_Generated.back() );
+}
+
+void ShaderParser::Append( std::string_view text )
+{
+	if ( m_Stage >= 0 && !text.empty() )
+		m_Out.Stages[m_Stage].Chunks.push_back( text );
+}
+
+bool ShaderParser::ParseFile( const std::filesystem::path& path, const std::string& from, unsigned int fromLine )
+{
+	std::error_code error;
+	std::filesystem::path canonical = std::filesystem::weakly_canonical( path, error );
+	std::string key = ( error ? path : canonical ).generic_string();
+
+	const bool isRoot = m_Out.Files.empty();
+	const std::string name = path.generic_string();
+
+	// Include-once is tracked per stage: a common file included by both the vertex
+	// and the fragment section must end up in both, but only once in each.
+	if ( isRoot )
+	{
+		for ( std::unordered_set<std::string>& included : m_Included )
+			included.insert( key );
+	}
+	else if ( !m_Included[m_Stage].insert( key ).second )
+	{
+		return false;
+	}
+
+	auto loaded = m_Loaded.find( key );
+	if ( loaded == m_Loaded.end() )
+	{
+		std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>( path );
+		if ( !file->IsOpen() )
+		{
+			if ( isRoot )
+				m_Out.Errors.push_back( "Failed to open " + name );
+			else
+				Error( from, fromLine, "failed to open include " + name );
+			return false;
+		}
+
+		loaded = m_Loaded.emplace( key, LoadedFile{ (unsigned int)m_Out.Files.size(), file->GetView() } ).first;
+		m_Out.Files.push_back( name );
+		m_Out.m_Mappings.push_back( std::move( file ) );
+	}
+
+	const std::string_view text = loaded->second.Text;
+	const unsigned int fileIndex = loaded->second.Index;
+
+	if ( !isRoot )
+		EmitLine( 1, fileIndex );
+
+	// Single pass over the mapping: ordinary lines only extend the current span,
+	// which is flushed as one view whenever a directive we handle interrupts it.
+	size_t spanStart = 0;
+	size_t pos = 0;
+	unsigned int line = 1;
+
+	while ( pos < text.size() )
+	{
+		size_t eol = text.find( '\n', pos );
+		size_t next = eol == std::string_view::npos ? text.size() : eol + 1;
+		std::string_view current = TrimFront( text.substr( pos, next - pos ) );
+
+		if ( !current.empty() && current[0] == '#' )
+		{
+			std::string_view rest;
+			std::string_view directive = TakeWord( current.substr( 1 ), rest );
+
+			if ( directive == "shader" )
+			{
+				Append( text.substr( spanStart, pos - spanStart ) );
+				spanStart = next;
+
+				if ( !isRoot )
+				{
+					Error( name, line, "#shader is not allowed in an included file" );
+				}
+				else
+				{
+					std::string_view stageName = Trim( rest );
+					m_Stage = -1;
+					for ( const ShaderStageName& entry : STAGE_NAMES )
+					{
+						if ( stageName == entry.Name )
+							m_Stage = (int)entry.Stage;
+					}
+
+					// Lines of an unknown section are dropped until the next valid #shader
+					if ( m_Stage < 0 )
+					{
+						Error( name, line, "unknown shader stage '" + std::string( stageName ) + "', section ignored" );
+					}
+					else
+					{
+						m_Out.Stages[m_Stage].Present = true;
+						EmitLine( line + 1, fileIndex );
+					}
+				}
+			}
+			else if ( directive == "include" )
+			{
+				Append( text.substr( spanStart, pos - spanStart ) );
+				spanStart = next;
+
+				std::string_view argument = Trim( rest );
+				if ( argument.size() < 2 || argument.front() != '"' || argument.back() != '"' )
+					Error( name, line, "expected #include \"file\"" );
+				else if ( m_Stage < 0 )
+					Error( name, line, "#include outside of a #shader section" );
+				else
+				{
+					std::filesystem::path included = path.parent_path() / std::string( argument.substr( 1, argument.size() - 2 ) );
+					if ( ParseFile( included, name, line ) )
+						EmitLine( line + 1, fileIndex );
+				}
+			}
+			else if ( directive == "version" && m_Stage >= 0 )
+			{
+				// Keep the #version line itself, then resync line numbers right after it
+				Append( text.substr( spanStart, next - spanStart ) );
+				spanStart = next;
+
+				m_VersionSeen[m_Stage] = true;
+				EmitLine( line + 1, fileIndex );
+			}
+		}
+
+		pos = next;
+		line++;
+	}
+
+	Append( text.substr( spanStart ) );
+
+	// Make sure the next chunk (an included file or a #line) starts on a fresh line
+	if ( !isRoot && !text.empty() && text.back() != '\n' )
+		Append( "\n" );
+
+	return true;
+}
+
+ShaderProgramSource ParseShader( const std::string& filepath )
+{
+	ShaderProgramSource source;
+	ShaderParser parser( source );
+	parser.ParseFile( filepath, std::string(), 0 );
+	return source;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class ShaderStage
+{
+	Vertex = 0,
+	Fragment,
+	Geometry,
+	TessControl,
+	TessEvaluation,
+	Compute,
+
+	Count
+};
+
+const char* GetShaderStageName( ShaderStage stage );
+
+// Source of one stage as a list of pieces to be concatenated: views into the
+// mapped shader files plus generated #line directives. Suitable for passing
+// straight to glShaderSource with explicit lengths, without joining.
+struct ShaderStageSource
+{
+	std::vector<std::string_view> Chunks;
+	bool Present = false;
+
+	size_t GetLength() const;
+	std::string ToString() const;
+};
+
+// Result of parsing a .shader file. Owns the file mappings the chunks point into,
+// so it is move-only and every view stays valid until it is destroyed.
+//
+// File format: '#shader <stage>' starts a section (vertex, fragment, geometry,
+// tess_control, tess_evaluation, compute); '#include "file"' is resolved relative
+// to the including file and each file is included at most once. #line directives
+// ('#line <line> <file index>') are emitted after '#version' and around includes,
+// so a driver error "N(L)" refers to line L of Files[N].
+class ShaderProgramSource
+{
+public:
+	ShaderStageSource Stages[(int)ShaderStage::Count];
+
+	// Every file that contributed source; the index is the #line source string number.
+	std::vector<std::string> Files;
+	std::vector<std::string> Errors;
+
+	const ShaderStageSource& GetStage( ShaderStage stage ) const { return Stages[(int)stage]; }
+	bool IsValid() const { return Errors.empty(); }
+
+private:
+	friend class ShaderParser;
+
+	std::vector<std::unique_ptr<MappedFile>> m_Mappings;
+	std::deque<std::string> m_Generated; // deque: growing it never moves existing strings
+};
+
+ShaderProgramSource ParseShader( const std::string& filepath );
@@ -0,0 +1,184 @@
+#include "ShaderSource.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+uint64_t HashShaderString( std::string_view text, uint64_t seed )
+{
+	uint64_t hash = seed;
+	for ( unsigned char c : text )
+	{
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+uint64_t ComputeShaderCacheKey( const ShaderProgramSource& source, const std::string& driver )
+{
+	// Stage names act as separators, so moving text between stages always changes the key
+	uint64_t key = HashShaderString( driver );
+	for ( int i = 0; i < (int)ShaderStage::Count; i++ )
+	{
+		const ShaderStageSource& stage = source.Stages[i];
+		if ( !stage.Present )
+			continue;
+
+		key = HashShaderString( "#shader ", key );
+		key = HashShaderString( GetShaderStageName( (ShaderStage)i ), key );
+		for ( std::string_view chunk : stage.Chunks )
+			key = HashShaderString( chunk, key );
+	}
+	return key;
+}
+
+// ----------------------------------------------------------------------------
+
+static const char CACHE_MAGIC[4] = { 'S', 'H', 'B', 'C' };
+static const uint32_t CACHE_VERSION = 1;
+
+struct ShaderCacheHeader
+{
+	char Magic[4];
+	uint32_t Version;
+	uint64_t Key;
+	uint32_t BinaryFormat;
+	uint32_t BinarySize;
+};
+
+static_assert( sizeof( ShaderCacheHeader ) == 24, "ShaderCacheHeader layout is part of the file format" );
+
+ShaderBinaryCache::ShaderBinaryCache( const std::filesystem::path& directory )
+	: m_Directory( directory )
+{
+	std::error_code error;
+	std::filesystem::create_directories( m_Directory, error );
+}
+
+std::filesystem::path ShaderBinaryCache::GetEntryPath( uint64_t key ) const
+{
+	char name[32];
+	snprintf( name, sizeof( name ), "%016llx.bin", (unsigned long long)key );
+	return m_Directory / name;
+}
+
+bool ShaderBinaryCache::Load( uint64_t key, unsigned int& binaryFormat, std::vector<char>& binary ) const
+{
+	std::ifstream stream( GetEntryPath( key ), std::ios::binary );
+	if ( !stream )
+		return false;
+
+	ShaderCacheHeader header;
+	stream.read( (char*)&header, sizeof( header ) );
+
+	bool valid = stream.gcount() == sizeof( header )
+		&& memcmp( header.Magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) ) == 0
+		&& header.Version == CACHE_VERSION
+		&& header.Key == key
+		&& header.BinarySize > 0;
+
+	if ( valid )
+	{
+		binary.resize( header.BinarySize );
+		stream.read( binary.data(), header.BinarySize );
+		valid = stream.gcount() == (std::streamsize)header.BinarySize;
+	}
+
+	if ( !valid )
+	{
+		stream.close();
+		Invalidate( key );
+		return false;
+	}
+
+	binaryFormat = header.BinaryFormat;
+	return true;
+}
+
+bool ShaderBinaryCache::Store( uint64_t key, unsigned int binaryFormat, const std::vector<char>& binary ) const
+{
+	if ( binary.empty() )
+		return false;
+
+	ShaderCacheHeader header;
+	memcpy( header.Magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+	header.Version = CACHE_VERSION;
+	header.Key = key;
+	header.BinaryFormat = binaryFormat;
+	header.BinarySize = (uint32_t)binary.size();
+
+	// Write to a temporary file first so a crash never leaves a half-written entry behind
+	std::filesystem::path path = GetEntryPath( key );
+	std::filesystem::path temp = path;
+	temp += ".tmp";
+
+	{
+		std::ofstream stream( temp, std::ios::binary | std::ios::trunc );
+		if ( !stream )
+			return false;
+
+		stream.write( (const char*)&header, sizeof( header ) );
+		stream.write( binary.data(), binary.size() );
+		if ( !stream )
+			return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename( temp, path, error );
+	return !error;
+}
+
+void ShaderBinaryCache::Invalidate( uint64_t key ) const
+{
+	std::error_code error;
+	std::filesystem::remove( GetEntryPath( key ), error );
+}
+
+// ----------------------------------------------------------------------------
+
+ShaderFileWatcher::ShaderFileWatcher( double interval )
+	: m_Interval( interval )
+{
+}
+
+void ShaderFileWatcher::Watch( const std::filesystem::path& file )
+{
+	for ( const WatchedFile& watched : m_Files )
+	{
+		if ( watched.Path == file )
+			return;
+	}
+
+	std::error_code error;
+	m_Files.push_back( { file, std::filesystem::last_write_time( file, error ) } );
+}
+
+void ShaderFileWatcher::Clear()
+{
+	m_Files.clear();
+}
+
+std::vector<std::filesystem::path> ShaderFileWatcher::Poll( double time )
+{
+	std::vector<std::filesystem::path> changed;
+
+	if ( m_LastPoll >= 0.0 && time - m_LastPoll < m_Interval )
+		return changed;
+	m_LastPoll = time;
+
+	for ( WatchedFile& watched : m_Files )
+	{
+		// Editors often replace files on save; a failed query just means "try again next poll"
+		std::error_code error;
+		std::filesystem::file_time_type lastWrite = std::filesystem::last_write_time( watched.Path, error );
+		if ( error || lastWrite == watched.LastWrite )
+			continue;
+
+		watched.LastWrite = lastWrite;
+		changed.push_back( watched.Path );
+	}
+
+	return changed;
+}
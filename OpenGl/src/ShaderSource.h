@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ShaderParser.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Everything in here (and in ShaderParser) is plain C++ with no OpenGL calls, so
+// shader parsing, cache keys and cache invalidation can be exercised without a GL context.
+
+// 64-bit FNV-1a, chained through 'seed' so several strings can be folded into one key.
+uint64_t HashShaderString( std::string_view text, uint64_t seed = 14695981039346656037ull );
+
+// Cache key of a linked program. Binaries are only valid for the driver that produced them,
+// so the driver identification string (vendor/renderer/version) is part of the key.
+uint64_t ComputeShaderCacheKey( const ShaderProgramSource& source, const std::string& driver );
+
+// On-disk store of linked program binaries, one file per cache key.
+// Each file carries a header with the key and the binary format; anything
+// that does not match (old format version, hash collision, truncated write)
+// is treated as a miss and deleted.
+class ShaderBinaryCache
+{
+public:
+	explicit ShaderBinaryCache( const std::filesystem::path& directory );
+
+	bool Load( uint64_t key, unsigned int& binaryFormat, std::vector<char>& binary ) const;
+	bool Store( uint64_t key, unsigned int binaryFormat, const std::vector<char>& binary ) const;
+	void Invalidate( uint64_t key ) const;
+
+	std::filesystem::path GetEntryPath( uint64_t key ) const;
+
+private:
+	std::filesystem::path m_Directory;
+};
+
+// Polls modification times of a set of files. Cheap enough to call once per frame:
+// the file system is only touched every 'interval' seconds of caller-supplied time.
+class ShaderFileWatcher
+{
+public:
+	explicit ShaderFileWatcher( double interval = 0.5 );
+
+	void Watch( const std::filesystem::path& file );
+	void Clear();
+
+	// Returns the files whose timestamp changed since the previous poll.
+	std::vector<std::filesystem::path> Poll( double time );
+
+private:
+	struct WatchedFile
+	{
+		std::filesystem::path Path;
+		std::filesystem::file_time_type LastWrite;
+	};
+
+	std::vector<WatchedFile> m_Files;
+	double m_Interval;
+	double m_LastPoll = -1.0;
+};
@@ -0,0 +1,41 @@
+#include "UniformBuffer.h"
+
+#include <GL/glew.h>
+
+#include <cstring>
+
+const SharedUniformBlock SHARED_UNIFORM_BLOCKS[] = {
+	{ "FrameData", FRAME_DATA_BINDING },
+};
+
+const int SHARED_UNIFORM_BLOCK_COUNT = sizeof( SHARED_UNIFORM_BLOCKS ) / sizeof( SHARED_UNIFORM_BLOCKS[0] );
+
+UniformBuffer::UniformBuffer( unsigned int binding, size_t size )
+	: m_Binding( binding ), m_Shadow( size )
+{
+	glGenBuffers( 1, &m_RendererID );
+	glBindBuffer( GL_UNIFORM_BUFFER, m_RendererID );
+	glBufferData( GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW );
+	glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+
+	glBindBufferBase( GL_UNIFORM_BUFFER, m_Binding, m_RendererID );
+}
+
+UniformBuffer::~UniformBuffer()
+{
+	glDeleteBuffers( 1, &m_RendererID );
+}
+
+bool UniformBuffer::Update( const void* data )
+{
+	if ( m_Valid && memcmp( m_Shadow.data(), data, m_Shadow.size() ) == 0 )
+		return false;
+
+	memcpy( m_Shadow.data(), data, m_Shadow.size() );
+	m_Valid = true;
+
+	glBindBuffer( GL_UNIFORM_BUFFER, m_RendererID );
+	glBufferSubData( GL_UNIFORM_BUFFER, 0, m_Shadow.size(), data );
+	glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+	return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ProgramReflection.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// Binding points of the uniform blocks shared by all programs.
+// ShaderLibrary attaches any block with one of these names when it reflects a program.
+static const unsigned int FRAME_DATA_BINDING = 0;
+
+extern const SharedUniformBlock SHARED_UNIFORM_BLOCKS[];
+extern const int SHARED_UNIFORM_BLOCK_COUNT;
+
+// CPU mirror of 'layout( std140 ) uniform FrameData' in the shaders. Keep members
+// vec4/mat4 sized, or add explicit padding, so the std140 offsets match.
+struct FrameUniforms
+{
+	glm::mat4 ViewProj;
+};
+
+static_assert( sizeof( FrameUniforms ) % 16 == 0, "std140 blocks are padded to 16 bytes" );
+
+// A uniform buffer permanently bound to one binding point. Update() keeps a copy
+// of the last upload and does nothing when the new contents are identical.
+class UniformBuffer
+{
+public:
+	UniformBuffer( unsigned int binding, size_t size );
+	~UniformBuffer();
+
+	UniformBuffer( const UniformBuffer& ) = delete;
+	UniformBuffer& operator=( const UniformBuffer& ) = delete;
+
+	// Returns true if the data was uploaded.
+	bool Update( const void* data );
+
+	unsigned int GetBinding() const { return m_Binding; }
+
+private:
+	unsigned int m_RendererID = 0;
+	unsigned int m_Binding;
+	std::vector<char> m_Shadow;
+	bool m_Valid = false;
+};
@@ -0,0 +1,92 @@
+#include "WorkerPool.h"
+
+#include "Profiler.h"
+
+WorkerPool::WorkerPool( unsigned int workerCount )
+{
+	m_Workers.reserve( workerCount );
+	for ( unsigned int i = 0; i < workerCount; i++ )
+		m_Workers.emplace_back( &WorkerPool::WorkerLoop, this );
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_Mutex );
+		m_Quit = true;
+	}
+	m_WakeCondition.notify_all();
+
+	for ( std::thread& worker : m_Workers )
+		worker.join();
+}
+
+void WorkerPool::ParallelFor( int count, JobFn job, void* data )
+{
+	if ( count <= 0 )
+		return;
+
+	if ( m_Workers.empty() || count == 1 )
+	{
+		for ( int i = 0; i < count; i++ )
+			job( data, i );
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( m_Mutex );
+		m_Job = job;
+		m_Data = data;
+		m_Count = count;
+		m_Next.store( 0 );
+		m_Busy = (int)m_Workers.size();
+		m_Batch++;
+	}
+	m_WakeCondition.notify_all();
+
+	RunJobs();
+
+	// Every worker must be out of the batch before its state is reused, not just every job started
+	std::unique_lock<std::mutex> lock( m_Mutex );
+	m_DoneCondition.wait( lock, [this] { return m_Busy == 0; } );
+}
+
+void WorkerPool::ImGuiParallelFor( void* pool, int count, JobFn job, void* data )
+{
+	( (WorkerPool*)pool )->ParallelFor( count, job, data );
+}
+
+void WorkerPool::RunJobs()
+{
+	PROFILE_SCOPE( "Jobs" );
+
+	for ( ;; )
+	{
+		int index = m_Next.fetch_add( 1 );
+		if ( index >= m_Count )
+			break;
+		m_Job( m_Data, index );
+	}
+}
+
+void WorkerPool::WorkerLoop()
+{
+	uint64_t batch = 0;
+
+	for ( ;; )
+	{
+		{
+			std::unique_lock<std::mutex> lock( m_Mutex );
+			m_WakeCondition.wait( lock, [&] { return m_Quit || m_Batch != batch; } );
+			if ( m_Quit )
+				return;
+			batch = m_Batch;
+		}
+
+		RunJobs();
+
+		std::lock_guard<std::mutex> lock( m_Mutex );
+		if ( --m_Busy == 0 )
+			m_DoneCondition.notify_one();
+	}
+}
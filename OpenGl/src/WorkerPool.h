@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads running ParallelFor() batches. The calling thread takes
+// part in every batch, so a pool of n workers spreads jobs over n + 1 threads.
+// Jobs are handed out one index at a time, which keeps uneven jobs balanced.
+class WorkerPool
+{
+public:
+	typedef void ( *JobFn )( void* data, int index );
+
+	explicit WorkerPool( unsigned int workerCount );
+	~WorkerPool();
+
+	// Runs job( data, i ) once for every i in [0, count) and returns when all of them completed.
+	void ParallelFor( int count, JobFn job, void* data );
+
+	unsigned int GetWorkerCount() const { return (unsigned int)m_Workers.size(); }
+
+	// Signature of ImGuiIO::ParallelForFn, with the pool as ParallelForUserData
+	static void ImGuiParallelFor( void* pool, int count, JobFn job, void* data );
+
+private:
+	void WorkerLoop();
+	void RunJobs();
+
+	std::vector<std::thread> m_Workers;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WakeCondition;
+	std::condition_variable m_DoneCondition;
+	uint64_t m_Batch = 0;
+	int m_Busy = 0; // workers that have not finished the current batch
+	bool m_Quit = false;
+
+	// Current batch, written under m_Mutex before waking the workers
+	JobFn m_Job = nullptr;
+	void* m_Data = nullptr;
+	int m_Count = 0;
+	std::atomic<int> m_Next{ 0 };
+};
@@ -63,9 +63,11 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
+// [SECTION] MISC HELPERS/UTILITIES (Memory: ImFrameArena, ImSizeClassPool)
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
 // [SECTION] ImGuiTextBuffer
+// [SECTION] ImGuiTextDocument
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -865,6 +867,9 @@ CODE
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#ifdef _MSC_VER
+#include <intrin.h>     // _InterlockedIncrement, _InterlockedExchange
+#endif
 
 // [Windows] On non-Visual Studio compilers, we default to IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS unless explicitly enabled
 #if defined(_WIN32) && !defined(_MSC_VER) && !defined(IMGUI_ENABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS)
@@ -954,6 +959,9 @@ static const float WINDOWS_HOVER_PADDING                    = 4.0f;     // Exten
 static const float WINDOWS_RESIZE_FROM_EDGES_FEEDBACK_TIMER = 0.04f;    // Reduce visual noise by only highlighting the border after a certain time.
 static const float WINDOWS_MOUSE_WHEEL_SCROLL_LOCK_TIMER    = 2.00f;    // Lock scrolled window (so it doesn't pick child windows that are scrolling through) for a certain time, unless mouse moved.
 
+// Idle frames
+static const float IDLE_HOVER_FEEDBACK_TIMER                = 1.00f;    // Keep rendering for this long after an item starts being hovered: resize borders, tab tooltips and drag and drop targets react to HoveredIdTimer.
+
 // Docking
 static const float DOCKING_TRANSPARENT_PAYLOAD_ALPHA        = 0.50f;    // For use with io.ConfigDockingTransparentPayload. Apply to Viewport _or_ WindowBg in host viewport.
 static const float DOCKING_SPLITTER_SIZE                    = 2.0f;
@@ -1023,6 +1031,9 @@ static void             RenderWindowDecorations(ImGuiWindow* window, const ImRec
 static void             RenderWindowTitleBarContents(ImGuiWindow* window, const ImRect& title_bar_rect, const char* name, bool* p_open);
 static void             RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32 col);
 static void             RenderDimmedBackgrounds();
+static void             WindowBeginRetainedDrawList(ImGuiWindow* window);
+static void             UpdateRetainedDrawListsEndFrame();
+static void             UpdateEventWaitingTimeEndFrame();
 static ImGuiWindow*     FindBlockingModal(ImGuiWindow* window);
 
 // Viewports
@@ -1222,6 +1233,7 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigDrawNoSimd = false;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -1803,9 +1815,33 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     if (out_buf_end) { *out_buf_end = g.TempBuffer.Data + buf_len; }
 }
 
-// CRC32 needs a 1KB lookup table (not cache friendly)
-// Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
+// IDs are CRC32 hashes computed with a 1KB lookup table.
+// Define IMGUI_USE_CRC32C_HASH in imconfig.h to use CRC32C (Castagnoli) instead, computed with the CRC32 instruction when the CPU has one
+// (SSE 4.2 on x64, ARMv8 CRC extension) and with the table otherwise. Both give the same values, so .ini data doesn't depend on the machine that wrote it,
+// but CRC32C changes every ID: settings stored by ID in existing .ini files (docking layouts, tables) would be lost once, which is why it is opt-in.
+// Using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
+#ifdef IMGUI_USE_CRC32C_HASH
+static const ImU32 GCrc32LookupTable[256] =
+{
+    0x00000000,0xF26B8303,0xE13B70F7,0x1350F3F4,0xC79A971F,0x35F1141C,0x26A1E7E8,0xD4CA64EB,0x8AD958CF,0x78B2DBCC,0x6BE22838,0x9989AB3B,0x4D43CFD0,0xBF284CD3,0xAC78BF27,0x5E133C24,
+    0x105EC76F,0xE235446C,0xF165B798,0x030E349B,0xD7C45070,0x25AFD373,0x36FF2087,0xC494A384,0x9A879FA0,0x68EC1CA3,0x7BBCEF57,0x89D76C54,0x5D1D08BF,0xAF768BBC,0xBC267848,0x4E4DFB4B,
+    0x20BD8EDE,0xD2D60DDD,0xC186FE29,0x33ED7D2A,0xE72719C1,0x154C9AC2,0x061C6936,0xF477EA35,0xAA64D611,0x580F5512,0x4B5FA6E6,0xB93425E5,0x6DFE410E,0x9F95C20D,0x8CC531F9,0x7EAEB2FA,
+    0x30E349B1,0xC288CAB2,0xD1D83946,0x23B3BA45,0xF779DEAE,0x05125DAD,0x1642AE59,0xE4292D5A,0xBA3A117E,0x4851927D,0x5B016189,0xA96AE28A,0x7DA08661,0x8FCB0562,0x9C9BF696,0x6EF07595,
+    0x417B1DBC,0xB3109EBF,0xA0406D4B,0x522BEE48,0x86E18AA3,0x748A09A0,0x67DAFA54,0x95B17957,0xCBA24573,0x39C9C670,0x2A993584,0xD8F2B687,0x0C38D26C,0xFE53516F,0xED03A29B,0x1F682198,
+    0x5125DAD3,0xA34E59D0,0xB01EAA24,0x42752927,0x96BF4DCC,0x64D4CECF,0x77843D3B,0x85EFBE38,0xDBFC821C,0x2997011F,0x3AC7F2EB,0xC8AC71E8,0x1C661503,0xEE0D9600,0xFD5D65F4,0x0F36E6F7,
+    0x61C69362,0x93AD1061,0x80FDE395,0x72966096,0xA65C047D,0x5437877E,0x4767748A,0xB50CF789,0xEB1FCBAD,0x197448AE,0x0A24BB5A,0xF84F3859,0x2C855CB2,0xDEEEDFB1,0xCDBE2C45,0x3FD5AF46,
+    0x7198540D,0x83F3D70E,0x90A324FA,0x62C8A7F9,0xB602C312,0x44694011,0x5739B3E5,0xA55230E6,0xFB410CC2,0x092A8FC1,0x1A7A7C35,0xE811FF36,0x3CDB9BDD,0xCEB018DE,0xDDE0EB2A,0x2F8B6829,
+    0x82F63B78,0x709DB87B,0x63CD4B8F,0x91A6C88C,0x456CAC67,0xB7072F64,0xA457DC90,0x563C5F93,0x082F63B7,0xFA44E0B4,0xE9141340,0x1B7F9043,0xCFB5F4A8,0x3DDE77AB,0x2E8E845F,0xDCE5075C,
+    0x92A8FC17,0x60C37F14,0x73938CE0,0x81F80FE3,0x55326B08,0xA759E80B,0xB4091BFF,0x466298FC,0x1871A4D8,0xEA1A27DB,0xF94AD42F,0x0B21572C,0xDFEB33C7,0x2D80B0C4,0x3ED04330,0xCCBBC033,
+    0xA24BB5A6,0x502036A5,0x4370C551,0xB11B4652,0x65D122B9,0x97BAA1BA,0x84EA524E,0x7681D14D,0x2892ED69,0xDAF96E6A,0xC9A99D9E,0x3BC21E9D,0xEF087A76,0x1D63F975,0x0E330A81,0xFC588982,
+    0xB21572C9,0x407EF1CA,0x532E023E,0xA145813D,0x758FE5D6,0x87E466D5,0x94B49521,0x66DF1622,0x38CC2A06,0xCAA7A905,0xD9F75AF1,0x2B9CD9F2,0xFF56BD19,0x0D3D3E1A,0x1E6DCDEE,0xEC064EED,
+    0xC38D26C4,0x31E6A5C7,0x22B65633,0xD0DDD530,0x0417B1DB,0xF67C32D8,0xE52CC12C,0x1747422F,0x49547E0B,0xBB3FFD08,0xA86F0EFC,0x5A048DFF,0x8ECEE914,0x7CA56A17,0x6FF599E3,0x9D9E1AE0,
+    0xD3D3E1AB,0x21B862A8,0x32E8915C,0xC083125F,0x144976B4,0xE622F5B7,0xF5720643,0x07198540,0x590AB964,0xAB613A67,0xB831C993,0x4A5A4A90,0x9E902E7B,0x6CFBAD78,0x7FAB5E8C,0x8DC0DD8F,
+    0xE330A81A,0x115B2B19,0x020BD8ED,0xF0605BEE,0x24AA3F05,0xD6C1BC06,0xC5914FF2,0x37FACCF1,0x69E9F0D5,0x9B8273D6,0x88D28022,0x7AB90321,0xAE7367CA,0x5C18E4C9,0x4F48173D,0xBD23943E,
+    0xF36E6F75,0x0105EC76,0x12551F82,0xE03E9C81,0x34F4F86A,0xC69F7B69,0xD5CF889D,0x27A40B9E,0x79B737BA,0x8BDCB4B9,0x988C474D,0x6AE7C44E,0xBE2DA0A5,0x4C4623A6,0x5F16D052,0xAD7D5351,
+};
+#else
 static const ImU32 GCrc32LookupTable[256] =
 {
     0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
@@ -1825,18 +1861,94 @@ static const ImU32 GCrc32LookupTable[256] =
     0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
     0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
 };
+#endif
 
-// Known size hash
-// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+#if defined(IMGUI_USE_CRC32C_HASH) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define IMGUI_ENABLE_HASH_CRC32_ARM
+#elif defined(IMGUI_USE_CRC32C_HASH) && defined(IMGUI_ENABLE_SSE) && (defined(__x86_64__) || defined(_M_X64))
+#define IMGUI_ENABLE_HASH_CRC32_SSE42
+#if defined(__SSE4_2__)
+#define IMGUI_HASH_SSE42_TARGET
+#elif defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>             // __cpuid
+#define IMGUI_HASH_SSE42_TARGET
+#else
+#include <cpuid.h>              // __get_cpuid
+#define IMGUI_HASH_SSE42_TARGET __attribute__((target("sse4.2")))
+#endif
+#endif
+
+static ImU32 ImHashUpdateTable(ImU32 crc, const unsigned char* data, size_t data_size)
 {
-    ImU32 crc = ~seed;
-    const unsigned char* data = (const unsigned char*)data_p;
     const ImU32* crc32_lut = GCrc32LookupTable;
     while (data_size-- != 0)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
-    return ~crc;
+    return crc;
+}
+
+#if defined(IMGUI_ENABLE_HASH_CRC32_SSE42)
+static bool ImHashDetectCrc32Instruction()
+{
+#if defined(__SSE4_2__)
+    return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int cpu_info[4];
+    __cpuid(cpu_info, 1);
+    return (cpu_info[2] & (1 << 20)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+#endif
+}
+
+// Zero until dynamic initialization: hashes computed by static constructors before that use the table, with identical results.
+static const bool GImHashHasCrc32Instruction = ImHashDetectCrc32Instruction();
+
+IMGUI_HASH_SSE42_TARGET static ImU32 ImHashUpdateSse42(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    ImU64 crc64 = crc;
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc64 = _mm_crc32_u64(crc64, v);
+    }
+    crc = (ImU32)crc64;
+    if (data_size & 4) { ImU32 v; memcpy(&v, data, 4); crc = _mm_crc32_u32(crc, v); data += 4; }
+    if (data_size & 2) { ImU16 v; memcpy(&v, data, 2); crc = _mm_crc32_u16(crc, v); data += 2; }
+    if (data_size & 1) { crc = _mm_crc32_u8(crc, *data); }
+    return crc;
+}
+#define IMGUI_HASH_HAS_CRC32_INSTRUCTION    GImHashHasCrc32Instruction
+#define ImHashUpdateInstruction             ImHashUpdateSse42
+#elif defined(IMGUI_ENABLE_HASH_CRC32_ARM)
+static ImU32 ImHashUpdateArm(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = __crc32cd(crc, v);
+    }
+    if (data_size & 4) { ImU32 v; memcpy(&v, data, 4); crc = __crc32cw(crc, v); data += 4; }
+    if (data_size & 2) { ImU16 v; memcpy(&v, data, 2); crc = __crc32ch(crc, v); data += 2; }
+    if (data_size & 1) { crc = __crc32cb(crc, *data); }
+    return crc;
+}
+#define IMGUI_HASH_HAS_CRC32_INSTRUCTION    true
+#define ImHashUpdateInstruction             ImHashUpdateArm
+#endif
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+#ifdef IMGUI_HASH_HAS_CRC32_INSTRUCTION
+    if (IMGUI_HASH_HAS_CRC32_INSTRUCTION)
+        return ~ImHashUpdateInstruction(~seed, (const unsigned char*)data_p, data_size);
+#endif
+    return ~ImHashUpdateTable(~seed, (const unsigned char*)data_p, data_size);
 }
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
@@ -1844,9 +1956,20 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - With the CRC32 instruction, hashing is cheap enough that finding the last ### first (memchr) then hashing whole words from there is faster.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
 {
+#ifdef IMGUI_HASH_HAS_CRC32_INSTRUCTION
+    if (IMGUI_HASH_HAS_CRC32_INSTRUCTION)
+    {
+        const char* data_begin = data_p;
+        const char* data_end = data_p + (data_size != 0 ? data_size : strlen(data_p));
+        for (const char* p = data_begin; data_end - p >= 3 && (p = (const char*)memchr(p, '#', (size_t)(data_end - p - 2))) != NULL; p++)
+            if (p[1] == '#' && p[2] == '#')
+                data_begin = p;
+        return ~ImHashUpdateInstruction(~seed, (const unsigned char*)data_begin, (size_t)(data_end - data_begin));
+    }
+#endif
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
@@ -1873,6 +1996,21 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     return ~crc;
 }
 
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+// The length and the ### operator were resolved at compile time, leaving a plain hash of the hashed part.
+// With the CRC32 instruction the string isn't even read: CRCs are linear, so hashing it from the seed
+// == hashing it from 0 (done at compile time, str.Crc) xor hashing as many zero bytes from the seed.
+ImGuiID ImHashStr(const ImGuiHashedStr& str, ImU32 seed)
+{
+#ifdef IMGUI_HASH_HAS_CRC32_INSTRUCTION
+    static const unsigned char zeros[64] = {};
+    if (IMGUI_HASH_HAS_CRC32_INSTRUCTION && str.Len <= IM_ARRAYSIZE(zeros))
+        return ~(ImHashUpdateInstruction(~seed, zeros, str.Len) ^ str.Crc);
+#endif
+    return ImHashData(str.StrEnd - str.Len, str.Len, seed);
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -1950,11 +2088,47 @@ void*   ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_f
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 //-----------------------------------------------------------------------------
 
+// SSE2 or AArch64 NEON scanning of ASCII runs in ImTextStrFromUtf8() and ImTextCountCharsFromUtf8(). #define IMGUI_DISABLE_SIMD_UTF8 to compile it out.
+#if !defined(IMGUI_DISABLE_SIMD_UTF8) && (defined(IMGUI_ENABLE_SSE) || defined(__aarch64__) || defined(_M_ARM64))
+#define IMGUI_ENABLE_SIMD_UTF8
+#ifndef IMGUI_ENABLE_SSE
+#include <arm_neon.h>
+#endif
+#endif
+
 // Convert UTF-8 to 32-bit character, process single character input.
 // A nearly-branchless UTF-8 decoder, based on work of Christopher Wellons (https://github.com/skeeto/branchless-utf8).
 // We handle UTF-8 decoding error by skipping forward.
 int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end)
 {
+    // Fast path for ASCII and well-formed 2 and 3 bytes sequences (every code point of the BMP but surrogates), which is nearly all text.
+    // Bytes are only read while the previous one was part of the sequence, so this never reads past a 0 terminator.
+    // 4 bytes sequences and invalid or truncated input go through the decoder below, which defines how errors are handled.
+    const unsigned char* p = (const unsigned char*)in_text;
+    if (in_text_end == NULL || in_text < in_text_end)
+    {
+        const unsigned int c0 = p[0];
+        if (c0 < 0x80)
+        {
+            *out_char = c0;
+            return 1;
+        }
+        if (c0 >= 0xC2 && c0 <= 0xDF && (in_text_end == NULL || in_text_end - in_text >= 2) && (p[1] & 0xC0) == 0x80)
+        {
+            *out_char = ((c0 & 0x1F) << 6) | (p[1] & 0x3F);
+            return 2;
+        }
+        if ((c0 & 0xF0) == 0xE0 && (in_text_end == NULL || in_text_end - in_text >= 3) && (p[1] & 0xC0) == 0x80 && (p[2] & 0xC0) == 0x80)
+        {
+            const unsigned int c = ((c0 & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+            if (c >= 0x800 && (c >> 11) != 0x1B) // Non-canonical encoding or surrogate half otherwise
+            {
+                *out_char = c;
+                return 3;
+            }
+        }
+    }
+
     static const char lengths[32] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 3, 3, 4, 0 };
     static const int masks[]  = { 0x00, 0x7f, 0x1f, 0x0f, 0x07 };
     static const uint32_t mins[] = { 0x400000, 0, 0x80, 0x800, 0x10000 };
@@ -2005,12 +2179,57 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+// Return the number of bytes in [in_text, in_text_end) before the first one that is 0 or not ASCII.
+static int ImTextCountAsciiPrefix(const char* in_text, const char* in_text_end)
+{
+    const char* p = in_text;
+#ifdef IMGUI_ENABLE_SIMD_UTF8
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i zero = _mm_setzero_si128();
+    while (in_text_end - p >= 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)p);
+        if (_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, zero))) != 0) // Top bit set for bytes >= 0x80, and for 0
+            break;
+        p += 16;
+    }
+#else
+    const uint8x16_t one = vdupq_n_u8(1);
+    while (in_text_end - p >= 16)
+    {
+        const uint8x16_t v = vld1q_u8((const uint8_t*)p);
+        if (vmaxvq_u8(vsubq_u8(v, one)) >= 0x7F) // 0x01..0x7F become 0x00..0x7E, 0 wraps around to 0xFF
+            break;
+        p += 16;
+    }
+#endif
+#endif
+    while (p < in_text_end && (unsigned char)(*p - 1) < 0x7F)
+        p++;
+    return (int)(p - in_text);
+}
+
+// Runs of ASCII characters are copied in bulk, the rest is decoded one character at a time.
+// When 'in_text_end' is NULL, the terminator bounds the bulk reads. Characters are still decoded without an end, as before: an invalid
+// sequence followed by 0 may consume it, in which case decoding carries on after it and we look for the next terminator.
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
+    const char* scan_end = in_text_end ? in_text_end : in_text + strlen(in_text);
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if ((unsigned char)*in_text < 0x80)
+        {
+            if (in_text >= scan_end)
+                scan_end = in_text + strlen(in_text);
+            const int ascii_len = ImTextCountAsciiPrefix(in_text, in_text + ImMin((int)(scan_end - in_text), (int)(buf_end - 1 - buf_out)));
+            for (int n = 0; n < ascii_len; n++)
+                buf_out[n] = (ImWchar)(unsigned char)in_text[n];
+            buf_out += ascii_len;
+            in_text += ascii_len;
+            continue;
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
@@ -2026,8 +2245,18 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
 int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
 {
     int char_count = 0;
+    const char* scan_end = in_text_end ? in_text_end : in_text + strlen(in_text); // See ImTextStrFromUtf8()
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if ((unsigned char)*in_text < 0x80)
+        {
+            if (in_text >= scan_end)
+                scan_end = in_text + strlen(in_text);
+            const int ascii_len = ImTextCountAsciiPrefix(in_text, scan_end);
+            char_count += ascii_len;
+            in_text += ascii_len;
+            continue;
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
@@ -2211,35 +2440,239 @@ void ImGui::ColorConvertHSVtoRGB(float h, float s, float v, float& out_r, float&
     }
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] MISC HELPERS/UTILITIES (Memory: ImFrameArena, ImSizeClassPool)
+//-----------------------------------------------------------------------------
+
+void* ImFrameArena::Alloc(size_t size)
+{
+    size = IM_MEMALIGN(size, 16);
+    if (size > LargeThreshold)
+    {
+        void* ptr = IM_ALLOC(size);
+        Overflow.push_back(ptr);
+        LargeSize += size;
+        return ptr;
+    }
+    if (Block == NULL)
+    {
+        if (BlockSize == 0)
+            BlockSize = 64 * 1024;
+        Block = (char*)IM_ALLOC(BlockSize);
+    }
+    if (Used + size <= BlockSize)
+    {
+        void* ptr = Block + Used;
+        Used += size;
+        return ptr;
+    }
+    void* ptr = IM_ALLOC(size);
+    Overflow.push_back(ptr);
+    OverflowSize += size;
+    return ptr;
+}
+
+void ImFrameArena::Reset()
+{
+    LastFrameSize = Used + OverflowSize + LargeSize;
+    for (int n = 0; n < Overflow.Size; n++)
+        IM_FREE(Overflow[n]);
+    Overflow.resize(0);
+    if (OverflowSize > 0)
+    {
+        // The block was too small for this frame: make the next one hold all of it (large requests excluded)
+        IM_FREE(Block);
+        Block = NULL;
+        BlockSize = IM_MEMALIGN(BlockSize + OverflowSize + OverflowSize / 2, 4096);
+    }
+    Used = OverflowSize = LargeSize = 0;
+}
+
+void ImFrameArena::Clear()
+{
+    Reset();
+    IM_FREE(Block);
+    Block = NULL;
+    BlockSize = 0;
+    Overflow.clear();
+}
+
+struct ImSizeClassPoolHeader
+{
+    ImSizeClassPool*    Pool;
+    int                 ClassIdx;           // -1 for a large block
+};
+
+void* ImSizeClassPool::Alloc(size_t size)
+{
+    IM_STATIC_ASSERT(sizeof(ImSizeClassPoolHeader) <= HeaderSize);
+    size += HeaderSize;
+    int class_idx = 0;
+    while (class_idx < ClassCount && (size_t)GetClassSize(class_idx) < size)
+        class_idx++;
+
+    char* block;
+    if (class_idx == ClassCount)
+    {
+        block = (char*)IM_ALLOC(size);
+        class_idx = -1;
+        LargeBlocks++;
+    }
+    else
+    {
+        if (FreeList[class_idx] == NULL)
+        {
+            // Carve a new slab into blocks of that class
+            const int block_size = GetClassSize(class_idx);
+            const int block_count = SlabSize / block_size;
+            char* slab = (char*)IM_ALLOC(SlabSize);
+            Slabs.push_back(slab);
+            for (int n = block_count - 1; n >= 0; n--)
+            {
+                *(void**)(void*)(slab + n * block_size) = FreeList[class_idx];
+                FreeList[class_idx] = slab + n * block_size;
+            }
+            TotalBlocks[class_idx] += block_count;
+        }
+        block = (char*)FreeList[class_idx];
+        FreeList[class_idx] = *(void**)(void*)block;
+        UsedBlocks[class_idx]++;
+    }
+
+    ImSizeClassPoolHeader* header = (ImSizeClassPoolHeader*)(void*)block;
+    header->Pool = this;
+    header->ClassIdx = class_idx;
+    return block + HeaderSize;
+}
+
+void ImSizeClassPool::Free(void* ptr)
+{
+    if (ptr == NULL)
+        return;
+    char* block = (char*)ptr - HeaderSize;
+    ImSizeClassPoolHeader* header = (ImSizeClassPoolHeader*)(void*)block;
+    ImSizeClassPool* pool = header->Pool;
+    const int class_idx = header->ClassIdx;
+    if (class_idx < 0)
+    {
+        pool->LargeBlocks--;
+        IM_FREE(block);
+        return;
+    }
+    IM_ASSERT(class_idx < ClassCount && pool->UsedBlocks[class_idx] > 0);
+    *(void**)(void*)block = pool->FreeList[class_idx];
+    pool->FreeList[class_idx] = block;
+    pool->UsedBlocks[class_idx]--;
+}
+
+void ImSizeClassPool::Clear()
+{
+    for (int class_idx = 0; class_idx < ClassCount; class_idx++)
+        IM_ASSERT(UsedBlocks[class_idx] == 0 && "Blocks are still in use!");
+    IM_ASSERT(LargeBlocks == 0 && "Blocks are still in use!");
+    for (int n = 0; n < Slabs.Size; n++)
+        IM_FREE(Slabs[n]);
+    Slabs.clear();
+    memset(FreeList, 0, sizeof(FreeList));
+    memset(TotalBlocks, 0, sizeof(TotalBlocks));
+}
+
+size_t ImSizeClassPool::CalcMemoryUsage() const
+{
+    return (size_t)Slabs.Size * SlabSize + (size_t)Slabs.Capacity * sizeof(void*);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiStorage
 // Helper: Key->value storage
 //-----------------------------------------------------------------------------
 
-// std::lower_bound but without the bullshit
-static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImGuiID key)
+// Pairs live in Data in insertion order. Slots is a Robin Hood hash table of (key, index into Data):
+// an entry is never further from its home slot than the entry it would have displaced, so a lookup
+// for a missing key stops as soon as it meets an entry closer to home than the current probe distance.
+// There is no removal (apart from Clear()), so no tombstones are needed.
+static inline ImU32 StorageHomeSlot(ImGuiID key, ImU32 mask)
 {
-    ImGuiStorage::ImGuiStoragePair* first = data.Data;
-    ImGuiStorage::ImGuiStoragePair* last = data.Data + data.Size;
-    size_t count = (size_t)(last - first);
-    while (count > 0)
+    // IDs are already hashes, but user keys may be sequential or share low bits (e.g. pointers)
+    ImU32 h = key * 0x9E3779B1u;
+    return (h ^ (h >> 16)) & mask;
+}
+
+// A key that is already indexed is left alone. An indexed duplicate sits in the cluster before any entry
+// this probe could displace, so it is always met before 'entry' stops carrying the new key.
+static void StorageInsertSlot(ImGuiStorage* storage, ImGuiID key, int index)
+{
+    const ImU32 mask = (ImU32)storage->Slots.Size - 1;
+    ImGuiStorage::ImGuiStorageSlot entry = { key, index };
+    ImU32 dist = 0;
+    for (ImU32 pos = StorageHomeSlot(key, mask);; pos = (pos + 1) & mask, dist++)
     {
-        size_t count2 = count >> 1;
-        ImGuiStorage::ImGuiStoragePair* mid = first + count2;
-        if (mid->key < key)
+        ImGuiStorage::ImGuiStorageSlot* slot = &storage->Slots.Data[pos];
+        if (slot->index < 0)
         {
-            first = ++mid;
-            count -= count2 + 1;
+            *slot = entry;
+            return;
         }
-        else
+        if (slot->key == entry.key)
+            return;
+        const ImU32 slot_dist = (pos - StorageHomeSlot(slot->key, mask)) & mask;
+        if (slot_dist < dist)
         {
-            count = count2;
+            ImSwap(*slot, entry);
+            dist = slot_dist;
         }
     }
-    return first;
 }
 
-// For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+// Re-index every pair of Data. With duplicate keys (pairs added to Data directly), the first one wins.
+static void StorageRebuildSlots(ImGuiStorage* storage)
+{
+    int capacity = 16;
+    while (capacity * 3 < (storage->Data.Size + 1) * 4)
+        capacity *= 2;
+    storage->Slots.resize(capacity);
+    memset(storage->Slots.Data, 0xFF, (size_t)storage->Slots.size_in_bytes()); // index = -1
+    for (int n = 0; n < storage->Data.Size; n++)
+        StorageInsertSlot(storage, storage->Data[n].key, n);
+    storage->SlotsCount = storage->Data.Size;
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->SlotsCount != storage->Data.Size)
+        StorageRebuildSlots(const_cast<ImGuiStorage*>(storage));
+    if (storage->Data.Size == 0)
+        return NULL;
+    const ImU32 mask = (ImU32)storage->Slots.Size - 1;
+    ImU32 dist = 0;
+    for (ImU32 pos = StorageHomeSlot(key, mask);; pos = (pos + 1) & mask, dist++)
+    {
+        const ImGuiStorage::ImGuiStorageSlot* slot = &storage->Slots.Data[pos];
+        if (slot->index < 0 || ((pos - StorageHomeSlot(slot->key, mask)) & mask) < dist)
+            return NULL;
+        if (slot->key == key)
+            return &storage->Data.Data[slot->index];
+    }
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrAdd(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& new_pair)
+{
+    if (ImGuiStorage::ImGuiStoragePair* it = StorageFind(storage, new_pair.key))
+        return it;
+    storage->Data.push_back(new_pair);
+    if (storage->Data.Size * 4 > storage->Slots.Size * 3)
+    {
+        StorageRebuildSlots(storage);
+    }
+    else
+    {
+        StorageInsertSlot(storage, new_pair.key, storage->Data.Size - 1);
+        storage->SlotsCount++;
+    }
+    return &storage->Data.back();
+}
+
+// For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents to Data and then sort/index once.
 void ImGuiStorage::BuildSortByKey()
 {
     struct StaticFunc
@@ -2253,14 +2686,13 @@ void ImGuiStorage::BuildSortByKey()
         }
     };
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairComparerByID);
+    StorageRebuildSlots(this);
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2270,27 +2702,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2300,30 +2725,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_i = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2333,24 +2745,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_f = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_p = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2527,6 +2927,285 @@ void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
     va_end(args_copy);
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiTextDocument
+//-----------------------------------------------------------------------------
+
+// Index of the first element >= value
+static int TextDocumentLowerBound(const ImVector<int>& v, int value)
+{
+    int first = 0, count = v.Size;
+    while (count > 0)
+    {
+        const int step = count >> 1;
+        if (v.Data[first + step] < value)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return first;
+}
+
+static int TextDocumentCountLineBreaks(const ImVector<int>& line_breaks, int offset, int length)
+{
+    return TextDocumentLowerBound(line_breaks, offset + length) - TextDocumentLowerBound(line_breaks, offset);
+}
+
+static void TextDocumentAppend(ImVector<char>* buf, ImVector<int>* line_breaks, const char* text, const char* text_end)
+{
+    const int offset = buf->Size;
+    const int length = (int)(text_end - text);
+    if (length == 0)
+        return; // buf->Data may be NULL, which memcpy() does not accept even for 0 bytes
+    buf->resize(offset + length);
+    memcpy(buf->Data + offset, text, (size_t)length);
+    for (const char* p = text; (p = (const char*)memchr(p, '\n', (size_t)(text_end - p))) != NULL; p++)
+        line_breaks->push_back(offset + (int)(p - text));
+}
+
+void ImGuiTextDocument::SetText(const char* text, const char* text_end)
+{
+    if (text_end == NULL)
+        text_end = text + strlen(text);
+    Original.resize(0);
+    Added.resize(0);
+    LineBreaks[0].resize(0);
+    LineBreaks[1].resize(0);
+    TextDocumentAppend(&Original, &LineBreaks[0], text, text_end);
+    Pieces.resize(0);
+    if (Original.Size > 0)
+    {
+        ImGuiTextDocumentPiece piece = { 0, 0, Original.Size, LineBreaks[0].Size };
+        Pieces.push_back(piece);
+    }
+    Length = Original.Size;
+    LineCount = LineBreaks[0].Size + 1;
+    UndoRecords.resize(0);
+    UndoPieces.resize(0);
+    UndoPoint = 0;
+    Cursor = SelectStart = SelectEnd = 0;
+    CursorAnim = 0.0f;
+    PreferredX = -1.0f;
+    ContentWidth = 0.0f;
+    CursorFollow = false;
+}
+
+int ImGuiTextDocument::GetLineStart(int line) const
+{
+    if (line <= 0)
+        return 0;
+    int breaks_to_skip = line;
+    int piece_start = 0;
+    for (const ImGuiTextDocumentPiece* piece = Pieces.Data; piece != Pieces.Data + Pieces.Size; piece++)
+    {
+        if (breaks_to_skip <= piece->LineBreaks)
+        {
+            const ImVector<int>& line_breaks = LineBreaks[piece->Buffer];
+            const int line_break = line_breaks.Data[TextDocumentLowerBound(line_breaks, piece->Offset) + breaks_to_skip - 1];
+            return piece_start + (line_break - piece->Offset) + 1;
+        }
+        breaks_to_skip -= piece->LineBreaks;
+        piece_start += piece->Length;
+    }
+    return Length;
+}
+
+int ImGuiTextDocument::GetLineEnd(int line) const
+{
+    return (line + 1 < LineCount) ? GetLineStart(line + 1) - 1 : Length;
+}
+
+int ImGuiTextDocument::GetLineFromOffset(int offset) const
+{
+    int line = 0;
+    int piece_start = 0;
+    for (const ImGuiTextDocumentPiece* piece = Pieces.Data; piece != Pieces.Data + Pieces.Size; piece++)
+    {
+        if (offset < piece_start + piece->Length)
+            return line + TextDocumentCountLineBreaks(LineBreaks[piece->Buffer], piece->Offset, offset - piece_start);
+        line += piece->LineBreaks;
+        piece_start += piece->Length;
+    }
+    return line;
+}
+
+char ImGuiTextDocument::GetChar(int offset) const
+{
+    int piece_start = 0;
+    for (const ImGuiTextDocumentPiece* piece = Pieces.Data; piece != Pieces.Data + Pieces.Size; piece++)
+    {
+        if (offset < piece_start + piece->Length)
+            return (piece->Buffer == 0 ? Original.Data : Added.Data)[piece->Offset + offset - piece_start];
+        piece_start += piece->Length;
+    }
+    return 0;
+}
+
+const char* ImGuiTextDocument::GetText(int offset, int length, ImVector<char>* scratch) const
+{
+    IM_ASSERT(offset >= 0 && length >= 0 && offset + length <= Length);
+    scratch->resize(0);
+    int piece_start = 0;
+    for (const ImGuiTextDocumentPiece* piece = Pieces.Data; piece != Pieces.Data + Pieces.Size && length > 0; piece++)
+    {
+        const int piece_end = piece_start + piece->Length;
+        if (offset < piece_end)
+        {
+            const char* src = (piece->Buffer == 0 ? Original.Data : Added.Data) + piece->Offset + (offset - piece_start);
+            const int copy_length = ImMin(length, piece_end - offset);
+            if (copy_length == length && scratch->Size == 0)
+                return src; // Contiguous
+            const int write_offset = scratch->Size;
+            scratch->resize(write_offset + copy_length);
+            memcpy(scratch->Data + write_offset, src, (size_t)copy_length);
+            offset += copy_length;
+            length -= copy_length;
+        }
+        piece_start = piece_end;
+    }
+    scratch->push_back(0);
+    return scratch->Data;
+}
+
+int ImGuiTextDocument::SplitPiece(int offset)
+{
+    int piece_start = 0;
+    for (int piece_n = 0; piece_n < Pieces.Size; piece_n++)
+    {
+        ImGuiTextDocumentPiece& piece = Pieces[piece_n];
+        if (offset == piece_start)
+            return piece_n;
+        if (offset < piece_start + piece.Length)
+        {
+            ImGuiTextDocumentPiece tail = piece;
+            piece.Length = offset - piece_start;
+            piece.LineBreaks = TextDocumentCountLineBreaks(LineBreaks[piece.Buffer], piece.Offset, piece.Length);
+            tail.Offset += piece.Length;
+            tail.Length -= piece.Length;
+            tail.LineBreaks -= piece.LineBreaks;
+            Pieces.insert(Pieces.Data + piece_n + 1, tail);
+            return piece_n + 1;
+        }
+        piece_start += piece.Length;
+    }
+    return Pieces.Size;
+}
+
+void ImGuiTextDocument::DeletePieces(int offset, int length, ImVector<ImGuiTextDocumentPiece>* out_deleted)
+{
+    if (length <= 0)
+        return;
+    const int piece_begin = SplitPiece(offset);
+    const int piece_end = SplitPiece(offset + length);
+    for (int piece_n = piece_begin; piece_n < piece_end; piece_n++)
+    {
+        LineCount -= Pieces[piece_n].LineBreaks;
+        if (out_deleted)
+            out_deleted->push_back(Pieces[piece_n]);
+    }
+    Pieces.erase(Pieces.Data + piece_begin, Pieces.Data + piece_end);
+    Length -= length;
+}
+
+void ImGuiTextDocument::InsertPieces(int offset, const ImGuiTextDocumentPiece* pieces, int pieces_count)
+{
+    int piece_n = SplitPiece(offset);
+    for (int n = 0; n < pieces_count; n++)
+    {
+        const ImGuiTextDocumentPiece& piece = pieces[n];
+        Length += piece.Length;
+        LineCount += piece.LineBreaks;
+
+        // Typing appends to 'Added' right after the previous insertion: extend its piece instead of adding one
+        if (piece_n > 0 && Pieces[piece_n - 1].Buffer == piece.Buffer && Pieces[piece_n - 1].Offset + Pieces[piece_n - 1].Length == piece.Offset)
+        {
+            Pieces[piece_n - 1].Length += piece.Length;
+            Pieces[piece_n - 1].LineBreaks += piece.LineBreaks;
+            continue;
+        }
+        Pieces.insert(Pieces.Data + piece_n, piece);
+        piece_n++;
+    }
+}
+
+void ImGuiTextDocument::Replace(int offset, int delete_length, const char* text, const char* text_end, bool record_undo)
+{
+    if (text_end == NULL)
+        text_end = text + strlen(text);
+    IM_ASSERT(offset >= 0 && delete_length >= 0 && offset + delete_length <= Length);
+    ImGuiTextDocumentPiece inserted = { 1, Added.Size, (int)(text_end - text), LineBreaks[1].Size };
+    if (inserted.Length == 0 && delete_length == 0)
+        return;
+    TextDocumentAppend(&Added, &LineBreaks[1], text, text_end);
+    inserted.LineBreaks = LineBreaks[1].Size - inserted.LineBreaks;
+
+    if (!record_undo)
+    {
+        DeletePieces(offset, delete_length, NULL);
+        InsertPieces(offset, &inserted, inserted.Length > 0 ? 1 : 0);
+        return;
+    }
+
+    // Discard what could be redone, then the oldest record if full
+    if (UndoPoint < UndoRecords.Size)
+    {
+        UndoPieces.resize(UndoRecords[UndoPoint].PiecesOffset);
+        UndoRecords.resize(UndoPoint);
+    }
+    if (UndoRecords.Size == STB_TEXTEDIT_UNDOSTATECOUNT)
+    {
+        const int discard_count = UndoRecords[0].DeletedPiecesCount + UndoRecords[0].InsertedPiecesCount;
+        UndoPieces.erase(UndoPieces.Data, UndoPieces.Data + discard_count);
+        UndoRecords.erase(UndoRecords.Data);
+        for (int n = 0; n < UndoRecords.Size; n++)
+            UndoRecords[n].PiecesOffset -= discard_count;
+    }
+    ImGuiTextDocumentUndoRecord record;
+    record.Where = offset;
+    record.InsertLength = inserted.Length;
+    record.DeleteLength = delete_length;
+    record.PiecesOffset = UndoPieces.Size;
+    DeletePieces(offset, delete_length, &UndoPieces);
+    record.DeletedPiecesCount = UndoPieces.Size - record.PiecesOffset;
+    record.InsertedPiecesCount = inserted.Length > 0 ? 1 : 0;
+    if (record.InsertedPiecesCount > 0)
+        UndoPieces.push_back(inserted);
+    InsertPieces(offset, &inserted, record.InsertedPiecesCount);
+    UndoRecords.push_back(record);
+    UndoPoint = UndoRecords.Size;
+}
+
+bool ImGuiTextDocument::Undo()
+{
+    if (UndoPoint == 0)
+        return false;
+    const ImGuiTextDocumentUndoRecord& record = UndoRecords[--UndoPoint];
+    DeletePieces(record.Where, record.InsertLength, NULL);
+    InsertPieces(record.Where, UndoPieces.Data + record.PiecesOffset, record.DeletedPiecesCount);
+    Cursor = SelectStart = SelectEnd = record.Where + record.DeleteLength;
+    PreferredX = -1.0f;
+    CursorFollow = true;
+    return true;
+}
+
+bool ImGuiTextDocument::Redo()
+{
+    if (UndoPoint == UndoRecords.Size)
+        return false;
+    const ImGuiTextDocumentUndoRecord& record = UndoRecords[UndoPoint++];
+    DeletePieces(record.Where, record.DeleteLength, NULL);
+    InsertPieces(record.Where, UndoPieces.Data + record.PiecesOffset + record.DeletedPiecesCount, record.InsertedPiecesCount);
+    Cursor = SelectStart = SelectEnd = record.Where + record.InsertLength;
+    PreferredX = -1.0f;
+    CursorFollow = true;
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 // This is currently not as flexible/powerful as it should be and really confusing/spaghetti, mostly because we changed
@@ -3381,7 +4060,7 @@ void ImGui::RenderMouseCursor(ImVec2 base_pos, float base_scale, ImGuiMouseCurso
 //-----------------------------------------------------------------------------
 
 // ImGuiWindow is mostly a dumb struct. It merely has a constructor and a few helper methods
-ImGuiWindow::ImGuiWindow(ImGuiContext* context, const char* name) : DrawListInst(NULL)
+ImGuiWindow::ImGuiWindow(ImGuiContext* context, const char* name) : DrawListInst(NULL), DrawListRetainScratch(NULL)
 {
     memset(this, 0, sizeof(*this));
     Name = ImStrdup(name);
@@ -3407,6 +4086,8 @@ ImGuiWindow::ImGuiWindow(ImGuiContext* context, const char* name) : DrawListInst
     DrawList = &DrawListInst;
     DrawList->_Data = &context->DrawListSharedData;
     DrawList->_OwnerName = Name;
+    DrawListRetainScratch._Data = &context->DrawListSharedData;
+    DrawListRetainScratch._OwnerName = Name;
     IM_PLACEMENT_NEW(&WindowClass) ImGuiWindowClass();
 }
 
@@ -3427,6 +4108,18 @@ ImGuiID ImGuiWindow::GetID(const char* str, const char* str_end)
     return id;
 }
 
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+ImGuiID ImGuiWindow::GetID(const ImGuiHashedStr& str)
+{
+    ImGuiID seed = IDStack.back();
+    ImGuiID id = ImHashStr(str, seed);
+    ImGuiContext& g = *GImGui;
+    if (g.DebugHookIdInfo == id)
+        ImGui::DebugHookIdInfo(id, ImGuiDataType_String, str.Str, str.StrEnd);
+    return id;
+}
+#endif
+
 ImGuiID ImGuiWindow::GetID(const void* ptr)
 {
     ImGuiID seed = IDStack.back();
@@ -3484,6 +4177,8 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
     window->IDStack.clear();
     window->DrawList->_ClearFreeMemory();
+    window->DrawListRetainScratch._ClearFreeMemory();
+    window->RetainedHashStable = false;
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
@@ -3792,11 +4487,47 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
     return ImMax(wrap_pos_x - pos.x, 1.0f);
 }
 
+// The address of a thread_local is distinct for every thread: it tells the context's owner thread apart without any OS call.
+static thread_local char GImGuiThreadTag;
+
+static inline bool IsContextOwnerThread(const ImGuiContext* ctx)
+{
+    return ctx->OwnerThreadTag == &GImGuiThreadTag;
+}
+
+#ifdef _MSC_VER
+static inline void ImAtomicIncrement(volatile int* p)           { _InterlockedIncrement((volatile long*)p); }
+static inline int  ImAtomicExchange(volatile int* p, int value) { return (int)_InterlockedExchange((volatile long*)p, (long)value); }
+#else
+static inline void ImAtomicIncrement(volatile int* p)           { __atomic_add_fetch(p, 1, __ATOMIC_RELAXED); }
+static inline int  ImAtomicExchange(volatile int* p, int value) { return __atomic_exchange_n(p, value, __ATOMIC_RELAXED); }
+#endif
+
+// Add the MemAlloc()/MemFree() calls made on other threads since the last call to the owner thread's counters.
+static void FoldThreadMemCounters(ImGuiContext& g)
+{
+    const int allocs = ImAtomicExchange(&g.ThreadMemAllocCount, 0);
+    const int frees = ImAtomicExchange(&g.ThreadMemFreeCount, 0);
+    g.IO.MetricsActiveAllocations += allocs - frees;
+    g.FrameMemAllocCount += allocs;
+    g.FrameMemFreeCount += frees;
+}
+
 // IM_ALLOC() == ImGui::MemAlloc()
 void* ImGui::MemAlloc(size_t size)
 {
     if (ImGuiContext* ctx = GImGui)
-        ctx->IO.MetricsActiveAllocations++;
+    {
+        if (IsContextOwnerThread(ctx))
+        {
+            ctx->IO.MetricsActiveAllocations++;
+            ctx->FrameMemAllocCount++;
+        }
+        else
+        {
+            ImAtomicIncrement(&ctx->ThreadMemAllocCount);
+        }
+    }
     return (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 }
 
@@ -3805,10 +4536,27 @@ void ImGui::MemFree(void* ptr)
 {
     if (ptr)
         if (ImGuiContext* ctx = GImGui)
-            ctx->IO.MetricsActiveAllocations--;
+        {
+            if (IsContextOwnerThread(ctx))
+            {
+                ctx->IO.MetricsActiveAllocations--;
+                ctx->FrameMemFreeCount++;
+            }
+            else
+            {
+                ImAtomicIncrement(&ctx->ThreadMemFreeCount);
+            }
+        }
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
 
+void* ImGui::MemAllocFrame(size_t size)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(!g.ParallelJobsRunning);
+    return g.FrameArena.Alloc(size);
+}
+
 const char* ImGui::GetClipboardText()
 {
     ImGuiContext& g = *GImGui;
@@ -3862,6 +4610,7 @@ ImGuiContext* ImGui::CreateContext(ImFontAtlas* shared_font_atlas)
 {
     ImGuiContext* prev_ctx = GetCurrentContext();
     ImGuiContext* ctx = IM_NEW(ImGuiContext)(shared_font_atlas);
+    ctx->OwnerThreadTag = &GImGuiThreadTag;
     SetCurrentContext(ctx);
     Initialize();
     if (prev_ctx != NULL)
@@ -3940,6 +4689,20 @@ int ImGui::GetFrameCount()
     return GImGui->FrameCount;
 }
 
+void ImGui::SetMaxWaitBeforeNextFrame(double time)
+{
+    ImGuiContext& g = *GImGui;
+    g.MaxWaitBeforeNextFrame = ImMin(g.MaxWaitBeforeNextFrame, ImMax(time, 0.0));
+}
+
+double ImGui::GetEventWaitingTime()
+{
+    ImGuiContext& g = *GImGui;
+    if (g.InputEventsQueue.Size > 0) // Events trickled to the next frame, or submitted since
+        return 0.0;
+    return g.MaxWaitBeforeNextFrame;
+}
+
 static ImDrawList* GetViewportDrawList(ImGuiViewportP* viewport, size_t drawlist_no, const char* drawlist_name)
 {
     // Create the draw list on demand, because they are not frequently used for all viewports
@@ -4575,6 +5338,7 @@ void ImGui::NewFrame()
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
+    g.MaxWaitBeforeNextFrame = FLT_MAX;
 
     // Calculate frame-rate for the user, as a purely luxurious feature
     g.FramerateSecPerFrameAccum += g.IO.DeltaTime - g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx];
@@ -4583,8 +5347,20 @@ void ImGui::NewFrame()
     g.FramerateSecPerFrameCount = ImMin(g.FramerateSecPerFrameCount + 1, IM_ARRAYSIZE(g.FramerateSecPerFrame));
     g.IO.Framerate = (g.FramerateSecPerFrameAccum > 0.0f) ? (1.0f / (g.FramerateSecPerFrameAccum / (float)g.FramerateSecPerFrameCount)) : FLT_MAX;
 
+    // Publish last frame's allocation count, and release its transient allocations
+    g.OwnerThreadTag = &GImGuiThreadTag;
+    FoldThreadMemCounters(g);
+    g.IO.MetricsFrameAllocations = g.FrameMemAllocCount;
+    g.FrameMemAllocHistory[g.FrameMemAllocHistoryIdx] = (float)g.FrameMemAllocCount;
+    g.FrameMemAllocHistoryIdx = (g.FrameMemAllocHistoryIdx + 1) % IM_ARRAYSIZE(g.FrameMemAllocHistory);
+    g.FrameMemAllocCount = g.FrameMemFreeCount = 0;
+    g.FrameArena.Reset();
+
     UpdateViewportsNewFrame();
 
+    // Rasterize glyphs requested by last frame's text (ImFontAtlasFlags_DynamicGlyphs), while the atlas can still be modified
+    ImFontAtlasUpdateDynamicGlyphs(g.IO.Fonts, g.Time);
+
     // Setup current font and draw list shared data
     // FIXME-VIEWPORT: the concept of a single ClipRectFullscreen is not ideal!
     g.IO.Fonts->Locked = true;
@@ -4605,6 +5381,8 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.ConfigDrawNoSimd)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_NoSimd;
 
     // Mark rendering data as invalid to prevent user who may have a handle on it to use it.
     for (int n = 0; n < g.Viewports.Size; n++)
@@ -4875,9 +5653,13 @@ void ImGui::Shutdown()
     CallContextHooks(&g, ImGuiContextHookType_Shutdown);
 
     // Clear everything else
-    g.Windows.clear_delete();
+    for (int n = 0; n < g.Windows.Size; n++)
+        ImSizeClassPool::Delete(g.Windows[n]);
+    g.Windows.clear();
     g.WindowsFocusOrder.clear();
     g.WindowsTempSortBuffer.clear();
+    g.DrawStreamsToTessellate.clear();
+    g.DrawListSharedData.ClearCircleRings();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
     g.WindowsById.Clear();
@@ -4922,6 +5704,9 @@ void ImGui::Shutdown()
     g.LogBuffer.clear();
     g.DebugLogBuf.clear();
 
+    g.FrameArena.Clear();
+    g.ObjectPool.Clear();
+
     g.Initialized = false;
 }
 
@@ -4996,6 +5781,8 @@ static void AddWindowToDrawData(ImGuiWindow* window, int layer)
     if (window->Flags & ImGuiWindowFlags_DockNodeHost)
         window->DrawList->ChannelsMerge();
     AddDrawListToDrawData(&viewport->DrawDataBuilder.Layers[layer], window->DrawList);
+    for (int i = 0; i < window->DrawStreams.Size; i++)
+        AddDrawListToDrawData(&viewport->DrawDataBuilder.Layers[layer], window->DrawStreams[i]->_DrawList);
     for (int i = 0; i < window->DC.ChildWindows.Size; i++)
     {
         ImGuiWindow* child = window->DC.ChildWindows[i];
@@ -5104,6 +5891,7 @@ static void ImGui::RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32
         // and draw list have been trimmed already, hence the explicit recreation of a draw command if missing.
         // FIXME: This is creating complication, might be simpler if we could inject a drawlist in drawdata at a given position and not attempt to manipulate ImDrawCmd order.
         ImDrawList* draw_list = window->RootWindowDockTree->DrawList;
+        window->RootWindowDockTree->RetainedHashStable = false; // Drawing after UpdateRetainedDrawListsEndFrame() isn't hashed: don't reuse the list as is
         if (draw_list->CmdBuffer.Size == 0)
             draw_list->AddDrawCmd();
         draw_list->PushClipRect(viewport_rect.Min - ImVec2(1, 1), viewport_rect.Max + ImVec2(1, 1), false); // Ensure ImDrawCmd are not merged
@@ -5119,7 +5907,9 @@ static void ImGui::RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32
     // Draw over sibling docking nodes in a same docking tree
     if (window->RootWindow->DockIsActive)
     {
-        ImDrawList* draw_list = FindFrontMostVisibleChildWindow(window->RootWindowDockTree)->DrawList;
+        ImGuiWindow* front_most_window = FindFrontMostVisibleChildWindow(window->RootWindowDockTree);
+        ImDrawList* draw_list = front_most_window->DrawList;
+        front_most_window->RetainedHashStable = false;
         if (draw_list->CmdBuffer.Size == 0)
             draw_list->AddDrawCmd();
         draw_list->PushClipRect(viewport_rect.Min, viewport_rect.Max, false);
@@ -5181,6 +5971,7 @@ static void ImGui::RenderDimmedBackgrounds()
         bb.Expand(distance);
         if (bb.GetWidth() >= viewport->Size.x && bb.GetHeight() >= viewport->Size.y)
             bb.Expand(-distance - 1.0f); // If a window fits the entire viewport, adjust its highlight inward
+        window->RetainedHashStable = false;
         if (window->DrawList->CmdBuffer.Size == 0)
             window->DrawList->AddDrawCmd();
         window->DrawList->PushClipRect(viewport->Pos, viewport->Pos + viewport->Size);
@@ -5202,6 +5993,144 @@ static void ImGui::RenderDimmedBackgrounds()
     }
 }
 
+// Whether input may have changed what the window (or another window of its child tree) draws this frame.
+// Mouse and keyboard events only reach the hovered and focused windows, while an active item, a moving window etc. may animate without any.
+static bool IsWindowTouchedByInput(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* busy_windows[] = { g.ActiveIdWindow, g.ActiveIdPreviousFrameWindow, g.MovingWindow, g.WheelingWindow, g.NavWindowingTarget };
+    for (ImGuiWindow* busy_window : busy_windows)
+        if (busy_window && busy_window->RootWindow == window->RootWindow)
+            return true;
+    if (g.InputEventsTrail.Size == 0)
+        return false;
+    ImGuiWindow* input_windows[] = { g.HoveredWindow, g.HoveredWindowUnderMovingWindow, g.NavWindow };
+    for (ImGuiWindow* input_window : input_windows)
+        if (input_window && input_window->RootWindow == window->RootWindow)
+            return true;
+    return false;
+}
+
+// ImGuiWindowFlags_RetainDrawList: select the list the window draws into this frame.
+// Reuse DrawListInst when the last frame hashed the same as it, and neither this frame nor the last one was touched by input
+// (widgets commonly show the effect of an input one frame later). The frame is then drawn into DrawListRetainScratch,
+// where primitives are hashed but not tessellated. If the hash turns out different, the content is displayed one frame late.
+// Frames touched by input aren't hashed at all: the next one is rebuilt anyway.
+// Windows that had child windows last frame are rebuilt as if touched: children may draw their borders and background into the parent's
+// list (see render_decorations_in_parent in Begin()), and whether they do depends on the vertices the parent emitted before them.
+static void ImGui::WindowBeginRetainedDrawList(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    const bool touched = window->Appearing || window->DC.ChildWindows.Size > 0 || IsWindowTouchedByInput(window);
+    if (touched)
+        window->RetainedTouchedFrame = g.FrameCount;
+    const bool reuse = window->RetainedHashStable && window->RetainedTouchedFrame < g.FrameCount - 1;
+    window->DrawList = reuse ? &window->DrawListRetainScratch : &window->DrawListInst;
+    window->DrawList->_ResetForNewFrame();
+    if (touched)
+        return;
+    window->DrawList->_ContentHashing = true;
+    window->DrawList->_ContentSkipTessellation = reuse;
+    window->DrawList->_ContentHash = ImHashData(&g.DrawListSharedData.TexUvWhitePixel, sizeof(ImVec2));
+}
+
+// Compare the hash of each retained window's frame with the content of its DrawListInst, and point DrawList back to it.
+// Called once nothing is drawn into windows anymore, except by RenderDimmedBackgrounds() which invalidates the windows it draws into.
+static void ImGui::UpdateRetainedDrawListsEndFrame()
+{
+    ImGuiContext& g = *GImGui;
+    for (int i = 0; i < g.Windows.Size; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (!(window->Flags & ImGuiWindowFlags_RetainDrawList) || window->LastFrameActive != g.FrameCount)
+            continue;
+        ImDrawList* draw_list = window->DrawList;
+        if (!draw_list->_ContentHashing)
+        {
+            window->RetainedRebuiltCount++;
+            window->RetainedHashStable = false;
+            continue;
+        }
+        window->RetainedHashStable = (draw_list->_ContentHash == window->RetainedHash);
+        if (!draw_list->_ContentSkipTessellation)
+        {
+            window->RetainedRebuiltCount++;
+            window->RetainedHash = draw_list->_ContentHash;
+        }
+        else if (window->RetainedHashStable)
+        {
+            window->RetainedReusedCount++;
+        }
+        else
+        {
+            window->RetainedLateCount++;
+            SetMaxWaitBeforeNextFrame(0.0); // The list on screen is one frame behind
+        }
+        draw_list->_ContentHashing = draw_list->_ContentSkipTessellation = false;
+        window->DrawList = &window->DrawListInst;
+    }
+}
+
+// Lower g.MaxWaitBeforeNextFrame for everything that would change the next frame without any new input event.
+static void ImGui::UpdateEventWaitingTimeEndFrame()
+{
+    ImGuiContext& g = *GImGui;
+
+    // Widgets commonly show the effect of an input one frame late (e.g. clicked button toggling a bool read before it)
+    if (g.InputEventsTrail.Size > 0)
+        SetMaxWaitBeforeNextFrame(0.0);
+
+    // Held keys and buttons repeat, drag, resize, and so on. This covers active items too: once nothing is held,
+    // the only active items left are text inputs, which request the frames their cursor blink needs.
+    for (int n = 0; n < IM_ARRAYSIZE(g.IO.KeysData); n++)
+        if (g.IO.KeysData[n].Down)
+            SetMaxWaitBeforeNextFrame(0.0);
+    if (g.DragDropActive)
+        SetMaxWaitBeforeNextFrame(0.0);
+
+    // Timers
+    if (g.HoveredId != 0 && g.HoveredIdTimer < IDLE_HOVER_FEEDBACK_TIMER)
+        SetMaxWaitBeforeNextFrame(0.0);
+    if (g.HoverDelayId != 0)
+    {
+        // NewFrame() adds the time we waited to HoverDelayTimer: wake up when it reaches the next delay IsItemHovered() may test
+        if (g.HoverDelayTimer < g.IO.HoverDelayShort)
+            SetMaxWaitBeforeNextFrame(g.IO.HoverDelayShort - g.HoverDelayTimer);
+        else if (g.HoverDelayTimer < g.IO.HoverDelayNormal)
+            SetMaxWaitBeforeNextFrame(g.IO.HoverDelayNormal - g.HoverDelayTimer);
+    }
+    if (g.SettingsDirtyTimer > 0.0f)
+        SetMaxWaitBeforeNextFrame(g.SettingsDirtyTimer);
+
+    // Animations: CTRL+Tab list and its fade out, modal dimming fading in or out
+    if (g.NavWindowingTarget != NULL || g.NavWindowingTargetAnim != NULL)
+        SetMaxWaitBeforeNextFrame(0.0);
+    if (g.DimBgRatio > 0.0f && g.DimBgRatio < 1.0f)
+        SetMaxWaitBeforeNextFrame(0.0);
+
+    // Requests processed by the next frame
+    if (g.NavMoveSubmitted || g.NavMoveScoringItems || g.NavMoveForwardToNextFrame || g.NavInitRequest || g.NavNextActivateId != 0)
+        SetMaxWaitBeforeNextFrame(0.0);
+    if (g.DockContext.Requests.Size > 0)
+        SetMaxWaitBeforeNextFrame(0.0);
+    if (ImFontAtlasHasPendingDynamicGlyphs(g.IO.Fonts))
+        SetMaxWaitBeforeNextFrame(0.0);
+
+    // Windows that are appearing, auto-fitting or scrolling to a target need a few frames to settle
+    for (int i = 0; i < g.Windows.Size && g.MaxWaitBeforeNextFrame > 0.0; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (!window->Active)
+            continue;
+        if (window->HiddenFramesCanSkipItems > 0 || window->HiddenFramesCannotSkipItems > 0 || window->HiddenFramesForRenderOnly > 0)
+            SetMaxWaitBeforeNextFrame(0.0);
+        else if (window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0)
+            SetMaxWaitBeforeNextFrame(0.0);
+        else if (window->ScrollTarget.x != FLT_MAX || window->ScrollTarget.y != FLT_MAX)
+            SetMaxWaitBeforeNextFrame(0.0);
+    }
+}
+
 // This is normally called by Render(). You may want to call it directly if you want to avoid calling Render() but the gain will be very minimal.
 void ImGui::EndFrame()
 {
@@ -5255,6 +6184,9 @@ void ImGui::EndFrame()
         g.DragDropWithinSource = false;
     }
 
+    // Retained draw lists: nothing draws into windows past this point
+    UpdateRetainedDrawListsEndFrame();
+
     // End frame
     g.WithinFrameScope = false;
     g.FrameCountEnded = g.FrameCount;
@@ -5289,9 +6221,55 @@ void ImGui::EndFrame()
     g.IO.MouseWheel = g.IO.MouseWheelH = 0.0f;
     g.IO.InputQueueCharacters.resize(0);
 
+    UpdateEventWaitingTimeEndFrame();
+
     CallContextHooks(&g, ImGuiContextHookType_EndFramePost);
 }
 
+static void TessellateDrawStream(void* job_data, int index)
+{
+    ImDrawStream* stream = ((ImDrawStream**)job_data)[index];
+    ImDrawList* draw_list = stream->_DrawList;
+    draw_list->_ResetForNewFrame();
+    draw_list->PushTextureID(stream->_TextureId);
+    draw_list->PushClipRect(ImVec2(stream->_ClipRect.x, stream->_ClipRect.y), ImVec2(stream->_ClipRect.z, stream->_ClipRect.w));
+    stream->Replay(draw_list);
+}
+
+// Replay the ImDrawStream submitted by visible windows into their draw lists.
+// Each stream owns its output, so jobs share nothing but read-only data (fonts, ImDrawListSharedData) and may run in any order.
+static void TessellateDrawStreams()
+{
+    ImGuiContext& g = *GImGui;
+    ImVector<ImDrawStream*>& streams = g.DrawStreamsToTessellate;
+    streams.resize(0);
+    for (int n = 0; n != g.Windows.Size; n++)
+    {
+        ImGuiWindow* window = g.Windows[n];
+        if (window->DrawStreams.Size > 0 && IsWindowActiveAndVisible(window))
+            for (int i = 0; i < window->DrawStreams.Size; i++)
+                streams.push_back(window->DrawStreams[i]);
+    }
+    if (streams.Size == 0)
+        return;
+
+    // Jobs share g.DrawListSharedData, whose circle ring cache is filled now and only read by them.
+    // (Done the same way when running serially, so that the output doesn't depend on io.ParallelForFn.)
+    // Glyph run caches of the fonts are likewise only read: runs are recorded by text drawn outside of streams.
+    for (int n = 0; n < streams.Size; n++)
+        streams[n]->_CacheCircleRings(streams[n]->_DrawList);
+
+    g.ParallelJobsRunning = true;
+    g.DrawListSharedData.CachesReadOnly = true;
+    if (g.IO.ParallelForFn && streams.Size > 1)
+        g.IO.ParallelForFn(g.IO.ParallelForUserData, streams.Size, TessellateDrawStream, streams.Data);
+    else
+        for (int n = 0; n < streams.Size; n++)
+            TessellateDrawStream(streams.Data, n);
+    g.DrawListSharedData.CachesReadOnly = false;
+    g.ParallelJobsRunning = false;
+}
+
 // Prepare the data for rendering so you can call GetDrawData()
 // (As with anything within the ImGui:: namspace this doesn't touch your GPU or graphics API at all:
 // it is the role of the ImGui_ImplXXXX_RenderDrawData() function provided by the renderer backend)
@@ -5317,6 +6295,11 @@ void ImGui::Render()
             AddDrawListToDrawData(&viewport->DrawDataBuilder.Layers[0], GetBackgroundDrawList(viewport));
     }
 
+    // Tessellate recorded ImDrawStream (possibly on worker threads)
+    if (first_render_of_frame)
+        TessellateDrawStreams();
+    FoldThreadMemCounters(g);
+
     // Add ImDrawList to render
     ImGuiWindow* windows_to_render_top_most[2];
     windows_to_render_top_most[0] = (g.NavWindowingTarget && !(g.NavWindowingTarget->Flags & ImGuiWindowFlags_NoBringToFrontOnFocus)) ? g.NavWindowingTarget->RootWindowDockTree : NULL;
@@ -5376,7 +6359,30 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+
+    // Most text measured here was already measured earlier in the frame or on a previous frame
+    ImVec2 text_size;
+    ImFontTextSizeCache* size_cache = font->TextSizeCache;
+    const int text_len = (int)((text_display_end ? text_display_end : text + strlen(text)) - text);
+    if (size_cache && text_len <= IM_FONT_TEXT_SIZE_MAX_TEXT_LENGTH)
+    {
+        const ImGuiID text_hash = ImHashData(text, (size_t)text_len);
+        if (const ImVec2* cached_size = size_cache->Find(text_hash, text_len, font_size, wrap_width))
+        {
+            text_size = *cached_size;
+            size_cache->Hits++;
+        }
+        else
+        {
+            text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text + text_len, NULL);
+            size_cache->Add(text_hash, text_len, font_size, wrap_width, text_size);
+            size_cache->Misses++;
+        }
+    }
+    else
+    {
+        text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    }
 
     // Round
     // FIXME: This has been here since Dec 2015 (7b0bf230) but down the line we want this out.
@@ -5802,7 +6808,7 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
     //IMGUI_DEBUG_LOG("CreateNewWindow '%s', flags = 0x%08X\n", name, flags);
 
     // Create window the first time
-    ImGuiWindow* window = IM_NEW(ImGuiWindow)(&g, name);
+    ImGuiWindow* window = IM_PLACEMENT_NEW(g.ObjectPool.Alloc(sizeof(ImGuiWindow))) ImGuiWindow(&g, name);
     window->Flags = flags;
     g.WindowsById.SetVoidPtr(window->ID, window);
 
@@ -6712,7 +7718,11 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->HasCloseButton = (p_open != NULL);
         window->ClipRect = ImVec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
         window->IDStack.resize(1);
-        window->DrawList->_ResetForNewFrame();
+        if (flags & ImGuiWindowFlags_RetainDrawList)
+            WindowBeginRetainedDrawList(window);
+        else
+            window->DrawList->_ResetForNewFrame();
+        window->DrawStreams.resize(0);
         window->DC.CurrentTableIdx = -1;
         if (flags & ImGuiWindowFlags_DockNodeHost)
         {
@@ -6878,6 +7888,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
             IM_ASSERT(parent_window && parent_window->Active);
             window->BeginOrderWithinParent = (short)parent_window->DC.ChildWindows.Size;
             parent_window->DC.ChildWindows.push_back(window);
+            if (parent_window->DrawList->_ContentHashing) // A child window appearing in a retained parent: the parent is rebuilt from next frame on, this one counts as changed
+                parent_window->DrawList->_ContentHash = ImHashData(&window->ID, sizeof(window->ID), parent_window->DrawList->_ContentHash);
             if (!(flags & ImGuiWindowFlags_Popup) && !window_pos_set_by_api && !window_is_child_tooltip)
                 window->Pos = parent_window->DC.CursorPos;
         }
@@ -7117,6 +8129,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
                 if (window->DrawList->CmdBuffer.back().ElemCount == 0 && parent_is_empty && !previous_child_overlapping)
                     render_decorations_in_parent = true;
             }
+            ImDrawList* backup_draw_list = window->DrawList;
             if (render_decorations_in_parent)
                 window->DrawList = parent_window->DrawList;
 
@@ -7126,7 +8139,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
             RenderWindowDecorations(window, title_bar_rect, title_bar_is_highlight, handle_borders_and_resize_grips, resize_grip_count, resize_grip_col, resize_grip_draw_size);
 
             if (render_decorations_in_parent)
-                window->DrawList = &window->DrawListInst;
+                window->DrawList = backup_draw_list;
         }
 
         // UPDATE RECTANGLES (2- THOSE AFFECTED BY SCROLLING)
@@ -8080,6 +9093,21 @@ ImDrawList* ImGui::GetWindowDrawList()
     return window->DrawList;
 }
 
+void ImGui::AddDrawStream(ImDrawStream* stream)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = GetCurrentWindow();
+    IM_ASSERT(stream != NULL);
+    IM_ASSERT(stream->_SubmitFrame != g.FrameCount && "ImDrawStream can only be submitted once per frame!");
+    if (stream->_DrawList == NULL)
+        stream->_DrawList = IM_NEW(ImDrawList)(&g.DrawListSharedData);
+    stream->_DrawList->_OwnerName = window->Name;
+    stream->_ClipRect = window->DrawList->_CmdHeader.ClipRect;
+    stream->_TextureId = window->DrawList->_CmdHeader.TextureId;
+    stream->_SubmitFrame = g.FrameCount;
+    window->DrawStreams.push_back(stream);
+}
+
 float ImGui::GetWindowDpiScale()
 {
     ImGuiContext& g = *GImGui;
@@ -8221,6 +9249,16 @@ void ImGui::PushID(const char* str_id_begin, const char* str_id_end)
     window->IDStack.push_back(id);
 }
 
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+void ImGui::PushID(const ImGuiHashedStr& str_id)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiID id = window->GetID(str_id);
+    window->IDStack.push_back(id);
+}
+#endif
+
 void ImGui::PushID(const void* ptr_id)
 {
     ImGuiContext& g = *GImGui;
@@ -8284,6 +9322,14 @@ ImGuiID ImGui::GetID(const void* ptr_id)
     return window->GetID(ptr_id);
 }
 
+#ifdef IMGUI_HAS_CONSTEXPR_HASH
+ImGuiID ImGui::GetID(const ImGuiHashedStr& str_id)
+{
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    return window->GetID(str_id);
+}
+#endif
+
 bool ImGui::IsRectVisible(const ImVec2& size)
 {
     ImGuiWindow* window = GImGui->CurrentWindow;
@@ -14052,7 +15098,7 @@ void ImGui::DockContextShutdown(ImGuiContext* ctx)
     ImGuiDockContext* dc  = &ctx->DockContext;
     for (int n = 0; n < dc->Nodes.Data.Size; n++)
         if (ImGuiDockNode* node = (ImGuiDockNode*)dc->Nodes.Data[n].val_p)
-            IM_DELETE(node);
+            ImSizeClassPool::Delete(node);
 }
 
 void ImGui::DockContextClearNodes(ImGuiContext* ctx, ImGuiID root_id, bool clear_settings_refs)
@@ -14198,7 +15244,7 @@ static ImGuiDockNode* ImGui::DockContextAddNode(ImGuiContext* ctx, ImGuiID id)
 
     // We don't set node->LastFrameAlive on construction. Nodes are always created at all time to reflect .ini settings!
     IMGUI_DEBUG_LOG_DOCKING("[docking] DockContextAddNode 0x%08X\n", id);
-    ImGuiDockNode* node = IM_NEW(ImGuiDockNode)(id);
+    ImGuiDockNode* node = IM_PLACEMENT_NEW(ctx->ObjectPool.Alloc(sizeof(ImGuiDockNode))) ImGuiDockNode(id);
     ctx->DockContext.Nodes.SetVoidPtr(node->ID, node);
     return node;
 }
@@ -14230,7 +15276,7 @@ static void ImGui::DockContextRemoveNode(ImGuiContext* ctx, ImGuiDockNode* node,
             if (parent_node->ChildNodes[n] == node)
                 node->ParentNode->ChildNodes[n] = NULL;
         dc->Nodes.SetVoidPtr(node->ID, NULL);
-        IM_DELETE(node);
+        ImSizeClassPool::Delete(node);
     }
 }
 
@@ -14708,7 +15754,7 @@ ImGuiDockNode::ImGuiDockNode(ImGuiID id)
 
 ImGuiDockNode::~ImGuiDockNode()
 {
-    IM_DELETE(TabBar);
+    ImSizeClassPool::Delete(TabBar);
     TabBar = NULL;
     ChildNodes[0] = ChildNodes[1] = NULL;
 }
@@ -15783,14 +16829,15 @@ static void ImGui::DockNodeUpdateTabBar(ImGuiDockNode* node, ImGuiWindow* host_w
 static void ImGui::DockNodeAddTabBar(ImGuiDockNode* node)
 {
     IM_ASSERT(node->TabBar == NULL);
-    node->TabBar = IM_NEW(ImGuiTabBar);
+    ImGuiContext& g = *GImGui;
+    node->TabBar = IM_PLACEMENT_NEW(g.ObjectPool.Alloc(sizeof(ImGuiTabBar))) ImGuiTabBar();
 }
 
 static void ImGui::DockNodeRemoveTabBar(ImGuiDockNode* node)
 {
     if (node->TabBar == NULL)
         return;
-    IM_DELETE(node->TabBar);
+    ImSizeClassPool::Delete(node->TabBar);
     node->TabBar = NULL;
 }
 
@@ -16265,12 +17312,12 @@ void ImGui::DockNodeTreeMerge(ImGuiContext* ctx, ImGuiDockNode* parent_node, ImG
     if (child_0)
     {
         ctx->DockContext.Nodes.SetVoidPtr(child_0->ID, NULL);
-        IM_DELETE(child_0);
+        ImSizeClassPool::Delete(child_0);
     }
     if (child_1)
     {
         ctx->DockContext.Nodes.SetVoidPtr(child_1->ID, NULL);
-        IM_DELETE(child_1);
+        ImSizeClassPool::Delete(child_1);
     }
 }
 
@@ -18000,7 +19047,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Dear ImGui %s", GetVersion());
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
-    Text("%d visible windows, %d active allocations", io.MetricsRenderWindows, io.MetricsActiveAllocations);
+    Text("%d visible windows, %d active allocations, %d allocations last frame", io.MetricsRenderWindows, io.MetricsActiveAllocations, io.MetricsFrameAllocations);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
     Separator();
@@ -18289,6 +19336,37 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         TreePop();
     }
 
+    // Details for Memory
+    if (TreeNode("Memory"))
+    {
+        Text("MemAlloc() calls this frame: %d, MemFree() calls: %d", g.FrameMemAllocCount, g.FrameMemFreeCount);
+        const int history_count = IM_ARRAYSIZE(g.FrameMemAllocHistory);
+        float history_max = 0.0f;
+        for (int n = 0; n < history_count; n++)
+            history_max = ImMax(history_max, g.FrameMemAllocHistory[n]);
+        PlotHistogram("##FrameAllocs", g.FrameMemAllocHistory, history_count, g.FrameMemAllocHistoryIdx, NULL, 0.0f, ImMax(history_max, 1.0f), ImVec2(0.0f, GetTextLineHeight() * 3));
+        SameLine();
+        Text("Last %d frames\n(max %d)", history_count, (int)history_max);
+
+        ImFrameArena* arena = &g.FrameArena;
+        if (TreeNode("FrameArena", "Frame arena: %d/%d bytes used, %d bytes last frame", (int)(arena->Used + arena->OverflowSize + arena->LargeSize), (int)arena->BlockSize, (int)arena->LastFrameSize))
+        {
+            BulletText("Block: %d bytes (%s)", (int)arena->BlockSize, arena->Block ? "allocated" : "not allocated");
+            BulletText("Overflow: %d allocations, %d bytes (+ %d bytes above threshold)", arena->Overflow.Size, (int)arena->OverflowSize, (int)arena->LargeSize);
+            TreePop();
+        }
+
+        ImSizeClassPool* pool = &g.ObjectPool;
+        if (TreeNode("ObjectPool", "Object pool: %d slabs (%d KB), %d large blocks", pool->Slabs.Size, (int)(pool->CalcMemoryUsage() / 1024), pool->LargeBlocks))
+        {
+            for (int class_idx = 0; class_idx < ImSizeClassPool::ClassCount; class_idx++)
+                if (pool->TotalBlocks[class_idx] > 0)
+                    BulletText("%5d bytes: %d/%d blocks used", ImSizeClassPool::GetClassSize(class_idx), pool->UsedBlocks[class_idx], pool->TotalBlocks[class_idx]);
+            TreePop();
+        }
+        TreePop();
+    }
+
     // Details for Docking
 #ifdef IMGUI_HAS_DOCK
     if (TreeNode("Docking"))
@@ -18750,6 +19828,25 @@ void ImGui::DebugNodeFont(ImFont* font)
     Text("Ellipsis character: '%s' (U+%04X)", ImTextCharToUtf8(c_str, font->EllipsisChar), font->EllipsisChar);
     const int surface_sqrt = (int)ImSqrt((float)font->MetricsTotalSurface);
     Text("Texture Area: about %d px ~%dx%d px", font->MetricsTotalSurface, surface_sqrt, surface_sqrt);
+    if (ImFontGlyphRunCache* run_cache = font->GlyphRunCache)
+    {
+        const int lookups = run_cache->Hits + run_cache->Misses;
+        Text("Glyph run cache: %d/%d runs, %d KB, %d/%d hits (%.0f%%)%s", run_cache->Runs.Size, IM_FONT_GLYPH_RUN_CACHE_SIZE, (int)(run_cache->CalcMemoryUsage() / 1024),
+            run_cache->Hits, lookups, lookups > 0 ? run_cache->Hits * 100.0f / lookups : 0.0f, run_cache->Disabled ? " (disabled: colored glyphs)" : "");
+        SameLine();
+        if (SmallButton("Clear"))
+            font->ClearGlyphRunCache();
+    }
+    if (ImFontTextSizeCache* size_cache = font->TextSizeCache)
+    {
+        const int lookups = size_cache->Hits + size_cache->Misses;
+        Text("Text size cache: %d entries, %d/%d hits (%.0f%%)", IM_FONT_TEXT_SIZE_CACHE_SIZE, size_cache->Hits, lookups, lookups > 0 ? size_cache->Hits * 100.0f / lookups : 0.0f);
+        SameLine();
+        PushID(size_cache);
+        if (SmallButton("Clear"))
+            font->ClearTextSizeCache();
+        PopID();
+    }
     for (int config_i = 0; config_i < font->ConfigDataCount; config_i++)
         if (font->ConfigData)
             if (const ImFontConfig* cfg = &font->ConfigData[config_i])
@@ -18824,7 +19921,7 @@ void ImGui::DebugNodeFontGlyph(ImFont*, const ImFontGlyph* glyph)
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
-    if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
+    if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes() + storage->Slots.size_in_bytes()))
         return;
     for (int n = 0; n < storage->Data.Size; n++)
     {
@@ -18932,12 +20029,14 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
         TextDisabled("Note: some memory buffers have been compacted/freed.");
 
     ImGuiWindowFlags flags = window->Flags;
-    DebugNodeDrawList(window, window->Viewport, window->DrawList, "DrawList");
+    DebugNodeDrawList(window, window->Viewport, &window->DrawListInst, "DrawList"); // Not DrawList, which may be DrawListRetainScratch until EndFrame()
     BulletText("Pos: (%.1f,%.1f), Size: (%.1f,%.1f), ContentSize (%.1f,%.1f) Ideal (%.1f,%.1f)", window->Pos.x, window->Pos.y, window->Size.x, window->Size.y, window->ContentSize.x, window->ContentSize.y, window->ContentSizeIdeal.x, window->ContentSizeIdeal.y);
     BulletText("Flags: 0x%08X (%s%s%s%s%s%s%s%s%s..)", flags,
         (flags & ImGuiWindowFlags_ChildWindow)  ? "Child " : "",      (flags & ImGuiWindowFlags_Tooltip)     ? "Tooltip "   : "",  (flags & ImGuiWindowFlags_Popup) ? "Popup " : "",
         (flags & ImGuiWindowFlags_Modal)        ? "Modal " : "",      (flags & ImGuiWindowFlags_ChildMenu)   ? "ChildMenu " : "",  (flags & ImGuiWindowFlags_NoSavedSettings) ? "NoSavedSettings " : "",
         (flags & ImGuiWindowFlags_NoMouseInputs)? "NoMouseInputs":"", (flags & ImGuiWindowFlags_NoNavInputs) ? "NoNavInputs" : "", (flags & ImGuiWindowFlags_AlwaysAutoResize) ? "AlwaysAutoResize" : "");
+    if (flags & ImGuiWindowFlags_RetainDrawList)
+        BulletText("RetainDrawList: %d reused, %d rebuilt, %d late, Hash: 0x%08X%s", window->RetainedReusedCount, window->RetainedRebuiltCount, window->RetainedLateCount, window->RetainedHash, window->RetainedHashStable ? " (stable)" : "");
     BulletText("WindowClassId: 0x%08X", window->WindowClass.ClassId);
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
@@ -9,6 +9,7 @@ Index of this file:
 // [SECTION] Style functions
 // [SECTION] ImDrawList
 // [SECTION] ImDrawListSplitter
+// [SECTION] ImDrawStream
 // [SECTION] ImDrawData
 // [SECTION] Helpers ShadeVertsXXX functions
 // [SECTION] ImFontConfig
@@ -404,6 +405,18 @@ void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
 }
 
+void ImDrawListSharedData::ClearCircleRings()
+{
+    IM_ASSERT(!CachesReadOnly);
+    for (int n = 0; n < IM_ARRAYSIZE(CircleRings); n++)
+    {
+        CircleRings[n].Key = CircleRings[n].Count = 0;
+        CircleRings[n].LastUse = 0;
+        CircleRings[n].Data.clear();
+    }
+    CircleRingsUseCount = 0;
+}
+
 // Initialize before use in a new frame. We always have a command ready in the buffer.
 void ImDrawList::_ResetForNewFrame()
 {
@@ -428,6 +441,8 @@ void ImDrawList::_ResetForNewFrame()
     _Splitter.Clear();
     CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = 1.0f;
+    _ContentHash = 0;
+    _ContentHashing = _ContentSkipTessellation = false;
 }
 
 void ImDrawList::_ClearFreeMemory()
@@ -442,9 +457,44 @@ void ImDrawList::_ClearFreeMemory()
     _ClipRectStack.clear();
     _TextureIdStack.clear();
     _Path.clear();
+    _TempBuffer.clear();
     _Splitter.ClearFreeMemory();
 }
 
+// ImGuiWindowFlags_RetainDrawList: primitives are hashed from their arguments rather than from the vertices they produce,
+// so a window can tell whether its content changed without tessellating it. Each hooked function is a leaf (it doesn't
+// call another hooked function), and the draw state it is emitted with (clip rect, texture, AA flags) is hashed along.
+enum ImDrawListPrimitive_
+{
+    ImDrawListPrimitive_Polyline,
+    ImDrawListPrimitive_ConvexPolyFilled,
+    ImDrawListPrimitive_RectFilled,
+    ImDrawListPrimitive_RectFilledMultiColor,
+    ImDrawListPrimitive_CircleFilled,
+    ImDrawListPrimitive_Image,
+    ImDrawListPrimitive_ImageQuad,
+    ImDrawListPrimitive_Callback,
+    ImDrawListPrimitive_Channel,
+    ImDrawListPrimitive_ShadeColor,
+    ImDrawListPrimitive_ShadeUV,
+    ImDrawListPrimitive_Char,
+    ImDrawListPrimitive_Text,
+};
+
+// Only call when draw_list->_ContentHashing is set. 'args' must not contain padding bytes.
+// Return true if the list only hashes this frame, in which case the caller must not emit anything.
+static bool ImDrawListHashPrimitive(ImDrawList* draw_list, int primitive, const void* args, size_t args_size, const void* data = NULL, size_t data_size = 0)
+{
+    const struct { ImDrawListFlags Flags; float FringeScale; int Primitive; } state = { draw_list->Flags, draw_list->_FringeScale, primitive };
+    ImU32 hash = ImHashData(&draw_list->_CmdHeader, IM_OFFSETOF(ImDrawCmdHeader, VtxOffset), draw_list->_ContentHash); // ClipRect, TextureId
+    hash = ImHashData(&state, sizeof(state), hash);
+    hash = ImHashData(args, args_size, hash);
+    if (data_size > 0)
+        hash = ImHashData(data, data_size, hash);
+    draw_list->_ContentHash = hash;
+    return draw_list->_ContentSkipTessellation;
+}
+
 ImDrawList* ImDrawList::CloneOutput() const
 {
     ImDrawList* dst = IM_NEW(ImDrawList(_Data));
@@ -480,6 +530,12 @@ void ImDrawList::_PopUnusedDrawCmd()
 
 void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 {
+    if (_ContentHashing)
+    {
+        const struct { ImDrawCallback Callback; void* Data; } args = { callback, callback_data };
+        if (ImDrawListHashPrimitive(this, ImDrawListPrimitive_Callback, &args, sizeof(args)))
+            return;
+    }
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(curr_cmd->UserCallback == NULL);
@@ -724,12 +780,139 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Batched (4 points per iteration) versions of the AddPolyline() and AddConvexPolyFilled() inner loops, using SSE2 or AArch64 NEON.
+// - They perform the same IEEE operations in the same order as the scalar macros above, so the output is bit-for-bit identical to the
+//   scalar path, as long as the compiler is not allowed to contract the scalar 'a * b + c' into FMA (default for MSVC /fp:precise, and for
+//   GCC/Clang unless both -ffp-contract=fast and an FMA target are used; with contraction the difference stays within 1 ulp per operation).
+//   ImRsqrt() and its batched version map to the same instruction (RSQRTSS/RSQRTPS on x86, 1/sqrt otherwise).
+// - Skipped when ImDrawListFlags_NoSimd is set on the draw list. #define IMGUI_DISABLE_SIMD_TESSELLATION to compile them out.
+#if !defined(IMGUI_DISABLE_SIMD_TESSELLATION) && (defined(IMGUI_ENABLE_SSE) || defined(__aarch64__) || defined(_M_ARM64))
+#define IMGUI_ENABLE_SIMD_TESSELLATION
+#ifdef IMGUI_ENABLE_SSE
+typedef __m128 ImFloat4;
+static inline ImFloat4 ImFloat4Set(float v)                                 { return _mm_set1_ps(v); }
+static inline ImFloat4 ImFloat4Add(ImFloat4 a, ImFloat4 b)                  { return _mm_add_ps(a, b); }
+static inline ImFloat4 ImFloat4Sub(ImFloat4 a, ImFloat4 b)                  { return _mm_sub_ps(a, b); }
+static inline ImFloat4 ImFloat4Mul(ImFloat4 a, ImFloat4 b)                  { return _mm_mul_ps(a, b); }
+static inline ImFloat4 ImFloat4Div(ImFloat4 a, ImFloat4 b)                  { return _mm_div_ps(a, b); }
+static inline ImFloat4 ImFloat4Min(ImFloat4 a, ImFloat4 b)                  { return _mm_min_ps(a, b); }
+static inline ImFloat4 ImFloat4Neg(ImFloat4 a)                              { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+static inline ImFloat4 ImFloat4Rsqrt(ImFloat4 a)                            { return _mm_rsqrt_ps(a); }
+static inline ImFloat4 ImFloat4SelectGt(ImFloat4 a, ImFloat4 b, ImFloat4 if_gt, ImFloat4 if_not) { ImFloat4 m = _mm_cmpgt_ps(a, b); return _mm_or_ps(_mm_and_ps(m, if_gt), _mm_andnot_ps(m, if_not)); }
+static inline void     ImFloat4LoadVec2(const ImVec2* p, ImFloat4& x, ImFloat4& y)     { __m128 a = _mm_loadu_ps(&p[0].x), b = _mm_loadu_ps(&p[2].x); x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)); y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)); }
+static inline void     ImFloat4StoreVec2(ImVec2* p, int stride, ImFloat4 x, ImFloat4 y) { __m128 lo = _mm_unpacklo_ps(x, y), hi = _mm_unpackhi_ps(x, y); _mm_storel_pi((__m64*)&p[0], lo); _mm_storeh_pi((__m64*)&p[stride], lo); _mm_storel_pi((__m64*)&p[stride * 2], hi); _mm_storeh_pi((__m64*)&p[stride * 3], hi); }
+static inline void     ImFloat4StoreVtxPos(ImDrawVert* v, int stride, ImFloat4 x, ImFloat4 y) { __m128 lo = _mm_unpacklo_ps(x, y), hi = _mm_unpackhi_ps(x, y); _mm_storel_pi((__m64*)&v[0].pos, lo); _mm_storeh_pi((__m64*)&v[stride].pos, lo); _mm_storel_pi((__m64*)&v[stride * 2].pos, hi); _mm_storeh_pi((__m64*)&v[stride * 3].pos, hi); }
+#else
+#include <arm_neon.h>
+typedef float32x4_t ImFloat4;
+static inline ImFloat4 ImFloat4Set(float v)                                 { return vdupq_n_f32(v); }
+static inline ImFloat4 ImFloat4Add(ImFloat4 a, ImFloat4 b)                  { return vaddq_f32(a, b); }
+static inline ImFloat4 ImFloat4Sub(ImFloat4 a, ImFloat4 b)                  { return vsubq_f32(a, b); }
+static inline ImFloat4 ImFloat4Mul(ImFloat4 a, ImFloat4 b)                  { return vmulq_f32(a, b); }
+static inline ImFloat4 ImFloat4Div(ImFloat4 a, ImFloat4 b)                  { return vdivq_f32(a, b); }
+static inline ImFloat4 ImFloat4Min(ImFloat4 a, ImFloat4 b)                  { return vminq_f32(a, b); }
+static inline ImFloat4 ImFloat4Neg(ImFloat4 a)                              { return vnegq_f32(a); }
+static inline ImFloat4 ImFloat4Rsqrt(ImFloat4 a)                            { return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(a)); }
+static inline ImFloat4 ImFloat4SelectGt(ImFloat4 a, ImFloat4 b, ImFloat4 if_gt, ImFloat4 if_not) { return vbslq_f32(vcgtq_f32(a, b), if_gt, if_not); }
+static inline void     ImFloat4LoadVec2(const ImVec2* p, ImFloat4& x, ImFloat4& y)     { float32x4x2_t v = vld2q_f32(&p[0].x); x = v.val[0]; y = v.val[1]; }
+static inline void     ImFloat4StoreVec2(ImVec2* p, int stride, ImFloat4 x, ImFloat4 y) { float32x4x2_t v = vzipq_f32(x, y); vst1_f32(&p[0].x, vget_low_f32(v.val[0])); vst1_f32(&p[stride].x, vget_high_f32(v.val[0])); vst1_f32(&p[stride * 2].x, vget_low_f32(v.val[1])); vst1_f32(&p[stride * 3].x, vget_high_f32(v.val[1])); }
+static inline void     ImFloat4StoreVtxPos(ImDrawVert* p, int stride, ImFloat4 x, ImFloat4 y) { float32x4x2_t v = vzipq_f32(x, y); vst1_f32(&p[0].pos.x, vget_low_f32(v.val[0])); vst1_f32(&p[stride].pos.x, vget_high_f32(v.val[0])); vst1_f32(&p[stride * 2].pos.x, vget_low_f32(v.val[1])); vst1_f32(&p[stride * 3].pos.x, vget_high_f32(v.val[1])); }
+#endif
+
+// Segment normals: normals[i] = perpendicular of the normalized (points[i + 1] - points[i]), for i in [0, count).
+// Returns the number of normals written (a multiple of 4), the caller completes the rest.
+static int ImPolylineNormalsSIMD(const ImVec2* points, int count, ImVec2* normals)
+{
+    const ImFloat4 zero = ImFloat4Set(0.0f);
+    const ImFloat4 one = ImFloat4Set(1.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        ImFloat4 x1, y1, x2, y2;
+        ImFloat4LoadVec2(points + i, x1, y1);
+        ImFloat4LoadVec2(points + i + 1, x2, y2);
+        ImFloat4 dx = ImFloat4Sub(x2, x1);
+        ImFloat4 dy = ImFloat4Sub(y2, y1);
+        const ImFloat4 d2 = ImFloat4Add(ImFloat4Mul(dx, dx), ImFloat4Mul(dy, dy));
+        const ImFloat4 inv_len = ImFloat4SelectGt(d2, zero, ImFloat4Rsqrt(d2), one); // IM_NORMALIZE2F_OVER_ZERO (x * 1.0f == x)
+        dx = ImFloat4Mul(dx, inv_len);
+        dy = ImFloat4Mul(dy, inv_len);
+        ImFloat4StoreVec2(normals + i, 1, dy, ImFloat4Neg(dx));
+    }
+    return i;
+}
+
+// Average of normals[i - 1] and normals[i] for 4 consecutive points, fixed up by IM_FIXNORMAL2F.
+static inline void ImAverageNormalsSIMD(const ImVec2* normals, int i, ImFloat4& dm_x, ImFloat4& dm_y)
+{
+    ImFloat4 n1x, n1y, n2x, n2y;
+    ImFloat4LoadVec2(normals + i - 1, n1x, n1y);
+    ImFloat4LoadVec2(normals + i, n2x, n2y);
+    dm_x = ImFloat4Mul(ImFloat4Add(n1x, n2x), ImFloat4Set(0.5f));
+    dm_y = ImFloat4Mul(ImFloat4Add(n1y, n2y), ImFloat4Set(0.5f));
+    const ImFloat4 d2 = ImFloat4Add(ImFloat4Mul(dm_x, dm_x), ImFloat4Mul(dm_y, dm_y));
+    const ImFloat4 one = ImFloat4Set(1.0f);
+    const ImFloat4 inv_len2 = ImFloat4SelectGt(d2, ImFloat4Set(0.000001f), ImFloat4Min(ImFloat4Div(one, d2), ImFloat4Set(IM_FIXNORMAL2F_MAX_INVLEN2)), one);
+    dm_x = ImFloat4Mul(dm_x, inv_len2);
+    dm_y = ImFloat4Mul(dm_y, inv_len2);
+}
+
+// Edge points around points[i] for i in [first, last), from the average of the normals of the two segments sharing it:
+// out[k] = points[i] + dm * scales[k] and out[2 * scales_count - 1 - k] = points[i] - dm * scales[k], with out = &temp_points[i * 2 * scales_count].
+// Returns the first point not processed, the caller completes the rest.
+static int ImPolylineEdgesSIMD(const ImVec2* points, const ImVec2* normals, int first, int last, const float* scales, int scales_count, ImVec2* temp_points)
+{
+    const int stride = scales_count * 2;
+    int i = first;
+    for (; i + 4 <= last; i += 4)
+    {
+        ImFloat4 dm_x, dm_y, px, py;
+        ImAverageNormalsSIMD(normals, i, dm_x, dm_y);
+        ImFloat4LoadVec2(points + i, px, py);
+        for (int k = 0; k < scales_count; k++)
+        {
+            const ImFloat4 scale = ImFloat4Set(scales[k]);
+            const ImFloat4 ox = ImFloat4Mul(dm_x, scale);
+            const ImFloat4 oy = ImFloat4Mul(dm_y, scale);
+            ImFloat4StoreVec2(temp_points + i * stride + k, stride, ImFloat4Add(px, ox), ImFloat4Add(py, oy));
+            ImFloat4StoreVec2(temp_points + i * stride + stride - 1 - k, stride, ImFloat4Sub(px, ox), ImFloat4Sub(py, oy));
+        }
+    }
+    return i;
+}
+
+// AddConvexPolyFilled() fringe around points[i] for i in [first, last): writes the position of the inner vertex (points[i] - dm * scale)
+// to vtx[i * 2].pos and of the outer one (points[i] + dm * scale) to vtx[i * 2 + 1].pos. Returns the first point not processed.
+static int ImConvexFringeSIMD(const ImVec2* points, const ImVec2* normals, int first, int last, float scale, ImDrawVert* vtx)
+{
+    const ImFloat4 scale4 = ImFloat4Set(scale);
+    int i = first;
+    for (; i + 4 <= last; i += 4)
+    {
+        ImFloat4 dm_x, dm_y, px, py;
+        ImAverageNormalsSIMD(normals, i, dm_x, dm_y);
+        ImFloat4LoadVec2(points + i, px, py);
+        dm_x = ImFloat4Mul(dm_x, scale4);
+        dm_y = ImFloat4Mul(dm_y, scale4);
+        ImFloat4StoreVtxPos(vtx + i * 2, 2, ImFloat4Sub(px, dm_x), ImFloat4Sub(py, dm_y));
+        ImFloat4StoreVtxPos(vtx + i * 2 + 1, 2, ImFloat4Add(px, dm_x), ImFloat4Add(py, dm_y));
+    }
+    return i;
+}
+#endif // #ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
 {
     if (points_count < 2)
         return;
+    if (_ContentHashing)
+    {
+        const struct { ImU32 Col; ImDrawFlags Flags; float Thickness; int PointsCount; } args = { col, flags, thickness, points_count };
+        if (ImDrawListHashPrimitive(this, ImDrawListPrimitive_Polyline, &args, sizeof(args), points, points_count * sizeof(ImVec2)))
+            return;
+    }
 
     const bool closed = (flags & ImDrawFlags_Closed) != 0;
     const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
@@ -761,11 +944,18 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 
         // Temporary buffer
         // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * ((use_texture || !thick_line) ? 3 : 5) * sizeof(ImVec2)); //-V630
+        // (kept in the draw list rather than on the stack: plots easily reach millions of points)
+        _TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
+        ImVec2* temp_normals = _TempBuffer.Data;
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
+        int i1_first = 0;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+        if (!(Flags & ImDrawListFlags_NoSimd))
+            i1_first = ImPolylineNormalsSIMD(points, points_count - 1, temp_normals); // Segments not wrapping around
+#endif
+        for (int i1 = i1_first; i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
             float dx = points[i2].x - points[i1].x;
@@ -799,14 +989,16 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            int i1_edges = 0;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+            if (!(Flags & ImDrawListFlags_NoSimd))
+                i1_edges = ImPolylineEdgesSIMD(points, temp_normals, 1, points_count, &half_draw_size, 1, temp_points) - 1;
+#endif
+            for (int i1 = i1_edges; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -821,6 +1013,14 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[0].y = points[i2].y + dm_y;
                 out_vtx[1].x = points[i2].x - dm_x;
                 out_vtx[1].y = points[i2].y - dm_y;
+            }
+
+            // Generate the indices to form a number of triangles for each line segment
+            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
+            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
                 if (use_texture)
                 {
@@ -895,14 +1095,19 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            int i1_edges = 0;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+            if (!(Flags & ImDrawListFlags_NoSimd))
+            {
+                const float scales[2] = { half_inner_thickness + AA_SIZE, half_inner_thickness };
+                i1_edges = ImPolylineEdgesSIMD(points, temp_normals, 1, points_count, scales, 2, temp_points) - 1;
+            }
+#endif
+            for (int i1 = i1_edges; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -923,6 +1128,14 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[2].y = points[i2].y - dm_in_y;
                 out_vtx[3].x = points[i2].x - dm_out_x;
                 out_vtx[3].y = points[i2].y - dm_out_y;
+            }
+
+            // Generate the indices to form a number of triangles for each line segment
+            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
+            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
@@ -987,6 +1200,12 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 {
     if (points_count < 3)
         return;
+    if (_ContentHashing)
+    {
+        const struct { ImU32 Col; int PointsCount; } args = { col, points_count };
+        if (ImDrawListHashPrimitive(this, ImDrawListPrimitive_ConvexPolyFilled, &args, sizeof(args), points, points_count * sizeof(ImVec2)))
+            return;
+    }
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
 
@@ -1008,10 +1227,18 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        _TempBuffer.reserve_discard(points_count);
+        ImVec2* temp_normals = _TempBuffer.Data;
+
+        // Compute normals (temp_normals[i0] is the normal of the edge going from point i0 to the next one)
+        int i0_first = 0;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+        if (!(Flags & ImDrawListFlags_NoSimd))
+            i0_first = ImPolylineNormalsSIMD(points, points_count - 1, temp_normals); // Edges not wrapping around
+#endif
+        for (int i0 = i0_first; i0 < points_count; i0++)
         {
+            const int i1 = (i0 + 1) == points_count ? 0 : i0 + 1;
             const ImVec2& p0 = points[i0];
             const ImVec2& p1 = points[i1];
             float dx = p1.x - p0.x;
@@ -1021,20 +1248,32 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             temp_normals[i0].y = -dx;
         }
 
+        // Fringe positions of points [1, i1_batched_end) are written ahead by the batched code (point 0 uses the last edge)
+        int i1_batched_end = 1;
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+        if (!(Flags & ImDrawListFlags_NoSimd))
+            i1_batched_end = ImConvexFringeSIMD(points, temp_normals, 1, points_count, AA_SIZE * 0.5f, _VtxWritePtr);
+#endif
+
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
+            if (i1 == 0 || i1 >= i1_batched_end)
+            {
+                // Average normals
+                const ImVec2& n0 = temp_normals[i0];
+                const ImVec2& n1 = temp_normals[i1];
+                float dm_x = (n0.x + n1.x) * 0.5f;
+                float dm_y = (n0.y + n1.y) * 0.5f;
+                IM_FIXNORMAL2F(dm_x, dm_y);
+                dm_x *= AA_SIZE * 0.5f;
+                dm_y *= AA_SIZE * 0.5f;
+                _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y);
+                _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y);
+            }
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;          // Inner
+            _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;    // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -1416,6 +1655,12 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
         return;
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
+        if (_ContentHashing)
+        {
+            const struct { ImVec2 Min, Max; ImU32 Col; } args = { p_min, p_max, col };
+            if (ImDrawListHashPrimitive(this, ImDrawListPrimitive_RectFilled, &args, sizeof(args)))
+                return;
+        }
         PrimReserve(6, 4);
         PrimRect(p_min, p_max, col);
     }
@@ -1431,6 +1676,12 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
 {
     if (((col_upr_left | col_upr_right | col_bot_right | col_bot_left) & IM_COL32_A_MASK) == 0)
         return;
+    if (_ContentHashing)
+    {
+        const struct { ImVec2 Min, Max; ImU32 Cols[4]; } args = { p_min, p_max, { col_upr_left, col_upr_right, col_bot_right, col_bot_left } };
+        if (ImDrawListHashPrimitive(this, ImDrawListPrimitive_RectFilledMultiColor, &args, sizeof(args)))
+            return;
+    }
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
     PrimReserve(6, 4);
@@ -1488,12 +1739,143 @@ void ImDrawList::AddTriangleFilled(const ImVec2& p1, const ImVec2& p2, const ImV
     PathFillConvex(col);
 }
 
+// Return the cached unit circle matching a full circle of 'radius' with 'num_segments' (<= 0: automatic count), creating it if needed.
+// Returns NULL if the circle degenerates to a point, or if it isn't cached while the cache is read-only.
+static const ImDrawListCircleRing* GetCircleRing(ImDrawList* draw_list, float radius, int num_segments)
+{
+    if (radius < 0.5f || num_segments > IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX)
+        return NULL;
+
+    // Automatic circles only differ by the sample step _PathArcToFastEx() is going to use
+    ImDrawListSharedData* data = (ImDrawListSharedData*)draw_list->_Data; // The cache is the only part of the shared data written by draw lists
+    const int key = (num_segments > 0) ? num_segments : -ImClamp(IM_DRAWLIST_ARCFAST_SAMPLE_MAX / draw_list->_CalcCircleAutoSegmentCount(radius), 1, IM_DRAWLIST_ARCFAST_TABLE_SIZE / 4);
+    ImDrawListCircleRing* ring = NULL;
+    for (int n = 0; n < IM_ARRAYSIZE(data->CircleRings); n++)
+    {
+        ImDrawListCircleRing* slot = &data->CircleRings[n];
+        if (slot->Key == key)
+        {
+            if (!data->CachesReadOnly)
+                slot->LastUse = ++data->CircleRingsUseCount;
+            return slot;
+        }
+        if (ring == NULL || slot->LastUse < ring->LastUse)
+            ring = slot;
+    }
+    if (data->CachesReadOnly)
+        return NULL;
+
+    // Tessellate at the origin with a radius of 1 using the regular path code (0.0f + v * 1.0f == v)
+    ImVector<ImVec2>& path = draw_list->_Path;
+    const int path_size = path.Size;
+    if (key > 0)
+        draw_list->_PathArcToN(ImVec2(0.0f, 0.0f), 1.0f, 0.0f, (IM_PI * 2.0f) * ((float)key - 1.0f) / (float)key, key - 1);
+    else
+        draw_list->_PathArcToFastEx(ImVec2(0.0f, 0.0f), 1.0f, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, -key);
+    const int count = (key > 0) ? key : path.Size - path_size - 1; // Automatic arcs repeat their first point at the end
+    ring->Key = key;
+    ring->Count = count;
+    ring->LastUse = ++data->CircleRingsUseCount;
+    ring->Data.resize(count * 2);
+    ImVec2* ring_pos = ring->Data.Data;
+    ImVec2* ring_fringe = ring_pos + count;
+    memcpy(ring_pos, path.Data + path_size, (size_t)count * sizeof(ImVec2));
+    path.Size = path_size;
+
+    // Fringe directions, computed like AddConvexPolyFilled() does
+    float n0_x = ring_pos[0].x - ring_pos[count - 1].x;
+    float n0_y = ring_pos[0].y - ring_pos[count - 1].y;
+    IM_NORMALIZE2F_OVER_ZERO(n0_x, n0_y);
+    for (int i1 = 0; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == count ? 0 : i1 + 1;
+        float n1_x = ring_pos[i2].x - ring_pos[i1].x;
+        float n1_y = ring_pos[i2].y - ring_pos[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(n1_x, n1_y);
+        float dm_x = (n0_y + n1_y) * 0.5f;  // Normals are (dy, -dx)
+        float dm_y = -(n0_x + n1_x) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        ring_fringe[i1].x = dm_x;
+        ring_fringe[i1].y = dm_y;
+        n0_x = n1_x;
+        n0_y = n1_y;
+    }
+    return ring;
+}
+
+// Append the points of a cached unit circle to the path, scaled and offset the same way PathArcTo() would place them.
+static void PathCircleRing(ImDrawList* draw_list, const ImDrawListCircleRing* ring, const ImVec2& center, float radius)
+{
+    ImVector<ImVec2>& path = draw_list->_Path;
+    path.resize(path.Size + ring->Count);
+    ImVec2* out_ptr = path.Data + (path.Size - ring->Count);
+    for (const ImVec2* p = ring->Data.Data; p != ring->Data.Data + ring->Count; p++, out_ptr++)
+    {
+        out_ptr->x = center.x + p->x * radius;
+        out_ptr->y = center.y + p->y * radius;
+    }
+}
+
+// Anti-aliased fill of a cached unit circle: same geometry as AddConvexPolyFilled() without computing any normal.
+static void AddCircleRingFilled(ImDrawList* draw_list, const ImDrawListCircleRing* ring, const ImVec2& center, float radius, ImU32 col)
+{
+    if (draw_list->_ContentHashing)
+    {
+        const struct { ImVec2 Center; float Radius; ImU32 Col; int PointsCount; } args = { center, radius, col, ring->Count };
+        if (ImDrawListHashPrimitive(draw_list, ImDrawListPrimitive_CircleFilled, &args, sizeof(args)))
+            return;
+    }
+    const int points_count = ring->Count;
+    const ImVec2* ring_pos = ring->Data.Data;
+    const ImVec2* ring_fringe = ring_pos + points_count;
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    const float half_aa_size = draw_list->_FringeScale * 0.5f;
+    const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+    const int idx_count = (points_count - 2) * 3 + points_count * 6;
+    const int vtx_count = (points_count * 2);
+    draw_list->PrimReserve(idx_count, vtx_count);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    const unsigned int vtx_inner_idx = draw_list->_VtxCurrentIdx;
+    const unsigned int vtx_outer_idx = draw_list->_VtxCurrentIdx + 1;
+    for (int i = 2; i < points_count; i++)
+    {
+        idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); idx_write[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+        idx_write += 3;
+    }
+    for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+    {
+        const float x = center.x + ring_pos[i1].x * radius;
+        const float y = center.y + ring_pos[i1].y * radius;
+        const float dm_x = ring_fringe[i1].x * half_aa_size;
+        const float dm_y = ring_fringe[i1].y * half_aa_size;
+        vtx_write[0].pos.x = x - dm_x; vtx_write[0].pos.y = y - dm_y; vtx_write[0].uv = uv; vtx_write[0].col = col;         // Inner
+        vtx_write[1].pos.x = x + dm_x; vtx_write[1].pos.y = y + dm_y; vtx_write[1].uv = uv; vtx_write[1].col = col_trans;   // Outer
+        vtx_write += 2;
+        idx_write[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+        idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); idx_write[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+        idx_write += 6;
+    }
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx += (ImDrawIdx)vtx_count;
+}
+
 void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int num_segments, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
-    if (num_segments <= 0)
+    // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
+    if (num_segments > 0)
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+
+    if (const ImDrawListCircleRing* ring = GetCircleRing(this, radius - 0.5f, num_segments))
+    {
+        PathCircleRing(this, ring, center, radius - 0.5f);
+    }
+    else if (num_segments <= 0)
     {
         // Use arc with automatic segment count
         _PathArcToFastEx(center, radius - 0.5f, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
@@ -1501,9 +1883,6 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-
         // Because we are filling a closed shape we remove 1 from the count of segments/points
         const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
@@ -1517,7 +1896,20 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
-    if (num_segments <= 0)
+    // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
+    if (num_segments > 0)
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+
+    if (const ImDrawListCircleRing* ring = GetCircleRing(this, radius, num_segments))
+    {
+        if (Flags & ImDrawListFlags_AntiAliasedFill)
+        {
+            AddCircleRingFilled(this, ring, center, radius, col);
+            return;
+        }
+        PathCircleRing(this, ring, center, radius);
+    }
+    else if (num_segments <= 0)
     {
         // Use arc with automatic segment count
         _PathArcToFastEx(center, radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
@@ -1525,9 +1917,6 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-
         // Because we are filling a closed shape we remove 1 from the count of segments/points
         const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
@@ -1542,9 +1931,16 @@ void ImDrawList::AddNgon(const ImVec2& center, float radius, ImU32 col, int num_
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
 
-    // Because we are filling a closed shape we remove 1 from the count of segments/points
-    const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
-    PathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
+    if (const ImDrawListCircleRing* ring = GetCircleRing(this, radius - 0.5f, num_segments))
+    {
+        PathCircleRing(this, ring, center, radius - 0.5f);
+    }
+    else
+    {
+        // Because we are filling a closed shape we remove 1 from the count of segments/points
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        PathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
+    }
     PathStroke(col, ImDrawFlags_Closed, thickness);
 }
 
@@ -1554,9 +1950,21 @@ void ImDrawList::AddNgonFilled(const ImVec2& center, float radius, ImU32 col, in
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
 
-    // Because we are filling a closed shape we remove 1 from the count of segments/points
-    const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
-    PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
+    if (const ImDrawListCircleRing* ring = GetCircleRing(this, radius, num_segments))
+    {
+        if (Flags & ImDrawListFlags_AntiAliasedFill)
+        {
+            AddCircleRingFilled(this, ring, center, radius, col);
+            return;
+        }
+        PathCircleRing(this, ring, center, radius);
+    }
+    else
+    {
+        // Because we are filling a closed shape we remove 1 from the count of segments/points
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
+    }
     PathFillConvex(col);
 }
 
@@ -1625,8 +2033,17 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
     if (push_texture_id)
         PushTextureID(user_texture_id);
 
-    PrimReserve(6, 4);
-    PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    bool skip = false;
+    if (_ContentHashing)
+    {
+        const struct { ImVec2 Min, Max, UvMin, UvMax; ImU32 Col; } args = { p_min, p_max, uv_min, uv_max, col };
+        skip = ImDrawListHashPrimitive(this, ImDrawListPrimitive_Image, &args, sizeof(args));
+    }
+    if (!skip)
+    {
+        PrimReserve(6, 4);
+        PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    }
 
     if (push_texture_id)
         PopTextureID();
@@ -1641,8 +2058,17 @@ void ImDrawList::AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, con
     if (push_texture_id)
         PushTextureID(user_texture_id);
 
-    PrimReserve(6, 4);
-    PrimQuadUV(p1, p2, p3, p4, uv1, uv2, uv3, uv4, col);
+    bool skip = false;
+    if (_ContentHashing)
+    {
+        const struct { ImVec2 P[4], Uv[4]; ImU32 Col; } args = { { p1, p2, p3, p4 }, { uv1, uv2, uv3, uv4 }, col };
+        skip = ImDrawListHashPrimitive(this, ImDrawListPrimitive_ImageQuad, &args, sizeof(args));
+    }
+    if (!skip)
+    {
+        PrimReserve(6, 4);
+        PrimQuadUV(p1, p2, p3, p4, uv1, uv2, uv3, uv4, col);
+    }
 
     if (push_texture_id)
         PopTextureID();
@@ -1801,6 +2227,8 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     IM_ASSERT(idx >= 0 && idx < _Count);
     if (_Current == idx)
         return;
+    if (draw_list->_ContentHashing)
+        ImDrawListHashPrimitive(draw_list, ImDrawListPrimitive_Channel, &idx, sizeof(idx)); // The channels are still switched while skipping, as later primitives don't emit anything either
 
     // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
     memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
@@ -1820,6 +2248,187 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
         draw_list->AddDrawCmd();
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawStream
+//-----------------------------------------------------------------------------
+// Commands are only recorded here. ImDrawStream::Replay() turns them into vertices, typically from a job started by ImGui::Render().
+//-----------------------------------------------------------------------------
+
+ImDrawStream::~ImDrawStream()
+{
+    if (_DrawList)
+        IM_DELETE(_DrawList);
+}
+
+static ImDrawStreamCmd* AddDrawStreamCmd(ImVector<ImDrawStreamCmd>& cmds, int type, ImU32 col)
+{
+    cmds.resize(cmds.Size + 1);
+    ImDrawStreamCmd* cmd = &cmds.back();
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->Type = type;
+    cmd->Col = col;
+    return cmd;
+}
+
+void ImDrawStream::PushClipRect(const ImVec2& cr_min, const ImVec2& cr_max, bool intersect_with_current_clip_rect)
+{
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_PushClipRect, 0);
+    cmd->P1 = cr_min;
+    cmd->P2 = cr_max;
+    cmd->Flags = intersect_with_current_clip_rect ? 1 : 0;
+}
+
+void ImDrawStream::PopClipRect()
+{
+    AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_PopClipRect, 0);
+}
+
+void ImDrawStream::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float thickness)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_Line, col);
+    cmd->P1 = p1;
+    cmd->P2 = p2;
+    cmd->Thickness = thickness;
+}
+
+void ImDrawStream::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_Rect, col);
+    cmd->P1 = p_min;
+    cmd->P2 = p_max;
+    cmd->Rounding = rounding;
+    cmd->Flags = flags;
+    cmd->Thickness = thickness;
+}
+
+void ImDrawStream::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_RectFilled, col);
+    cmd->P1 = p_min;
+    cmd->P2 = p_max;
+    cmd->Rounding = rounding;
+    cmd->Flags = flags;
+}
+
+void ImDrawStream::AddCircle(const ImVec2& center, float radius, ImU32 col, int num_segments, float thickness)
+{
+    if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
+        return;
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_Circle, col);
+    cmd->P1 = center;
+    cmd->Rounding = radius;
+    cmd->Flags = num_segments;
+    cmd->Thickness = thickness;
+}
+
+void ImDrawStream::AddCircleFilled(const ImVec2& center, float radius, ImU32 col, int num_segments)
+{
+    if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
+        return;
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_CircleFilled, col);
+    cmd->P1 = center;
+    cmd->Rounding = radius;
+    cmd->Flags = num_segments;
+}
+
+void ImDrawStream::AddPolyline(const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags, float thickness)
+{
+    if (num_points < 2 || (col & IM_COL32_A_MASK) == 0)
+        return;
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_Polyline, col);
+    cmd->Flags = flags;
+    cmd->Thickness = thickness;
+    cmd->DataOffset = Points.Size;
+    cmd->DataCount = num_points;
+    Points.resize(Points.Size + num_points);
+    memcpy(Points.Data + cmd->DataOffset, points, (size_t)num_points * sizeof(ImVec2));
+}
+
+void ImDrawStream::AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col)
+{
+    if (num_points < 3 || (col & IM_COL32_A_MASK) == 0)
+        return;
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_ConvexPolyFilled, col);
+    cmd->DataOffset = Points.Size;
+    cmd->DataCount = num_points;
+    Points.resize(Points.Size + num_points);
+    memcpy(Points.Data + cmd->DataOffset, points, (size_t)num_points * sizeof(ImVec2));
+}
+
+static void ImFontAtlasDynamicGlyphsTouchText(const ImFont* font, const char* text_begin, const char* text_end);
+
+void ImDrawStream::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end)
+{
+    AddText(NULL, 0.0f, pos, col, text_begin, text_end);
+}
+
+void ImDrawStream::AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end)
+{
+    if ((col & IM_COL32_A_MASK) == 0)
+        return;
+    if (text_end == NULL)
+        text_end = text_begin + strlen(text_begin);
+    if (text_begin == text_end)
+        return;
+    if (const ImFont* text_font = font ? font : GImGui ? GImGui->DrawListSharedData.Font : NULL)
+        ImFontAtlasDynamicGlyphsTouchText(text_font, text_begin, text_end); // Replay() runs on worker threads, which can't request glyphs
+    ImDrawStreamCmd* cmd = AddDrawStreamCmd(Cmds, ImDrawStreamCmdType_Text, col);
+    cmd->P1 = pos;
+    cmd->Thickness = font_size;
+    cmd->Font = font;
+    cmd->DataOffset = TextBuffer.Size;
+    cmd->DataCount = (int)(text_end - text_begin);
+    TextBuffer.resize(TextBuffer.Size + cmd->DataCount);
+    memcpy(TextBuffer.Data + cmd->DataOffset, text_begin, (size_t)cmd->DataCount);
+}
+
+// Create the circle rings Replay() is going to look up, before it runs on a thread where the cache is read-only.
+// Mirrors the radius and segment count adjustments of ImDrawList::AddCircle()/AddCircleFilled().
+void ImDrawStream::_CacheCircleRings(ImDrawList* draw_list) const
+{
+    float prev_radius = -1.0f;
+    int prev_num_segments = 0;
+    for (const ImDrawStreamCmd* cmd = Cmds.Data; cmd != Cmds.Data + Cmds.Size; cmd++)
+    {
+        if (cmd->Type != ImDrawStreamCmdType_Circle && cmd->Type != ImDrawStreamCmdType_CircleFilled)
+            continue;
+        const float radius = (cmd->Type == ImDrawStreamCmdType_Circle) ? cmd->Rounding - 0.5f : cmd->Rounding;
+        const int num_segments = (cmd->Flags > 0) ? ImClamp(cmd->Flags, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX) : cmd->Flags;
+        if (radius == prev_radius && num_segments == prev_num_segments) // Markers tend to come in runs of the same size
+            continue;
+        GetCircleRing(draw_list, radius, num_segments);
+        prev_radius = radius;
+        prev_num_segments = num_segments;
+    }
+}
+
+void ImDrawStream::Replay(ImDrawList* draw_list) const
+{
+    for (const ImDrawStreamCmd* cmd = Cmds.Data; cmd != Cmds.Data + Cmds.Size; cmd++)
+    {
+        switch (cmd->Type)
+        {
+        case ImDrawStreamCmdType_PushClipRect:      draw_list->PushClipRect(cmd->P1, cmd->P2, cmd->Flags != 0); break;
+        case ImDrawStreamCmdType_PopClipRect:       draw_list->PopClipRect(); break;
+        case ImDrawStreamCmdType_Line:              draw_list->AddLine(cmd->P1, cmd->P2, cmd->Col, cmd->Thickness); break;
+        case ImDrawStreamCmdType_Rect:              draw_list->AddRect(cmd->P1, cmd->P2, cmd->Col, cmd->Rounding, cmd->Flags, cmd->Thickness); break;
+        case ImDrawStreamCmdType_RectFilled:        draw_list->AddRectFilled(cmd->P1, cmd->P2, cmd->Col, cmd->Rounding, cmd->Flags); break;
+        case ImDrawStreamCmdType_Circle:            draw_list->AddCircle(cmd->P1, cmd->Rounding, cmd->Col, cmd->Flags, cmd->Thickness); break;
+        case ImDrawStreamCmdType_CircleFilled:      draw_list->AddCircleFilled(cmd->P1, cmd->Rounding, cmd->Col, cmd->Flags); break;
+        case ImDrawStreamCmdType_Polyline:          draw_list->AddPolyline(Points.Data + cmd->DataOffset, cmd->DataCount, cmd->Col, cmd->Flags, cmd->Thickness); break;
+        case ImDrawStreamCmdType_ConvexPolyFilled:  draw_list->AddConvexPolyFilled(Points.Data + cmd->DataOffset, cmd->DataCount, cmd->Col); break;
+        case ImDrawStreamCmdType_Text:              draw_list->AddText(cmd->Font, cmd->Thickness, cmd->P1, cmd->Col, TextBuffer.Data + cmd->DataOffset, TextBuffer.Data + cmd->DataOffset + cmd->DataCount); break;
+        default: IM_ASSERT(0); break;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawData
 //-----------------------------------------------------------------------------
@@ -1859,6 +2468,21 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
     }
 }
 
+ImU32 ImDrawData::CalcContentHash() const
+{
+    ImU32 hash = ImHashData(&DisplayPos, sizeof(ImVec2));
+    hash = ImHashData(&DisplaySize, sizeof(ImVec2), hash);
+    hash = ImHashData(&FramebufferScale, sizeof(ImVec2), hash);
+    for (int i = 0; i < CmdListsCount; i++)
+    {
+        const ImDrawList* cmd_list = CmdLists[i];
+        hash = ImHashData(cmd_list->CmdBuffer.Data, (size_t)cmd_list->CmdBuffer.size_in_bytes(), hash);
+        hash = ImHashData(cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.size_in_bytes(), hash);
+        hash = ImHashData(cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.size_in_bytes(), hash);
+    }
+    return hash;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Helpers ShadeVertsXXX functions
 //-----------------------------------------------------------------------------
@@ -1866,6 +2490,13 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
 {
+    if (draw_list->_ContentHashing)
+    {
+        // The vertex range isn't hashed: it depends on whether earlier primitives were emitted
+        const struct { ImVec2 P0, P1; ImU32 Col0, Col1; } args = { gradient_p0, gradient_p1, col0, col1 };
+        if (ImDrawListHashPrimitive(draw_list, ImDrawListPrimitive_ShadeColor, &args, sizeof(args)))
+            return;
+    }
     ImVec2 gradient_extent = gradient_p1 - gradient_p0;
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
@@ -1890,6 +2521,12 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
 // Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
+    if (draw_list->_ContentHashing)
+    {
+        const struct { ImVec2 A, B, UvA, UvB; int Clamp; } args = { a, b, uv_a, uv_b, clamp ? 1 : 0 };
+        if (ImDrawListHashPrimitive(draw_list, ImDrawListPrimitive_ShadeUV, &args, sizeof(args)))
+            return;
+    }
     const ImVec2 size = b - a;
     const ImVec2 uv_size = uv_b - uv_a;
     const ImVec2 scale = ImVec2(
@@ -1981,10 +2618,14 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
     { ImVec2(109,0),ImVec2(13,15), ImVec2( 6, 7) }, // ImGuiMouseCursor_NotAllowed
 };
 
+static void ImFontAtlasDestroyDynamicGlyphs(ImFontAtlas* atlas);
+
 ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    GlyphsEvictDelay = 10.0f;
+    TexSdfSpread = 4;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2014,6 +2655,7 @@ void    ImFontAtlas::ClearInputData()
     ConfigData.clear();
     CustomRects.clear();
     PackIdMouseCursors = PackIdLines = -1;
+    ImFontAtlasDestroyDynamicGlyphs(this); // Needs the font data to rasterize glyphs
     // Important: we leave TexReady untouched
 }
 
@@ -2033,6 +2675,7 @@ void    ImFontAtlas::ClearTexData()
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDestroyDynamicGlyphs(this);
     Fonts.clear_delete();
     TexReady = false;
 }
@@ -2295,14 +2938,283 @@ bool    ImFontAtlas::Build()
     return builder_io->FontBuilder_Build(this);
 }
 
-void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
+// Build cache
+// - The output of Build() only depends on the font data, ImFontConfig fields, custom rectangles and atlas options,
+//   so it can be saved once and restored on later runs as long as these don't change. They are hashed into a key
+//   stored in the cache: LoadBuildCache() refuses data saved with a different key (or by a different build of dear imgui).
+// - The data is a plain native-endian dump, read with bounds checks. It is parsed once to validate it, then a second
+//   time to apply it, so a truncated or mismatching file never leaves the atlas half restored.
+static const ImU32 FONT_ATLAS_CACHE_MAGIC = 0x43414649; // "IFAC"
+static const ImU32 FONT_ATLAS_CACHE_VERSION = 1;
+
+static void ImFontResetTextCaches(ImFont* font);
+
+struct ImFontAtlasCacheReader
 {
-    for (unsigned int i = 0; i < 256; i++)
+    const char*     Ptr;
+    const char*     End;
+
+    bool Read(void* dst, size_t size)   { if ((size_t)(End - Ptr) < size) return false; if (dst) memcpy(dst, Ptr, size); Ptr += size; return true; }
+    template<typename T> bool Read(T* dst) { return Read(dst, sizeof(T)); }
+    template<typename T> bool ReadCheck(const T& expected) { T v; return Read(&v, sizeof(T)) && memcmp(&v, &expected, sizeof(T)) == 0; }
+    template<typename T> bool ReadVector(ImVector<T>* dst, int* out_count = NULL)
     {
-        unsigned int value = (unsigned int)(i * in_brighten_factor);
-        out_table[i] = value > 255 ? 255 : (value & 0xFF);
+        int count;
+        if (!Read(&count) || count < 0 || (size_t)(End - Ptr) / sizeof(T) < (size_t)count)
+            return false;
+        if (dst)
+            dst->resize(count);
+        if (out_count)
+            *out_count = count;
+        return Read(dst ? dst->Data : NULL, (size_t)count * sizeof(T));
     }
-}
+};
+
+static void ImFontAtlasCacheWrite(ImVector<char>* out, const void* data, size_t size)
+{
+    const int pos = out->Size;
+    out->resize(out->Size + (int)size);
+    memcpy(out->Data + pos, data, size);
+}
+template<typename T> static void ImFontAtlasCacheWrite(ImVector<char>* out, const T& v) { ImFontAtlasCacheWrite(out, &v, sizeof(T)); }
+template<typename T> static void ImFontAtlasCacheWriteVector(ImVector<char>* out, const ImVector<T>& v)
+{
+    ImFontAtlasCacheWrite(out, v.Size);
+    ImFontAtlasCacheWrite(out, v.Data, (size_t)v.size_in_bytes());
+}
+
+static int ImFontAtlasCacheFindFont(const ImFontAtlas* atlas, const ImFont* font)
+{
+    for (int n = 0; n < atlas->Fonts.Size; n++)
+        if (atlas->Fonts[n] == font)
+            return n;
+    return -1;
+}
+
+// Hash everything Build() reads. Struct fields are hashed one by one to skip padding and pointers.
+static ImU32 ImFontAtlasCalcBuildCacheKey(ImFontAtlas* atlas)
+{
+    ImU32 key = ImHashData(&FONT_ATLAS_CACHE_VERSION, sizeof(FONT_ATLAS_CACHE_VERSION));
+#define HASH_FIELD(_FIELD)  key = ImHashData(&(_FIELD), sizeof(_FIELD), key)
+    HASH_FIELD(atlas->Flags);
+    HASH_FIELD(atlas->TexDesiredWidth);
+    HASH_FIELD(atlas->TexGlyphPadding);
+    HASH_FIELD(atlas->TexSdfSpread);
+    HASH_FIELD(atlas->FontBuilderFlags);
+    for (int n = 0; n < atlas->ConfigData.Size; n++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[n];
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count] && ranges[ranges_count + 1])
+            ranges_count += 2;
+        const int dst_font_index = ImFontAtlasCacheFindFont(atlas, cfg.DstFont);
+        key = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, key);
+        key = ImHashData(ranges, (size_t)ranges_count * sizeof(ImWchar), key);
+        HASH_FIELD(ranges_count);
+        HASH_FIELD(dst_font_index);
+        HASH_FIELD(cfg.FontNo);
+        HASH_FIELD(cfg.SizePixels);
+        HASH_FIELD(cfg.OversampleH);
+        HASH_FIELD(cfg.OversampleV);
+        HASH_FIELD(cfg.PixelSnapH);
+        HASH_FIELD(cfg.GlyphExtraSpacing);
+        HASH_FIELD(cfg.GlyphOffset);
+        HASH_FIELD(cfg.GlyphMinAdvanceX);
+        HASH_FIELD(cfg.GlyphMaxAdvanceX);
+        HASH_FIELD(cfg.MergeMode);
+        HASH_FIELD(cfg.FontBuilderFlags);
+        HASH_FIELD(cfg.RasterizerMultiply);
+        HASH_FIELD(cfg.EllipsisChar);
+    }
+    for (int n = 0; n < atlas->CustomRects.Size; n++)
+    {
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[n];
+        const int font_index = r.Font ? ImFontAtlasCacheFindFont(atlas, r.Font) : -1;
+        HASH_FIELD(r.Width);
+        HASH_FIELD(r.Height);
+        HASH_FIELD(r.GlyphID);
+        HASH_FIELD(r.GlyphAdvanceX);
+        HASH_FIELD(r.GlyphOffset);
+        HASH_FIELD(font_index);
+    }
+#undef HASH_FIELD
+    return key;
+}
+
+// With 'apply' == false only check that the data can be read entirely and matches the atlas layout.
+static bool ImFontAtlasReadBuildCache(ImFontAtlas* atlas, ImFontAtlasCacheReader r, ImU32 key, bool apply)
+{
+    int tex_width, tex_height;
+    bool has_alpha8, has_rgba32, use_colors;
+    if (!r.ReadCheck(FONT_ATLAS_CACHE_MAGIC) || !r.ReadCheck(FONT_ATLAS_CACHE_VERSION) || !r.ReadCheck(key))
+        return false;
+    if (!r.ReadCheck((int)sizeof(ImWchar)) || !r.ReadCheck((int)sizeof(ImFontGlyph)) || !r.ReadCheck((int)IM_DRAWLIST_TEX_LINES_WIDTH_MAX))
+        return false;
+    if (!r.ReadCheck(atlas->Fonts.Size) || !r.ReadCheck(atlas->CustomRects.Size))
+        return false;
+    if (!r.Read(&tex_width) || !r.Read(&tex_height) || tex_width <= 0 || tex_height <= 0 || !r.Read(&has_alpha8) || !r.Read(&has_rgba32) || !r.Read(&use_colors))
+        return false;
+
+    if (apply)
+    {
+        ImFontAtlasDestroyDynamicGlyphs(atlas);
+        atlas->ClearTexData();
+        atlas->TexID = (ImTextureID)NULL;
+        atlas->TexWidth = tex_width;
+        atlas->TexHeight = tex_height;
+        atlas->TexPixelsUseColors = use_colors;
+    }
+    ImFontAtlas* dst = apply ? atlas : NULL;
+    if (!r.Read(dst ? &dst->TexUvScale : NULL, sizeof(ImVec2)) || !r.Read(dst ? &dst->TexUvWhitePixel : NULL, sizeof(ImVec2)) || !r.Read(dst ? dst->TexUvLines : NULL, sizeof(atlas->TexUvLines)))
+        return false;
+    for (int n = 0; n < atlas->CustomRects.Size; n++)
+    {
+        ImFontAtlasCustomRect* rect = dst ? &dst->CustomRects[n] : NULL;
+        if (!r.Read(rect ? &rect->X : NULL, sizeof(rect->X)) || !r.Read(rect ? &rect->Y : NULL, sizeof(rect->Y)))
+            return false;
+    }
+
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFont* font = dst ? dst->Fonts[font_n] : NULL;
+        int fallback_glyph_index = -1;
+        int glyphs_count = 0;
+        if (font)
+            font->ClearOutputData();
+        if (!r.Read(font ? &font->FontSize : NULL, sizeof(float)) || !r.Read(font ? &font->Ascent : NULL, sizeof(float)) || !r.Read(font ? &font->Descent : NULL, sizeof(float)))
+            return false;
+        if (!r.Read(font ? &font->FallbackAdvanceX : NULL, sizeof(float)) || !r.Read(font ? &font->MetricsTotalSurface : NULL, sizeof(int)))
+            return false;
+        if (!r.Read(font ? &font->FallbackChar : NULL, sizeof(ImWchar)) || !r.Read(font ? &font->EllipsisChar : NULL, sizeof(ImWchar)) || !r.Read(font ? &font->DotChar : NULL, sizeof(ImWchar)))
+            return false;
+        if (!r.Read(font ? font->Used4kPagesMap : NULL, sizeof(font->Used4kPagesMap)) || !r.Read(&fallback_glyph_index))
+            return false;
+        if (!r.ReadVector(font ? &font->Glyphs : NULL, &glyphs_count) || !r.ReadVector(font ? &font->IndexAdvanceX : NULL) || !r.ReadVector(font ? &font->IndexLookup : NULL))
+            return false;
+        if (fallback_glyph_index < 0 || fallback_glyph_index >= glyphs_count)
+            return false;
+        if (!font)
+            continue;
+
+        // Same links as ImFontAtlasBuildSetupFont() would have set up
+        font->FallbackGlyph = &font->Glyphs[fallback_glyph_index];
+        font->ContainerAtlas = atlas;
+        font->DirtyLookupTables = false;
+        for (int cfg_n = 0; cfg_n < atlas->ConfigData.Size; cfg_n++)
+            if (atlas->ConfigData[cfg_n].DstFont == font)
+            {
+                if (!atlas->ConfigData[cfg_n].MergeMode)
+                {
+                    font->ConfigData = &atlas->ConfigData[cfg_n];
+                    font->ConfigDataCount = 0;
+                }
+                font->ConfigDataCount++;
+            }
+        ImFontResetTextCaches(font);
+    }
+
+    const size_t pixels_count = (size_t)tex_width * (size_t)tex_height;
+    if (has_alpha8)
+    {
+        if (dst)
+            dst->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(pixels_count);
+        if (!r.Read(dst ? dst->TexPixelsAlpha8 : NULL, pixels_count))
+            return false;
+    }
+    if (has_rgba32)
+    {
+        if (dst)
+            dst->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(pixels_count * 4);
+        if (!r.Read(dst ? dst->TexPixelsRGBA32 : NULL, pixels_count * 4))
+            return false;
+    }
+    if (dst)
+        dst->TexReady = true;
+    return r.Ptr == r.End && (has_alpha8 || has_rgba32);
+}
+
+bool    ImFontAtlas::LoadBuildCache(const void* data, size_t data_size)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    // The texture of a dynamic atlas changes while it is used: saving it would mostly capture whatever was on screen.
+    if (data == NULL || (Flags & ImFontAtlasFlags_DynamicGlyphs))
+        return false;
+
+    // Same inputs as Build() would see
+    if (ConfigData.Size == 0)
+        AddFontDefault();
+    ImFontAtlasBuildInit(this);
+
+    ImFontAtlasCacheReader reader;
+    reader.Ptr = (const char*)data;
+    reader.End = reader.Ptr + data_size;
+    const ImU32 key = ImFontAtlasCalcBuildCacheKey(this);
+    if (!ImFontAtlasReadBuildCache(this, reader, key, false))
+        return false;
+    return ImFontAtlasReadBuildCache(this, reader, key, true);
+}
+
+void    ImFontAtlas::SaveBuildCache(ImVector<char>* out_data)
+{
+    IM_ASSERT(TexReady && (TexPixelsAlpha8 != NULL || TexPixelsRGBA32 != NULL) && "Call Build() first!");
+    IM_ASSERT(ConfigData.Size > 0 && "Call before ClearInputData()!");
+    ImVector<char>* out = out_data;
+    out->resize(0);
+    ImFontAtlasCacheWrite(out, FONT_ATLAS_CACHE_MAGIC);
+    ImFontAtlasCacheWrite(out, FONT_ATLAS_CACHE_VERSION);
+    ImFontAtlasCacheWrite(out, ImFontAtlasCalcBuildCacheKey(this));
+    ImFontAtlasCacheWrite(out, (int)sizeof(ImWchar));
+    ImFontAtlasCacheWrite(out, (int)sizeof(ImFontGlyph));
+    ImFontAtlasCacheWrite(out, (int)IM_DRAWLIST_TEX_LINES_WIDTH_MAX);
+    ImFontAtlasCacheWrite(out, Fonts.Size);
+    ImFontAtlasCacheWrite(out, CustomRects.Size);
+    ImFontAtlasCacheWrite(out, TexWidth);
+    ImFontAtlasCacheWrite(out, TexHeight);
+    ImFontAtlasCacheWrite(out, TexPixelsAlpha8 != NULL);
+    ImFontAtlasCacheWrite(out, TexPixelsRGBA32 != NULL);
+    ImFontAtlasCacheWrite(out, TexPixelsUseColors);
+    ImFontAtlasCacheWrite(out, TexUvScale);
+    ImFontAtlasCacheWrite(out, TexUvWhitePixel);
+    ImFontAtlasCacheWrite(out, TexUvLines, sizeof(TexUvLines));
+    for (int n = 0; n < CustomRects.Size; n++)
+    {
+        ImFontAtlasCacheWrite(out, CustomRects[n].X);
+        ImFontAtlasCacheWrite(out, CustomRects[n].Y);
+    }
+    for (int n = 0; n < Fonts.Size; n++)
+    {
+        const ImFont* font = Fonts[n];
+        IM_ASSERT(!font->DirtyLookupTables && font->FallbackGlyph != NULL);
+        ImFontAtlasCacheWrite(out, font->FontSize);
+        ImFontAtlasCacheWrite(out, font->Ascent);
+        ImFontAtlasCacheWrite(out, font->Descent);
+        ImFontAtlasCacheWrite(out, font->FallbackAdvanceX);
+        ImFontAtlasCacheWrite(out, font->MetricsTotalSurface);
+        ImFontAtlasCacheWrite(out, font->FallbackChar);
+        ImFontAtlasCacheWrite(out, font->EllipsisChar);
+        ImFontAtlasCacheWrite(out, font->DotChar);
+        ImFontAtlasCacheWrite(out, font->Used4kPagesMap, sizeof(font->Used4kPagesMap));
+        ImFontAtlasCacheWrite(out, font->Glyphs.index_from_ptr(font->FallbackGlyph));
+        ImFontAtlasCacheWriteVector(out, font->Glyphs);
+        ImFontAtlasCacheWriteVector(out, font->IndexAdvanceX);
+        ImFontAtlasCacheWriteVector(out, font->IndexLookup);
+    }
+    const size_t pixels_count = (size_t)TexWidth * (size_t)TexHeight;
+    if (TexPixelsAlpha8)
+        ImFontAtlasCacheWrite(out, TexPixelsAlpha8, pixels_count);
+    if (TexPixelsRGBA32)
+        ImFontAtlasCacheWrite(out, TexPixelsRGBA32, pixels_count * 4);
+}
+
+void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
+{
+    for (unsigned int i = 0; i < 256; i++)
+    {
+        unsigned int value = (unsigned int)(i * in_brighten_factor);
+        out_table[i] = value > 255 ? 255 : (value & 0xFF);
+    }
+}
 
 void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride)
 {
@@ -2312,6 +3224,13 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             data[i] = table[data[i]];
 }
 
+// Coverage of a pixel of text drawn from a distance field (ImFontAtlasFlags_SignedDistanceField), as computed by the imgui_impl_opengl3 shader.
+// 'texel' is the bilinearly filtered texture value (0..1) and 'texel_per_pixel' how much it changes across one output pixel (fwidth() in GLSL).
+float   ImFontAtlasSdfCoverage(float texel, float texel_per_pixel)
+{
+    return ImSaturate((texel - IM_FONT_SDF_ON_EDGE / 255.0f) / ImMax(texel_per_pixel, 1e-4f) + 0.5f);
+}
+
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
@@ -2338,6 +3257,163 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Looking up, measuring and rasterizing glyphs is spread over worker threads (io.ParallelForFn of the current context, if any).
+// Lookups run one job per source font, the other two one job per slice of a source font's glyphs. Merging sources and packing
+// stay serial, and every glyph is rasterized into its own packed rectangle, so the texture comes out the same either way.
+static const int FONT_ATLAS_BUILD_JOB_GLYPHS = 256;
+
+struct ImFontBuildJob
+{
+    int                 SrcIndex;
+    int                 GlyphsBegin;
+    int                 GlyphsEnd;
+};
+
+struct ImFontBuildJobsContext
+{
+    ImFontAtlas*                Atlas;
+    ImFontBuildSrcData*         SrcTmp;
+    const ImFontBuildJob*       Jobs;
+    const stbtt_pack_context*   PackContext;
+    bool                        ResidentOnly;   // ImFontAtlasFlags_DynamicGlyphs
+};
+
+// Glyphs rasterized by Build() with ImFontAtlasFlags_DynamicGlyphs, which stay in the atlas: ASCII and the characters
+// ImFont::BuildLookupTable() looks for (fallback, ellipsis and dots).
+static inline bool ImFontAtlasIsResidentCodepoint(unsigned int c)
+{
+    return (c >= 0x20 && c < 0x7F) || c == IM_UNICODE_CODEPOINT_INVALID || c == 0x2026 || c == 0x0085 || c == 0xFF0E;
+}
+
+static void ImFontAtlasBuildParallelFor(int count, void (*job)(void* job_data, int index), void* job_data)
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx && ctx->IO.ParallelForFn && count > 1)
+    {
+        ctx->ParallelJobsRunning = true;
+        ctx->IO.ParallelForFn(ctx->IO.ParallelForUserData, count, job, job_data);
+        ctx->ParallelJobsRunning = false;
+    }
+    else
+    {
+        for (int n = 0; n < count; n++)
+            job(job_data, n);
+    }
+}
+
+// Size of the rectangle to pack for a glyph: its bitmap box, plus the distance field spread or the oversampling filter width, plus padding.
+static void ImFontAtlasBuildCalcGlyphRect(const ImFontAtlas* atlas, const stbtt_fontinfo* font_info, const ImFontConfig& cfg, float scale, int glyph_index_in_font, stbrp_rect* r)
+{
+    int x0, y0, x1, y1;
+    const int padding = atlas->TexGlyphPadding;
+    if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+    {
+        stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+        const int spread = (x0 != x1 && y0 != y1) ? atlas->TexSdfSpread * 2 : 0; // stbtt_GetGlyphSDF() outputs nothing for empty glyphs
+        r->w = (stbrp_coord)(x1 - x0 + spread + padding);
+        r->h = (stbrp_coord)(y1 - y0 + spread + padding);
+        return;
+    }
+    stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    r->w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+    r->h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+}
+
+// Write the distance field of a glyph into its packed rectangle, and fill 'out_char' the way stbtt_PackFontRangesRenderIntoRects() would.
+static void ImFontAtlasBuildRenderGlyphSdf(ImFontAtlas* atlas, const stbtt_fontinfo* font_info, float scale, int glyph_index_in_font, const stbrp_rect& r, stbtt_packedchar* out_char)
+{
+    const int spread = atlas->TexSdfSpread;
+    int w = 0, h = 0, x_off = 0, y_off = 0;
+    if (unsigned char* sdf = stbtt_GetGlyphSDF(font_info, scale, glyph_index_in_font, spread, IM_FONT_SDF_ON_EDGE, (float)IM_FONT_SDF_ON_EDGE / spread, &w, &h, &x_off, &y_off))
+    {
+        IM_ASSERT(w <= r.w && h <= r.h);
+        for (int y = 0; y < h; y++)
+            memcpy(atlas->TexPixelsAlpha8 + (size_t)(r.y + y) * atlas->TexWidth + r.x, sdf + (size_t)y * w, (size_t)w);
+        stbtt_FreeSDF(sdf, NULL);
+    }
+    int advance, left_side_bearing;
+    stbtt_GetGlyphHMetrics(font_info, glyph_index_in_font, &advance, &left_side_bearing);
+    out_char->x0 = (unsigned short)r.x;
+    out_char->y0 = (unsigned short)r.y;
+    out_char->x1 = (unsigned short)(r.x + w);
+    out_char->y1 = (unsigned short)(r.y + h);
+    out_char->xoff = (float)x_off;
+    out_char->yoff = (float)y_off;
+    out_char->xoff2 = (float)(x_off + w);
+    out_char->yoff2 = (float)(y_off + h);
+    out_char->xadvance = scale * advance;
+}
+
+// Mark the requested codepoints that are present in the font data (one job per source font)
+static void ImFontAtlasBuildFindGlyphsJob(void* job_data, int src_i)
+{
+    ImFontBuildJobsContext* jobs_ctx = (ImFontBuildJobsContext*)job_data;
+    ImFontBuildSrcData& src_tmp = jobs_ctx->SrcTmp[src_i];
+    for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
+        for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
+        {
+            if (jobs_ctx->ResidentOnly && !ImFontAtlasIsResidentCodepoint(codepoint))
+                continue;
+            if (stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))
+                src_tmp.GlyphsSet.SetBit(codepoint);
+        }
+}
+
+// Gather the sizes of the rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
+static void ImFontAtlasBuildGatherRectsJob(void* job_data, int job_index)
+{
+    ImFontBuildJobsContext* jobs_ctx = (ImFontBuildJobsContext*)job_data;
+    const ImFontBuildJob& job = jobs_ctx->Jobs[job_index];
+    ImFontBuildSrcData& src_tmp = jobs_ctx->SrcTmp[job.SrcIndex];
+    const ImFontConfig& cfg = jobs_ctx->Atlas->ConfigData[job.SrcIndex];
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+    for (int glyph_i = job.GlyphsBegin; glyph_i < job.GlyphsEnd; glyph_i++)
+    {
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
+        IM_ASSERT(glyph_index_in_font != 0);
+        ImFontAtlasBuildCalcGlyphRect(jobs_ctx->Atlas, &src_tmp.FontInfo, cfg, scale, glyph_index_in_font, &src_tmp.Rects[glyph_i]);
+    }
+}
+
+// Render/rasterize a slice of packed glyphs into the texture, then apply the multiply operator to them.
+static void ImFontAtlasBuildRenderRectsJob(void* job_data, int job_index)
+{
+    ImFontBuildJobsContext* jobs_ctx = (ImFontBuildJobsContext*)job_data;
+    const ImFontBuildJob& job = jobs_ctx->Jobs[job_index];
+    ImFontBuildSrcData& src_tmp = jobs_ctx->SrcTmp[job.SrcIndex];
+    const ImFontConfig& cfg = jobs_ctx->Atlas->ConfigData[job.SrcIndex];
+
+    if (jobs_ctx->Atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+    {
+        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+        for (int glyph_i = job.GlyphsBegin; glyph_i < job.GlyphsEnd; glyph_i++)
+            if (src_tmp.Rects[glyph_i].was_packed)
+                ImFontAtlasBuildRenderGlyphSdf(jobs_ctx->Atlas, &src_tmp.FontInfo, scale, stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]), src_tmp.Rects[glyph_i], &src_tmp.PackedChars[glyph_i]);
+        return;
+    }
+
+    // stbtt_PackFontRangesRenderIntoRects() temporarily writes the oversampling settings into the pack context: give each job a copy.
+    stbtt_pack_context spc = *jobs_ctx->PackContext;
+    stbtt_pack_range range = src_tmp.PackRange;
+    range.array_of_unicode_codepoints += job.GlyphsBegin;
+    range.chardata_for_range += job.GlyphsBegin;
+    range.num_chars = job.GlyphsEnd - job.GlyphsBegin;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &range, 1, src_tmp.Rects + job.GlyphsBegin);
+
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlas* atlas = jobs_ctx->Atlas;
+        for (int glyph_i = job.GlyphsBegin; glyph_i < job.GlyphsEnd; glyph_i++)
+        {
+            const stbrp_rect* r = &src_tmp.Rects[glyph_i];
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+        }
+    }
+}
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2350,13 +3426,466 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+//-------------------------------------------------------------------------
+// Dynamic glyphs (ImFontAtlasFlags_DynamicGlyphs)
+//-------------------------------------------------------------------------
+// - Build() only rasterizes the resident glyphs and leaves the rows below them empty. Drawing or measuring text requests
+//   the glyphs it is missing, and ImFontAtlasUpdateDynamicGlyphs() (called by NewFrame() before the atlas gets locked)
+//   rasterizes them over io.ParallelForFn. A new character is thus drawn with the fallback glyph for one frame.
+// - Glyphs that weren't used for GlyphsEvictDelay seconds are evicted. The skyline packer never reuses space, so when
+//   a new glyph doesn't fit anymore the dynamic area is compacted: the glyphs drawn in the last frame are repacked (and
+//   their UVs updated), the others evicted.
+// - Modified pixels are accumulated in a dirty rectangle, which backends retrieve with GetTexDataDirtyRect().
+//-------------------------------------------------------------------------
+
+enum ImFontDynamicGlyphState_
+{
+    ImFontDynamicGlyphState_Unknown,        // Not requested since it was last registered or evicted
+    ImFontDynamicGlyphState_Pending,        // Waiting for the next ImFontAtlasUpdateDynamicGlyphs()
+    ImFontDynamicGlyphState_Missing,        // Not in the glyph ranges or in the font data
+    ImFontDynamicGlyphState_NoRoom,         // Didn't fit: may be requested again once something got evicted
+};
+
+struct ImFontDynamicGlyph
+{
+    int                 FontIndex;          // Index into ImFontAtlasDynamicGlyphs::Fonts[]
+    int                 GlyphIndex;         // Index into ImFont::Glyphs[]
+    stbrp_rect          Rect;               // Packed rectangle, relative to ImFontAtlasDynamicGlyphs::PackY
+    double              LastUsedTime;
+};
+
+struct ImFontDynamicFont
+{
+    ImFont*             Font;
+    ImVector<int>       GlyphSlots;         // Index into ImFontAtlasDynamicGlyphs::Glyphs[] for each of Font->Glyphs[] (-1 for resident and free entries)
+    ImVector<int>       FreeGlyphs;         // Entries of Font->Glyphs[] left by evicted glyphs. Indices in IndexLookup[] need to stay valid, so we reuse them.
+    ImVector<unsigned int> NoRoomCodepoints;
+    ImGuiStorage        States;             // ImFontDynamicGlyphState_ of codepoints without a glyph
+};
+
+struct ImFontDynamicRequest
+{
+    int                 FontIndex;
+    unsigned int        Codepoint;
+    int                 SrcIndex;           // Index into atlas->ConfigData[] of the source font providing the glyph
+    stbrp_rect          Rect;               // Relative to ImFontAtlasDynamicGlyphs::PackY
+    stbtt_packedchar    PackedChar;
+};
+
+struct ImFontAtlasDynamicGlyphs
+{
+    ImVector<stbtt_fontinfo>        FontInfos;      // For each of atlas->ConfigData[]
+    ImVector<ImFontDynamicFont>     Fonts;          // For each of atlas->Fonts[]
+    ImVector<ImFontDynamicGlyph>    Glyphs;         // Glyphs currently in the dynamic area
+    ImVector<ImFontDynamicRequest>  Requests;
+    stbrp_context                   PackContext;
+    ImVector<stbrp_node>            PackNodes;
+    int                             PackY;          // First row below the resident glyphs
+    double                          Time;           // Time of the last ImFontAtlasUpdateDynamicGlyphs(), stamped on glyphs as they are used
+    int                             DirtyX0, DirtyY0, DirtyX1, DirtyY1;
+
+    ImFontAtlasDynamicGlyphs()      { memset(&PackContext, 0, sizeof(PackContext)); PackY = 0; Time = 0.0; DirtyX0 = DirtyY0 = DirtyX1 = DirtyY1 = 0; }
+    ~ImFontAtlasDynamicGlyphs()     { Fonts.clear_destruct(); }
+
+    void AddDirtyRect(int x0, int y0, int x1, int y1)
+    {
+        if (DirtyX0 >= DirtyX1 || DirtyY0 >= DirtyY1)
+        {
+            DirtyX0 = x0; DirtyY0 = y0; DirtyX1 = x1; DirtyY1 = y1;
+            return;
+        }
+        DirtyX0 = ImMin(DirtyX0, x0); DirtyY0 = ImMin(DirtyY0, y0);
+        DirtyX1 = ImMax(DirtyX1, x1); DirtyY1 = ImMax(DirtyY1, y1);
+    }
+};
+
+// Glyphs of a dynamic atlas are rasterized 16 per job
+static const int FONT_ATLAS_DYNAMIC_JOB_GLYPHS = 16;
+
+struct ImFontDynamicJobsContext
+{
+    ImFontAtlas*                Atlas;
+    ImFontDynamicRequest*       Requests;
+    int                         RequestsCount;
+};
+
+static void ImFontAtlasCreateDynamicGlyphs(ImFontAtlas* atlas, const ImVector<ImFontBuildSrcData>& src_tmp_array, int pack_y)
+{
+    ImFontAtlasDynamicGlyphs* dyn = IM_NEW(ImFontAtlasDynamicGlyphs)();
+    dyn->FontInfos.resize(src_tmp_array.Size);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        dyn->FontInfos[src_i] = src_tmp_array[src_i].FontInfo;
+    dyn->Fonts.resize(atlas->Fonts.Size);
+    memset((void*)dyn->Fonts.Data, 0, (size_t)dyn->Fonts.size_in_bytes());
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+        dyn->Fonts[font_i].Font = atlas->Fonts[font_i];
+    dyn->PackY = pack_y;
+    dyn->PackNodes.resize(atlas->TexWidth);
+    stbrp_init_target(&dyn->PackContext, atlas->TexWidth, atlas->TexHeight - pack_y, dyn->PackNodes.Data, dyn->PackNodes.Size);
+    atlas->DynamicGlyphs = dyn;
+}
+
+static void ImFontAtlasDestroyDynamicGlyphs(ImFontAtlas* atlas)
+{
+    if (atlas->DynamicGlyphs == NULL)
+        return;
+    IM_DELETE(atlas->DynamicGlyphs);
+    atlas->DynamicGlyphs = NULL;
+}
+
+// Called when text is drawn or measured. Stamp the dynamic glyphs it uses, and request those it is missing.
+static void ImFontAtlasDynamicGlyphsTouchText(const ImFont* font, const char* text_begin, const char* text_end)
+{
+    ImFontAtlasDynamicGlyphs* dyn = font->ContainerAtlas ? font->ContainerAtlas->DynamicGlyphs : NULL;
+    if (dyn == NULL)
+        return;
+    ImGuiContext* ctx = GImGui;
+    if (ctx != NULL && ctx->ParallelJobsRunning)
+        return; // Text tessellated by jobs was already seen when it was recorded
+
+    int font_i = -1;
+    for (const char* s = text_begin; s < text_end; )
+    {
+        if ((unsigned char)*s < 0x80)
+        {
+            s++; // All of ASCII is resident
+            continue;
+        }
+        unsigned int c;
+        s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c > IM_UNICODE_CODEPOINT_MAX)
+            continue;
+        if (font_i == -1)
+        {
+            for (int n = 0; n < dyn->Fonts.Size && font_i == -1; n++)
+                if (dyn->Fonts[n].Font == font)
+                    font_i = n;
+            if (font_i == -1)
+                return; // Font added after Build()
+        }
+        ImFontDynamicFont& dyn_font = dyn->Fonts[font_i];
+        const ImWchar glyph_index = (c < (unsigned int)font->IndexLookup.Size) ? font->IndexLookup.Data[c] : (ImWchar)-1;
+        if (glyph_index != (ImWchar)-1)
+        {
+            const int slot = (glyph_index < dyn_font.GlyphSlots.Size) ? dyn_font.GlyphSlots.Data[glyph_index] : -1;
+            if (slot != -1)
+                dyn->Glyphs[slot].LastUsedTime = dyn->Time;
+        }
+        else if (dyn_font.States.GetInt(c, ImFontDynamicGlyphState_Unknown) == ImFontDynamicGlyphState_Unknown)
+        {
+            dyn_font.States.SetInt(c, ImFontDynamicGlyphState_Pending);
+            ImFontDynamicRequest req;
+            memset(&req, 0, sizeof(req));
+            req.FontIndex = font_i;
+            req.Codepoint = c;
+            dyn->Requests.push_back(req);
+        }
+    }
+}
+
+// Remove a glyph from its font's lookup tables. The entry in ImFont::Glyphs[] is kept for the next dynamic glyph.
+static void ImFontAtlasDynamicGlyphsEvict(ImFontAtlasDynamicGlyphs* dyn, int slot)
+{
+    const ImFontDynamicGlyph dyn_glyph = dyn->Glyphs[slot];
+    ImFontDynamicFont& dyn_font = dyn->Fonts[dyn_glyph.FontIndex];
+    ImFont* font = dyn_font.Font;
+    ImFontGlyph& glyph = font->Glyphs[dyn_glyph.GlyphIndex];
+    font->IndexLookup[glyph.Codepoint] = (ImWchar)-1;
+    font->IndexAdvanceX[glyph.Codepoint] = font->FallbackAdvanceX;
+    glyph.Visible = 0;
+    dyn_font.GlyphSlots[dyn_glyph.GlyphIndex] = -1;
+    dyn_font.FreeGlyphs.push_back(dyn_glyph.GlyphIndex);
+
+    const int last_slot = dyn->Glyphs.Size - 1;
+    if (slot != last_slot)
+    {
+        const ImFontDynamicGlyph& moved = dyn->Glyphs[slot] = dyn->Glyphs[last_slot];
+        dyn->Fonts[moved.FontIndex].GlyphSlots[moved.GlyphIndex] = slot;
+    }
+    dyn->Glyphs.pop_back();
+}
+
+// Repack the glyphs used since 'used_time' along with the requests, moving their pixels. Other glyphs are evicted.
+static void ImFontAtlasDynamicGlyphsCompact(ImFontAtlas* atlas, ImFontAtlasDynamicGlyphs* dyn, double used_time)
+{
+    for (int slot = dyn->Glyphs.Size - 1; slot >= 0; slot--)
+        if (dyn->Glyphs[slot].LastUsedTime < used_time)
+            ImFontAtlasDynamicGlyphsEvict(dyn, slot);
+
+    const int glyphs_count = dyn->Glyphs.Size;
+    ImVector<stbrp_rect> rects;
+    rects.resize(glyphs_count + dyn->Requests.Size);
+    for (int slot = 0; slot < glyphs_count; slot++)
+        rects[slot] = dyn->Glyphs[slot].Rect;
+    for (int req_i = 0; req_i < dyn->Requests.Size; req_i++)
+        rects[glyphs_count + req_i] = dyn->Requests[req_i].Rect;
+    stbrp_init_target(&dyn->PackContext, atlas->TexWidth, atlas->TexHeight - dyn->PackY, dyn->PackNodes.Data, dyn->PackNodes.Size);
+    stbrp_pack_rects(&dyn->PackContext, rects.Data, rects.Size);
+
+    // Move the pixels through a copy of the area, as old and new rectangles may overlap.
+    const int stride = atlas->TexWidth;
+    unsigned char* area = atlas->TexPixelsAlpha8 + (size_t)dyn->PackY * stride;
+    const size_t area_size = (size_t)(atlas->TexHeight - dyn->PackY) * stride;
+    ImVector<unsigned char> old_area;
+    old_area.resize((int)area_size);
+    memcpy(old_area.Data, area, area_size);
+    memset(area, 0, area_size);
+    for (int slot = glyphs_count - 1; slot >= 0; slot--)
+    {
+        ImFontDynamicGlyph& dyn_glyph = dyn->Glyphs[slot];
+        const stbrp_rect& r = rects[slot];
+        if (!r.was_packed)
+        {
+            // Packing order changed and it doesn't fit anymore. Slots above this one were already moved.
+            ImFontAtlasDynamicGlyphsEvict(dyn, slot);
+            continue;
+        }
+        for (int y = 0; y < r.h; y++)
+            memcpy(area + (size_t)(r.y + y) * stride + r.x, old_area.Data + (size_t)(dyn_glyph.Rect.y + y) * stride + dyn_glyph.Rect.x, (size_t)r.w);
+        ImFontGlyph& glyph = dyn->Fonts[dyn_glyph.FontIndex].Font->Glyphs[dyn_glyph.GlyphIndex];
+        const float du = (r.x - dyn_glyph.Rect.x) * atlas->TexUvScale.x;
+        const float dv = (r.y - dyn_glyph.Rect.y) * atlas->TexUvScale.y;
+        glyph.U0 += du; glyph.U1 += du;
+        glyph.V0 += dv; glyph.V1 += dv;
+        dyn_glyph.Rect = r;
+    }
+    for (int req_i = 0; req_i < dyn->Requests.Size; req_i++)
+        dyn->Requests[req_i].Rect = rects[glyphs_count + req_i];
+    dyn->AddDirtyRect(0, dyn->PackY, atlas->TexWidth, atlas->TexHeight);
+}
+
+static void ImFontAtlasDynamicGlyphsRenderJob(void* job_data, int job_index)
+{
+    ImFontDynamicJobsContext* jobs_ctx = (ImFontDynamicJobsContext*)job_data;
+    ImFontAtlas* atlas = jobs_ctx->Atlas;
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    const int req_end = ImMin((job_index + 1) * FONT_ATLAS_DYNAMIC_JOB_GLYPHS, jobs_ctx->RequestsCount);
+    for (int req_i = job_index * FONT_ATLAS_DYNAMIC_JOB_GLYPHS; req_i < req_end; req_i++)
+    {
+        ImFontDynamicRequest& req = jobs_ctx->Requests[req_i];
+        if (!req.Rect.was_packed)
+            continue;
+        const ImFontConfig& cfg = atlas->ConfigData[req.SrcIndex];
+
+        stbtt_pack_context spc;
+        memset(&spc, 0, sizeof(spc));
+        spc.width = atlas->TexWidth;
+        spc.height = atlas->TexHeight;
+        spc.stride_in_bytes = atlas->TexWidth;
+        spc.padding = atlas->TexGlyphPadding;
+        spc.pixels = atlas->TexPixelsAlpha8;
+
+        stbtt_pack_range range;
+        memset(&range, 0, sizeof(range));
+        range.font_size = cfg.SizePixels;
+        range.first_unicode_codepoint_in_range = (int)req.Codepoint;
+        range.num_chars = 1;
+        range.chardata_for_range = &req.PackedChar;
+        range.h_oversample = (unsigned char)cfg.OversampleH;
+        range.v_oversample = (unsigned char)cfg.OversampleV;
+
+        // The area may hold pixels of an evicted glyph. (stb_truetype offsets the rectangle in place, hence the copy.)
+        stbrp_rect r = req.Rect;
+        r.y += dyn->PackY;
+        for (int y = 0; y < req.Rect.h; y++)
+            memset(atlas->TexPixelsAlpha8 + (size_t)(r.y + y) * atlas->TexWidth + r.x, 0, (size_t)req.Rect.w);
+        if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+        {
+            const stbtt_fontinfo* font_info = &dyn->FontInfos[req.SrcIndex];
+            const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels);
+            ImFontAtlasBuildRenderGlyphSdf(atlas, font_info, scale, stbtt_FindGlyphIndex(font_info, (int)req.Codepoint), r, &req.PackedChar);
+            continue;
+        }
+        stbtt_PackFontRangesRenderIntoRects(&spc, &dyn->FontInfos[req.SrcIndex], &range, 1, &r);
+
+        if (cfg.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, req.Rect.x, req.Rect.y + dyn->PackY, req.Rect.w, req.Rect.h, atlas->TexWidth * 1);
+        }
+    }
+}
+
+// Glyphs requested by the text of the last frame are only drawn by the next one
+bool ImFontAtlasHasPendingDynamicGlyphs(const ImFontAtlas* atlas)
+{
+    return atlas->DynamicGlyphs != NULL && atlas->DynamicGlyphs->Requests.Size > 0;
+}
+
+void ImFontAtlasUpdateDynamicGlyphs(ImFontAtlas* atlas, double time)
+{
+    ImFontAtlasDynamicGlyphs* dyn = atlas->DynamicGlyphs;
+    if (dyn == NULL || atlas->TexPixelsAlpha8 == NULL)
+        return;
+    const double prev_time = dyn->Time;
+    dyn->Time = time;
+
+    // 1. Evict glyphs that weren't used for a while, and let glyphs that didn't fit be requested again
+    const int glyphs_count_before = dyn->Glyphs.Size;
+    for (int slot = dyn->Glyphs.Size - 1; slot >= 0; slot--)
+        if (dyn->Glyphs[slot].LastUsedTime < time - atlas->GlyphsEvictDelay)
+            ImFontAtlasDynamicGlyphsEvict(dyn, slot);
+    bool glyphs_changed = dyn->Glyphs.Size != glyphs_count_before;
+    if (glyphs_changed)
+        for (int font_i = 0; font_i < dyn->Fonts.Size; font_i++)
+        {
+            ImFontDynamicFont& dyn_font = dyn->Fonts[font_i];
+            for (int n = 0; n < dyn_font.NoRoomCodepoints.Size; n++)
+                dyn_font.States.SetInt(dyn_font.NoRoomCodepoints[n], ImFontDynamicGlyphState_Unknown);
+            dyn_font.NoRoomCodepoints.resize(0);
+        }
+
+    // 2. Find the source font of each requested codepoint, the same way Build() would, and measure its glyph
+    int requests_count = 0;
+    for (int req_i = 0; req_i < dyn->Requests.Size; req_i++)
+    {
+        ImFontDynamicRequest req = dyn->Requests[req_i];
+        ImFontDynamicFont& dyn_font = dyn->Fonts[req.FontIndex];
+        req.SrcIndex = -1;
+        int glyph_index_in_font = 0;
+        for (int src_i = 0; src_i < atlas->ConfigData.Size && req.SrcIndex == -1; src_i++)
+        {
+            const ImFontConfig& cfg = atlas->ConfigData[src_i];
+            if (cfg.DstFont != dyn_font.Font)
+                continue;
+            for (const ImWchar* src_range = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault(); src_range[0] && src_range[1]; src_range += 2)
+                if (req.Codepoint >= src_range[0] && req.Codepoint <= src_range[1])
+                {
+                    if ((glyph_index_in_font = stbtt_FindGlyphIndex(&dyn->FontInfos[src_i], (int)req.Codepoint)) != 0)
+                        req.SrcIndex = src_i;
+                    break;
+                }
+        }
+        if (req.SrcIndex == -1)
+        {
+            dyn_font.States.SetInt(req.Codepoint, ImFontDynamicGlyphState_Missing);
+            continue;
+        }
+
+        const ImFontConfig& cfg = atlas->ConfigData[req.SrcIndex];
+        const stbtt_fontinfo* font_info = &dyn->FontInfos[req.SrcIndex];
+        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels);
+        ImFontAtlasBuildCalcGlyphRect(atlas, font_info, cfg, scale, glyph_index_in_font, &req.Rect);
+        dyn->Requests[requests_count++] = req;
+    }
+    dyn->Requests.resize(requests_count);
+
+    if (requests_count > 0)
+    {
+        // 3. Pack, compacting the dynamic area if it is full
+        ImVector<stbrp_rect> rects;
+        rects.resize(requests_count);
+        for (int req_i = 0; req_i < requests_count; req_i++)
+            rects[req_i] = dyn->Requests[req_i].Rect;
+        if (stbrp_pack_rects(&dyn->PackContext, rects.Data, rects.Size))
+        {
+            for (int req_i = 0; req_i < requests_count; req_i++)
+                dyn->Requests[req_i].Rect = rects[req_i];
+        }
+        else
+        {
+            ImFontAtlasDynamicGlyphsCompact(atlas, dyn, prev_time);
+        }
+        rects.clear();
+
+        // 4. Render/rasterize glyphs into the texture
+        ImFontDynamicJobsContext jobs_ctx;
+        jobs_ctx.Atlas = atlas;
+        jobs_ctx.Requests = dyn->Requests.Data;
+        jobs_ctx.RequestsCount = requests_count;
+        ImFontAtlasBuildParallelFor((requests_count + FONT_ATLAS_DYNAMIC_JOB_GLYPHS - 1) / FONT_ATLAS_DYNAMIC_JOB_GLYPHS, ImFontAtlasDynamicGlyphsRenderJob, &jobs_ctx);
+
+        // 5. Register glyphs, reusing entries of evicted glyphs
+        for (int req_i = 0; req_i < requests_count; req_i++)
+        {
+            const ImFontDynamicRequest& req = dyn->Requests[req_i];
+            ImFontDynamicFont& dyn_font = dyn->Fonts[req.FontIndex];
+            if (!req.Rect.was_packed)
+            {
+                dyn_font.States.SetInt(req.Codepoint, ImFontDynamicGlyphState_NoRoom);
+                dyn_font.NoRoomCodepoints.push_back(req.Codepoint);
+                continue;
+            }
+
+            ImFont* font = dyn_font.Font;
+            const ImFontConfig& cfg = atlas->ConfigData[req.SrcIndex];
+            const float font_off_x = cfg.GlyphOffset.x;
+            const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(font->Ascent);
+            stbtt_aligned_quad q;
+            float unused_x = 0.0f, unused_y = 0.0f;
+            stbtt_GetPackedQuad(&req.PackedChar, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+
+            const int fallback_index = font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1;
+            font->AddGlyph(&cfg, (ImWchar)req.Codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, req.PackedChar.xadvance);
+            int glyph_index = font->Glyphs.Size - 1;
+            if (dyn_font.FreeGlyphs.Size > 0)
+            {
+                glyph_index = dyn_font.FreeGlyphs.back();
+                dyn_font.FreeGlyphs.pop_back();
+                font->Glyphs[glyph_index] = font->Glyphs.back();
+                font->Glyphs.pop_back();
+            }
+            IM_ASSERT(font->Glyphs.Size < 0xFFFF); // -1 is reserved
+            if (fallback_index != -1)
+                font->FallbackGlyph = &font->Glyphs[fallback_index];
+            font->DirtyLookupTables = false;
+
+            const int index_size = font->IndexLookup.Size;
+            font->GrowIndex((int)req.Codepoint + 1);
+            for (int n = index_size; n < font->IndexAdvanceX.Size; n++)
+                font->IndexAdvanceX[n] = font->FallbackAdvanceX;
+            font->IndexAdvanceX[req.Codepoint] = font->Glyphs[glyph_index].AdvanceX;
+            font->IndexLookup[req.Codepoint] = (ImWchar)glyph_index;
+            const int page_n = (int)req.Codepoint / 4096;
+            font->Used4kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+
+            ImFontDynamicGlyph dyn_glyph;
+            dyn_glyph.FontIndex = req.FontIndex;
+            dyn_glyph.GlyphIndex = glyph_index;
+            dyn_glyph.Rect = req.Rect;
+            dyn_glyph.LastUsedTime = time;
+            if (dyn_font.GlyphSlots.Size < font->Glyphs.Size)
+                dyn_font.GlyphSlots.resize(font->Glyphs.Size, -1);
+            dyn_font.GlyphSlots[glyph_index] = dyn->Glyphs.Size;
+            dyn->Glyphs.push_back(dyn_glyph);
+            dyn_font.States.SetInt(req.Codepoint, ImFontDynamicGlyphState_Unknown);
+            dyn->AddDirtyRect(req.Rect.x, req.Rect.y + dyn->PackY, req.Rect.x + req.Rect.w, req.Rect.y + dyn->PackY + req.Rect.h);
+        }
+        dyn->Requests.resize(0);
+        glyphs_changed = true;
+    }
+    if (!glyphs_changed)
+        return;
+
+    // Keep the RGBA32 copy in sync
+    if (atlas->TexPixelsRGBA32 && dyn->DirtyX0 < dyn->DirtyX1)
+        for (int y = dyn->DirtyY0; y < dyn->DirtyY1; y++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + (size_t)y * atlas->TexWidth + dyn->DirtyX0;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + (size_t)y * atlas->TexWidth + dyn->DirtyX0;
+            for (int n = dyn->DirtyX1 - dyn->DirtyX0; n > 0; n--)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+
+    // Glyph data and advances changed: forget previous text layouts
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        atlas->Fonts[font_i]->ClearGlyphRunCache();
+        atlas->Fonts[font_i]->ClearTextSizeCache();
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
+    IM_ASSERT(!(atlas->Flags & ImFontAtlasFlags_SignedDistanceField) || atlas->TexSdfSpread > 0);
 
     ImFontAtlasBuildInit(atlas);
 
     // Clear atlas
+    ImFontAtlasDestroyDynamicGlyphs(atlas);
+    const bool dynamic_glyphs = (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) != 0;
     atlas->TexID = (ImTextureID)NULL;
     atlas->TexWidth = atlas->TexHeight = 0;
     atlas->TexUvScale = ImVec2(0.0f, 0.0f);
@@ -2404,7 +3933,6 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 2. For every requested codepoint, check for their presence in the font data, and handle redundancy or overlaps between source fonts to avoid unused glyphs.
-    int total_glyphs_count = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
@@ -2412,22 +3940,32 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.GlyphsSet.Create(src_tmp.GlyphsHighest + 1);
         if (dst_tmp.GlyphsSet.Storage.empty())
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
+    }
+    ImFontBuildJobsContext jobs_ctx;
+    jobs_ctx.Atlas = atlas;
+    jobs_ctx.SrcTmp = src_tmp_array.Data;
+    jobs_ctx.Jobs = NULL;
+    jobs_ctx.PackContext = NULL;
+    jobs_ctx.ResidentOnly = dynamic_glyphs;
+    ImFontAtlasBuildParallelFor(src_tmp_array.Size, ImFontAtlasBuildFindGlyphsJob, &jobs_ctx);
 
-        for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
-            for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
-            {
-                if (dst_tmp.GlyphsSet.TestBit(codepoint))    // Don't overwrite existing glyphs. We could make this an option for MergeMode (e.g. MergeOverwrite==true)
-                    continue;
-                if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))    // It is actually in the font?
-                    continue;
-
-                // Add to avail set/counters
+    int total_glyphs_count = 0;
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        ImFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
+        for (int word_n = 0; word_n < src_tmp.GlyphsSet.Storage.Size; word_n++)
+        {
+            // Don't overwrite existing glyphs. We could make this an option for MergeMode (e.g. MergeOverwrite==true)
+            ImU32& src_word = src_tmp.GlyphsSet.Storage[word_n];
+            ImU32& dst_word = dst_tmp.GlyphsSet.Storage[word_n];
+            src_word &= ~dst_word;
+            dst_word |= src_word;
+            for (ImU32 bits = src_word; bits != 0; bits &= bits - 1)
                 src_tmp.GlyphsCount++;
-                dst_tmp.GlyphsCount++;
-                src_tmp.GlyphsSet.SetBit(codepoint);
-                dst_tmp.GlyphsSet.SetBit(codepoint);
-                total_glyphs_count++;
-            }
+        }
+        dst_tmp.GlyphsCount += src_tmp.GlyphsCount;
+        total_glyphs_count += src_tmp.GlyphsCount;
     }
 
     // 3. Unpack our bit map into a flat list (we now have all the Unicode points that we know are requested _and_ available _and_ not overlapping another)
@@ -2453,7 +3991,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
-    int total_surface = 0;
+    ImVector<ImFontBuildJob> jobs;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
@@ -2477,20 +4015,21 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
         src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
 
-        // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
-        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i += FONT_ATLAS_BUILD_JOB_GLYPHS)
         {
-            int x0, y0, x1, y1;
-            const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
-            IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+            ImFontBuildJob job;
+            job.SrcIndex = src_i;
+            job.GlyphsBegin = glyph_i;
+            job.GlyphsEnd = ImMin(glyph_i + FONT_ATLAS_BUILD_JOB_GLYPHS, src_tmp.GlyphsCount);
+            jobs.push_back(job);
         }
     }
+    jobs_ctx.Jobs = jobs.Data;
+    ImFontAtlasBuildParallelFor(jobs.Size, ImFontAtlasBuildGatherRectsJob, &jobs_ctx);
+
+    int total_surface = 0;
+    for (int rect_i = 0; rect_i < buf_rects.Size; rect_i++)
+        total_surface += buf_rects[rect_i].w * buf_rects[rect_i].h;
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
@@ -2499,6 +4038,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     atlas->TexHeight = 0;
     if (atlas->TexDesiredWidth > 0)
         atlas->TexWidth = atlas->TexDesiredWidth;
+    else if (dynamic_glyphs)
+        atlas->TexWidth = 1024;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
 
@@ -2526,39 +4067,28 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 7. Allocate texture
-    atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+    // (Dynamic glyphs get the rows below the resident ones. The texture is square unless these already take more than half of it.)
+    const int resident_height = atlas->TexHeight;
+    if (dynamic_glyphs)
+        atlas->TexHeight = ImMax(atlas->TexWidth, (int)ImUpperPowerOfTwo(resident_height * 2));
+    else
+        atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
     spc.pixels = atlas->TexPixelsAlpha8;
     spc.height = atlas->TexHeight;
 
-    // 8. Render/rasterize font characters into the texture
+    // 8. Render/rasterize font characters into the texture. Packed rectangles don't overlap, so jobs write to disjoint pixels.
+    jobs_ctx.PackContext = &spc;
+    ImFontAtlasBuildParallelFor(jobs.Size, ImFontAtlasBuildRenderRectsJob, &jobs_ctx);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
-        {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
-        }
-        src_tmp.Rects = NULL;
-    }
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
     buf_rects.clear();
+    jobs.clear();
 
     // 9. Setup ImFont and glyphs for runtime
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
@@ -2595,6 +4125,9 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    if (dynamic_glyphs)
+        ImFontAtlasCreateDynamicGlyphs(atlas, src_tmp_array, resident_height);
+
     // Cleanup
     src_tmp_array.clear_destruct();
 
@@ -2609,6 +4142,28 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
     return &io;
 }
 
+bool ImFontAtlas::GetTexDataDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h)
+{
+    ImFontAtlasDynamicGlyphs* dyn = DynamicGlyphs;
+    if (dyn == NULL || dyn->DirtyX0 >= dyn->DirtyX1 || dyn->DirtyY0 >= dyn->DirtyY1)
+        return false;
+    *out_x = dyn->DirtyX0;
+    *out_y = dyn->DirtyY0;
+    *out_w = dyn->DirtyX1 - dyn->DirtyX0;
+    *out_h = dyn->DirtyY1 - dyn->DirtyY0;
+    dyn->DirtyX0 = dyn->DirtyY0 = dyn->DirtyX1 = dyn->DirtyY1 = 0;
+    return true;
+}
+
+#else
+
+// Only the stb_truetype builder supports ImFontAtlasFlags_DynamicGlyphs: atlas->DynamicGlyphs stays NULL.
+static void ImFontAtlasDestroyDynamicGlyphs(ImFontAtlas*) {}
+static void ImFontAtlasDynamicGlyphsTouchText(const ImFont*, const char*, const char*) {}
+void ImFontAtlasUpdateDynamicGlyphs(ImFontAtlas*, double) {}
+bool ImFontAtlasHasPendingDynamicGlyphs(const ImFontAtlas*) { return false; }
+bool ImFontAtlas::GetTexDataDirtyRect(int*, int*, int*, int*) { return false; }
+
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
 void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent)
@@ -2767,6 +4322,10 @@ static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
 // Note: this is called / shared by both the stb_truetype and the FreeType builder
 void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 {
+    // Baked lines are anti-aliased through their texels, which a distance field renderer would threshold
+    if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+        atlas->Flags |= ImFontAtlasFlags_NoBakedLines;
+
     // Register texture region for mouse cursors or standard white pixels
     if (atlas->PackIdMouseCursors < 0)
     {
@@ -3127,11 +4686,17 @@ ImFont::ImFont()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    GlyphRunCache = NULL;
+    TextSizeCache = NULL;
 }
 
 ImFont::~ImFont()
 {
     ClearOutputData();
+    if (GlyphRunCache)
+        IM_DELETE(GlyphRunCache);
+    if (TextSizeCache)
+        IM_DELETE(TextSizeCache);
 }
 
 void    ImFont::ClearOutputData()
@@ -3146,6 +4711,8 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    ClearGlyphRunCache();
+    ClearTextSizeCache();
 }
 
 static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_chars, int candidate_chars_count)
@@ -3226,6 +4793,24 @@ void ImFont::BuildLookupTable()
     for (int i = 0; i < max_codepoint + 1; i++)
         if (IndexAdvanceX[i] < 0.0f)
             IndexAdvanceX[i] = FallbackAdvanceX;
+
+    // Glyph data may have changed: forget previous text layouts
+    ImFontResetTextCaches(this);
+}
+
+// Also used by ImFontAtlas::LoadBuildCache(), which restores lookup tables without calling BuildLookupTable()
+static void ImFontResetTextCaches(ImFont* font)
+{
+    if (font->GlyphRunCache == NULL)
+        font->GlyphRunCache = IM_NEW(ImFontGlyphRunCache)();
+    font->GlyphRunCache->Clear();
+    font->GlyphRunCache->Disabled = false;
+    for (int i = 0; i < font->Glyphs.Size; i++)
+        if (font->Glyphs[i].Colored)
+            font->GlyphRunCache->Disabled = true;
+    if (font->TextSizeCache == NULL)
+        font->TextSizeCache = IM_NEW(ImFontTextSizeCache)();
+    font->TextSizeCache->Clear();
 }
 
 // API is designed this way to avoid exposing the 4K page size
@@ -3245,6 +4830,19 @@ void ImFont::SetGlyphVisible(ImWchar c, bool visible)
 {
     if (ImFontGlyph* glyph = (ImFontGlyph*)(void*)FindGlyph((ImWchar)c))
         glyph->Visible = visible ? 1 : 0;
+    ClearGlyphRunCache();
+}
+
+void ImFont::ClearGlyphRunCache()
+{
+    if (GlyphRunCache)
+        GlyphRunCache->Clear();
+}
+
+void ImFont::ClearTextSizeCache()
+{
+    if (TextSizeCache)
+        TextSizeCache->Clear();
 }
 
 void ImFont::GrowIndex(int new_size)
@@ -3316,6 +4914,8 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    ClearGlyphRunCache();
+    ClearTextSizeCache();
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
@@ -3441,6 +5041,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
+    ImFontAtlasDynamicGlyphsTouchText(this, text_begin, text_end);
 
     const float line_height = size;
     const float scale = size / FontSize;
@@ -3534,6 +5135,12 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c) const
 {
+    if (draw_list->_ContentHashing)
+    {
+        const struct { const ImFont* Font; ImVec2 Pos; float Size; ImU32 Col; unsigned int C; int GlyphsGeneration; } args = { this, pos, size, col, (unsigned int)c, GlyphRunCache ? GlyphRunCache->Generation : 0 };
+        if (ImDrawListHashPrimitive(draw_list, ImDrawListPrimitive_Char, &args, sizeof(args)))
+            return;
+    }
     const ImFontGlyph* glyph = FindGlyph(c);
     if (!glyph || !glyph->Visible)
         return;
@@ -3547,6 +5154,179 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
+void ImFontGlyphRunCache::Clear()
+{
+    Runs.clear_destruct();
+    Buckets.clear();
+    LruHead = LruTail = -1;
+    Hits = Misses = 0;
+    Generation++;
+}
+
+ImGuiID ImFontGlyphRunCache::HashRun(float size, float wrap_width, const char* text, const char* text_end)
+{
+    ImGuiID seed = ImHashData(&size, sizeof(size));
+    seed = ImHashData(&wrap_width, sizeof(wrap_width), seed);
+    return ImHashStr(text, (size_t)(text_end - text), seed);
+}
+
+int ImFontGlyphRunCache::Find(ImGuiID hash, float size, float wrap_width, const char* text, const char* text_end) const
+{
+    if (Buckets.Size == 0)
+        return -1;
+    const int text_len = (int)(text_end - text);
+    for (int run_idx = Buckets[hash & (Buckets.Size - 1)]; run_idx != -1; run_idx = Runs[run_idx].HashNext)
+    {
+        const ImFontGlyphRun& run = Runs[run_idx];
+        if (run.Hash == hash && run.Size == size && run.WrapWidth == wrap_width && run.Text.Size == text_len && memcmp(run.Text.Data, text, (size_t)text_len) == 0)
+            return run_idx;
+    }
+    return -1;
+}
+
+ImFontGlyphRun* ImFontGlyphRunCache::Add(ImGuiID hash, float size, float wrap_width, const char* text, const char* text_end, int quads_count)
+{
+    if (Buckets.Size == 0)
+    {
+        Buckets.resize(ImUpperPowerOfTwo(IM_FONT_GLYPH_RUN_CACHE_SIZE * 2));
+        memset(Buckets.Data, -1, (size_t)Buckets.size_in_bytes());
+        Runs.reserve(IM_FONT_GLYPH_RUN_CACHE_SIZE);
+    }
+
+    const int text_len = (int)(text_end - text);
+    int run_idx;
+    if (Runs.Size < IM_FONT_GLYPH_RUN_CACHE_SIZE)
+    {
+        // Buffers rounded up to a power of two: more of the text drawn later fits when the run is recycled
+        run_idx = Runs.Size;
+        Runs.push_back(ImFontGlyphRun());
+        Runs[run_idx].Text.reserve(ImUpperPowerOfTwo(ImMax(text_len, 8)));
+        Runs[run_idx].Quads.reserve(ImUpperPowerOfTwo(ImMax(quads_count, 8)));
+    }
+    else
+    {
+        // Recycle one of the least recently used runs that can hold the text without growing its buffers
+        run_idx = LruTail;
+        for (int n = 0; n < 8 && run_idx != -1; n++, run_idx = Runs[run_idx].LruPrev)
+            if (Runs[run_idx].Text.Capacity >= text_len && Runs[run_idx].Quads.Capacity >= quads_count)
+                break;
+        if (run_idx == -1 || Runs[run_idx].Text.Capacity < text_len || Runs[run_idx].Quads.Capacity < quads_count)
+            return NULL;
+
+        ImFontGlyphRun& old_run = Runs[run_idx];
+        int* link = &Buckets[old_run.Hash & (Buckets.Size - 1)];
+        while (*link != run_idx)
+            link = &Runs[*link].HashNext;
+        *link = old_run.HashNext;
+        if (old_run.LruPrev != -1)
+            Runs[old_run.LruPrev].LruNext = old_run.LruNext;
+        else
+            LruHead = old_run.LruNext;
+        if (old_run.LruNext != -1)
+            Runs[old_run.LruNext].LruPrev = old_run.LruPrev;
+        else
+            LruTail = old_run.LruPrev;
+    }
+
+    ImFontGlyphRun& run = Runs[run_idx];
+    run.Hash = hash;
+    run.Size = size;
+    run.WrapWidth = wrap_width;
+    run.Text.resize(text_len);
+    memcpy(run.Text.Data, text, (size_t)text_len);
+    run.Quads.resize(quads_count);
+    int& bucket = Buckets[hash & (Buckets.Size - 1)];
+    run.HashNext = bucket;
+    bucket = run_idx;
+    run.LruPrev = -1;
+    run.LruNext = LruHead;
+    if (LruHead != -1)
+        Runs[LruHead].LruPrev = run_idx;
+    LruHead = run_idx;
+    if (LruTail == -1)
+        LruTail = run_idx;
+    return &run;
+}
+
+void ImFontGlyphRunCache::Touch(int run_idx)
+{
+    if (run_idx == LruHead)
+        return;
+    ImFontGlyphRun& run = Runs[run_idx];
+    Runs[run.LruPrev].LruNext = run.LruNext;
+    if (run.LruNext != -1)
+        Runs[run.LruNext].LruPrev = run.LruPrev;
+    else
+        LruTail = run.LruPrev;
+    run.LruPrev = -1;
+    run.LruNext = LruHead;
+    Runs[LruHead].LruPrev = run_idx;
+    LruHead = run_idx;
+}
+
+size_t ImFontGlyphRunCache::CalcMemoryUsage() const
+{
+    size_t size = sizeof(*this) + (size_t)Runs.Capacity * sizeof(ImFontGlyphRun) + (size_t)Buckets.size_in_bytes();
+    for (int n = 0; n < Runs.Size; n++)
+        size += (size_t)Runs[n].Text.Capacity + (size_t)Runs[n].Quads.Capacity * sizeof(ImVec4);
+    return size;
+}
+
+const ImVec2* ImFontTextSizeCache::Find(ImGuiID hash, int length, float size, float wrap_width)
+{
+    ImFontTextSize* set = &Entries[(hash * 2) & (IM_FONT_TEXT_SIZE_CACHE_SIZE - 1)];
+    for (int n = 0; n < 2; n++)
+        if (set[n].Hash == hash && set[n].Length == length && set[n].Size == size && set[n].WrapWidth == wrap_width)
+        {
+            set[n].LastUse = ++UseCount;
+            return &set[n].TextSize;
+        }
+    return NULL;
+}
+
+void ImFontTextSizeCache::Add(ImGuiID hash, int length, float size, float wrap_width, const ImVec2& text_size)
+{
+    IM_STATIC_ASSERT((IM_FONT_TEXT_SIZE_CACHE_SIZE & (IM_FONT_TEXT_SIZE_CACHE_SIZE - 1)) == 0);
+    ImFontTextSize* set = &Entries[(hash * 2) & (IM_FONT_TEXT_SIZE_CACHE_SIZE - 1)];
+    ImFontTextSize& entry = (set[0].LastUse <= set[1].LastUse) ? set[0] : set[1];
+    entry.Hash = hash;
+    entry.Length = length;
+    entry.Size = size;
+    entry.WrapWidth = wrap_width;
+    entry.TextSize = text_size;
+    entry.LastUse = ++UseCount;
+}
+
+// Emit the quads of a cached run, offset to the text position
+static void RenderGlyphRun(ImDrawList* draw_list, const ImFontGlyphRun& run, float x, float y, ImU32 col)
+{
+    const int quads_count = run.Quads.Size / 2;
+    if (quads_count == 0)
+        return;
+    draw_list->PrimReserve(quads_count * 6, quads_count * 4);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    for (const ImVec4* quad = run.Quads.Data; quad != run.Quads.Data + run.Quads.Size; quad += 2)
+    {
+        const float x1 = x + quad[0].x, y1 = y + quad[0].y, x2 = x + quad[0].z, y2 = y + quad[0].w;
+        const float u1 = quad[1].x, v1 = quad[1].y, u2 = quad[1].z, v2 = quad[1].w;
+        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+        vtx_write += 4;
+        vtx_current_idx += 4;
+        idx_write += 6;
+    }
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+}
+
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
     if (!text_end)
@@ -3557,8 +5337,46 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     float y = IM_FLOOR(pos.y);
     if (y > clip_rect.w)
         return;
+    ImFontAtlasDynamicGlyphsTouchText(this, text_begin, text_end);
+    if (draw_list->_ContentHashing)
+    {
+        // Glyphs rasterized or evicted by the dynamic atlas change the output of the same text: the generation follows them
+        const struct { const ImFont* Font; ImVec4 ClipRect; float X, Y, Size, WrapWidth; ImU32 Col; int CpuFineClip, GlyphsGeneration, TextLength; } args =
+            { this, clip_rect, x, y, size, wrap_width, col, cpu_fine_clip ? 1 : 0, GlyphRunCache ? GlyphRunCache->Generation : 0, (int)(text_end - text_begin) };
+        if (ImDrawListHashPrimitive(draw_list, ImDrawListPrimitive_Text, &args, sizeof(args), text_begin, (size_t)(text_end - text_begin)))
+            return;
+    }
+
+    // Reuse the layout of the same text drawn earlier, if none of its glyphs needs clipping here.
+    // While draw lists are built by several threads, the cache is only read (and no statistics are kept).
+    ImFontGlyphRunCache* run_cache = (GlyphRunCache && !GlyphRunCache->Disabled && text_end - text_begin <= IM_FONT_GLYPH_RUN_MAX_TEXT_LENGTH) ? GlyphRunCache : NULL;
+    const bool run_cache_writable = !draw_list->_Data->CachesReadOnly;
+    ImGuiID run_hash = 0;
+    if (run_cache)
+    {
+        run_hash = ImFontGlyphRunCache::HashRun(size, wrap_width, text_begin, text_end);
+        const int run_idx = run_cache->Find(run_hash, size, wrap_width, text_begin, text_end);
+        if (run_idx != -1)
+        {
+            const ImFontGlyphRun& run = run_cache->Runs[run_idx];
+            if (x + run.Bounds.x >= clip_rect.x && y + run.Bounds.y >= clip_rect.y && x + run.Bounds.z <= clip_rect.z && y + run.Bounds.w <= clip_rect.w)
+            {
+                RenderGlyphRun(draw_list, run, x, y, col);
+                if (run_cache_writable)
+                {
+                    run_cache->Touch(run_idx);
+                    run_cache->Hits++;
+                }
+                return;
+            }
+        }
+        if (run_cache_writable)
+            run_cache->Misses++;
+    }
+    bool run_clipped = false;
 
     const float start_x = x;
+    const float start_y = y;
     const float scale = size / FontSize;
     const float line_height = FontSize * scale;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
@@ -3572,6 +5390,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
             s = (const char*)memchr(s, '\n', text_end - s);
             s = s ? s + 1 : text_end;
             y += line_height;
+            run_clipped = true;
         }
 
     // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
@@ -3600,6 +5419,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    ImDrawVert* const vtx_begin = vtx_write;
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
 
@@ -3651,7 +5471,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
                 x = start_x;
                 y += line_height;
                 if (y > clip_rect.w)
+                {
+                    run_clipped = true;
                     break; // break out of main loop
+                }
                 continue;
             }
             if (c == '\r')
@@ -3670,6 +5493,8 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
             float x2 = x + glyph->X1 * scale;
             float y1 = y + glyph->Y0 * scale;
             float y2 = y + glyph->Y1 * scale;
+            if (x1 < clip_rect.x || y1 < clip_rect.y || x2 > clip_rect.z || y2 > clip_rect.w)
+                run_clipped = true; // Culled or cut by cpu_fine_clip
             if (x1 <= clip_rect.z && x2 >= clip_rect.x)
             {
                 // Render a character
@@ -3735,6 +5560,25 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_current_idx;
+
+    // Record the run. Only runs that were fully emitted are kept, so a replay never has to clip.
+    ImFontGlyphRun* run = (run_cache && run_cache_writable && !run_clipped) ? run_cache->Add(run_hash, size, wrap_width, text_begin, text_end, (int)(vtx_write - vtx_begin) / 2) : NULL;
+    if (run)
+    {
+        run->Bounds = ImVec4(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        ImVec4* quad = run->Quads.Data;
+        for (const ImDrawVert* v = vtx_begin; v != vtx_write; v += 4, quad += 2)
+        {
+            quad[0] = ImVec4(v[0].pos.x - start_x, v[0].pos.y - start_y, v[2].pos.x - start_x, v[2].pos.y - start_y);
+            quad[1] = ImVec4(v[0].uv.x, v[0].uv.y, v[2].uv.x, v[2].uv.y);
+            run->Bounds.x = ImMin(run->Bounds.x, quad[0].x);
+            run->Bounds.y = ImMin(run->Bounds.y, quad[0].y);
+            run->Bounds.z = ImMax(run->Bounds.z, quad[0].z);
+            run->Bounds.w = ImMax(run->Bounds.w, quad[0].w);
+        }
+        if (run->Quads.Size == 0)
+            run->Bounds = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+    }
 }
 
 //-----------------------------------------------------------------------------
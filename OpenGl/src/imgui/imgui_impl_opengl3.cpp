@@ -16,6 +16,10 @@
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
 //  2022-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
+//  2022-XX-XX: OpenGL: Added a second program reconstructing coverage from distance fields, used for the font texture of atlases built with ImFontAtlasFlags_SignedDistanceField.
+//  2022-XX-XX: OpenGL: Upload the region returned by ImFontAtlas::GetTexDataDirtyRect() at the start of ImGui_ImplOpenGL3_RenderDrawData(), for atlases using ImFontAtlasFlags_DynamicGlyphs.
+//  2022-XX-XX: OpenGL: Added ImGui_ImplOpenGL3_SetStateCache(): optional shadow state cache shared with the application, replacing the per-frame glGet*() backup and filtering redundant state changes.
+//  2022-XX-XX: OpenGL: Added persistent-mapped ring upload path (GL 4.4 or GL_ARB_buffer_storage): all draw lists are copied into one fenced, triple-buffered block per frame. See ImGui_ImplOpenGL3_SetPersistentUpload().
 //  2022-05-23: OpenGL: Reworking 2021-12-15 "Using buffer orphaning" so it only happens on Intel GPU, seems to cause problems otherwise. (#4468, #4825, #4832, #5127).
 //  2022-05-13: OpenGL: Fix state corruption on OpenGL ES 2.0 due to not preserving GL_ELEMENT_ARRAY_BUFFER_BINDING and vertex attribute states.
 //  2021-12-15: OpenGL: Using buffer orphaning + glBufferSubData(), seems to fix leaks with multi-viewports with some Intel HD drivers.
@@ -93,6 +97,8 @@
 
 #include "imgui.h"
 #include "imgui_impl_opengl3.h"
+#include "imgui_impl_opengl3_ring.h"
+#include "imgui_impl_opengl3_state.h"
 #include <stdio.h>
 #if defined(_MSC_VER) && _MSC_VER <= 1500 // MSVC 2008 or earlier
 #include <stddef.h>     // intptr_t
@@ -175,6 +181,11 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Desktop GL 4.4+ (or GL_ARB_buffer_storage) has glBufferStorage() and persistent mapping
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_4_4)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
@@ -189,6 +200,9 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLuint          ShaderHandleSdf;         // Font texture of ImFontAtlasFlags_SignedDistanceField atlases. Same vertex shader and attribute locations as ShaderHandle.
+    GLint           AttribLocationSdfTex;
+    GLint           AttribLocationSdfProjMtx;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -197,6 +211,14 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    bool            HasBufferStorage;
+    bool            UsePersistentRing;       // Upload through RingHandle instead of VboHandle/ElementsHandle
+    bool            RingBound;               // RingHandle is the source of the draw data being rendered
+    GLuint          RingHandle;              // Storage of Ring, created by its first Alloc()
+    GLsizeiptr      RingVtxOffset;           // Byte offset of the current submission's vertices in RingHandle
+    ImGui_ImplOpenGL3_Ring Ring;
+    ImGui_ImplOpenGL3_StateCache* StateCache;      // Shared cache installed with ImGui_ImplOpenGL3_SetStateCache(), or NULL
+    ImGui_ImplOpenGL3_StateCache DirectState;      // Unfiltered pass-through used when no cache is installed
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -208,9 +230,22 @@ static ImGui_ImplOpenGL3_Data* ImGui_ImplOpenGL3_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplOpenGL3_Data*)ImGui::GetIO().BackendRendererUserData : NULL;
 }
 
+// State changes made by the backend go through the shared cache when the application installed one
+static ImGui_ImplOpenGL3_StateCache* ImGui_ImplOpenGL3_GetState(ImGui_ImplOpenGL3_Data* bd)
+{
+    return bd->StateCache ? bd->StateCache : &bd->DirectState;
+}
+
 // Forward Declarations
 static void ImGui_ImplOpenGL3_InitPlatformInterface();
 static void ImGui_ImplOpenGL3_ShutdownPlatformInterface();
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static void* ImGui_ImplOpenGL3_CreateRingStorage(void* user_data, size_t size);
+static void ImGui_ImplOpenGL3_DestroyRingStorage(void* user_data);
+static void* ImGui_ImplOpenGL3_InsertFence(void* user_data);
+static bool ImGui_ImplOpenGL3_WaitFence(void* user_data, void* fence, bool block);
+static void ImGui_ImplOpenGL3_DeleteFence(void* user_data, void* fence);
+#endif
 
 // OpenGL vertex attribute state (for ES 1.0 and ES 2.0 only)
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
@@ -320,8 +355,51 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != NULL && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+        if (extension != NULL && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            bd->HasBufferStorage = true;
     }
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->GlVersion >= 440)
+        bd->HasBufferStorage = true;
+    bd->UsePersistentRing = bd->HasBufferStorage;
+    ImGui_ImplOpenGL3_RingFuncs ring_funcs;
+    ring_funcs.CreateStorage = ImGui_ImplOpenGL3_CreateRingStorage;
+    ring_funcs.DestroyStorage = ImGui_ImplOpenGL3_DestroyRingStorage;
+    ring_funcs.InsertFence = ImGui_ImplOpenGL3_InsertFence;
+    ring_funcs.WaitFence = ImGui_ImplOpenGL3_WaitFence;
+    ring_funcs.DeleteFence = ImGui_ImplOpenGL3_DeleteFence;
+    ring_funcs.UserData = NULL;
+    bd->Ring.Init(ring_funcs);
+#else
+    bd->HasBufferStorage = false;
+#endif
+
+    // Fill the pass-through dispatch table from our loader
+    ImGui_ImplOpenGL3_StateFuncs& funcs = bd->DirectState.Funcs;
+    funcs.GetIntegerv = glGetIntegerv;
+    funcs.IsEnabled = glIsEnabled;
+    funcs.Enable = glEnable;
+    funcs.Disable = glDisable;
+    funcs.ActiveTexture = glActiveTexture;
+    funcs.BindTexture = glBindTexture;
+    funcs.UseProgram = glUseProgram;
+    funcs.BindBuffer = glBindBuffer;
+    funcs.Viewport = glViewport;
+    funcs.Scissor = glScissor;
+    funcs.BlendEquationSeparate = glBlendEquationSeparate;
+    funcs.BlendFuncSeparate = glBlendFuncSeparate;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+    if (bd->GlVersion >= 330)
+        funcs.BindSampler = glBindSampler;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    funcs.BindVertexArray = glBindVertexArray;
+#endif
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+    funcs.PolygonMode = glPolygonMode;
+#endif
+    bd->DirectState.FilterRedundant = false;
 
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         ImGui_ImplOpenGL3_InitPlatformInterface();
@@ -342,6 +420,13 @@ void    ImGui_ImplOpenGL3_Shutdown()
     IM_DELETE(bd);
 }
 
+void    ImGui_ImplOpenGL3_SetStateCache(ImGui_ImplOpenGL3_StateCache* cache)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->StateCache = cache;
+}
+
 void    ImGui_ImplOpenGL3_NewFrame()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -354,21 +439,22 @@ void    ImGui_ImplOpenGL3_NewFrame()
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_StateCache* state = ImGui_ImplOpenGL3_GetState(bd);
 
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_STENCIL_TEST);
-    glEnable(GL_SCISSOR_TEST);
+    state->Enable(GL_BLEND);
+    state->BlendEquation(GL_FUNC_ADD);
+    state->BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    state->Disable(GL_CULL_FACE);
+    state->Disable(GL_DEPTH_TEST);
+    state->Disable(GL_STENCIL_TEST);
+    state->Enable(GL_SCISSOR_TEST);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
     if (bd->GlVersion >= 310)
-        glDisable(GL_PRIMITIVE_RESTART);
+        state->Disable(GL_PRIMITIVE_RESTART);
 #endif
 #ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    state->PolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 #endif
 
     // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
@@ -384,7 +470,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 
     // Setup viewport, orthographic projection matrix
     // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
-    glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
+    state->Viewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
     float L = draw_data->DisplayPos.x;
     float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
     float T = draw_data->DisplayPos.y;
@@ -399,34 +485,251 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
-    glUseProgram(bd->ShaderHandle);
+    if (bd->ShaderHandleSdf && (ImGui::GetIO().Fonts->Flags & ImFontAtlasFlags_SignedDistanceField))
+    {
+        state->UseProgram(bd->ShaderHandleSdf);
+        glUniform1i(bd->AttribLocationSdfTex, 0);
+        glUniformMatrix4fv(bd->AttribLocationSdfProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    }
+    state->UseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
-        glBindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
+        state->BindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
 #endif
 
     (void)vertex_array_object;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(vertex_array_object);
+    state->BindVertexArray(vertex_array_object);
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+    // (the persistent ring holds vertices and indices in the same buffer, vertices starting at RingVtxOffset)
+    const GLuint vtx_handle = bd->RingBound ? bd->RingHandle : bd->VboHandle;
+    const GLuint idx_handle = bd->RingBound ? bd->RingHandle : bd->ElementsHandle;
+    const intptr_t vtx_offset = bd->RingBound ? (intptr_t)bd->RingVtxOffset : 0;
+    state->BindBuffer(GL_ARRAY_BUFFER, vtx_handle);
+    state->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, idx_handle);
     glEnableVertexAttribArray(bd->AttribLocationVtxPos);
     glEnableVertexAttribArray(bd->AttribLocationVtxUV);
     glEnableVertexAttribArray(bd->AttribLocationVtxColor);
-    glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
-    glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+    glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, pos)));
+    glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, uv)));
+    glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, col)));
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static void* ImGui_ImplOpenGL3_InsertFence(void*)
+{
+    return (void*)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+static bool ImGui_ImplOpenGL3_WaitFence(void*, void* fence, bool block)
+{
+    if (!block)
+    {
+        GLenum status = glClientWaitSync((GLsync)fence, 0, 0);
+        return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED;
+    }
+    for (;;)
+    {
+        // Flush on the first wait so the fence is guaranteed to reach the GPU; a failed wait is treated as signaled rather than spinning forever
+        GLenum status = glClientWaitSync((GLsync)fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000); // 100 ms
+        if (status != GL_TIMEOUT_EXPIRED)
+            return true;
+    }
+}
+
+static void ImGui_ImplOpenGL3_DeleteFence(void*, void* fence)
+{
+    glDeleteSync((GLsync)fence);
+}
+
+static void* ImGui_ImplOpenGL3_CreateRingStorage(void*, size_t size)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &bd->RingHandle);
+    ImGui_ImplOpenGL3_GetState(bd)->BindBuffer(GL_ARRAY_BUFFER, bd->RingHandle);
+    glBufferStorage(GL_ARRAY_BUFFER, (GLsizeiptr)size, NULL, flags);
+    void* mapped_data = glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)size, flags);
+    if (mapped_data == NULL)
+    {
+        ImGui_ImplOpenGL3_GetState(bd)->OnBufferDeleted(bd->RingHandle);
+        glDeleteBuffers(1, &bd->RingHandle);
+        bd->RingHandle = 0;
+    }
+    return mapped_data;
+}
+
+static void ImGui_ImplOpenGL3_DestroyRingStorage(void*)
+{
+    // Deleting the buffer also unmaps it
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_GetState(bd)->OnBufferDeleted(bd->RingHandle);
+    glDeleteBuffers(1, &bd->RingHandle);
+    bd->RingHandle = 0;
 }
 
+// Copy every draw list into one block of the ring: all vertices first, then all indices.
+// On success the caller draws with glDrawElementsBaseVertex() using running vertex/index counts, and calls Ring.Submit() afterwards.
+static bool ImGui_ImplOpenGL3_UploadToRing(ImDrawData* draw_data, GLsizeiptr* out_idx_offset)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const size_t vtx_size = (size_t)draw_data->TotalVtxCount * sizeof(ImDrawVert);
+    const size_t idx_size = (size_t)draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+    if (vtx_size == 0 || idx_size == 0)
+        return false;
+
+    const size_t offset = bd->Ring.Alloc(vtx_size + idx_size);
+    if (offset == ImGui_ImplOpenGL3_Ring::NoSpace)
+    {
+        // The storage could not be mapped: stay on the glBufferData() path from now on
+        bd->UsePersistentRing = false;
+        return false;
+    }
+
+    char* vtx_dst = (char*)bd->Ring.MappedData + offset;
+    char* idx_dst = vtx_dst + vtx_size;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(idx_dst, cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vtx_dst += (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        idx_dst += (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+    }
+
+    bd->RingVtxOffset = (GLsizeiptr)offset;
+    *out_idx_offset = (GLsizeiptr)(offset + vtx_size);
+    return true;
+}
+#endif
+
+bool    ImGui_ImplOpenGL3_SetPersistentUpload(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->UsePersistentRing = enable && bd->HasBufferStorage;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (!bd->UsePersistentRing)
+        bd->Ring.Destroy();
+#endif
+    return bd->UsePersistentRing;
+}
+
+// GL state saved and restored around ImGui_ImplOpenGL3_RenderDrawData() when no state cache is installed
+struct ImGui_ImplOpenGL3_DriverState
+{
+    GLenum      last_active_texture;
+    GLuint      last_program;
+    GLuint      last_texture;
+    GLuint      last_sampler;
+    GLuint      last_array_buffer;
+    GLuint      last_vertex_array_object;
+    GLint       last_polygon_mode[2];
+    GLint       last_viewport[4];
+    GLint       last_scissor_box[4];
+    GLenum      last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha;
+    GLenum      last_blend_equation_rgb, last_blend_equation_alpha;
+    GLboolean   last_enable_blend, last_enable_cull_face, last_enable_depth_test, last_enable_stencil_test, last_enable_scissor_test, last_enable_primitive_restart;
+
+    void Backup(ImGui_ImplOpenGL3_Data* bd)
+    {
+        glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
+        glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
+        last_sampler = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); }
+#endif
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+        last_vertex_array_object = 0;
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
+#endif
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+        glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
+#endif
+        glGetIntegerv(GL_VIEWPORT, last_viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
+        glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
+        glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
+        glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
+        last_enable_blend = glIsEnabled(GL_BLEND);
+        last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
+        last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+        last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
+        last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+        last_enable_primitive_restart = GL_FALSE;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+#endif
+    }
+
+    void Restore(ImGui_ImplOpenGL3_Data* bd)
+    {
+        glUseProgram(last_program);
+        glBindTexture(GL_TEXTURE_2D, last_texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330)
+            glBindSampler(0, last_sampler);
+#endif
+        glActiveTexture(last_active_texture);
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindVertexArray(last_vertex_array_object);
+#endif
+        glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+        glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
+        glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
+        if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+        if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+        if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+        if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
+        if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        if (bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+#endif
+
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+        glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
+#endif
+        glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
+        glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+        (void)bd;
+    }
+};
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
+// Upload the part of the font atlas modified since last frame (ImFontAtlasFlags_DynamicGlyphs). Leaves the texture bound to the active unit.
+static void ImGui_ImplOpenGL3_UpdateFontsTexture(ImGui_ImplOpenGL3_StateCache* state)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    int x, y, w, h;
+    if (!bd->FontTexture || !atlas->GetTexDataDirtyRect(&x, &y, &w, &h))
+        return;
+
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    state->BindTexture(GL_TEXTURE_2D, bd->FontTexture);
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + ((size_t)y * width + x) * 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#else
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)y * width * 4);
+#endif
+}
+
 void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
@@ -438,14 +741,14 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
-#endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+    // With a shared state cache the backup is a copy of its shadow state, otherwise every value is queried from the driver.
+    ImGui_ImplOpenGL3_StateCache* state = ImGui_ImplOpenGL3_GetState(bd);
+    ImGui_ImplOpenGL3_State last_cached_state;
+    ImGui_ImplOpenGL3_DriverState last_driver_state;
+    if (bd->StateCache)
+        last_cached_state = bd->StateCache->Current;
+    else
+        last_driver_state.Backup(bd);
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
     GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
@@ -453,28 +756,8 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
     ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
 #endif
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
-#endif
+    state->ActiveTexture(GL_TEXTURE0);
+    ImGui_ImplOpenGL3_UpdateFontsTexture(state);
 
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
@@ -483,13 +766,27 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     glGenVertexArrays(1, &vertex_array_object);
 #endif
+
+    // With the persistent ring, everything is uploaded here with plain memcpy and the loop below only issues draws
+    GLsizeiptr ring_idx_offset = 0;
+    bd->RingBound = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->UsePersistentRing)
+        bd->RingBound = ImGui_ImplOpenGL3_UploadToRing(draw_data, &ring_idx_offset);
+#endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
+    // Draws sampling the font texture of a distance field atlas go through ShaderHandleSdf
+    const ImTextureID sdf_tex_id = (bd->ShaderHandleSdf && (ImGui::GetIO().Fonts->Flags & ImFontAtlasFlags_SignedDistanceField)) ? ImGui::GetIO().Fonts->TexID : (ImTextureID)NULL;
+    GLuint program = bd->ShaderHandle;
+
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
     // Render command lists
+    int global_vtx_offset = 0;
+    int global_idx_offset = 0;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
@@ -500,7 +797,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - OpenGL drivers are in a very sorry state in 2022, for now we are switching code path based on vendors.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
-        if (bd->UseBufferSubData)
+        if (bd->RingBound)
+        {
+            // Already in the ring
+        }
+        else if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
             {
@@ -532,6 +833,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
+                program = bd->ShaderHandle;
             }
             else
             {
@@ -542,59 +844,52 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     continue;
 
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
+                state->Scissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
 
                 // Bind texture, Draw
-                glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+                const GLuint cmd_program = (sdf_tex_id != (ImTextureID)NULL && pcmd->GetTexID() == sdf_tex_id) ? bd->ShaderHandleSdf : bd->ShaderHandle;
+                if (cmd_program != program)
+                    state->UseProgram(program = cmd_program);
+                state->BindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
-                if (bd->GlVersion >= 320)
+                if (bd->RingBound)
+                    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(ring_idx_offset + (global_idx_offset + pcmd->IdxOffset) * sizeof(ImDrawIdx)), (GLint)(global_vtx_offset + pcmd->VtxOffset));
+                else if (bd->GlVersion >= 320)
                     glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
                 else
 #endif
                 glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
             }
         }
+        global_vtx_offset += cmd_list->VtxBuffer.Size;
+        global_idx_offset += cmd_list->IdxBuffer.Size;
     }
 
-    // Destroy the temporary VAO
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glDeleteVertexArrays(1, &vertex_array_object);
+    // Fence this frame's block so the ring does not overwrite it while the GPU may still read it
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->RingBound)
+        bd->Ring.Submit();
 #endif
+    bd->RingBound = false;
+    (void)ring_idx_offset;
 
     // Restore modified GL state
-    glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (bd->GlVersion >= 330)
-        glBindSampler(0, last_sampler);
-#endif
-    glActiveTexture(last_active_texture);
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(last_vertex_array_object);
-#endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+    if (bd->StateCache)
+        bd->StateCache->Restore(last_cached_state);
+    else
+        last_driver_state.Restore(bd);
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
     last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
     last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
     last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
 #endif
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
-#endif
 
-#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
+    // Destroy the temporary VAO (after the restore, so it is no longer bound and the cache stays accurate)
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    state->OnVertexArrayDeleted(vertex_array_object);
+    glDeleteVertexArrays(1, &vertex_array_object);
 #endif
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
     (void)bd; // Not all compilation paths use this
 }
 
@@ -620,6 +915,8 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 #endif
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    int unused_x, unused_y, unused_w, unused_h;
+    io.Fonts->GetTexDataDirtyRect(&unused_x, &unused_y, &unused_w, &unused_h); // Already part of the full upload
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
@@ -636,6 +933,7 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
     if (bd->FontTexture)
     {
+        ImGui_ImplOpenGL3_GetState(bd)->OnTextureDeleted(bd->FontTexture);
         glDeleteTextures(1, &bd->FontTexture);
         io.Fonts->SetTexID(0);
         bd->FontTexture = 0;
@@ -797,28 +1095,86 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
         "}\n";
 
+    // Distance field variants: same as ImFontAtlasSdfCoverage() (0.50196 == IM_FONT_SDF_ON_EDGE / 255)
+    const GLchar* fragment_shader_sdf_glsl_120 =
+        "#ifdef GL_ES\n"
+        "    #extension GL_OES_standard_derivatives : enable\n"
+        "    precision mediump float;\n"
+        "#endif\n"
+        "uniform sampler2D Texture;\n"
+        "varying vec2 Frag_UV;\n"
+        "varying vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    float d = texture2D(Texture, Frag_UV.st).a;\n"
+        "    float coverage = clamp((d - 0.50196) / max(fwidth(d), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    gl_FragColor = vec4(Frag_Color.rgb, Frag_Color.a * coverage);\n"
+        "}\n";
+
+    const GLchar* fragment_shader_sdf_glsl_130 =
+        "uniform sampler2D Texture;\n"
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "out vec4 Out_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    float d = texture(Texture, Frag_UV.st).a;\n"
+        "    float coverage = clamp((d - 0.50196) / max(fwidth(d), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * coverage);\n"
+        "}\n";
+
+    const GLchar* fragment_shader_sdf_glsl_300_es =
+        "precision mediump float;\n"
+        "uniform sampler2D Texture;\n"
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "layout (location = 0) out vec4 Out_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    float d = texture(Texture, Frag_UV.st).a;\n"
+        "    float coverage = clamp((d - 0.50196) / max(fwidth(d), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * coverage);\n"
+        "}\n";
+
+    const GLchar* fragment_shader_sdf_glsl_410_core =
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "uniform sampler2D Texture;\n"
+        "layout (location = 0) out vec4 Out_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    float d = texture(Texture, Frag_UV.st).a;\n"
+        "    float coverage = clamp((d - 0.50196) / max(fwidth(d), 0.0001) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * coverage);\n"
+        "}\n";
+
     // Select shaders matching our GLSL versions
     const GLchar* vertex_shader = NULL;
     const GLchar* fragment_shader = NULL;
+    const GLchar* fragment_shader_sdf = NULL;
     if (glsl_version < 130)
     {
         vertex_shader = vertex_shader_glsl_120;
         fragment_shader = fragment_shader_glsl_120;
+        fragment_shader_sdf = fragment_shader_sdf_glsl_120;
     }
     else if (glsl_version >= 410)
     {
         vertex_shader = vertex_shader_glsl_410_core;
         fragment_shader = fragment_shader_glsl_410_core;
+        fragment_shader_sdf = fragment_shader_sdf_glsl_410_core;
     }
     else if (glsl_version == 300)
     {
         vertex_shader = vertex_shader_glsl_300_es;
         fragment_shader = fragment_shader_glsl_300_es;
+        fragment_shader_sdf = fragment_shader_sdf_glsl_300_es;
     }
     else
     {
         vertex_shader = vertex_shader_glsl_130;
         fragment_shader = fragment_shader_glsl_130;
+        fragment_shader_sdf = fragment_shader_sdf_glsl_130;
     }
 
     // Create shaders
@@ -843,7 +1199,6 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     glDetachShader(bd->ShaderHandle, vert_handle);
     glDetachShader(bd->ShaderHandle, frag_handle);
-    glDeleteShader(vert_handle);
     glDeleteShader(frag_handle);
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
@@ -852,6 +1207,37 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
 
+    // Distance field program, sharing the attribute locations so the vertex setup works for both.
+    // (Optional: without it, e.g. on ES 2.0 without GL_OES_standard_derivatives, distance fields are drawn through ShaderHandle.)
+    const GLchar* fragment_shader_sdf_with_version[2] = { bd->GlslVersionString, fragment_shader_sdf };
+    GLuint frag_sdf_handle = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(frag_sdf_handle, 2, fragment_shader_sdf_with_version, NULL);
+    glCompileShader(frag_sdf_handle);
+    if (CheckShader(frag_sdf_handle, "SDF fragment shader"))
+    {
+        bd->ShaderHandleSdf = glCreateProgram();
+        glAttachShader(bd->ShaderHandleSdf, vert_handle);
+        glAttachShader(bd->ShaderHandleSdf, frag_sdf_handle);
+        glBindAttribLocation(bd->ShaderHandleSdf, bd->AttribLocationVtxPos, "Position");
+        glBindAttribLocation(bd->ShaderHandleSdf, bd->AttribLocationVtxUV, "UV");
+        glBindAttribLocation(bd->ShaderHandleSdf, bd->AttribLocationVtxColor, "Color");
+        glLinkProgram(bd->ShaderHandleSdf);
+        glDetachShader(bd->ShaderHandleSdf, vert_handle);
+        glDetachShader(bd->ShaderHandleSdf, frag_sdf_handle);
+        if (CheckProgram(bd->ShaderHandleSdf, "SDF shader program"))
+        {
+            bd->AttribLocationSdfTex = glGetUniformLocation(bd->ShaderHandleSdf, "Texture");
+            bd->AttribLocationSdfProjMtx = glGetUniformLocation(bd->ShaderHandleSdf, "ProjMtx");
+        }
+        else
+        {
+            glDeleteProgram(bd->ShaderHandleSdf);
+            bd->ShaderHandleSdf = 0;
+        }
+    }
+    glDeleteShader(frag_sdf_handle);
+    glDeleteShader(vert_handle);
+
     // Create buffers
     glGenBuffers(1, &bd->VboHandle);
     glGenBuffers(1, &bd->ElementsHandle);
@@ -871,9 +1257,14 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-    if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
-    if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+    ImGui_ImplOpenGL3_StateCache* state = ImGui_ImplOpenGL3_GetState(bd);
+    if (bd->VboHandle)      { state->OnBufferDeleted(bd->VboHandle); glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    bd->Ring.Destroy();
+#endif
+    if (bd->ElementsHandle) { state->OnBufferDeleted(bd->ElementsHandle); glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+    if (bd->ShaderHandleSdf) { glDeleteProgram(bd->ShaderHandleSdf); bd->ShaderHandleSdf = 0; }
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
 
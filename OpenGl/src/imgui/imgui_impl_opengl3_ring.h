@@ -0,0 +1,185 @@
+// dear imgui: upload ring allocator used by imgui_impl_opengl3.cpp for its persistent-mapped upload path.
+// This file has no OpenGL dependency: the storage buffer and the fences are reached through callbacks, so the
+// wraparound, growth and retirement logic can be exercised with a fake GPU.
+
+// The ring hands out one contiguous block per submission (one ImGui_ImplOpenGL3_RenderDrawData() call).
+// After the draws reading a block were issued, Submit() inserts a fence for it; the block is only
+// reused once that fence has signaled. At most MaxInFlight submissions are outstanding at once, which
+// gives triple buffering: the CPU fills block N while the GPU still reads N-1 and N-2.
+// The storage is created on the first Alloc(), and recreated larger when MaxInFlight blocks of the
+// requested size would not fit, after waiting for every outstanding submission.
+
+#pragma once
+#include "imgui.h"      // IM_ASSERT
+#include <stddef.h>
+#include <string.h>     // memset
+
+struct ImGui_ImplOpenGL3_RingFuncs
+{
+    void*   (*CreateStorage)(void* user_data, size_t size);             // Create a buffer of 'size' bytes and map it persistently. Return the mapping, or NULL on failure
+    void    (*DestroyStorage)(void* user_data);                         // Delete the buffer created last, which also unmaps it
+    void*   (*InsertFence)(void* user_data);                            // Fence signaling once all commands issued so far have completed
+    bool    (*WaitFence)(void* user_data, void* fence, bool block);     // Return true if signaled. With 'block', wait until it is
+    void    (*DeleteFence)(void* user_data, void* fence);
+    void*   UserData;
+};
+
+struct ImGui_ImplOpenGL3_Ring
+{
+    enum { MaxInFlight = 3, Alignment = 16 };
+    static const size_t NoSpace = (size_t)-1;
+    static const size_t InitialCapacity = 4 * 1024 * 1024;
+
+    struct Submission
+    {
+        void*   Fence;
+        size_t  Begin;
+        size_t  End;
+    };
+
+    ImGui_ImplOpenGL3_RingFuncs Funcs;
+    void*       MappedData;                 // Mapping of the storage, NULL until the first Alloc()
+    size_t      Capacity;
+    size_t      Head;                       // Next free byte
+    Submission  InFlight[MaxInFlight];      // Oldest first
+    int         InFlightCount;
+    Submission  Pending;                    // Block returned by Alloc() and not yet submitted
+    bool        HasPending;
+    int         StallCount;                 // Number of times Alloc() had to block on the GPU
+    int         WrapCount;
+    int         GrowCount;
+
+    ImGui_ImplOpenGL3_Ring() { memset((void*)this, 0, sizeof(*this)); }
+
+    void Init(const ImGui_ImplOpenGL3_RingFuncs& funcs)
+    {
+        Destroy();
+        Funcs = funcs;
+    }
+
+    // Wait for every outstanding submission and forget them.
+    void Reset()
+    {
+        while (InFlightCount > 0)
+            Retire(true);
+        Head = 0;
+        HasPending = false;
+    }
+
+    // Reset() and release the storage. The next Alloc() creates it again.
+    void Destroy()
+    {
+        Reset();
+        if (MappedData != NULL)
+            Funcs.DestroyStorage(Funcs.UserData);
+        MappedData = NULL;
+    }
+
+    // Return the offset in MappedData of a block of 'size' bytes (rounded up to Alignment), or NoSpace if the storage could not be created.
+    // May block until the GPU is done with older submissions.
+    size_t Alloc(size_t size)
+    {
+        IM_ASSERT(!HasPending && "Submit() the previous block first!");
+        size = (size + Alignment - 1) & ~(size_t)(Alignment - 1);
+        if (size == 0)
+            return NoSpace;
+
+        // Grow unless MaxInFlight blocks of this size fit, otherwise every frame would wait for the previous one's fence
+        if (MappedData == NULL || (size + Alignment) * MaxInFlight >= Capacity)
+            if (!Grow(size))
+                return NoSpace;
+
+        // Release whatever already finished, then make room for one more submission
+        while (InFlightCount > 0 && Retire(false)) {}
+        if (InFlightCount == MaxInFlight)
+            Retire(true);
+
+        for (;;)
+        {
+            if (InFlightCount == 0)
+            {
+                if (Head + size > Capacity)
+                    Wrap();
+                break;
+            }
+
+            // Bytes in use run from the oldest submission's start up to Head, possibly wrapping past the end.
+            // Never let Head catch up with 'tail' exactly, or a full ring would look empty.
+            const size_t tail = InFlight[0].Begin;
+            if (Head >= tail)
+            {
+                if (Head + size <= Capacity)
+                    break;
+                if (size < tail)
+                {
+                    Wrap();
+                    break;
+                }
+            }
+            else if (Head + size < tail)
+            {
+                break;
+            }
+            Retire(true);
+        }
+
+        Pending.Fence = NULL;
+        Pending.Begin = Head;
+        Pending.End = Head + size;
+        HasPending = true;
+        Head += size;
+        return Pending.Begin;
+    }
+
+    // Fence the block returned by the last Alloc(). Call after issuing the draws that read it.
+    void Submit()
+    {
+        if (!HasPending)
+            return;
+        IM_ASSERT(InFlightCount < MaxInFlight);
+        Pending.Fence = Funcs.InsertFence(Funcs.UserData);
+        InFlight[InFlightCount++] = Pending;
+        HasPending = false;
+    }
+
+private:
+    bool Grow(size_t size)
+    {
+        size_t capacity = Capacity ? Capacity : InitialCapacity;
+        while (capacity <= (size + Alignment) * MaxInFlight)
+            capacity *= 2;
+
+        // The GPU may still be reading the old storage
+        Destroy();
+        MappedData = Funcs.CreateStorage(Funcs.UserData, capacity);
+        if (MappedData == NULL)
+            return false;
+        Capacity = capacity;
+        GrowCount++;
+        return true;
+    }
+
+    void Wrap()
+    {
+        Head = 0;
+        WrapCount++;
+    }
+
+    bool Retire(bool block)
+    {
+        IM_ASSERT(InFlightCount > 0);
+        void* fence = InFlight[0].Fence;
+        if (!Funcs.WaitFence(Funcs.UserData, fence, false))
+        {
+            if (!block)
+                return false;
+            StallCount++;
+            Funcs.WaitFence(Funcs.UserData, fence, true);
+        }
+        Funcs.DeleteFence(Funcs.UserData, fence);
+        for (int n = 1; n < InFlightCount; n++)
+            InFlight[n - 1] = InFlight[n];
+        InFlightCount--;
+        return true;
+    }
+};
@@ -0,0 +1,329 @@
+// dear imgui: optional shadow GL state cache, shared between imgui_impl_opengl3.cpp and the application.
+// This file has no OpenGL dependency: every driver call goes through the ImGui_ImplOpenGL3_StateFuncs dispatch
+// table, which the application fills from its own loader (or a test fills with mock functions).
+
+// Usage:
+//  - Fill 'Funcs', call Sync() once with a current context to read the initial state from the driver.
+//  - Route the tracked bindings and enables below through the cache instead of calling GL directly.
+//    When FilterRedundant is set, a change to the value already current is dropped and counted.
+//  - Install it with ImGui_ImplOpenGL3_SetStateCache(): the backend then backs up and restores its state from the
+//    shadow copy instead of ~20 glGetIntegerv() calls per frame.
+//  - Anything that changes tracked state behind the cache's back must call Sync() afterwards.
+// Tracked: active texture unit, GL_TEXTURE_2D and sampler bindings of the first TextureUnits units, current program,
+// GL_ARRAY_BUFFER binding, vertex array binding, viewport, scissor box, blend equations/functions, polygon mode,
+// and the enables listed in ImGui_ImplOpenGL3_StateCap. Other targets and caps are passed through untracked.
+
+#pragma once
+#include <stddef.h>
+#include <string.h>     // memset, memcmp
+
+#ifndef IMGUI_IMPL_OPENGL_STATE_APIENTRY
+#ifdef _WIN32
+#define IMGUI_IMPL_OPENGL_STATE_APIENTRY __stdcall
+#else
+#define IMGUI_IMPL_OPENGL_STATE_APIENTRY
+#endif
+#endif
+
+// Same signatures as the GL entry points (GLenum/GLuint = unsigned int, GLint/GLsizei = int, GLboolean = unsigned char)
+struct ImGui_ImplOpenGL3_StateFuncs
+{
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *GetIntegerv)(unsigned int pname, int* data);
+    unsigned char   (IMGUI_IMPL_OPENGL_STATE_APIENTRY *IsEnabled)(unsigned int cap);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *Enable)(unsigned int cap);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *Disable)(unsigned int cap);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *ActiveTexture)(unsigned int texture);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *BindTexture)(unsigned int target, unsigned int texture);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *BindSampler)(unsigned int unit, unsigned int sampler);   // May be NULL before GL 3.3
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *UseProgram)(unsigned int program);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *BindBuffer)(unsigned int target, unsigned int buffer);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *BindVertexArray)(unsigned int array);                     // May be NULL on GL ES 2
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *Viewport)(int x, int y, int width, int height);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *Scissor)(int x, int y, int width, int height);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *BlendEquationSeparate)(unsigned int mode_rgb, unsigned int mode_alpha);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *BlendFuncSeparate)(unsigned int src_rgb, unsigned int dst_rgb, unsigned int src_alpha, unsigned int dst_alpha);
+    void            (IMGUI_IMPL_OPENGL_STATE_APIENTRY *PolygonMode)(unsigned int face, unsigned int mode);    // May be NULL on GL ES
+};
+
+enum ImGui_ImplOpenGL3_StateCap
+{
+    ImGui_ImplOpenGL3_StateCap_Blend,
+    ImGui_ImplOpenGL3_StateCap_CullFace,
+    ImGui_ImplOpenGL3_StateCap_DepthTest,
+    ImGui_ImplOpenGL3_StateCap_StencilTest,
+    ImGui_ImplOpenGL3_StateCap_ScissorTest,
+    ImGui_ImplOpenGL3_StateCap_PrimitiveRestart,
+    ImGui_ImplOpenGL3_StateCap_COUNT
+};
+
+struct ImGui_ImplOpenGL3_State
+{
+    enum { TextureUnits = 8 };
+
+    unsigned int    ActiveTexture;                  // GL_TEXTURE0 + unit
+    unsigned int    Texture2D[TextureUnits];
+    unsigned int    Sampler[TextureUnits];
+    unsigned int    Program;
+    unsigned int    ArrayBuffer;
+    unsigned int    VertexArray;
+    int             Viewport[4];
+    int             Scissor[4];
+    unsigned int    BlendEquationRgb, BlendEquationAlpha;
+    unsigned int    BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha;
+    unsigned int    PolygonMode;                    // GL_FRONT_AND_BACK mode
+    bool            Enabled[ImGui_ImplOpenGL3_StateCap_COUNT];
+};
+
+struct ImGui_ImplOpenGL3_StateCache
+{
+    // GL enums used here, spelled out so this header does not need a GL header
+    enum
+    {
+        Gl_TEXTURE_2D = 0x0DE1, Gl_TEXTURE0 = 0x84C0, Gl_ARRAY_BUFFER = 0x8892, Gl_FRONT_AND_BACK = 0x0408,
+        Gl_ACTIVE_TEXTURE = 0x84E0, Gl_TEXTURE_BINDING_2D = 0x8069, Gl_SAMPLER_BINDING = 0x8919, Gl_CURRENT_PROGRAM = 0x8B8D,
+        Gl_ARRAY_BUFFER_BINDING = 0x8894, Gl_VERTEX_ARRAY_BINDING = 0x85B5, Gl_VIEWPORT = 0x0BA2, Gl_SCISSOR_BOX = 0x0C10,
+        Gl_BLEND_EQUATION_RGB = 0x8009, Gl_BLEND_EQUATION_ALPHA = 0x883D, Gl_BLEND_SRC_RGB = 0x80C9, Gl_BLEND_DST_RGB = 0x80C8,
+        Gl_BLEND_SRC_ALPHA = 0x80CB, Gl_BLEND_DST_ALPHA = 0x80CA, Gl_POLYGON_MODE = 0x0B40,
+    };
+
+    ImGui_ImplOpenGL3_StateFuncs Funcs;
+    ImGui_ImplOpenGL3_State Current;
+    bool            FilterRedundant;            // Drop changes to the value already current. When false every call reaches the driver.
+    int             AppliedCount;               // Changes sent to the driver since the last NewFrame()
+    int             SkippedCount;               // Redundant changes dropped since the last NewFrame()
+    int             LastFrameAppliedCount;
+    int             LastFrameSkippedCount;
+
+    ImGui_ImplOpenGL3_StateCache() { memset((void*)this, 0, sizeof(*this)); FilterRedundant = true; }
+
+    static int CapIndex(unsigned int cap)
+    {
+        switch (cap)
+        {
+        case 0x0BE2: return ImGui_ImplOpenGL3_StateCap_Blend;
+        case 0x0B44: return ImGui_ImplOpenGL3_StateCap_CullFace;
+        case 0x0B71: return ImGui_ImplOpenGL3_StateCap_DepthTest;
+        case 0x0B90: return ImGui_ImplOpenGL3_StateCap_StencilTest;
+        case 0x0C11: return ImGui_ImplOpenGL3_StateCap_ScissorTest;
+        case 0x8F9D: return ImGui_ImplOpenGL3_StateCap_PrimitiveRestart;
+        default:     return -1;
+        }
+    }
+    static unsigned int CapEnum(int index)
+    {
+        static const unsigned int caps[ImGui_ImplOpenGL3_StateCap_COUNT] = { 0x0BE2, 0x0B44, 0x0B71, 0x0B90, 0x0C11, 0x8F9D };
+        return caps[index];
+    }
+
+    // Read the whole tracked state from the driver.
+    void Sync()
+    {
+        ImGui_ImplOpenGL3_State& s = Current;
+        Funcs.GetIntegerv(Gl_ACTIVE_TEXTURE, (int*)&s.ActiveTexture);
+        for (int unit = 0; unit < ImGui_ImplOpenGL3_State::TextureUnits; unit++)
+        {
+            Funcs.ActiveTexture(Gl_TEXTURE0 + unit);
+            Funcs.GetIntegerv(Gl_TEXTURE_BINDING_2D, (int*)&s.Texture2D[unit]);
+            s.Sampler[unit] = 0;
+            if (Funcs.BindSampler)
+                Funcs.GetIntegerv(Gl_SAMPLER_BINDING, (int*)&s.Sampler[unit]);
+        }
+        Funcs.ActiveTexture(s.ActiveTexture);
+        Funcs.GetIntegerv(Gl_CURRENT_PROGRAM, (int*)&s.Program);
+        Funcs.GetIntegerv(Gl_ARRAY_BUFFER_BINDING, (int*)&s.ArrayBuffer);
+        s.VertexArray = 0;
+        if (Funcs.BindVertexArray)
+            Funcs.GetIntegerv(Gl_VERTEX_ARRAY_BINDING, (int*)&s.VertexArray);
+        Funcs.GetIntegerv(Gl_VIEWPORT, s.Viewport);
+        Funcs.GetIntegerv(Gl_SCISSOR_BOX, s.Scissor);
+        Funcs.GetIntegerv(Gl_BLEND_EQUATION_RGB, (int*)&s.BlendEquationRgb);
+        Funcs.GetIntegerv(Gl_BLEND_EQUATION_ALPHA, (int*)&s.BlendEquationAlpha);
+        Funcs.GetIntegerv(Gl_BLEND_SRC_RGB, (int*)&s.BlendSrcRgb);
+        Funcs.GetIntegerv(Gl_BLEND_DST_RGB, (int*)&s.BlendDstRgb);
+        Funcs.GetIntegerv(Gl_BLEND_SRC_ALPHA, (int*)&s.BlendSrcAlpha);
+        Funcs.GetIntegerv(Gl_BLEND_DST_ALPHA, (int*)&s.BlendDstAlpha);
+        s.PolygonMode = 0x1B02; // GL_FILL
+        if (Funcs.PolygonMode)
+        {
+            int modes[2] = { 0x1B02, 0x1B02 };
+            Funcs.GetIntegerv(Gl_POLYGON_MODE, modes);
+            s.PolygonMode = (unsigned int)modes[0];
+        }
+        for (int n = 0; n < ImGui_ImplOpenGL3_StateCap_COUNT; n++)
+            s.Enabled[n] = Funcs.IsEnabled(CapEnum(n)) != 0;
+    }
+
+    // Roll the counters over; call once per frame.
+    void NewFrame()
+    {
+        LastFrameAppliedCount = AppliedCount;
+        LastFrameSkippedCount = SkippedCount;
+        AppliedCount = SkippedCount = 0;
+    }
+
+    // Apply every field of 'state' (typically a copy of Current taken earlier), skipping the ones already matching.
+    void Restore(const ImGui_ImplOpenGL3_State& state)
+    {
+        for (int unit = 0; unit < ImGui_ImplOpenGL3_State::TextureUnits; unit++)
+        {
+            if (state.Texture2D[unit] == Current.Texture2D[unit] && state.Sampler[unit] == Current.Sampler[unit])
+                continue;
+            ActiveTexture(Gl_TEXTURE0 + unit);
+            BindTexture(Gl_TEXTURE_2D, state.Texture2D[unit]);
+            if (Funcs.BindSampler)
+                BindSampler(unit, state.Sampler[unit]);
+        }
+        ActiveTexture(state.ActiveTexture);
+        UseProgram(state.Program);
+        if (Funcs.BindVertexArray)
+            BindVertexArray(state.VertexArray);
+        BindBuffer(Gl_ARRAY_BUFFER, state.ArrayBuffer);
+        Viewport(state.Viewport[0], state.Viewport[1], state.Viewport[2], state.Viewport[3]);
+        Scissor(state.Scissor[0], state.Scissor[1], state.Scissor[2], state.Scissor[3]);
+        BlendEquationSeparate(state.BlendEquationRgb, state.BlendEquationAlpha);
+        BlendFuncSeparate(state.BlendSrcRgb, state.BlendDstRgb, state.BlendSrcAlpha, state.BlendDstAlpha);
+        if (Funcs.PolygonMode)
+            PolygonMode(Gl_FRONT_AND_BACK, state.PolygonMode);
+        for (int n = 0; n < ImGui_ImplOpenGL3_StateCap_COUNT; n++)
+            SetEnabled(CapEnum(n), state.Enabled[n]);
+    }
+
+    // Deleting a bound object reverts the binding to 0 in the driver; mirror that here.
+    void OnTextureDeleted(unsigned int texture)         { for (int unit = 0; unit < ImGui_ImplOpenGL3_State::TextureUnits; unit++) if (Current.Texture2D[unit] == texture) Current.Texture2D[unit] = 0; }
+    void OnBufferDeleted(unsigned int buffer)           { if (Current.ArrayBuffer == buffer) Current.ArrayBuffer = 0; }
+    void OnVertexArrayDeleted(unsigned int array)       { if (Current.VertexArray == array) Current.VertexArray = 0; }
+
+    void SetEnabled(unsigned int cap, bool enabled)
+    {
+        const int index = CapIndex(cap);
+        if (index >= 0 && !Changed(Current.Enabled[index] != enabled))
+            return;
+        if (index >= 0)
+            Current.Enabled[index] = enabled;
+        if (enabled) Funcs.Enable(cap); else Funcs.Disable(cap);
+    }
+    void Enable(unsigned int cap)   { SetEnabled(cap, true); }
+    void Disable(unsigned int cap)  { SetEnabled(cap, false); }
+    bool IsEnabled(unsigned int cap) const
+    {
+        const int index = CapIndex(cap);
+        return index >= 0 ? Current.Enabled[index] : Funcs.IsEnabled(cap) != 0;
+    }
+
+    void ActiveTexture(unsigned int texture)
+    {
+        if (!Changed(Current.ActiveTexture != texture))
+            return;
+        Current.ActiveTexture = texture;
+        Funcs.ActiveTexture(texture);
+    }
+
+    void BindTexture(unsigned int target, unsigned int texture)
+    {
+        const int unit = (int)(Current.ActiveTexture - Gl_TEXTURE0);
+        const bool tracked = target == Gl_TEXTURE_2D && unit >= 0 && unit < ImGui_ImplOpenGL3_State::TextureUnits;
+        if (tracked && !Changed(Current.Texture2D[unit] != texture))
+            return;
+        if (tracked)
+            Current.Texture2D[unit] = texture;
+        Funcs.BindTexture(target, texture);
+    }
+
+    void BindSampler(unsigned int unit, unsigned int sampler)
+    {
+        const bool tracked = unit < ImGui_ImplOpenGL3_State::TextureUnits;
+        if (tracked && !Changed(Current.Sampler[unit] != sampler))
+            return;
+        if (tracked)
+            Current.Sampler[unit] = sampler;
+        Funcs.BindSampler(unit, sampler);
+    }
+
+    void UseProgram(unsigned int program)
+    {
+        if (!Changed(Current.Program != program))
+            return;
+        Current.Program = program;
+        Funcs.UseProgram(program);
+    }
+
+    void BindBuffer(unsigned int target, unsigned int buffer)
+    {
+        const bool tracked = target == Gl_ARRAY_BUFFER;
+        if (tracked && !Changed(Current.ArrayBuffer != buffer))
+            return;
+        if (tracked)
+            Current.ArrayBuffer = buffer;
+        Funcs.BindBuffer(target, buffer);
+    }
+
+    void BindVertexArray(unsigned int array)
+    {
+        if (!Changed(Current.VertexArray != array))
+            return;
+        Current.VertexArray = array;
+        Funcs.BindVertexArray(array);
+    }
+
+    void Viewport(int x, int y, int width, int height)
+    {
+        const int value[4] = { x, y, width, height };
+        if (!Changed(memcmp(Current.Viewport, value, sizeof(value)) != 0))
+            return;
+        memcpy(Current.Viewport, value, sizeof(value));
+        Funcs.Viewport(x, y, width, height);
+    }
+
+    void Scissor(int x, int y, int width, int height)
+    {
+        const int value[4] = { x, y, width, height };
+        if (!Changed(memcmp(Current.Scissor, value, sizeof(value)) != 0))
+            return;
+        memcpy(Current.Scissor, value, sizeof(value));
+        Funcs.Scissor(x, y, width, height);
+    }
+
+    void BlendEquation(unsigned int mode) { BlendEquationSeparate(mode, mode); }
+    void BlendEquationSeparate(unsigned int mode_rgb, unsigned int mode_alpha)
+    {
+        if (!Changed(Current.BlendEquationRgb != mode_rgb || Current.BlendEquationAlpha != mode_alpha))
+            return;
+        Current.BlendEquationRgb = mode_rgb;
+        Current.BlendEquationAlpha = mode_alpha;
+        Funcs.BlendEquationSeparate(mode_rgb, mode_alpha);
+    }
+
+    void BlendFuncSeparate(unsigned int src_rgb, unsigned int dst_rgb, unsigned int src_alpha, unsigned int dst_alpha)
+    {
+        if (!Changed(Current.BlendSrcRgb != src_rgb || Current.BlendDstRgb != dst_rgb || Current.BlendSrcAlpha != src_alpha || Current.BlendDstAlpha != dst_alpha))
+            return;
+        Current.BlendSrcRgb = src_rgb;
+        Current.BlendDstRgb = dst_rgb;
+        Current.BlendSrcAlpha = src_alpha;
+        Current.BlendDstAlpha = dst_alpha;
+        Funcs.BlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+    }
+
+    void PolygonMode(unsigned int face, unsigned int mode)
+    {
+        const bool tracked = face == Gl_FRONT_AND_BACK;
+        if (tracked && !Changed(Current.PolygonMode != mode))
+            return;
+        if (tracked)
+            Current.PolygonMode = mode;
+        Funcs.PolygonMode(face, mode);
+    }
+
+private:
+    // Count the change and return whether it must reach the driver
+    bool Changed(bool differs)
+    {
+        if (differs || !FilterRedundant)
+        {
+            AppliedCount++;
+            return true;
+        }
+        SkippedCount++;
+        return false;
+    }
+};
@@ -128,6 +128,7 @@ static const ImU64          IM_U64_MAX = (2ULL * 9223372036854775807LL + 1);
 static bool             InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data, ImGuiInputSource input_source);
 static int              InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end);
 static ImVec2           InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining = NULL, ImVec2* out_offset = NULL, bool stop_on_new_line = false);
+static bool             InputTextCursorBlinkIsVisible(float cursor_anim);
 
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Text, etc.
@@ -3565,6 +3566,7 @@ bool ImGui::InputDouble(const char* label, double* v, double step, double step_f
 // - InputTextReindexLines() [Internal]
 // - InputTextReindexLinesRange() [Internal]
 // - InputTextEx() [Internal]
+// - InputTextMultiline() [ImGuiTextDocument]
 // - DebugNodeInputTextState() [Internal]
 //-------------------------------------------------------------------------
 
@@ -3599,6 +3601,18 @@ static int InputTextCalcTextLenAndLineCount(const char* text_begin, const char**
     return line_count;
 }
 
+// The cursor stays on while 'cursor_anim' is negative (right after an edit), then blinks 0.80s on, 0.40s off.
+// Applications waiting for events get a frame at the next toggle.
+static bool InputTextCursorBlinkIsVisible(float cursor_anim)
+{
+    ImGuiContext& g = *GImGui;
+    if (!g.IO.ConfigInputTextCursorBlink)
+        return true;
+    const float phase = (cursor_anim <= 0.0f) ? cursor_anim : ImFmod(cursor_anim, 1.20f);
+    ImGui::SetMaxWaitBeforeNextFrame((phase <= 0.80f ? 0.80f : 1.20f) - phase);
+    return phase <= 0.80f;
+}
+
 static ImVec2 InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining, ImVec2* out_offset, bool stop_on_new_line)
 {
     ImGuiContext& g = *GImGui;
@@ -4399,10 +4413,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
                 const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
-                char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
+                char* clipboard_data = (char*)MemAllocFrame(clipboard_data_len * sizeof(char));
                 ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
                 SetClipboardText(clipboard_data);
-                MemFree(clipboard_data);
             }
             if (is_cut)
             {
@@ -4418,7 +4431,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                ImWchar* clipboard_filtered = (ImWchar*)IM_ALLOC((clipboard_len + 1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = (ImWchar*)MemAllocFrame((clipboard_len + 1) * sizeof(ImWchar));
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s; )
                 {
@@ -4436,7 +4449,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     stb_textedit_paste(state, &state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
             }
         }
 
@@ -4785,7 +4797,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         if (render_cursor)
         {
             state->CursorAnim += io.DeltaTime;
-            bool cursor_is_visible = (!g.IO.ConfigInputTextCursorBlink) || (state->CursorAnim <= 0.0f) || ImFmod(state->CursorAnim, 1.20f) <= 0.80f;
+            bool cursor_is_visible = InputTextCursorBlinkIsVisible(state->CursorAnim);
             ImVec2 cursor_screen_pos = ImFloor(draw_pos + cursor_offset - draw_scroll);
             ImRect cursor_screen_rect(cursor_screen_pos.x, cursor_screen_pos.y - g.FontSize + 0.5f, cursor_screen_pos.x + 1.0f, cursor_screen_pos.y - 1.5f);
             if (cursor_is_visible && cursor_screen_rect.Overlaps(clip_rect))
@@ -4862,6 +4874,508 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         return value_changed;
 }
 
+// Offsets in ImGuiTextDocument are in bytes: keep them on UTF-8 character boundaries.
+static int InputTextDocumentMoveChar(const ImGuiTextDocument* doc, int offset, int dir)
+{
+    if (dir < 0)
+    {
+        while (offset > 0 && (doc->GetChar(--offset) & 0xC0) == 0x80) {}
+        return offset;
+    }
+    while (offset < doc->Length && (doc->GetChar(++offset) & 0xC0) == 0x80) {}
+    return offset;
+}
+
+static int InputTextDocumentMoveWord(const ImGuiTextDocument* doc, int offset, int dir)
+{
+    offset = InputTextDocumentMoveChar(doc, offset, dir);
+    if (dir < 0)
+        while (offset > 0 && !(ImStb::is_separator((unsigned char)doc->GetChar(offset - 1)) && !ImStb::is_separator((unsigned char)doc->GetChar(offset))))
+            offset--;
+    else
+        while (offset < doc->Length && !(ImStb::is_separator((unsigned char)doc->GetChar(offset - 1)) && !ImStb::is_separator((unsigned char)doc->GetChar(offset))))
+            offset++;
+    return offset;
+}
+
+// Return the text of a line, without its '\n'. Valid until the next call.
+static const char* InputTextDocumentGetLine(ImGuiTextDocument* doc, int line, const char** out_text_end, int* out_line_start)
+{
+    const int line_start = doc->GetLineStart(line);
+    const int line_length = doc->GetLineEnd(line) - line_start;
+    const char* text = doc->GetText(line_start, line_length, &doc->Scratch);
+    *out_text_end = text + line_length;
+    *out_line_start = line_start;
+    return text;
+}
+
+static float InputTextDocumentCalcWidth(const char* text, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    return g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, 0.0f, text, text_end).x;
+}
+
+static float InputTextDocumentCalcCursorX(ImGuiTextDocument* doc, int offset)
+{
+    const char* line_end;
+    int line_start;
+    const char* line = InputTextDocumentGetLine(doc, doc->GetLineFromOffset(offset), &line_end, &line_start);
+    return InputTextDocumentCalcWidth(line, line + (offset - line_start));
+}
+
+static int InputTextDocumentLocateCoord(ImGuiTextDocument* doc, int line_no, float x)
+{
+    ImGuiContext& g = *GImGui;
+    const float scale = g.FontSize / g.Font->FontSize;
+    const char* line_end;
+    int line_start;
+    const char* line = InputTextDocumentGetLine(doc, ImClamp(line_no, 0, doc->LineCount - 1), &line_end, &line_start);
+    const char* s = line;
+    float line_x = 0.0f;
+    while (s < line_end)
+    {
+        unsigned int c;
+        const int char_len = ImTextCharFromUtf8(&c, s, line_end);
+        const float advance = (c == '\r') ? 0.0f : g.Font->GetCharAdvance((ImWchar)c) * scale;
+        if (x < line_x + advance * 0.5f)
+            break;
+        line_x += advance;
+        s += char_len;
+    }
+    return line_start + (int)(s - line);
+}
+
+static void InputTextDocumentMoveCursor(ImGuiTextDocument* doc, int offset, bool select)
+{
+    if (select)
+    {
+        if (!doc->HasSelection())
+            doc->SelectStart = doc->Cursor;
+        doc->SelectEnd = offset;
+    }
+    else
+    {
+        doc->SelectStart = doc->SelectEnd = offset;
+    }
+    doc->Cursor = offset;
+    doc->CursorAnim = -0.30f; // After a user-input the cursor stays on for a while without blinking
+    doc->PreferredX = -1.0f;
+    doc->CursorFollow = true;
+}
+
+static void InputTextDocumentMoveCursorVertical(ImGuiTextDocument* doc, int line_delta, bool select)
+{
+    const float x = (doc->PreferredX >= 0.0f) ? doc->PreferredX : InputTextDocumentCalcCursorX(doc, doc->Cursor);
+    const int line_no = doc->GetLineFromOffset(doc->Cursor) + line_delta;
+    if (line_no < 0)
+        InputTextDocumentMoveCursor(doc, 0, select);
+    else if (line_no >= doc->LineCount)
+        InputTextDocumentMoveCursor(doc, doc->Length, select);
+    else
+        InputTextDocumentMoveCursor(doc, InputTextDocumentLocateCoord(doc, line_no, x), select);
+    doc->PreferredX = x;
+}
+
+// Replace the selection (or insert at the cursor) and place the cursor after the new text
+static void InputTextDocumentReplaceSelection(ImGuiTextDocument* doc, const char* text, const char* text_end, bool record_undo)
+{
+    const int sel_min = ImMin(doc->SelectStart, doc->SelectEnd);
+    const int sel_max = ImMax(doc->SelectStart, doc->SelectEnd);
+    const int where = doc->HasSelection() ? sel_min : doc->Cursor;
+    const int text_len = (int)(text_end - text);
+    doc->Replace(where, doc->HasSelection() ? sel_max - sel_min : 0, text, text_end, record_undo);
+    InputTextDocumentMoveCursor(doc, where + text_len, false);
+}
+
+// Editing a ImGuiTextDocument, where InputTextEx() would need the whole buffer converted to wide chars and stb_textedit
+// to walk every row. All the work here is proportional to the visible lines, plus the number of pieces of the document.
+bool ImGui::InputTextMultiline(const char* label, ImGuiTextDocument* doc, const ImVec2& size_arg, ImGuiInputTextFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+
+    IM_ASSERT(doc != NULL);
+    IM_ASSERT((flags & ~(ImGuiInputTextFlags_ReadOnly | ImGuiInputTextFlags_AllowTabInput | ImGuiInputTextFlags_NoUndoRedo)) == 0); // Other flags are not supported with a document
+
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    const ImGuiStyle& style = g.Style;
+    const bool is_readonly = (flags & ImGuiInputTextFlags_ReadOnly) != 0;
+    const bool is_undoable = (flags & ImGuiInputTextFlags_NoUndoRedo) == 0;
+    flags |= ImGuiInputTextFlags_Multiline; // For InputTextFilterCharacter()
+
+    BeginGroup(); // Open group before calling GetID() because groups tracks id created within their scope (including the scrollbar)
+    const ImGuiID id = window->GetID(label);
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
+    const ImVec2 frame_size = CalcItemSize(size_arg, CalcItemWidth(), g.FontSize * 8.0f + style.FramePadding.y * 2.0f);
+    const ImVec2 total_size = ImVec2(frame_size.x + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), frame_size.y);
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + frame_size);
+    const ImRect total_bb(frame_bb.Min, frame_bb.Min + total_size);
+
+    ImVec2 backup_pos = window->DC.CursorPos;
+    ItemSize(total_bb, style.FramePadding.y);
+    if (!ItemAdd(total_bb, id, &frame_bb, ImGuiItemFlags_Inputable))
+    {
+        EndGroup();
+        return false;
+    }
+    const ImGuiItemStatusFlags item_status_flags = g.LastItemData.StatusFlags;
+    ImGuiLastItemData item_data_backup = g.LastItemData;
+    window->DC.CursorPos = backup_pos;
+
+    // Same child frame as InputTextEx(), scrolling horizontally as well since we don't track a ScrollX of our own
+    PushStyleColor(ImGuiCol_ChildBg, style.Colors[ImGuiCol_FrameBg]);
+    PushStyleVar(ImGuiStyleVar_ChildRounding, style.FrameRounding);
+    PushStyleVar(ImGuiStyleVar_ChildBorderSize, style.FrameBorderSize);
+    PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0)); // Ensure no clip rect so mouse hover can reach FramePadding edges
+    bool child_visible = BeginChildEx(label, id, frame_bb.GetSize(), true, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_HorizontalScrollbar);
+    PopStyleVar(3);
+    PopStyleColor();
+    if (!child_visible)
+    {
+        EndChild();
+        EndGroup();
+        return false;
+    }
+    ImGuiWindow* draw_window = g.CurrentWindow; // Child window
+    draw_window->DC.NavLayersActiveMaskNext |= (1 << draw_window->DC.NavLayerCurrent); // This is to ensure that EndChild() will display a navigation highlight so we can "enter" into it.
+    draw_window->DC.CursorPos += style.FramePadding;
+    ImVec2 draw_pos = draw_window->DC.CursorPos;
+
+    const bool hovered = ItemHoverable(frame_bb, id);
+    const bool hovered_text = hovered && draw_window->InnerRect.Contains(io.MousePos); // Not over the scrollbars
+    if (hovered_text)
+        g.MouseCursor = ImGuiMouseCursor_TextInput;
+
+    const bool input_requested_by_tabbing = (item_status_flags & ImGuiItemStatusFlags_FocusedByTabbing) != 0;
+    const bool input_requested_by_nav = (g.ActiveId != id) && ((g.NavActivateInputId == id) || (g.NavActivateId == id && g.NavInputSource == ImGuiInputSource_Keyboard));
+    const bool user_clicked = hovered_text && io.MouseClicked[0];
+    const bool init_make_active = (user_clicked || input_requested_by_nav || input_requested_by_tabbing);
+    bool clear_active_id = false;
+
+    if (g.ActiveId != id && init_make_active)
+    {
+        SetActiveID(id, window);
+        SetFocusID(id, window);
+        FocusWindow(window);
+
+        // Declare our inputs
+        g.ActiveIdUsingNavDirMask |= (1 << ImGuiDir_Left) | (1 << ImGuiDir_Right) | (1 << ImGuiDir_Up) | (1 << ImGuiDir_Down);
+        SetActiveIdUsingKey(ImGuiKey_Escape);
+        SetActiveIdUsingKey(ImGuiKey_NavGamepadCancel);
+        SetActiveIdUsingKey(ImGuiKey_Home);
+        SetActiveIdUsingKey(ImGuiKey_End);
+        SetActiveIdUsingKey(ImGuiKey_PageUp);
+        SetActiveIdUsingKey(ImGuiKey_PageDown);
+        if (flags & ImGuiInputTextFlags_AllowTabInput) // Disable keyboard tabbing out as we will use the \t character.
+            SetActiveIdUsingKey(ImGuiKey_Tab);
+        doc->CursorAnim = -0.30f;
+    }
+
+    // Release focus when we click outside
+    if (g.ActiveId == id && io.MouseClicked[0] && !hovered && !init_make_active)
+        clear_active_id = true;
+
+    // The document may have been modified by the user since last frame
+    doc->Cursor = ImClamp(doc->Cursor, 0, doc->Length);
+    doc->SelectStart = ImClamp(doc->SelectStart, 0, doc->Length);
+    doc->SelectEnd = ImClamp(doc->SelectEnd, 0, doc->Length);
+
+    const float line_height = g.FontSize;
+    bool value_changed = false;
+    if (g.ActiveId == id && !clear_active_id)
+    {
+        // Although we are active we don't prevent mouse from hovering other elements unless we are interacting right now with the widget.
+        g.ActiveIdAllowOverlap = !io.MouseDown[0];
+        g.WantTextInputNextFrame = 1;
+
+        // Process mouse inputs
+        const int mouse_line = (int)ImFloor((io.MousePos.y - draw_pos.y) / line_height);
+        const float mouse_x = io.MousePos.x - draw_pos.x;
+        if (user_clicked && io.MouseClickedCount[0] >= 2 && !io.KeyShift)
+        {
+            const int offset = InputTextDocumentLocateCoord(doc, mouse_line, mouse_x);
+            if (((io.MouseClickedCount[0] - 2) % 2) == 0)
+            {
+                // Double-click: Select word
+                int word_start = offset, word_end = offset;
+                while (word_start > 0 && !ImStb::is_separator((unsigned char)doc->GetChar(word_start - 1)))
+                    word_start--;
+                while (word_end < doc->Length && !ImStb::is_separator((unsigned char)doc->GetChar(word_end)))
+                    word_end++;
+                if (word_start == word_end)
+                    word_end = InputTextDocumentMoveChar(doc, word_end, +1);
+                InputTextDocumentMoveCursor(doc, word_start, false);
+                InputTextDocumentMoveCursor(doc, word_end, true);
+            }
+            else
+            {
+                // Triple-click: Select line
+                const int line_no = doc->GetLineFromOffset(offset);
+                InputTextDocumentMoveCursor(doc, doc->GetLineStart(line_no), false);
+                InputTextDocumentMoveCursor(doc, line_no + 1 < doc->LineCount ? doc->GetLineStart(line_no + 1) : doc->Length, true);
+            }
+        }
+        else if (user_clicked)
+        {
+            InputTextDocumentMoveCursor(doc, InputTextDocumentLocateCoord(doc, mouse_line, mouse_x), io.KeyShift);
+        }
+        else if (io.MouseDown[0] && !g.ActiveIdIsJustActivated && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
+        {
+            InputTextDocumentMoveCursor(doc, InputTextDocumentLocateCoord(doc, mouse_line, mouse_x), true);
+        }
+
+        // Process keys
+        const bool is_osx = io.ConfigMacOSXBehaviors;
+        const bool is_osx_shift_shortcut = is_osx && (io.KeyMods == (ImGuiModFlags_Super | ImGuiModFlags_Shift));
+        const bool is_wordmove_key_down = is_osx ? io.KeyAlt : io.KeyCtrl;                     // OS X style: Text editing cursor movement using Alt instead of Ctrl
+        const bool is_startend_key_down = is_osx && io.KeySuper && !io.KeyCtrl && !io.KeyAlt;  // OS X style: Line/Text Start and End using Cmd+Arrows instead of Home/End
+        const bool is_ctrl_key_only = (io.KeyMods == ImGuiModFlags_Ctrl);
+        const bool is_shift_key_only = (io.KeyMods == ImGuiModFlags_Shift);
+        const bool is_shortcut_key = is_osx ? (io.KeyMods == ImGuiModFlags_Super) : (io.KeyMods == ImGuiModFlags_Ctrl);
+        const bool ignore_char_inputs = (io.KeyCtrl && !io.KeyAlt) || (is_osx && io.KeySuper);
+
+        const bool is_cut   = ((is_shortcut_key && IsKeyPressed(ImGuiKey_X)) || (is_shift_key_only && IsKeyPressed(ImGuiKey_Delete))) && !is_readonly && doc->HasSelection();
+        const bool is_copy  = ((is_shortcut_key && IsKeyPressed(ImGuiKey_C)) || (is_ctrl_key_only  && IsKeyPressed(ImGuiKey_Insert))) && doc->HasSelection();
+        const bool is_paste = ((is_shortcut_key && IsKeyPressed(ImGuiKey_V)) || (is_shift_key_only && IsKeyPressed(ImGuiKey_Insert))) && !is_readonly;
+        const bool is_undo  = ((is_shortcut_key && IsKeyPressed(ImGuiKey_Z)) && !is_readonly && is_undoable);
+        const bool is_redo  = ((is_shortcut_key && IsKeyPressed(ImGuiKey_Y)) || (is_osx_shift_shortcut && IsKeyPressed(ImGuiKey_Z))) && !is_readonly && is_undoable;
+        const bool is_select_all = is_shortcut_key && IsKeyPressed(ImGuiKey_A);
+        const bool nav_gamepad_active = (io.ConfigFlags & ImGuiConfigFlags_NavEnableGamepad) != 0 && (io.BackendFlags & ImGuiBackendFlags_HasGamepad) != 0;
+        const bool is_enter_pressed = IsKeyPressed(ImGuiKey_Enter, true) || IsKeyPressed(ImGuiKey_KeypadEnter, true);
+        const bool is_cancel = IsKeyPressed(ImGuiKey_Escape, false) || (nav_gamepad_active && IsKeyPressed(ImGuiKey_NavGamepadCancel, false));
+        const int row_count_per_page = ImMax((int)((draw_window->InnerRect.GetHeight() - style.FramePadding.y) / line_height), 1);
+        const int sel_min = ImMin(doc->SelectStart, doc->SelectEnd);
+        const int sel_max = ImMax(doc->SelectStart, doc->SelectEnd);
+        const int edit_length = doc->Length;
+        const int edit_added_size = doc->Added.Size;
+
+        if (IsKeyPressed(ImGuiKey_LeftArrow))
+        {
+            if (is_startend_key_down)           InputTextDocumentMoveCursor(doc, doc->GetLineStart(doc->GetLineFromOffset(doc->Cursor)), io.KeyShift);
+            else if (is_wordmove_key_down)      InputTextDocumentMoveCursor(doc, InputTextDocumentMoveWord(doc, doc->Cursor, -1), io.KeyShift);
+            else if (doc->HasSelection() && !io.KeyShift) InputTextDocumentMoveCursor(doc, sel_min, false);
+            else                                InputTextDocumentMoveCursor(doc, InputTextDocumentMoveChar(doc, doc->Cursor, -1), io.KeyShift);
+        }
+        else if (IsKeyPressed(ImGuiKey_RightArrow))
+        {
+            if (is_startend_key_down)           InputTextDocumentMoveCursor(doc, doc->GetLineEnd(doc->GetLineFromOffset(doc->Cursor)), io.KeyShift);
+            else if (is_wordmove_key_down)      InputTextDocumentMoveCursor(doc, InputTextDocumentMoveWord(doc, doc->Cursor, +1), io.KeyShift);
+            else if (doc->HasSelection() && !io.KeyShift) InputTextDocumentMoveCursor(doc, sel_max, false);
+            else                                InputTextDocumentMoveCursor(doc, InputTextDocumentMoveChar(doc, doc->Cursor, +1), io.KeyShift);
+        }
+        else if (IsKeyPressed(ImGuiKey_UpArrow))    { if (io.KeyCtrl) SetScrollY(draw_window, ImMax(draw_window->Scroll.y - line_height, 0.0f)); else if (is_startend_key_down) InputTextDocumentMoveCursor(doc, 0, io.KeyShift); else InputTextDocumentMoveCursorVertical(doc, -1, io.KeyShift); }
+        else if (IsKeyPressed(ImGuiKey_DownArrow))  { if (io.KeyCtrl) SetScrollY(draw_window, ImMin(draw_window->Scroll.y + line_height, GetScrollMaxY())); else if (is_startend_key_down) InputTextDocumentMoveCursor(doc, doc->Length, io.KeyShift); else InputTextDocumentMoveCursorVertical(doc, +1, io.KeyShift); }
+        else if (IsKeyPressed(ImGuiKey_PageUp))     { InputTextDocumentMoveCursorVertical(doc, -row_count_per_page, io.KeyShift); }
+        else if (IsKeyPressed(ImGuiKey_PageDown))   { InputTextDocumentMoveCursorVertical(doc, +row_count_per_page, io.KeyShift); }
+        else if (IsKeyPressed(ImGuiKey_Home))       { InputTextDocumentMoveCursor(doc, io.KeyCtrl ? 0 : doc->GetLineStart(doc->GetLineFromOffset(doc->Cursor)), io.KeyShift); }
+        else if (IsKeyPressed(ImGuiKey_End))        { InputTextDocumentMoveCursor(doc, io.KeyCtrl ? doc->Length : doc->GetLineEnd(doc->GetLineFromOffset(doc->Cursor)), io.KeyShift); }
+        else if (IsKeyPressed(ImGuiKey_Delete) && !is_readonly && !is_cut)
+        {
+            if (!doc->HasSelection())
+                InputTextDocumentMoveCursor(doc, is_wordmove_key_down ? InputTextDocumentMoveWord(doc, doc->Cursor, +1) : InputTextDocumentMoveChar(doc, doc->Cursor, +1), true);
+            InputTextDocumentReplaceSelection(doc, "", NULL, is_undoable);
+        }
+        else if (IsKeyPressed(ImGuiKey_Backspace) && !is_readonly)
+        {
+            if (!doc->HasSelection())
+                InputTextDocumentMoveCursor(doc, is_wordmove_key_down ? InputTextDocumentMoveWord(doc, doc->Cursor, -1) : InputTextDocumentMoveChar(doc, doc->Cursor, -1), true);
+            InputTextDocumentReplaceSelection(doc, "", NULL, is_undoable);
+        }
+        else if (is_enter_pressed && !is_readonly)
+        {
+            InputTextDocumentReplaceSelection(doc, "\n", NULL, is_undoable);
+        }
+        else if (is_cancel)
+        {
+            clear_active_id = true;
+        }
+        else if (is_undo || is_redo)
+        {
+            if (is_undo ? doc->Undo() : doc->Redo())
+            {
+                doc->CursorAnim = -0.30f;
+                value_changed = true;
+            }
+        }
+        else if (is_select_all)
+        {
+            doc->SelectStart = 0;
+            doc->Cursor = doc->SelectEnd = doc->Length;
+        }
+        else if (is_cut || is_copy)
+        {
+            // Copy selection to clipboard (GetText() points into the document when it can, which isn't zero-terminated)
+            if (io.SetClipboardTextFn)
+            {
+                const char* text = doc->GetText(sel_min, sel_max - sel_min, &doc->Scratch);
+                if (text != doc->Scratch.Data)
+                {
+                    doc->Scratch.resize(sel_max - sel_min + 1);
+                    memcpy(doc->Scratch.Data, text, (size_t)(sel_max - sel_min));
+                    doc->Scratch[sel_max - sel_min] = 0;
+                }
+                SetClipboardText(doc->Scratch.Data);
+            }
+            if (is_cut)
+                InputTextDocumentReplaceSelection(doc, "", NULL, is_undoable);
+        }
+        else if (is_paste)
+        {
+            if (const char* clipboard = GetClipboardText())
+            {
+                // Filter pasted buffer: like InputTextFilterCharacter() without the Unicode ranges, which can't be control characters in UTF-8
+                ImVector<char>& filtered = doc->Scratch;
+                filtered.resize(0);
+                for (const char* s = clipboard; *s; s++)
+                    if ((unsigned char)*s >= ' ' || *s == '\n' || (*s == '\t' && (flags & ImGuiInputTextFlags_AllowTabInput)))
+                        filtered.push_back(*s);
+                if (filtered.Size > 0)
+                    InputTextDocumentReplaceSelection(doc, filtered.Data, filtered.Data + filtered.Size, is_undoable);
+            }
+        }
+
+        // Process text input. Typed characters are inserted at once, as a single undo record.
+        if ((flags & ImGuiInputTextFlags_AllowTabInput) && IsKeyPressed(ImGuiKey_Tab) && !ignore_char_inputs && !io.KeyShift && !is_readonly)
+            InputTextDocumentReplaceSelection(doc, "\t", NULL, is_undoable);
+        if (io.InputQueueCharacters.Size > 0)
+        {
+            if (!ignore_char_inputs && !is_readonly && !input_requested_by_nav)
+            {
+                ImVector<char>& typed = doc->Scratch;
+                typed.resize(0);
+                for (int n = 0; n < io.InputQueueCharacters.Size; n++)
+                {
+                    // Insert character if they pass filtering
+                    unsigned int c = (unsigned int)io.InputQueueCharacters[n];
+                    if (c == '\t') // Skip Tab, see above.
+                        continue;
+                    if (!InputTextFilterCharacter(&c, flags, NULL, NULL, ImGuiInputSource_Keyboard))
+                        continue;
+                    char c_utf8[5];
+                    for (const char* s = ImTextCharToUtf8(c_utf8, c); *s; s++)
+                        typed.push_back(*s);
+                }
+                if (typed.Size > 0)
+                    InputTextDocumentReplaceSelection(doc, typed.Data, typed.Data + typed.Size, is_undoable);
+            }
+
+            // Consume characters
+            io.InputQueueCharacters.resize(0);
+        }
+        value_changed |= (doc->Length != edit_length) || (doc->Added.Size != edit_added_size); // Added only ever grows
+
+        // Scroll to keep the cursor visible. Like InputTextEx() we modify the scroll directly, to display the change in the same frame.
+        if (doc->CursorFollow)
+        {
+            const ImRect& inner_rect = draw_window->InnerRect;
+            const ImVec2 cursor_pos = draw_pos + ImVec2(InputTextDocumentCalcCursorX(doc, doc->Cursor), doc->GetLineFromOffset(doc->Cursor) * line_height);
+            ImVec2 scroll = draw_window->Scroll;
+            if (cursor_pos.y < inner_rect.Min.y + style.FramePadding.y)
+                scroll.y -= inner_rect.Min.y + style.FramePadding.y - cursor_pos.y;
+            else if (cursor_pos.y + line_height > inner_rect.Max.y - style.FramePadding.y)
+                scroll.y += cursor_pos.y + line_height - (inner_rect.Max.y - style.FramePadding.y);
+            if (cursor_pos.x < inner_rect.Min.x + style.FramePadding.x)
+                scroll.x -= inner_rect.Min.x + style.FramePadding.x - cursor_pos.x;
+            else if (cursor_pos.x + 1.0f > inner_rect.Max.x - style.FramePadding.x)
+                scroll.x += cursor_pos.x + 1.0f - (inner_rect.Max.x - style.FramePadding.x);
+            scroll = ImMax(scroll, ImVec2(0.0f, 0.0f));
+            draw_pos += draw_window->Scroll - scroll;
+            draw_window->Scroll = scroll;
+            doc->CursorFollow = false;
+        }
+    }
+
+    if (clear_active_id && g.ActiveId == id)
+        ClearActiveID();
+
+    // Render visible lines only, fetched at once: GetText() copies them only if they span several pieces
+    const ImRect clip_rect = draw_window->ClipRect;
+    const int line_first = ImClamp((int)((clip_rect.Min.y - draw_pos.y) / line_height), 0, doc->LineCount - 1);
+    const int line_last = ImClamp((int)((clip_rect.Max.y - draw_pos.y) / line_height), line_first, doc->LineCount - 1);
+    const int visible_start = doc->GetLineStart(line_first);
+    const int visible_length = doc->GetLineEnd(line_last) - visible_start;
+    const char* visible_text = doc->GetText(visible_start, visible_length, &doc->Scratch);
+    const char* visible_text_end = visible_text + visible_length;
+
+    const bool render_cursor = (g.ActiveId == id);
+    const bool render_selection = render_cursor && doc->HasSelection();
+    const int sel_min = ImMin(doc->SelectStart, doc->SelectEnd);
+    const int sel_max = ImMax(doc->SelectStart, doc->SelectEnd);
+    const ImU32 text_col = GetColorU32(ImGuiCol_Text);
+    const ImU32 bg_color = GetColorU32(ImGuiCol_TextSelectedBg);
+    ImVec2 cursor_screen_pos(-FLT_MAX, -FLT_MAX);
+    ImVec2 line_pos(draw_pos.x, draw_pos.y + line_first * line_height);
+    for (const char* line = visible_text; line <= visible_text_end; line_pos.y += line_height)
+    {
+        const char* line_end = (const char*)memchr(line, '\n', visible_text_end - line);
+        if (line_end == NULL)
+            line_end = visible_text_end;
+        const int line_start_offset = visible_start + (int)(line - visible_text);
+        const int line_end_offset = line_start_offset + (int)(line_end - line);
+
+        if (render_selection && sel_max > line_start_offset && sel_min <= line_end_offset)
+        {
+            float x0 = InputTextDocumentCalcWidth(line, line + (ImMax(sel_min, line_start_offset) - line_start_offset));
+            float x1 = InputTextDocumentCalcWidth(line, line + (ImMin(sel_max, line_end_offset) - line_start_offset));
+            if (sel_max > line_end_offset)
+                x1 += IM_FLOOR(g.Font->GetCharAdvance((ImWchar)' ') * 0.50f); // So we can see selected line breaks
+            draw_window->DrawList->AddRectFilled(ImVec2(line_pos.x + x0, line_pos.y), ImVec2(line_pos.x + x1, line_pos.y + line_height), bg_color);
+        }
+        draw_window->DrawList->AddText(g.Font, g.FontSize, line_pos, text_col, line, line_end);
+        doc->ContentWidth = ImMax(doc->ContentWidth, InputTextDocumentCalcWidth(line, line_end));
+        if (render_cursor && doc->Cursor >= line_start_offset && doc->Cursor <= line_end_offset)
+            cursor_screen_pos = ImFloor(ImVec2(line_pos.x + InputTextDocumentCalcWidth(line, line + (doc->Cursor - line_start_offset)), line_pos.y));
+        line = line_end + 1;
+    }
+
+    // Draw blinking cursor
+    if (render_cursor && cursor_screen_pos.x != -FLT_MAX)
+    {
+        doc->CursorAnim += io.DeltaTime;
+        bool cursor_is_visible = InputTextCursorBlinkIsVisible(doc->CursorAnim);
+        ImRect cursor_screen_rect(cursor_screen_pos.x, cursor_screen_pos.y + 0.5f, cursor_screen_pos.x + 1.0f, cursor_screen_pos.y + line_height - 1.5f);
+        if (cursor_is_visible && cursor_screen_rect.Overlaps(clip_rect))
+            draw_window->DrawList->AddLine(cursor_screen_rect.Min, cursor_screen_rect.GetBL(), GetColorU32(ImGuiCol_Text));
+
+        // Notify OS of text input position for advanced IME (-1 x offset so that Windows IME can cover our cursor. Bit of an extra nicety.)
+        if (!is_readonly)
+        {
+            g.PlatformImeData.WantVisible = true;
+            g.PlatformImeData.InputPos = ImVec2(cursor_screen_pos.x - 1.0f, cursor_screen_pos.y);
+            g.PlatformImeData.InputLineHeight = g.FontSize;
+            g.PlatformImeViewport = window->Viewport->ID;
+        }
+    }
+
+    // For focus requests to work on our multiline we need to ensure our child ItemAdd() call specifies the ImGuiItemFlags_Inputable (ref issue #4761)...
+    Dummy(ImVec2(doc->ContentWidth + style.FramePadding.x, doc->LineCount * line_height + style.FramePadding.y));
+    ImGuiItemFlags backup_item_flags = g.CurrentItemFlags;
+    g.CurrentItemFlags |= ImGuiItemFlags_Inputable | ImGuiItemFlags_NoTabStop;
+    EndChild();
+    item_data_backup.StatusFlags |= (g.LastItemData.StatusFlags & ImGuiItemStatusFlags_HoveredWindow);
+    g.CurrentItemFlags = backup_item_flags;
+
+    // ...and then we need to undo the group overriding last item data, see InputTextEx().
+    EndGroup();
+    if (g.LastItemData.ID == 0)
+    {
+        g.LastItemData.ID = id;
+        g.LastItemData.InFlags = item_data_backup.InFlags;
+        g.LastItemData.StatusFlags = item_data_backup.StatusFlags;
+    }
+
+    if (label_size.x > 0)
+        RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y), label);
+
+    if (value_changed)
+        MarkItemEdited(id);
+
+    IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags);
+    return value_changed;
+}
+
 void ImGui::DebugNodeInputTextState(ImGuiInputTextState* state)
 {
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
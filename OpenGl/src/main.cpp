@@ -1,4 +1,5 @@
 #include <imgui.h>
+#include <imgui_internal.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
@@ -7,166 +8,368 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-#include <iostream>
+#include "AppOptions.h"
+#include "GLState.h"
+#include "HeadlessRunner.h"
+#include "InstanceBatch.h"
+#include "MappedFile.h"
+#include "Profiler.h"
+#include "Scene.h"
+#include "SceneRenderer.h"
+#include "ShaderLibrary.h"
+#include "UniformBuffer.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
 #include <fstream>
+#include <iostream>
 #include <string>
-#include <sstream>
+#include <thread>
+#include <vector>
 
 
-struct ShaderProgramSource
-{
-	std::string VertexSource;
-	std::string FragmentSource;
+float color[4] = {
+	1.0f, 0.76f, 0.0f, 1.0f
 };
 
-static ShaderProgramSource ParseShader( const std::string& filepath )
+float bgcolor[4] = {
+	0, 0, 0, 0
+};
+
+
+
+bool drawUIElements = true;
+bool showProfiler = false;
+bool showPlot = false;
+bool showLogViewer = false;
+bool showTelemetry = false;
+bool drawShapes = true;
+
+bool drawTriangle = false;
+bool drawSquare = true;
+bool drawCircle = false;
+
+bool drawPyramid = false;
+bool drawCube = false;
+bool drawSphere = false;
+
+bool rotate = false;
+bool rotateRight = false;
+bool rotateLeft = false;
+
+// Set when the window system lost what was on screen; event-driven mode then has to draw the next frame
+bool windowDamaged = true;
+
+int instancesPerShape = 1000;
+
+static const int MAX_PLOT_SERIES = 32;
+int plotSeries = 16;
+int plotPoints = 50000;
+int plotMarkers = 0;
+
+
+// Scatters instancesPerShape objects of every enabled shape over the viewport.
+// Each shape uses its own fixed seed so toggling one shape does not reshuffle the others.
+static void PopulateScene( Scene& scene )
 {
-	std::ifstream stream( filepath );
+	const bool enabled[(int)MeshType::Count] = {
+		drawTriangle, drawSquare, drawCircle, drawPyramid, drawCube, drawSphere
+	};
+
+	scene.Clear();
+	if ( !drawShapes )
+		return;
 
-	enum class ShaderType
+	for ( int type = 0; type < (int)MeshType::Count; type++ )
 	{
-		NONE = -1,
-		VERTEX = 0,
-		FRAGMENT = 1
-	};
+		if ( !enabled[type] )
+			continue;
 
-	std::string line;
-	std::stringstream sstring[2];
+		unsigned int seed = type + 1;
+		auto random = [&seed]() {
+			seed = seed * 1664525u + 1013904223u;
+			return ( seed >> 8 ) / 16777216.0f;
+		};
 
-	ShaderType stype = ShaderType::NONE;
+		const bool is3D = type >= (int)MeshType::Pyramid;
 
-	while ( getline( stream, line ) )
-	{
-		if ( line.find( "#shader" ) != std::string::npos )
-		{
-			if ( line.find( "vertex" ) != std::string::npos )
-			{
-				stype = ShaderType::VERTEX;
-			}
-			if ( line.find( "fragment" ) != std::string::npos )
-			{
-				stype = ShaderType::FRAGMENT;
-			}
-		}
-		else
+		for ( int i = 0; i < instancesPerShape; i++ )
 		{
-			sstring[(int)stype] << line << '\n';
+			SceneObject object;
+			object.Mesh = (MeshType)type;
+			object.Position = glm::vec3( random() * 1280.0f, random() * 1280.0f, 0.0f );
+			object.Scale = glm::vec3( 10.0f + random() * 30.0f );
+			if ( is3D )
+				object.Rotation = glm::vec3( 0.5f, 0.6f + random(), 0.0f );
+
+			float shade = 0.6f + 0.4f * random();
+			object.Color = glm::vec4( color[0] * shade, color[1] * shade, color[2] * shade, color[3] );
+
+			scene.Add( object );
 		}
 	}
+}
 
-	return { sstring[0].str(), sstring[1].str() };
+static void OnWindowRefresh( GLFWwindow* )
+{
+	windowDamaged = true;
 }
 
+// A single polyline has to stay under 64K vertices with 16-bit indices, so long series are split into chunks
+static const int PLOT_CHUNK_POINTS = 8192;
 
-float triangleVertices[6] = {
-	0.0f, 0.4f
-	,0.4f, -0.4f
-	,-0.4f, -0.4f,
+struct PlotRecordJob
+{
+	ImVec2 Origin;
+	ImVec2 Size;
+	float Time;
+	ImDrawStream* Streams;
+	std::vector<ImVec2>* Points;
 };
 
-float squareVertices[12] = {
-	200.0f, 200.0f
-	,400.0f, 200.0f
-	,400.0f, 400.0f
-	,400.0f, 400.0f
-	,200.0f, 400.0f
-	,200.0f, 200.0f
-};
+// Fills the stream of one series. Recording a stream doesn't touch the ImGui context, so this runs on the workers.
+static void RecordPlotSeries( void* data, int series )
+{
+	const PlotRecordJob& job = *(const PlotRecordJob*)data;
+	std::vector<ImVec2>& points = job.Points[series];
 
+	points.resize( plotPoints );
+	const float frequency = 2.0f + series * 0.5f;
+	for ( int i = 0; i < plotPoints; i++ )
+	{
+		float t = (float)i / ( plotPoints - 1 );
+		float y = 0.5f + 0.45f * sinf( t * frequency * 6.2831853f + job.Time + series );
+		points[i] = ImVec2( job.Origin.x + t * job.Size.x, job.Origin.y + y * job.Size.y );
+	}
 
-unsigned int indices[] = {
-	0, 1, 2,
-	2, 3, 0
-};
+	ImDrawStream& stream = job.Streams[series];
+	stream.Clear();
+	const ImU32 col = ImColor::HSV( (float)series / plotSeries, 0.6f, 0.9f );
+	for ( int first = 0; first < plotPoints - 1; first += PLOT_CHUNK_POINTS - 1 )
+		stream.AddPolyline( &points[first], std::min( PLOT_CHUNK_POINTS, plotPoints - first ), col, 0, 1.0f );
+	for ( int marker = 0; marker < plotMarkers; marker++ )
+		stream.AddCircleFilled( points[(int)( (float)marker / std::max( plotMarkers - 1, 1 ) * ( plotPoints - 1 ) )], 3.0f, col, 12 );
+}
 
-float position[4] = {
-	0.0f, 0.0f, 0.0f, 1.0f
-};
+// Stress test for the parallel draw path. Every series is recorded into its own
+// ImDrawStream on the worker pool, and ImGui::Render() tessellates them there too.
+static void DrawPlotWindow()
+{
+	PROFILE_FUNCTION();
 
+	static ImDrawStream streams[MAX_PLOT_SERIES];
+	static std::vector<ImVec2> points[MAX_PLOT_SERIES];
 
-float color[4] = {
-	1.0f, 0.76f, 0.0f, 1.0f
-};
+	if ( !ImGui::Begin( "Plot Stress Test", &showPlot ) )
+	{
+		ImGui::End();
+		return;
+	}
 
-float bgcolor[4] = {
-	0, 0, 0, 0
-};
+	ImGui::SliderInt( "Series", &plotSeries, 1, MAX_PLOT_SERIES );
+	ImGui::SliderInt( "Points Per Series", &plotPoints, 2, 200000 );
+	ImGui::SliderInt( "Markers Per Series", &plotMarkers, 0, 20000 );
 
+	bool simd = !ImGui::GetIO().ConfigDrawNoSimd;
+	if ( ImGui::Checkbox( "SIMD Tessellation", &simd ) )
+		ImGui::GetIO().ConfigDrawNoSimd = !simd;
 
+	PlotRecordJob job;
+	job.Origin = ImGui::GetCursorScreenPos();
+	job.Size = ImGui::GetContentRegionAvail();
+	job.Time = (float)ImGui::GetTime();
+	job.Streams = streams;
+	job.Points = points;
+	ImGui::SetMaxWaitBeforeNextFrame( 0.0 ); // animated
 
-bool drawUIElements = true;
-bool drawShapes = true;
+	if ( job.Size.x > 1.0f && job.Size.y > 1.0f )
+	{
+		const ImGuiIO& io = ImGui::GetIO();
+		if ( io.ParallelForFn )
+			io.ParallelForFn( io.ParallelForUserData, plotSeries, RecordPlotSeries, &job );
+		else
+			for ( int series = 0; series < plotSeries; series++ )
+				RecordPlotSeries( &job, series );
 
-bool drawTriangle = false;
-bool drawSquare = true;
-bool drawCircle = false;
+		for ( int series = 0; series < plotSeries; series++ )
+			ImGui::AddDrawStream( &streams[series] );
+	}
 
-bool drawPyramid = false;
-bool drawCube = false;
-bool drawSphere = false;
+	ImGui::Dummy( job.Size );
+	ImGui::End();
+}
 
-bool rotate = false;
-bool rotateRight = false;
-bool rotateLeft = false;
+// Multi-megabyte logs go through ImGuiTextDocument: only the visible lines are laid out each frame.
+static void DrawLogViewerWindow()
+{
+	PROFILE_FUNCTION();
 
+	static ImGuiTextDocument log;
+	static char path[260] = "";
+	static std::string status;
 
-float( *currentVertices )[12] = &squareVertices;
+	if ( !ImGui::Begin( "Log Viewer", &showLogViewer ) )
+	{
+		ImGui::End();
+		return;
+	}
 
+	ImGui::InputText( "##Path", path, sizeof( path ) );
+	ImGui::SameLine();
+	if ( ImGui::Button( "Open" ) )
+	{
+		MappedFile file( path );
+		if ( file.IsOpen() )
+		{
+			const std::string_view text = file.GetView();
+			log.SetText( text.data(), text.data() + text.size() );
+			status.clear();
+		}
+		else
+		{
+			status = std::string( "Failed to open " ) + path;
+		}
+	}
+
+	if ( !status.empty() )
+		ImGui::TextUnformatted( status.c_str() );
+	else
+		ImGui::Text( "%d lines, %.1f MB", log.GetLineCount(), log.GetLength() / ( 1024.0f * 1024.0f ) );
+
+	ImGui::InputTextMultiline( "##Log", &log, ImVec2( -FLT_MIN, -FLT_MIN ), ImGuiInputTextFlags_AllowTabInput );
+	ImGui::End();
+}
 
-static unsigned int CompileShader( unsigned int type, const std::string& source )
+// A million rows of synthetic telemetry, with more streaming in while "Live" is checked.
+// DataTable() keeps its sorted orders across frames and merges the new rows in.
+static void DrawTelemetryWindow()
 {
-	unsigned int id = glCreateShader( type );
-	const char* src = source.c_str();
-	glShaderSource( id, 1, &src, nullptr );
-	glCompileShader( id );
+	PROFILE_FUNCTION();
+
+	static const char* sources[] = { "renderer", "physics", "audio", "network", "streaming", "scripting", "ui", "input" };
+	static std::vector<int> samples;
+	static std::vector<const char*> names;
+	static std::vector<float> latencies;
+	static std::vector<unsigned int> sizes;
+	static ImGuiDataTable table;
+	static bool live = false;
+	static unsigned int seed = 1;
+
+	if ( !ImGui::Begin( "Telemetry Table", &showTelemetry ) )
+	{
+		ImGui::End();
+		return;
+	}
 
-	int result;
+	auto append = []( int count ) {
+		for ( int i = 0; i < count; i++ )
+		{
+			seed = seed * 1664525u + 1013904223u;
+			samples.push_back( (int)samples.size() );
+			names.push_back( sources[( seed >> 8 ) % IM_ARRAYSIZE( sources )] );
+			latencies.push_back( ( ( seed >> 12 ) % 100000 ) / 1000.0f );
+			sizes.push_back( ( seed >> 4 ) % 65536 );
+		}
+	};
 
-	glGetShaderiv( id, GL_COMPILE_STATUS, &result );
-	if ( result == GL_FALSE )
+	if ( samples.empty() )
+		append( 1000000 );
+
+	ImGui::Checkbox( "Live", &live );
+	ImGui::SameLine();
+	ImGui::Text( "%d rows, %d shown", (int)samples.size(), table.GetVisibleRowsCount() );
+	if ( live )
 	{
-		int length;
+		append( 1000 );
+		ImGui::SetMaxWaitBeforeNextFrame( 0.0 );
+	}
 
-		glGetShaderiv( id, GL_INFO_LOG_LENGTH, &length );
-		char* message = (char*)_malloca( length * sizeof( char ) );
-		glGetShaderInfoLog( id, length, &length, message );
-		std::cout << "Failed to compile " <<
-			(type == GL_VERTEX_SHADER ? "vertex" : "fragment")
-			<< std::endl;
-		std::cout << message << std::endl;
+	ImGuiDataTableColumn columns[4];
+	columns[0].Label = "Sample";
+	columns[0].DataType = ImGuiDataType_S32;
+	columns[0].Data = samples.data();
+	columns[1].Label = "Source";
+	columns[1].Strings = names.data();
+	columns[2].Label = "Latency (ms)";
+	columns[2].DataType = ImGuiDataType_Float;
+	columns[2].Data = latencies.data();
+	columns[2].Format = "%.3f";
+	columns[3].Label = "Bytes";
+	columns[3].DataType = ImGuiDataType_U32;
+	columns[3].Data = sizes.data();
+
+	const ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable;
+	ImGui::DataTable( "Telemetry", &table, columns, IM_ARRAYSIZE( columns ), (int)samples.size(), flags );
+	ImGui::End();
+}
 
-		glDeleteShader( id );
+// The first time the profiler opens it is split off the bottom of the Edit
+// window rather than floating over the scene. Edit is not docked in the
+// shipped imgui.ini, so it first gets a dock node at its current place.
+static void DockProfilerBelowEdit()
+{
+	ImGuiWindow* edit = ImGui::FindWindowByName( "Edit" );
+	if ( !edit || ImGui::FindWindowByName( "Profiler" ) || ImGui::FindWindowSettings( ImHashStr( "Profiler" ) ) )
+		return;
 
-		return 0;
+	ImGuiID editNode = edit->DockId;
+	if ( editNode == 0 )
+	{
+		editNode = ImGui::DockBuilderAddNode();
+		ImGui::DockBuilderSetNodePos( editNode, edit->Pos );
+		ImGui::DockBuilderSetNodeSize( editNode, edit->Size );
 	}
 
-	return id;
+	ImGuiID profilerNode, remainingNode;
+	ImGui::DockBuilderSplitNode( editNode, ImGuiDir_Down, 0.4f, &profilerNode, &remainingNode );
+	ImGui::DockBuilderDockWindow( "Edit", remainingNode );
+	ImGui::DockBuilderDockWindow( "Profiler", profilerNode );
+	ImGui::DockBuilderFinish( editNode );
 }
 
-static unsigned int CreateShader( const std::string vertexShader, const std::string& fragmentShader )
+// Restores the font atlas saved by a previous run, or builds it and saves it for the next one.
+// The cache is keyed on the fonts and every build setting, so a stale file is simply rebuilt.
+static void LoadFontAtlas( ImFontAtlas* atlas, const std::filesystem::path& cachePath )
 {
-	unsigned int program = glCreateProgram();
+	PROFILE_FUNCTION();
 
-	unsigned int vs = CompileShader( GL_VERTEX_SHADER, vertexShader );
-	unsigned int fs = CompileShader( GL_FRAGMENT_SHADER, fragmentShader );
+	{
+		MappedFile cache( cachePath );
+		std::string_view view = cache.GetView();
+		if ( cache.IsOpen() && atlas->LoadBuildCache( view.data(), view.size() ) )
+			return;
+	}
 
-	glAttachShader( program, vs );
-	glAttachShader( program, fs );
-	glLinkProgram( program );
-	glValidateProgram( program );
+	atlas->Build();
+	ImVector<char> data;
+	atlas->SaveBuildCache( &data );
 
-	glDeleteShader( fs );
-	glDeleteShader( vs );
+	// Write to a temporary file first so a crash never leaves a half-written cache behind
+	std::filesystem::path temp = cachePath;
+	temp += ".tmp";
+	{
+		std::ofstream stream( temp, std::ios::binary | std::ios::trunc );
+		if ( !stream )
+			return;
+		stream.write( data.Data, data.Size );
+		if ( !stream )
+			return;
+	}
 
-	return program;
+	std::error_code error;
+	std::filesystem::rename( temp, cachePath, error );
 }
 
-glm::mat4 proj = glm::ortho( 0.0f, 1280.0f, 0.0f, 1280.0f, -1.0f, 1.0f );
+glm::mat4 proj = glm::ortho( 0.0f, 1280.0f, 0.0f, 1280.0f, -1000.0f, 1000.0f );
 glm::mat4 view = glm::translate( glm::mat4( 1.0f ), glm::vec3( -100.0f, 0.0f, 0.0f ) );
 
-int main( void )
+int main( int argc, char** argv )
 {
-	glEnable( GL_DEPTH_TEST );
+	AppOptions options;
+	if ( !ParseAppOptions( argc, argv, options ) )
+		return -1;
 
 	GLFWwindow* window;
 
@@ -174,10 +377,15 @@ int main( void )
 	if ( !glfwInit() )
 		return -1;
 
+	/* Headless runs still need a context; a hidden window provides one without showing anything */
+	if ( options.Headless )
+		glfwWindowHint( GLFW_VISIBLE, GLFW_FALSE );
+
 	/* Create a windowed mode window and its OpenGL context */
-	window = glfwCreateWindow( 1280, 1280, "Spinning Cube", NULL, NULL );
+	window = glfwCreateWindow( options.Width, options.Height, "Spinning Cube", NULL, NULL );
 	if ( !window )
 	{
+		std::cout << "Failed to create a window and OpenGL context" << std::endl;
 		glfwTerminate();
 		return -1;
 	}
@@ -187,6 +395,8 @@ int main( void )
 	if ( glewInit() != GLEW_OK )
 		return -1;
 
+	Profiler::Get().InitGpuTimers();
+
 	// Setup Dear ImGui context
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
@@ -196,6 +406,17 @@ int main( void )
 	// Setup Platform/Renderer bindings
 	ImGui_ImplGlfw_InitForOpenGL( window, true );
 	ImGui_ImplOpenGL3_Init( "#version 330" );
+	glfwSetWindowRefreshCallback( window, OnWindowRefresh );
+
+	// Tessellates ImDrawStream contents during ImGui::Render() and sorts DataTable() rows; the main thread is one of the workers
+	WorkerPool* workers = new WorkerPool( std::max( 1u, std::thread::hardware_concurrency() ) - 1 );
+	io.ParallelForFn = WorkerPool::ImGuiParallelFor;
+	io.ParallelForUserData = workers;
+
+	LoadFontAtlas( io.Fonts, "res/imgui_fonts.cache" );
+
+	InitGLState();
+	SetGLStateCacheEnabled( options.StateCache );
 
 
 	// Setup Dear ImGui style
@@ -262,44 +483,64 @@ int main( void )
 
 	float _scale = 1.0f;
 
-	unsigned int buffer;
+	Scene scene;
+	BatchBuilder batches;
+	SceneRenderer* sceneRenderer = new SceneRenderer();
 
-	glGenBuffers( 1, &buffer );
-	glBindBuffer( GL_ARRAY_BUFFER, buffer );
-	glBufferData( GL_ARRAY_BUFFER, 6 * 2 * sizeof( float ), squareVertices, GL_STATIC_DRAW );
+	PopulateScene( scene );
 
-	glEnableVertexAttribArray( 0 );
-	glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, sizeof( float ) * 2, 0 );
+	ShaderLibrary* shaders = new ShaderLibrary( "res/shaders/cache" );
 
-	ShaderProgramSource source = ParseShader( "res/shaders/shader.shader" );
+	unsigned int shader = shaders->Load( "scene", "res/shaders/shader.shader" );
 
-	unsigned int shader = CreateShader( source.VertexSource, source.FragmentSource );
+	ProgramReflection& sceneUniforms = shaders->GetReflection( "scene" );
+	ProgramReflection::UniformHandle modelUniform = sceneUniforms.Find( "u_Model" );
 
-	glUseProgram( shader );
+	UniformBuffer* frameUniforms = new UniformBuffer( FRAME_DATA_BINDING, sizeof( FrameUniforms ) );
 
-	glBindBuffer( GL_ARRAY_BUFFER, 0 );
+	HeadlessRunner* headless = nullptr;
+	if ( options.Headless )
+	{
+		headless = new HeadlessRunner( options );
+		if ( !headless->IsValid() )
+		{
+			std::cout << "Failed to create the offscreen framebuffer" << std::endl;
+			return -1;
+		}
+	}
 
 	glm::vec3 translation( 0.0f, 0.0f, 0.0f );
 
+	// Event-driven mode: hash of the UI on screen, to tell whether a new frame would look any different
+	ImU32 presentedUiHash = 0;
+
 	/* Loop until the user closes the window */
 	while ( !glfwWindowShouldClose( window ) )
 	{
-		/* Render here */
-		glClearColor( bgcolor[0], bgcolor[1], bgcolor[2], bgcolor[3] );
-		glClear( GL_COLOR_BUFFER_BIT );
-
-		glm::mat4 model = glm::translate( glm::mat4( 1.0f ), translation);
+		Profiler::Get().NewFrame();
+		GetGLState().NewFrame();
 
-		glm::mat4 mvp = proj * view * model;
+		if ( headless )
+		{
+			if ( headless->IsDone() )
+				break;
+			headless->BeginFrame();
+		}
 
-		if ( drawSquare )
-			glDrawArrays( GL_TRIANGLES, 0, 6 );
-		if ( rotateLeft )
-			model = glm::rotate( model, 4.0f, glm::vec3( 1.0f, 0.0f, 0.0f) );
+		bool shaderReloaded = false;
+		if ( shaders->ReloadChanged( glfwGetTime() ) )
+		{
+			shader = shaders->Get( "scene" );
+			modelUniform = sceneUniforms.Find( "u_Model" );
+			shaderReloaded = true;
+		}
 
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
-		ImGui::NewFrame();
+		{
+			PROFILE_SCOPE( "ImGui::NewFrame" );
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplGlfw_NewFrame();
+			ImGui::NewFrame();
+		}
 
 		if ( ImGui::IsKeyDown( ImGuiKey_T ) )
 			drawUIElements = !drawUIElements;
@@ -308,13 +549,16 @@ int main( void )
 		else if ( ImGui::IsKeyDown( ImGuiKey_Escape ) )
 			exit( 0 );
 
+		bool sceneDirty = false;
+
 		if ( drawUIElements )
 		{
+			PROFILE_SCOPE( "Edit Window" );
 			ImGui::Begin( "Edit" );
 
 			if ( ImGui::CollapsingHeader( "Properties" ) )
 			{
-				ImGui::ColorEdit4( "Object Color", color );
+				sceneDirty |= ImGui::ColorEdit4( "Object Color", color );
 				ImGui::ColorEdit4( "Background Color", bgcolor );
 				ImGui::SliderFloat2( "Translate", &translation.x, 0.0f, 990.0f );
 				ImGui::SliderFloat( "Scale", &_scale, -5.0f, 5.0f );
@@ -323,15 +567,28 @@ int main( void )
 			ImGui::BeginChild( "Draw Shapes" );
 			if ( ImGui::CollapsingHeader( "2D Shapes" ) )
 			{
-				ImGui::Checkbox( "Draw Triangle", &drawTriangle );
-				ImGui::Checkbox( "Draw Square", &drawSquare );
-				ImGui::Checkbox( "Draw Circle", &drawCircle );
+				sceneDirty |= ImGui::Checkbox( "Draw Triangle", &drawTriangle );
+				sceneDirty |= ImGui::Checkbox( "Draw Square", &drawSquare );
+				sceneDirty |= ImGui::Checkbox( "Draw Circle", &drawCircle );
 			}
 			if ( ImGui::CollapsingHeader( "3D Shapes" ) )
 			{
-				ImGui::Checkbox( "Draw Pyramid", &drawPyramid );
-				ImGui::Checkbox( "Draw Cube", &drawCube );
-				ImGui::Checkbox( "Draw Sphere", &drawSphere );
+				sceneDirty |= ImGui::Checkbox( "Draw Pyramid", &drawPyramid );
+				sceneDirty |= ImGui::Checkbox( "Draw Cube", &drawCube );
+				sceneDirty |= ImGui::Checkbox( "Draw Sphere", &drawSphere );
+			}
+			if ( ImGui::CollapsingHeader( "Scene" ) )
+			{
+				sceneDirty |= ImGui::SliderInt( "Instances Per Shape", &instancesPerShape, 1, 20000 );
+				ImGui::Text( "%u objects in %u draw calls", scene.GetObjectCount(), (unsigned int)batches.GetBatches().size() );
+				ImGui::Text( "Shader cache: %u hits, %u misses", shaders->GetCacheHits(), shaders->GetCacheMisses() );
+				ImGui::Text( "Uniforms: %u uploaded, %u skipped", sceneUniforms.GetUploadCount(), sceneUniforms.GetSkippedCount() );
+
+				bool stateCache = IsGLStateCacheEnabled();
+				if ( ImGui::Checkbox( "GL State Cache", &stateCache ) )
+					SetGLStateCacheEnabled( stateCache );
+				ImGui::Checkbox( "Event-Driven Rendering", &options.EventDriven );
+				ImGui::Text( "GL state: %d applied, %d skipped", GetGLState().LastFrameAppliedCount, GetGLState().LastFrameSkippedCount );
 			}
 
 			if ( ImGui::CollapsingHeader( "Rotation" ) )
@@ -354,6 +611,16 @@ int main( void )
 					ImGui::EndMenu();
 				}
 				
+				if ( ImGui::BeginMenu( "View" ) )
+				{
+					ImGui::MenuItem( "Profiler", NULL, &showProfiler );
+					ImGui::MenuItem( "Plot Stress Test", NULL, &showPlot );
+					ImGui::MenuItem( "Log Viewer", NULL, &showLogViewer );
+					ImGui::MenuItem( "Telemetry Table", NULL, &showTelemetry );
+
+					ImGui::EndMenu();
+				}
+
 				if ( ImGui::BeginMenu( "Help" ) )
 				{
 					ImGui::Text( "Press F1 or T For UI Toggling" );
@@ -367,26 +634,123 @@ int main( void )
 			ImGui::End();
 		}
 
+		if ( drawUIElements && showProfiler )
+		{
+			DockProfilerBelowEdit();
+			Profiler::Get().DrawWindow( &showProfiler );
+		}
 
-		glUseProgram( shader );
-		glUniform4f( glGetUniformLocation( shader, "u_Color" ), color[0], color[1], color[2], color[3] );
-		glUniformMatrix4fv( glGetUniformLocation( shader, "u_MVP" ), 1, GL_FALSE, &mvp[0][0] );
+		if ( drawUIElements && showPlot )
+			DrawPlotWindow();
+
+		if ( drawUIElements && showLogViewer )
+			DrawLogViewerWindow();
+
+		if ( drawUIElements && showTelemetry )
+			DrawTelemetryWindow();
+
+		if ( sceneDirty )
+			PopulateScene( scene );
+
+		{
+			PROFILE_SCOPE( "ImGui::Render" );
+			ImGui::Render();
+		}
+
+		// The UI is built before the scene is drawn, so an event-driven frame that would look like the one
+		// on screen can be dropped. Scene settings edited through the UI show up in the UI's vertices too.
+		bool draw = true;
+		bool uiChanged = false;
+		if ( options.EventDriven )
+		{
+			const ImU32 uiHash = ImGui::GetDrawData()->CalcContentHash();
+			uiChanged = uiHash != presentedUiHash;
+			draw = windowDamaged || sceneDirty || shaderReloaded || uiChanged;
+			presentedUiHash = uiHash;
+		}
+
+		if ( draw )
+		{
+			/* Render here */
+			glClearColor( bgcolor[0], bgcolor[1], bgcolor[2], bgcolor[3] );
+			glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+			glm::mat4 model = glm::translate( glm::mat4( 1.0f ), translation);
+
+			FrameUniforms frame;
+			frame.ViewProj = proj * view;
+			frameUniforms->Update( &frame );
+
+			{
+				PROFILE_SCOPE( "Scene" );
+				PROFILE_GPU_SCOPE( "Scene" );
 
-		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData( ImGui::GetDrawData() );
+				if ( batches.Build( scene ) )
+					sceneRenderer->UploadInstances( batches );
 
-		/* Swap front and back buffers */
-		glfwSwapBuffers( window );
+				sceneUniforms.ResetCounters();
+
+				GetGLState().Enable( GL_DEPTH_TEST );
+				GetGLState().UseProgram( shader );
+				sceneUniforms.Set( modelUniform, model );
+				sceneRenderer->Draw( batches );
+			}
+
+			{
+				PROFILE_SCOPE( "ImGui_ImplOpenGL3_RenderDrawData" );
+				PROFILE_GPU_SCOPE( "ImGui" );
+				ImGui_ImplOpenGL3_RenderDrawData( ImGui::GetDrawData() );
+			}
+
+			/* Swap front and back buffers */
+			{
+				PROFILE_SCOPE( "Present" );
+				if ( headless )
+					headless->EndFrame();
+				else
+					glfwSwapBuffers( window );
+			}
+			windowDamaged = false;
+		}
+		else if ( headless )
+		{
+			headless->SkipFrame();
+		}
 
 		/* Poll for and process events */
-		glfwPollEvents();
+		if ( options.EventDriven )
+		{
+			// Sleep until input arrives, ImGui needs a frame (animations, timers, cursor blink), or the minimum refresh interval elapses.
+			// ImGui sizes windows from the previous frame's contents, so keep going until the UI stops changing.
+			const double timeout = uiChanged ? 0.0 : std::min( ImGui::GetEventWaitingTime(), 1.0 / options.MinRefreshRate );
+			PROFILE_SCOPE( "Wait Events" );
+			if ( timeout > 0.0 )
+				glfwWaitEventsTimeout( timeout );
+			else
+				glfwPollEvents();
+		}
+		else
+		{
+			glfwPollEvents();
+		}
 	}
 
+	if ( headless )
+	{
+		headless->Finish();
+		delete headless;
+	}
+
+	Profiler::Get().ShutdownGpuTimers();
+
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplGlfw_Shutdown();
 	ImGui::DestroyContext();
 
-	glDeleteProgram( shader );
+	delete workers;
+	delete sceneRenderer;
+	delete frameUniforms;
+	delete shaders;
 
 	glfwTerminate();
 